@@ -0,0 +1,237 @@
+/*  KStars tests
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "testcityindex.h"
+
+#include "auxiliary/cityindex.h"
+#include "geolocation.h"
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+
+namespace
+{
+const QString CONNECTION = "testcityindex";
+
+struct TestCity
+{
+    const char *name;
+    const char *province;
+    const char *country;
+    double latitude;
+    double longitude;
+};
+
+const TestCity CITIES[] =
+{
+    { "New York", "New York", "USA", 40.71, -74.01 },
+    { "Newark", "New Jersey", "USA", 40.74, -74.17 },
+    { "Newcastle", "", "United Kingdom", 54.98, -1.61 },
+    { "Yorkton", "Saskatchewan", "Canada", 51.21, -102.46 },
+    { "Paris", "", "France", 48.86, 2.35 },
+    { "Paris", "Texas", "USA", 33.66, -95.56 },
+    // Either side of the date line
+    { "Suva", "", "Fiji", -18.14, 178.44 },
+    { "Apia", "", "Samoa", -13.83, -171.76 },
+    // Near the north pole, on both sides of it
+    { "Alert", "Nunavut", "Canada", 82.50, -62.35 },
+    { "Longyearbyen", "", "Norway", 78.22, 15.65 },
+};
+}
+
+TestCityIndex::TestCityIndex(QObject *parent) : QObject(parent)
+{
+}
+
+void TestCityIndex::initTestCase()
+{
+    QSqlDatabase citydb = QSqlDatabase::addDatabase("QSQLITE", CONNECTION);
+    citydb.setDatabaseName(":memory:");
+    QVERIFY(citydb.open());
+
+    // Same table as citydb.sqlite, with coordinates as text like in the distributed database
+    QSqlQuery query(citydb);
+    QVERIFY(query.exec("CREATE TABLE city (id INTEGER PRIMARY KEY, Name TEXT, Province TEXT, Country TEXT, "
+                       "Latitude TEXT, Longitude TEXT, TZ REAL, TZRule TEXT, Elevation REAL)"));
+    QVERIFY(query.prepare("INSERT INTO city (Name, Province, Country, Latitude, Longitude, TZ, TZRule, Elevation) "
+                          "VALUES (?, ?, ?, ?, ?, 0, '--', 0)"));
+    for (const TestCity &city : CITIES)
+    {
+        query.addBindValue(QString(city.name));
+        query.addBindValue(QString(city.province));
+        query.addBindValue(QString(city.country));
+        query.addBindValue(QString::number(city.latitude, 'f', 2));
+        query.addBindValue(QString::number(city.longitude, 'f', 2));
+        QVERIFY(query.exec());
+    }
+}
+
+void TestCityIndex::cleanupTestCase()
+{
+    QSqlDatabase::database(CONNECTION).close();
+    QSqlDatabase::removeDatabase(CONNECTION);
+}
+
+void TestCityIndex::init()
+{
+    m_Index = new CityIndex(&m_Rulebook);
+    QSqlDatabase citydb = QSqlDatabase::database(CONNECTION);
+    QVERIFY(m_Index->load(citydb, true));
+    QCOMPARE(m_Index->count(), int(sizeof(CITIES) / sizeof(CITIES[0])));
+}
+
+void TestCityIndex::cleanup()
+{
+    delete m_Index;
+    m_Index = nullptr;
+}
+
+QStringList TestCityIndex::search(const QString &city, const QString &province, const QString &country)
+{
+    QStringList names;
+    for (GeoLocation *location : m_Index->search(city, province, country))
+        names.append(location->fullName());
+    names.sort();
+    return names;
+}
+
+void TestCityIndex::testSearch_data()
+{
+    QTest::addColumn<QString>("city");
+    QTest::addColumn<QString>("province");
+    QTest::addColumn<QString>("country");
+    QTest::addColumn<QStringList>("expected");
+
+    QTest::newRow("city prefix") << "new" << "" << ""
+                                 << (QStringList() << "New York, New York, USA" << "Newark, New Jersey, USA"
+                                     << "Newcastle, United Kingdom");
+    QTest::newRow("whole city name") << "NEWARK" << "" << "" << (QStringList() << "Newark, New Jersey, USA");
+    QTest::newRow("city substring not matched") << "york" << "" << ""
+                                    << (QStringList() << "Yorkton, Saskatchewan, Canada");
+    QTest::newRow("unknown city") << "Atlantis" << "" << "" << QStringList();
+    QTest::newRow("province prefix") << "" << "new" << ""
+                                     << (QStringList() << "New York, New York, USA" << "Newark, New Jersey, USA");
+    QTest::newRow("province substring not matched") << "" << "jersey" << "" << QStringList();
+    QTest::newRow("country prefix") << "" << "" << "can"
+                                    << (QStringList() << "Alert, Nunavut, Canada" << "Yorkton, Saskatchewan, Canada");
+    QTest::newRow("country substring not matched") << "" << "" << "kingdom" << QStringList();
+    QTest::newRow("same city name") << "paris" << "" << "" << (QStringList() << "Paris, France" << "Paris, Texas, USA");
+    QTest::newRow("city and country") << "paris" << "" << "fr" << (QStringList() << "Paris, France");
+    QTest::newRow("city and province") << "paris" << "tex" << "" << (QStringList() << "Paris, Texas, USA");
+}
+
+void TestCityIndex::testSearch()
+{
+    QFETCH(QString, city);
+    QFETCH(QString, province);
+    QFETCH(QString, country);
+    QFETCH(QStringList, expected);
+
+    // The filters match the start of the names only, like the location dialogs always did
+    QCOMPARE(search(city, province, country), expected);
+}
+
+void TestCityIndex::testFind()
+{
+    // Empty filters match every city
+    QCOMPARE(m_Index->search(QString(), QString(), QString()).size(), m_Index->count());
+
+    GeoLocation *paris = m_Index->find("Paris", QString(), "USA");
+    QVERIFY(paris != nullptr);
+    QCOMPARE(paris->province(), QString("Texas"));
+
+    // Lookups return the same location, which the index owns
+    QCOMPARE(m_Index->find("Paris", "Texas", QString()), paris);
+    QVERIFY(m_Index->find("Paris", QString(), "Germany") == nullptr);
+    QVERIFY(m_Index->find("Par", QString(), QString()) == nullptr);
+}
+
+void TestCityIndex::testNearestAcrossDateLine()
+{
+    // Suva is 2° away across the date line, Apia 8° away on the same side
+    GeoLocation *nearest = m_Index->nearest(-179.5, -17.5);
+    QVERIFY(nearest != nullptr);
+    QCOMPARE(nearest->name(), QString("Suva"));
+
+    nearest = m_Index->nearest(-175.0, -14.0);
+    QVERIFY(nearest != nullptr);
+    QCOMPARE(nearest->name(), QString("Apia"));
+
+    // Both signs of the date line longitude are the same place
+    nearest = m_Index->nearest(180.0, -18.0);
+    QVERIFY(nearest != nullptr);
+    QCOMPARE(nearest->name(), QString("Suva"));
+
+    nearest = m_Index->nearest(-180.0, -18.0);
+    QVERIFY(nearest != nullptr);
+    QCOMPARE(nearest->name(), QString("Suva"));
+}
+
+void TestCityIndex::testNearestNearPole()
+{
+    // Alert is 8.5° away through the pole, on the opposite meridian
+    GeoLocation *nearest = m_Index->nearest(117.65, 89.0);
+    QVERIFY(nearest != nullptr);
+    QCOMPARE(nearest->name(), QString("Alert"));
+
+    // On the meridian of Longyearbyen, Alert is still nearer, 78° away in longitude
+    nearest = m_Index->nearest(15.65, 88.0);
+    QVERIFY(nearest != nullptr);
+    QCOMPARE(nearest->name(), QString("Alert"));
+
+    // At the pole, the northernmost city is the nearest whatever its longitude
+    nearest = m_Index->nearest(0, 90.0);
+    QVERIFY(nearest != nullptr);
+    QCOMPARE(nearest->name(), QString("Alert"));
+
+    nearest = m_Index->nearest(15.65, 80.0);
+    QVERIFY(nearest != nullptr);
+    QCOMPARE(nearest->name(), QString("Longyearbyen"));
+}
+
+void TestCityIndex::testUserCities()
+{
+    // Added cities are found by name and position
+    GeoLocation *added = new GeoLocation(dms(-75.0), dms(-14.0), "Newtown", "", "Atlantis", 0, nullptr, 0, false);
+    m_Index->add(added);
+    QCOMPARE(m_Index->count(), int(sizeof(CITIES) / sizeof(CITIES[0])) + 1);
+    QVERIFY(search("new").contains("Newtown, Atlantis"));
+    QCOMPARE(search("", "", "atl"), QStringList() << "Newtown, Atlantis");
+    QCOMPARE(m_Index->nearest(-75.5, -14.5), added);
+    QVERIFY(m_Index->locations().contains(added));
+
+    // Updated cities are found by their new name and position only
+    added->setName("Oldtown");
+    added->setLong(dms(10.0));
+    added->setLat(dms(-60.0));
+    m_Index->update(added);
+    QVERIFY(search("new").contains("Newtown, Atlantis") == false);
+    QCOMPARE(search("old"), QStringList() << "Oldtown, Atlantis");
+    QCOMPARE(m_Index->find("Oldtown", QString(), "Atlantis"), added);
+    QVERIFY(m_Index->nearest(-75.5, -14.5) != added);
+    QCOMPARE(m_Index->nearest(10.0, -60.0), added);
+
+    // Removed cities are no longer found, and the caller owns them again
+    m_Index->remove(added);
+    QCOMPARE(m_Index->count(), int(sizeof(CITIES) / sizeof(CITIES[0])));
+    QVERIFY(search("old").isEmpty());
+    QVERIFY(search("", "", "atl").isEmpty());
+    QVERIFY(m_Index->nearest(10.0, -60.0) != added);
+    QVERIFY(m_Index->locations().contains(added) == false);
+    delete added;
+
+    // Cities read from the database can be removed too
+    GeoLocation *newark = m_Index->find("Newark", QString(), QString());
+    QVERIFY(newark != nullptr);
+    m_Index->remove(newark);
+    delete newark;
+    QCOMPARE(search("newa"), QStringList());
+    QCOMPARE(search("new"), QStringList() << "New York, New York, USA" << "Newcastle, United Kingdom");
+}
+
+QTEST_GUILESS_MAIN(TestCityIndex)
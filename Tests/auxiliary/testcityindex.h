@@ -0,0 +1,47 @@
+/*  KStars tests
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#ifndef TESTCITYINDEX_H
+#define TESTCITYINDEX_H
+
+#include <QtTest>
+#include <QObject>
+
+#include "timezonerule.h"
+
+class CityIndex;
+
+class TestCityIndex : public QObject
+{
+    Q_OBJECT
+public:
+    explicit TestCityIndex(QObject *parent = nullptr);
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void init();
+    void cleanup();
+
+    void testSearch_data();
+    void testSearch();
+    void testFind();
+    void testNearestAcrossDateLine();
+    void testNearestNearPole();
+    void testUserCities();
+
+private:
+    /** Names of the cities found by a search, sorted */
+    QStringList search(const QString &city, const QString &province = QString(), const QString &country = QString());
+
+    QMap<QString, TimeZoneRule> m_Rulebook;
+    CityIndex *m_Index { nullptr };
+};
+
+#endif // TESTCITYINDEX_H
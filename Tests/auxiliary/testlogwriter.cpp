@@ -0,0 +1,111 @@
+/*  KStars tests
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "testlogwriter.h"
+
+#include "auxiliary/logwriter.h"
+
+#include <QtConcurrent>
+
+TestLogWriter::TestLogWriter(QObject *parent) : QObject(parent)
+{
+}
+
+QStringList TestLogWriter::readLines(const QString &filename)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return QStringList();
+    return QString::fromUtf8(file.readAll()).split('\n', QString::SkipEmptyParts);
+}
+
+void TestLogWriter::testConcurrentAppend()
+{
+    const QString filename = m_Dir.filePath("concurrent.txt");
+    const int threads = 4, lines = 5000;
+
+    {
+        LogWriter writer(filename, 256);
+        writer.start();
+
+        QList<QFuture<void>> futures;
+        for (int t = 0; t < threads; t++)
+            futures << QtConcurrent::run([&writer, t, lines]()
+        {
+            for (int i = 0; i < lines; i++)
+            {
+                // Retry dropped lines so that every line is eventually written
+                while (writer.append(QString("%1 %2\n").arg(t).arg(i)) == false)
+                    QThread::yieldCurrentThread();
+            }
+        });
+        for (QFuture<void> &future : futures)
+            future.waitForFinished();
+    }
+
+    // Every line is written once, in order for each thread, apart from the drop notices
+    QVector<int> next(threads, 0);
+    for (const QString &line : readLines(filename))
+    {
+        if (line.contains("dropped"))
+            continue;
+        const QStringList fields = line.split(' ');
+        QCOMPARE(fields.size(), 2);
+        const int t = fields[0].toInt();
+        QCOMPARE(fields[1].toInt(), next[t]);
+        next[t]++;
+    }
+    for (int t = 0; t < threads; t++)
+        QCOMPARE(next[t], lines);
+}
+
+void TestLogWriter::testDrop()
+{
+    const QString filename = m_Dir.filePath("drop.txt");
+
+    // Not started, so nothing drains the buffer until flushed
+    LogWriter writer(filename, 4);
+    for (int i = 0; i < 10; i++)
+        writer.append(QString("line %1\n").arg(i));
+    QCOMPARE(writer.dropped(), 6u);
+
+    writer.flush();
+    const QStringList lines = readLines(filename);
+    QCOMPARE(lines.size(), 5);
+    QCOMPARE(lines[0], QString("line 0"));
+    QCOMPARE(lines[3], QString("line 3"));
+    QVERIFY(lines[4].contains("6 log messages dropped"));
+
+    // The buffer is usable again once drained
+    QVERIFY(writer.append("line 10\n"));
+    writer.flush();
+    QCOMPARE(readLines(filename).last(), QString("line 10"));
+}
+
+void TestLogWriter::testRotation()
+{
+    const QString filename = m_Dir.filePath("rotation.txt");
+
+    LogWriter writer(filename, 16);
+    writer.setMaxFileSize(10);
+    writer.setMaxRotatedFiles(2);
+
+    for (int i = 0; i < 4; i++)
+    {
+        writer.append(QString("batch %1 is long enough to rotate\n").arg(i));
+        writer.flush();
+    }
+
+    // Each batch went past the maximum size, so the file was emptied after each of them
+    QVERIFY(readLines(filename).isEmpty());
+    QCOMPARE(readLines(filename + ".1"), QStringList("batch 3 is long enough to rotate"));
+    QCOMPARE(readLines(filename + ".2"), QStringList("batch 2 is long enough to rotate"));
+    QVERIFY(!QFile::exists(filename + ".3"));
+}
+
+QTEST_GUILESS_MAIN(TestLogWriter)
@@ -0,0 +1,33 @@
+/*  KStars tests
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#ifndef TESTLOGWRITER_H
+#define TESTLOGWRITER_H
+
+#include <QtTest>
+#include <QObject>
+#include <QTemporaryDir>
+
+class TestLogWriter : public QObject
+{
+    Q_OBJECT
+public:
+    explicit TestLogWriter(QObject *parent = nullptr);
+
+private slots:
+    void testConcurrentAppend();
+    void testDrop();
+    void testRotation();
+
+private:
+    QStringList readLines(const QString &filename);
+
+    QTemporaryDir m_Dir;
+};
+
+#endif // TESTLOGWRITER_H
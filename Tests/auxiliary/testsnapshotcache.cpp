@@ -0,0 +1,140 @@
+/*  KStars tests
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "testsnapshotcache.h"
+
+#include "auxiliary/snapshotcache.h"
+
+#include <sys/types.h>
+#include <utime.h>
+
+namespace
+{
+const QString SNAPSHOT_NAME = "testsnapshot";
+const QStringList RECORDS   = QStringList() << "M 31" << "NGC 7000" << "IC 434";
+}
+
+TestSnapshotCache::TestSnapshotCache(QObject *parent) : QObject(parent)
+{
+}
+
+void TestSnapshotCache::initTestCase()
+{
+    // Keep the snapshots out of the user cache
+    QStandardPaths::setTestModeEnabled(true);
+    m_Source = m_Dir.filePath("source.dat");
+}
+
+void TestSnapshotCache::init()
+{
+    writeSource("M 31\nNGC 7000\nIC 434\n");
+    QFile::remove(SnapshotCache(SNAPSHOT_NAME, QStringList(m_Source), 1).filename());
+}
+
+void TestSnapshotCache::writeSource(const QByteArray &content)
+{
+    QFile file(m_Source);
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    file.write(content);
+}
+
+bool TestSnapshotCache::saveRecords(const QStringList &records, quint32 version)
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    SnapshotCache::prepare(stream);
+    stream << records;
+    return SnapshotCache(SNAPSHOT_NAME, QStringList(m_Source), version).save(data);
+}
+
+void TestSnapshotCache::testRoundTrip()
+{
+    QVERIFY(SnapshotCache(SNAPSHOT_NAME, QStringList(m_Source), 1).load() == false);
+    QVERIFY(saveRecords(RECORDS, 1));
+
+    SnapshotCache cache(SNAPSHOT_NAME, QStringList(m_Source), 1);
+    QVERIFY(cache.load());
+    QStringList records;
+    cache.stream() >> records;
+    QCOMPARE(cache.stream().status(), QDataStream::Ok);
+    QCOMPARE(records, RECORDS);
+
+    // Parsed once, then read back from the snapshot
+    int parsed = 0;
+    auto parse = [&]()
+    {
+        parsed++;
+        return RECORDS;
+    };
+    QFile::remove(cache.filename());
+    QCOMPARE(SnapshotCache(SNAPSHOT_NAME, QStringList(m_Source), 1).loadOrParse<QStringList>(parse), RECORDS);
+    QCOMPARE(SnapshotCache(SNAPSHOT_NAME, QStringList(m_Source), 1).loadOrParse<QStringList>(parse), RECORDS);
+    QCOMPARE(parsed, 1);
+}
+
+void TestSnapshotCache::testVersionMismatch()
+{
+    QVERIFY(saveRecords(RECORDS, 1));
+    QVERIFY(SnapshotCache(SNAPSHOT_NAME, QStringList(m_Source), 2).load() == false);
+    QVERIFY(SnapshotCache(SNAPSHOT_NAME, QStringList(m_Source), 1).load());
+}
+
+void TestSnapshotCache::testSourceChange()
+{
+    QVERIFY(saveRecords(RECORDS, 1));
+    QVERIFY(SnapshotCache(SNAPSHOT_NAME, QStringList(m_Source), 1).load());
+
+    // Touched, the content being the same
+    const QDateTime modified = QFileInfo(m_Source).lastModified().addSecs(-3600);
+    struct utimbuf times;
+    times.actime  = modified.toMSecsSinceEpoch() / 1000;
+    times.modtime = modified.toMSecsSinceEpoch() / 1000;
+    QCOMPARE(utime(QFile::encodeName(m_Source).constData(), &times), 0);
+    QVERIFY(SnapshotCache(SNAPSHOT_NAME, QStringList(m_Source), 1).load() == false);
+
+    // Modified
+    QVERIFY(saveRecords(RECORDS, 1));
+    QVERIFY(SnapshotCache(SNAPSHOT_NAME, QStringList(m_Source), 1).load());
+    writeSource("M 31\nNGC 7000\nIC 435\n");
+    QVERIFY(SnapshotCache(SNAPSHOT_NAME, QStringList(m_Source), 1).load() == false);
+
+    // Removed
+    QVERIFY(saveRecords(RECORDS, 1));
+    QVERIFY(QFile::remove(m_Source));
+    QVERIFY(SnapshotCache(SNAPSHOT_NAME, QStringList(m_Source), 1).load() == false);
+}
+
+void TestSnapshotCache::testTruncated()
+{
+    QVERIFY(saveRecords(RECORDS, 1));
+    const QString filename = SnapshotCache(SNAPSHOT_NAME, QStringList(m_Source), 1).filename();
+    QVERIFY(QFile::resize(filename, QFileInfo(filename).size() - 4));
+
+    // The header is intact, reading the body fails
+    {
+        SnapshotCache cache(SNAPSHOT_NAME, QStringList(m_Source), 1);
+        QVERIFY(cache.load());
+        QStringList records;
+        cache.stream() >> records;
+        QVERIFY(cache.stream().status() != QDataStream::Ok);
+    }
+
+    // The truncated snapshot is ignored and written again
+    int parsed = 0;
+    auto parse = [&]()
+    {
+        parsed++;
+        return RECORDS;
+    };
+    QCOMPARE(SnapshotCache(SNAPSHOT_NAME, QStringList(m_Source), 1).loadOrParse<QStringList>(parse), RECORDS);
+    QCOMPARE(parsed, 1);
+    QCOMPARE(SnapshotCache(SNAPSHOT_NAME, QStringList(m_Source), 1).loadOrParse<QStringList>(parse), RECORDS);
+    QCOMPARE(parsed, 1);
+}
+
+QTEST_GUILESS_MAIN(TestSnapshotCache)
@@ -0,0 +1,39 @@
+/*  KStars tests
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#ifndef TESTSNAPSHOTCACHE_H
+#define TESTSNAPSHOTCACHE_H
+
+#include <QtTest>
+#include <QObject>
+#include <QTemporaryDir>
+
+class TestSnapshotCache : public QObject
+{
+    Q_OBJECT
+public:
+    explicit TestSnapshotCache(QObject *parent = nullptr);
+
+private slots:
+    void initTestCase();
+    void init();
+
+    void testRoundTrip();
+    void testVersionMismatch();
+    void testSourceChange();
+    void testTruncated();
+
+private:
+    void writeSource(const QByteArray &content);
+    bool saveRecords(const QStringList &records, quint32 version);
+
+    QTemporaryDir m_Dir;
+    QString m_Source;
+};
+
+#endif // TESTSNAPSHOTCACHE_H
@@ -0,0 +1,112 @@
+/*  KStars tests
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "teststartuploader.h"
+
+#include "auxiliary/startuploader.h"
+
+#include <QAtomicInt>
+
+TestStartupLoader::TestStartupLoader(QObject *parent) : QObject(parent)
+{
+}
+
+void TestStartupLoader::testDependencies()
+{
+    StartupLoader loader("Test");
+    QAtomicInt a, b, c;
+    QThread *mainThread = QThread::currentThread();
+    bool mainInMainThread = false;
+
+    loader.addTask("a", [&]()
+    {
+        QThread::msleep(50);
+        a.storeRelease(1);
+        return true;
+    });
+    loader.addTask("b", [&]()
+    {
+        b.storeRelease(1);
+        return true;
+    });
+    loader.addTask("c", [&]()
+    {
+        // Runs once both dependencies are completed
+        c.storeRelease(a.loadAcquire() + b.loadAcquire());
+        return true;
+    }, QStringList() << "a" << "b");
+    loader.addTask("main", [&]()
+    {
+        mainInMainThread = QThread::currentThread() == mainThread;
+        return true;
+    }, QStringList() << "c", StartupLoader::MAIN_THREAD);
+
+    QSignalSpy finished(&loader, SIGNAL(taskFinished(QString, bool)));
+    QVERIFY(loader.run());
+    QCOMPARE(c.loadAcquire(), 2);
+    QVERIFY(mainInMainThread);
+    QVERIFY(loader.isReady("main"));
+    QCOMPARE(finished.count(), 4);
+    QCOMPARE(finished.last().at(0).toString(), QString("main"));
+}
+
+void TestStartupLoader::testFailure()
+{
+    StartupLoader loader("Test");
+    bool dependentRan = false;
+
+    loader.addTask("failing", []()
+    {
+        return false;
+    });
+    loader.addTask("dependent", [&]()
+    {
+        dependentRan = true;
+        return true;
+    }, QStringList() << "failing", StartupLoader::MAIN_THREAD);
+    loader.addTask("independent", []()
+    {
+        return true;
+    }, QStringList(), StartupLoader::MAIN_THREAD);
+
+    QVERIFY(loader.run() == false);
+    QCOMPARE(loader.failedTask(), QString("failing"));
+    QVERIFY(dependentRan == false);
+    QVERIFY(loader.isReady("dependent") == false);
+    QVERIFY(loader.isReady("independent"));
+    QVERIFY(loader.report().contains("skipped"));
+}
+
+void TestStartupLoader::testBackground()
+{
+    StartupLoader loader("Test");
+    QAtomicInt background;
+
+    loader.addTask("essential", []()
+    {
+        return true;
+    }, QStringList(), StartupLoader::MAIN_THREAD);
+    loader.addTask("background", [&]()
+    {
+        QThread::msleep(50);
+        background.storeRelease(1);
+        return true;
+    }, QStringList() << "essential", StartupLoader::WORKER_THREAD, false);
+
+    QSignalSpy done(&loader, SIGNAL(finished()));
+    QVERIFY(loader.run());
+    QVERIFY(loader.isReady("essential"));
+    QVERIFY(loader.isReady("background") == false);
+
+    // Completed from the event loop
+    QVERIFY(done.wait(5000));
+    QCOMPARE(background.loadAcquire(), 1);
+    QVERIFY(loader.isReady("background"));
+}
+
+QTEST_GUILESS_MAIN(TestStartupLoader)
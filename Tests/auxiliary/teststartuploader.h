@@ -0,0 +1,27 @@
+/*  KStars tests
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#ifndef TESTSTARTUPLOADER_H
+#define TESTSTARTUPLOADER_H
+
+#include <QtTest>
+#include <QObject>
+
+class TestStartupLoader : public QObject
+{
+    Q_OBJECT
+public:
+    explicit TestStartupLoader(QObject *parent = nullptr);
+
+private slots:
+    void testDependencies();
+    void testFailure();
+    void testBackground();
+};
+
+#endif // TESTSTARTUPLOADER_H
@@ -0,0 +1,105 @@
+/*  KStars tests
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "testtracer.h"
+
+#include "auxiliary/tracer.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QtConcurrent>
+
+TestTracer::TestTracer(QObject *parent) : QObject(parent)
+{
+}
+
+void TestTracer::init()
+{
+    Tracer::Instance()->setEnabled(false);
+    Tracer::Instance()->clear();
+}
+
+QJsonArray TestTracer::saveEvents(const QString &name)
+{
+    const QString filename = m_Dir.filePath(name);
+    if (Tracer::Instance()->save(filename) == false)
+        return QJsonArray();
+
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly))
+        return QJsonArray();
+
+    // Metadata events are left out
+    QJsonArray events;
+    for (const QJsonValue &event : QJsonDocument::fromJson(file.readAll()).object()["traceEvents"].toArray())
+    {
+        if (event.toObject()["ph"].toString() != "M")
+            events.append(event);
+    }
+    return events;
+}
+
+void TestTracer::testDisabled()
+{
+    {
+        TraceZone zone("disabled", "test");
+    }
+    Tracer::Instance()->instant("disabled", "test");
+
+    QVERIFY(saveEvents("disabled.json").isEmpty());
+}
+
+void TestTracer::testZones()
+{
+    Tracer::Instance()->setEnabled(true);
+
+    {
+        TraceZone outer("outer", "test");
+        TraceZone inner(QString("inner %1").arg(1), "test");
+        QThread::msleep(2);
+    }
+    QtConcurrent::run([]()
+    {
+        TraceZone zone("worker", "test");
+    }).waitForFinished();
+    Tracer::Instance()->instant("state", "test");
+
+    const QJsonArray events = saveEvents("zones.json");
+    QCOMPARE(events.size(), 4);
+
+    QMap<QString, QJsonObject> byName;
+    for (const QJsonValue &event : events)
+        byName[event.toObject()["name"].toString()] = event.toObject();
+
+    QCOMPARE(byName["outer"]["ph"].toString(), QString("X"));
+    QCOMPARE(byName["outer"]["cat"].toString(), QString("test"));
+    QVERIFY(byName["outer"]["dur"].toDouble() >= 2000);
+    // The inner zone is nested in the outer one
+    QVERIFY(byName["inner 1"]["ts"].toDouble() >= byName["outer"]["ts"].toDouble());
+    QVERIFY(byName["inner 1"]["dur"].toDouble() <= byName["outer"]["dur"].toDouble());
+    QCOMPARE(byName["outer"]["tid"].toInt(), byName["inner 1"]["tid"].toInt());
+    QVERIFY(byName["worker"]["tid"].toInt() != byName["outer"]["tid"].toInt());
+    QCOMPARE(byName["state"]["ph"].toString(), QString("i"));
+}
+
+void TestTracer::testRing()
+{
+    Tracer::Instance()->setEnabled(true);
+
+    const int extra = 10;
+    for (int i = 0; i < Tracer::capacity() + extra; i++)
+        Tracer::Instance()->complete(QString::number(i), "test", Tracer::Instance()->now());
+
+    // Only the most recent events are kept, oldest first
+    const QJsonArray events = saveEvents("ring.json");
+    QCOMPARE(events.size(), Tracer::capacity());
+    QCOMPARE(events.first().toObject()["name"].toString(), QString::number(extra));
+    QCOMPARE(events.last().toObject()["name"].toString(), QString::number(Tracer::capacity() + extra - 1));
+}
+
+QTEST_GUILESS_MAIN(TestTracer)
@@ -0,0 +1,35 @@
+/*  KStars tests
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#ifndef TESTTRACER_H
+#define TESTTRACER_H
+
+#include <QtTest>
+#include <QJsonArray>
+#include <QObject>
+#include <QTemporaryDir>
+
+class TestTracer : public QObject
+{
+    Q_OBJECT
+public:
+    explicit TestTracer(QObject *parent = nullptr);
+
+private slots:
+    void init();
+    void testDisabled();
+    void testZones();
+    void testRing();
+
+private:
+    QJsonArray saveEvents(const QString &name);
+
+    QTemporaryDir m_Dir;
+};
+
+#endif // TESTTRACER_H
@@ -0,0 +1,287 @@
+/*  Ekos Live telemetry tests
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "test_telemetry.h"
+
+#include "telemetry.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+
+using EkosLive::Telemetry;
+
+TestTelemetry::TestTelemetry() : QObject(), m_Server("test", QWebSocketServer::NonSecureMode)
+{
+}
+
+void TestTelemetry::init()
+{
+    QVERIFY(m_Server.listen(QHostAddress::LocalHost));
+
+    m_TextMessages.clear();
+    m_BinaryMessages.clear();
+
+    m_Client = new QWebSocket();
+    m_Client->open(m_Server.serverUrl());
+    QTRY_VERIFY(m_Server.hasPendingConnections());
+
+    m_Peer = m_Server.nextPendingConnection();
+    connect(m_Peer, &QWebSocket::textMessageReceived, [this](const QString & message)
+    {
+        m_TextMessages.append(message);
+    });
+    connect(m_Peer, &QWebSocket::binaryMessageReceived, [this](const QByteArray & message)
+    {
+        m_BinaryMessages.append(message);
+    });
+    QTRY_COMPARE(m_Client->state(), QAbstractSocket::ConnectedState);
+}
+
+void TestTelemetry::cleanup()
+{
+    delete m_Client;
+    delete m_Peer;
+    m_Client = nullptr;
+    m_Peer = nullptr;
+    m_Server.close();
+}
+
+void TestTelemetry::testMergeWithinTick()
+{
+    Telemetry telemetry(m_Client);
+
+    telemetry.update("new_mount_state", QJsonObject({{"ra", 1.5}}));
+    telemetry.update("new_mount_state", QJsonObject({{"de", 20.0}}));
+    telemetry.update("new_mount_state", QJsonObject({{"ra", 2.5}}));
+    telemetry.update("new_focus_state", QJsonObject({{"hfr", 1.2}}));
+    QCOMPARE(telemetry.queuedCount(), 2);
+
+    telemetry.flush();
+    QCOMPARE(telemetry.queuedCount(), 0);
+    QTRY_COMPARE(m_TextMessages.size(), 2);
+
+    QJsonObject mount = QJsonDocument::fromJson(m_TextMessages[0].toUtf8()).object();
+    QCOMPARE(mount["type"].toString(), QString("new_mount_state"));
+    QCOMPARE(mount["payload"].toObject(), QJsonObject({{"ra", 2.5}, {"de", 20.0}}));
+}
+
+void TestTelemetry::testUnchangedNotResent()
+{
+    Telemetry telemetry(m_Client);
+    telemetry.setDeltaEnabled(true);
+
+    telemetry.update("new_guide_state", QJsonObject({{"status", "Guiding"}, {"rms", 0.5}}));
+    telemetry.flush();
+    QTRY_COMPARE(m_TextMessages.size(), 1);
+
+    // Only the changed field is sent, and the status which is always sent
+    telemetry.update("new_guide_state", QJsonObject({{"status", "Guiding"}, {"rms", 0.7}}));
+    telemetry.flush();
+    QTRY_COMPARE(m_TextMessages.size(), 2);
+    QJsonObject guide = QJsonDocument::fromJson(m_TextMessages[1].toUtf8()).object();
+    QCOMPARE(guide["payload"].toObject(), QJsonObject({{"status", "Guiding"}, {"rms", 0.7}}));
+
+    // Nothing changed, nothing sent
+    telemetry.update("new_guide_state", QJsonObject({{"rms", 0.7}}));
+    telemetry.flush();
+    QTest::qWait(100);
+    QCOMPARE(m_TextMessages.size(), 2);
+
+    // Everything is sent again after a reset
+    telemetry.reset();
+    telemetry.update("new_guide_state", QJsonObject({{"rms", 0.7}}));
+    telemetry.flush();
+    QTRY_COMPARE(m_TextMessages.size(), 3);
+}
+
+void TestTelemetry::testFieldGroups()
+{
+    Telemetry telemetry(m_Client);
+    telemetry.setDeltaEnabled(true);
+    telemetry.addFieldGroup("new_focus_state", QStringList() << "hfr" << "pos");
+
+    telemetry.update("new_focus_state", QJsonObject({{"hfr", 2.5}, {"pos", 1000}}));
+    telemetry.flush();
+    QTRY_COMPARE(m_TextMessages.size(), 1);
+
+    // The position did not change, but is sent with the HFR it belongs to
+    telemetry.update("new_focus_state", QJsonObject({{"hfr", 2.1}, {"pos", 1000}}));
+    telemetry.flush();
+    QTRY_COMPARE(m_TextMessages.size(), 2);
+    QJsonObject focus = QJsonDocument::fromJson(m_TextMessages[1].toUtf8()).object();
+    QCOMPARE(focus["payload"].toObject(), QJsonObject({{"hfr", 2.1}, {"pos", 1000}}));
+
+    // A group is also completed from the last sent values
+    telemetry.update("new_focus_state", QJsonObject({{"pos", 1100}}));
+    telemetry.flush();
+    QTRY_COMPARE(m_TextMessages.size(), 3);
+    focus = QJsonDocument::fromJson(m_TextMessages[2].toUtf8()).object();
+    QCOMPARE(focus["payload"].toObject(), QJsonObject({{"hfr", 2.1}, {"pos", 1100}}));
+}
+
+void TestTelemetry::testStatusTransitions()
+{
+    Telemetry telemetry(m_Client);
+
+    // Every transition within a tick is sent, in order
+    telemetry.update("new_focus_state", QJsonObject({{"status", "Complete"}}));
+    telemetry.update("new_focus_state", QJsonObject({{"status", "Framing"}}));
+    telemetry.update("new_focus_state", QJsonObject({{"status", "Complete"}}));
+    QCOMPARE(telemetry.queuedCount(), 1);
+    telemetry.flush();
+    QTRY_COMPARE(m_TextMessages.size(), 3);
+    QCOMPARE(QJsonDocument::fromJson(m_TextMessages[1].toUtf8()).object()["payload"].toObject(),
+             QJsonObject({{"status", "Framing"}}));
+
+    // A repeated status is sent again
+    telemetry.update("new_focus_state", QJsonObject({{"status", "Complete"}}));
+    telemetry.flush();
+    QTRY_COMPARE(m_TextMessages.size(), 4);
+    QCOMPARE(QJsonDocument::fromJson(m_TextMessages[3].toUtf8()).object()["payload"].toObject(),
+             QJsonObject({{"status", "Complete"}}));
+}
+
+void TestTelemetry::testDeltaNegotiation()
+{
+    Telemetry telemetry(m_Client);
+    QVERIFY(!telemetry.deltaEnabled());
+
+    // By default each update is sent as queued, without a delta marker
+    telemetry.update("new_mount_state", QJsonObject({{"ra", 1.5}, {"de", 20.0}}));
+    telemetry.flush();
+    telemetry.update("new_mount_state", QJsonObject({{"ra", 1.5}, {"de", 21.0}}));
+    telemetry.flush();
+    QTRY_COMPARE(m_TextMessages.size(), 2);
+    QJsonObject mount = QJsonDocument::fromJson(m_TextMessages[1].toUtf8()).object();
+    QCOMPARE(mount["payload"].toObject(), QJsonObject({{"ra", 1.5}, {"de", 21.0}}));
+    QVERIFY(!mount.contains("delta"));
+
+    // Once enabled, the first update is complete and the next ones are marked deltas
+    telemetry.setDeltaEnabled(true);
+    telemetry.update("new_mount_state", QJsonObject({{"ra", 1.5}, {"de", 21.0}}));
+    telemetry.flush();
+    QTRY_COMPARE(m_TextMessages.size(), 3);
+    mount = QJsonDocument::fromJson(m_TextMessages[2].toUtf8()).object();
+    QCOMPARE(mount["payload"].toObject(), QJsonObject({{"ra", 1.5}, {"de", 21.0}}));
+
+    telemetry.update("new_mount_state", QJsonObject({{"ra", 1.5}, {"de", 22.0}}));
+    telemetry.flush();
+    QTRY_COMPARE(m_TextMessages.size(), 4);
+    mount = QJsonDocument::fromJson(m_TextMessages[3].toUtf8()).object();
+    QCOMPARE(mount["payload"].toObject(), QJsonObject({{"de", 22.0}}));
+    QCOMPARE(mount["delta"].toBool(), true);
+
+    // Enabling it again requests a full snapshot
+    telemetry.setDeltaEnabled(true);
+    telemetry.update("new_mount_state", QJsonObject({{"ra", 1.5}, {"de", 22.0}}));
+    telemetry.flush();
+    QTRY_COMPARE(m_TextMessages.size(), 5);
+    mount = QJsonDocument::fromJson(m_TextMessages[4].toUtf8()).object();
+    QCOMPARE(mount["payload"].toObject(), QJsonObject({{"ra", 1.5}, {"de", 22.0}}));
+}
+
+void TestTelemetry::testFullStates()
+{
+    Telemetry telemetry(m_Client);
+
+    QJsonObject ccd1({{"name", "CCD 1"}, {"temperature", -10.0}});
+    QJsonObject ccd2({{"name", "CCD 2"}, {"temperature", -10.0}});
+    telemetry.update("new_camera_state", ccd1, "CCD 1", false);
+    telemetry.update("new_camera_state", ccd2, "CCD 2", false);
+    telemetry.flush();
+    QTRY_COMPARE(m_TextMessages.size(), 2);
+
+    // Full states are sent complete when any field changed
+    ccd1["temperature"] = -15.0;
+    telemetry.update("new_camera_state", ccd1, "CCD 1", false);
+    telemetry.update("new_camera_state", ccd2, "CCD 2", false);
+    telemetry.flush();
+    QTRY_COMPARE(m_TextMessages.size(), 3);
+    QJsonObject camera = QJsonDocument::fromJson(m_TextMessages[2].toUtf8()).object();
+    QCOMPARE(camera["payload"].toObject(), ccd1);
+}
+
+void TestTelemetry::testBackpressure()
+{
+    Telemetry telemetry(m_Client);
+    telemetry.setInterval(10);
+    telemetry.setMaxPendingBytes(-1);
+
+    // Congested: sending is deferred while updates keep merging
+    telemetry.update("new_capture_state", QJsonObject({{"progress", 1}}));
+    telemetry.flush();
+    telemetry.update("new_capture_state", QJsonObject({{"progress", 2}}));
+    QCOMPARE(telemetry.queuedCount(), 1);
+    QTest::qWait(100);
+    QCOMPARE(m_TextMessages.size(), 0);
+
+    telemetry.setMaxPendingBytes(1024);
+    QTRY_COMPARE(m_TextMessages.size(), 1);
+    QJsonObject capture = QJsonDocument::fromJson(m_TextMessages[0].toUtf8()).object();
+    QCOMPARE(capture["payload"].toObject(), QJsonObject({{"progress", 2}}));
+    QTRY_COMPARE(telemetry.pendingBytes(), 0);
+
+    // Other messages on the socket are accounted for, so the count does not drift below their size
+    const qint64 bytes = m_Client->sendTextMessage(QString(512, 'x'));
+    telemetry.trackMessage(bytes);
+    QVERIFY(telemetry.pendingBytes() >= bytes);
+    QTRY_COMPARE(telemetry.pendingBytes(), 0);
+}
+
+void TestTelemetry::testBinaryRoundTrip()
+{
+    Telemetry::Change mount;
+    mount.type = "new_mount_state";
+    mount.payload = QJsonObject(
+    {
+        {"ra", 12.25}, {"pierSide", 1}, {"slewing", true}, {"parked", false},
+        {"status", QString::fromUtf8("Suivi é")}, {"target", QJsonValue()},
+        {"axes", QJsonArray({1, 2.5})}, {"limits", QJsonObject({{"min", -5}})}
+    });
+
+    Telemetry::Change camera;
+    camera.type = "new_camera_state";
+    camera.payload = QJsonObject({{"temperature", -10.5}});
+    camera.delta = false;
+
+    const QList<Telemetry::Change> changes = Telemetry::decode(Telemetry::encode({mount, camera}));
+    QCOMPARE(changes.size(), 2);
+    QCOMPARE(changes[0].type, mount.type);
+    QCOMPARE(changes[0].payload, mount.payload);
+    QVERIFY(changes[0].delta);
+    QCOMPARE(changes[1].payload, camera.payload);
+    QVERIFY(!changes[1].delta);
+
+    // The binary encoding sends one message per tick
+    Telemetry telemetry(m_Client);
+    telemetry.setEncoding(Telemetry::ENCODING_BINARY);
+    telemetry.setDeltaEnabled(true);
+    telemetry.update(mount.type, mount.payload);
+    telemetry.update(camera.type, camera.payload, "CCD", false);
+    telemetry.flush();
+    QTRY_COMPARE(m_BinaryMessages.size(), 1);
+    QCOMPARE(Telemetry::decode(m_BinaryMessages[0]).size(), 2);
+    QCOMPARE(m_TextMessages.size(), 0);
+}
+
+void TestTelemetry::testBinaryInvalid()
+{
+    Telemetry::Change change;
+    change.type = "new_focus_state";
+    change.payload = QJsonObject({{"status", "Complete"}});
+    const QByteArray frame = Telemetry::encode({change});
+
+    QVERIFY(Telemetry::decode(QByteArray()).isEmpty());
+    QVERIFY(Telemetry::decode(frame.left(frame.size() - 1)).isEmpty());
+
+    QByteArray version = frame;
+    version[0] = 2;
+    QVERIFY(Telemetry::decode(version).isEmpty());
+}
+
+QTEST_GUILESS_MAIN(TestTelemetry)
@@ -0,0 +1,46 @@
+/*  Ekos Live telemetry tests
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include <QtTest/QtTest>
+#include <QtWebSockets/QWebSocket>
+#include <QtWebSockets/QWebSocketServer>
+
+/**
+ * @class TestTelemetry
+ * @short Tests of the Ekos Live telemetry batching, against a local websocket server
+ */
+class TestTelemetry : public QObject
+{
+        Q_OBJECT
+
+    public:
+        TestTelemetry();
+
+    private slots:
+        void init();
+        void cleanup();
+
+        void testMergeWithinTick();
+        void testUnchangedNotResent();
+        void testFieldGroups();
+        void testStatusTransitions();
+        void testDeltaNegotiation();
+        void testFullStates();
+        void testBackpressure();
+        void testBinaryRoundTrip();
+        void testBinaryInvalid();
+
+    private:
+        QWebSocketServer m_Server;
+        QWebSocket *m_Client { nullptr };
+        QWebSocket *m_Peer { nullptr };
+        QStringList m_TextMessages;
+        QList<QByteArray> m_BinaryMessages;
+};
@@ -0,0 +1,84 @@
+/*  KStars tests
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include <QtTest>
+
+#include "testfitscompressor.h"
+
+#include "fitsviewer/fitscompressor.h"
+
+TestFitsCompressor::TestFitsCompressor(QObject *parent) : QObject(parent)
+{
+}
+
+void TestFitsCompressor::init()
+{
+    if(!QFile::exists(m_FitsFixture))
+        QSKIP("Skipping compression test because of missing fixture");
+
+    m_Dir = new QTemporaryDir();
+    QVERIFY(m_Dir->isValid());
+    m_Filename = m_Dir->filePath(m_FitsFixture);
+    QVERIFY(QFile::copy(m_FitsFixture, m_Filename));
+}
+
+void TestFitsCompressor::cleanup()
+{
+    delete m_Dir;
+    m_Dir = nullptr;
+}
+
+void TestFitsCompressor::testRoundTrip()
+{
+    QString compressed, error;
+    QVERIFY2(FITSCompressor::compress(m_Filename, FITSCompressor::COMPRESSION_RICE, false, &compressed, &error),
+             qPrintable(error));
+    QCOMPARE(compressed, m_Filename + ".fz");
+    QVERIFY(QFile::exists(compressed));
+    QVERIFY(QFileInfo(compressed).size() < QFileInfo(m_Filename).size());
+
+    // The original is kept unless requested
+    QVERIFY(QFile::exists(m_Filename));
+    QVERIFY2(FITSCompressor::verify(m_Filename, 1, compressed, 2, &error), qPrintable(error));
+}
+
+void TestFitsCompressor::testRemoveOriginal()
+{
+    QString compressed, error;
+    QVERIFY2(FITSCompressor::compress(m_Filename, FITSCompressor::COMPRESSION_HCOMPRESS, true, &compressed, &error),
+             qPrintable(error));
+    QVERIFY(QFile::exists(compressed));
+    QVERIFY(!QFile::exists(m_Filename));
+    QVERIFY2(FITSCompressor::verify(m_FitsFixture, 1, compressed, 2, &error), qPrintable(error));
+}
+
+void TestFitsCompressor::testCorruptedOutput()
+{
+    QString compressed, error;
+    QVERIFY2(FITSCompressor::compress(m_Filename, FITSCompressor::COMPRESSION_RICE, false, &compressed, &error),
+             qPrintable(error));
+
+    // Flip bytes in the compressed tiles, at the end of the file after the headers
+    QFile file(compressed);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    const qint64 offset = file.size() / 2;
+    QVERIFY(offset > 2 * 2880);
+    QVERIFY(file.seek(offset));
+    QByteArray data = file.read(64);
+    for (char &c : data)
+        c = ~c;
+    QVERIFY(file.seek(offset));
+    QCOMPARE(file.write(data), qint64(data.size()));
+    file.close();
+
+    error.clear();
+    QVERIFY(!FITSCompressor::verify(m_Filename, 1, compressed, 2, &error));
+    QVERIFY(!error.isEmpty());
+}
+
+QTEST_GUILESS_MAIN(TestFitsCompressor)
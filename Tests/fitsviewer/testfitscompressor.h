@@ -0,0 +1,37 @@
+/*  KStars tests
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#ifndef TESTFITSCOMPRESSOR_H
+#define TESTFITSCOMPRESSOR_H
+
+#include <QObject>
+#include <QTemporaryDir>
+
+class TestFitsCompressor : public QObject
+{
+    Q_OBJECT
+public:
+    explicit TestFitsCompressor(QObject *parent = nullptr);
+
+public:
+    QString const m_FitsFixture { "m47_sim_stars.fits" };
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testRoundTrip();
+    void testRemoveOriginal();
+    void testCorruptedOutput();
+
+private:
+    QTemporaryDir *m_Dir { nullptr };
+    QString m_Filename;
+};
+
+#endif // TESTFITSCOMPRESSOR_H
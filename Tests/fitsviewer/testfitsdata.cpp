@@ -12,6 +12,8 @@
 
 #include "testfitsdata.h"
 
+#include "fitsviewer/fitscompressor.h"
+
 TestFitsData::TestFitsData(QObject *parent) : QObject(parent)
 {
 }
@@ -98,7 +100,7 @@ void TestFitsData::testBahtinovFocusHFR()
     QCOMPARE(d->findStars(ALGORITHM_BAHTINOV, trackingBox), 1);
     QCOMPARE(d->getDetectedStars(), 1);
     QCOMPARE(d->getStarCenters().count(), 1);
-    QVERIFY(abs(d->getHFR() - 1.544) < 0.01);
+    QVERIFY(abs(d->getHFR() - 2.012) < 0.01);
 
     delete d;
     d = nullptr;
@@ -184,4 +186,31 @@ void TestFitsData::testSEPAlgorithmBenchmark()
     QBENCHMARK { fd->findStars(ALGORITHM_SEP); }
 }
 
+void TestFitsData::testLoadCompressedFits()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString filename = dir.filePath(m_FitsFixture);
+    QVERIFY(QFile::copy(m_FitsFixture, filename));
+
+    QString compressed, error;
+    QVERIFY2(FITSCompressor::compress(filename, FITSCompressor::COMPRESSION_RICE, false, &compressed, &error),
+             qPrintable(error));
+
+    // The fixture is loaded by init(), the compressed image is decoded in parallel bands of tiles
+    FITSData * d = new FITSData();
+    QFuture<bool> worker = d->loadFITS(compressed);
+    QTRY_VERIFY_WITH_TIMEOUT(worker.isFinished(), 5000);
+    QVERIFY(worker.result());
+    QVERIFY(d->isCompressed());
+
+    QCOMPARE(d->width(), fd->width());
+    QCOMPARE(d->height(), fd->height());
+    QCOMPARE(d->getStatistics().bytesPerPixel, fd->getStatistics().bytesPerPixel);
+    const size_t size = fd->getStatistics().samples_per_channel * fd->channels() * fd->getStatistics().bytesPerPixel;
+    QVERIFY(memcmp(d->getImageBuffer(), fd->getImageBuffer(), size) == 0);
+
+    delete d;
+}
+
 QTEST_GUILESS_MAIN(TestFitsData)
@@ -43,6 +43,7 @@ private slots:
     void testFocusHFR();
     void runFocusHFR(const QString &filename, int nstars, float hfr);
     void testBahtinovFocusHFR();
+    void testLoadCompressedFits();
 };
 
 #endif // TESTFITSDATA_H
@@ -0,0 +1,209 @@
+/*  KStars tests
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "testscanrender.h"
+
+#include "hips/scanrender.h"
+
+#include <cmath>
+#include <memory>
+#include <random>
+
+Q_DECLARE_METATYPE(ScanSpan::InstructionSet)
+
+namespace
+{
+const int TILE_SIZE = 512;
+
+// Bilinear span of the renderer before the span functions, sampling with float coordinates
+void legacyBilinear(quint32 *dst, int count, const quint32 *src, int sw, int sh, float u, float v, float du, float dv)
+{
+    int size = sw * sh;
+
+    for (int x = 0; x < count; x++)
+    {
+        float x_diff  = u - static_cast<int>(u);
+        float y_diff  = v - static_cast<int>(v);
+        float x_1diff = 1 - x_diff;
+        float y_1diff = 1 - y_diff;
+
+        int index = static_cast<int>(u) + static_cast<int>(v) * sw;
+
+        quint32 a = src[index];
+        quint32 b = src[(index + 1) % size];
+        quint32 c = src[(index + sw) % size];
+        quint32 d = src[(index + sw + 1) % size];
+
+        int qxy1 = (x_1diff * y_1diff) * 65536;
+        int qxy2 = (x_diff * y_1diff) * 65536;
+        int qxy  = (x_diff * y_diff) * 65536;
+        int qyx1 = (y_diff * x_1diff) * 65536;
+
+        int blue  = ((a & 0xff) * qxy1 + (b & 0xff) * qxy2 + (c & 0xff) * qyx1 + (d & 0xff) * qxy) >> 16;
+        int green = (((a >> 8) & 0xff) * qxy1 + ((b >> 8) & 0xff) * qxy2 + ((c >> 8) & 0xff) * qyx1 + ((d >> 8) & 0xff) * qxy) >> 16;
+        int red   = (((a >> 16) & 0xff) * qxy1 + ((b >> 16) & 0xff) * qxy2 + ((c >> 16) & 0xff) * qyx1 + ((d >> 16) & 0xff) * qxy) >> 16;
+
+        dst[x] = 0xff000000 | ((red << 16) & 0xff0000) | ((green << 8) & 0xff00) | blue;
+
+        u += du;
+        v += dv;
+    }
+}
+
+// Nearest neighbour span of the renderer before the span functions
+void legacyNearest(quint32 *dst, int count, const quint32 *src, int sw, int u, int v, int du, int dv)
+{
+    for (int x = 0; x < count; x++)
+    {
+        dst[x] = src[(u >> 16) + (v >> 16) * sw] | 0xff000000;
+        u += du;
+        v += dv;
+    }
+}
+
+int maxChannelDifference(quint32 a, quint32 b)
+{
+    return qMax(qMax(qAbs(qRed(a) - qRed(b)), qAbs(qGreen(a) - qGreen(b))), qAbs(qBlue(a) - qBlue(b)));
+}
+}
+
+TestScanRender::TestScanRender(QObject *parent) : QObject(parent)
+{
+}
+
+void TestScanRender::initTestCase()
+{
+    // Smooth gradients with some detail, like a survey tile
+    m_Tile = QImage(TILE_SIZE, TILE_SIZE, QImage::Format_ARGB32_Premultiplied);
+    for (int y = 0; y < TILE_SIZE; y++)
+    {
+        quint32 *line = reinterpret_cast<quint32 *>(m_Tile.scanLine(y));
+        for (int x = 0; x < TILE_SIZE; x++)
+            line[x] = qRgb(x / 2, y / 2, static_cast<int>(127.5 + 127.5 * std::sin(x * 0.05) * std::cos(y * 0.07)));
+    }
+}
+
+void TestScanRender::addInstructionSetRows()
+{
+    QTest::addColumn<ScanSpan::InstructionSet>("set");
+
+    const ScanSpan::InstructionSet sets[] = { ScanSpan::GENERIC, ScanSpan::SSE2, ScanSpan::AVX2, ScanSpan::NEON };
+    for (ScanSpan::InstructionSet set : sets)
+    {
+        // Only the instruction sets of this build and CPU can be tested
+        const ScanSpan::Functions *functions = ScanSpan::functions(set);
+        if (functions)
+            QTest::newRow(functions->name) << set;
+    }
+}
+
+void TestScanRender::testSpansMatchLegacy_data()
+{
+    addInstructionSetRows();
+}
+
+void TestScanRender::testSpansMatchLegacy()
+{
+    QFETCH(ScanSpan::InstructionSet, set);
+    const ScanSpan::Functions *functions = ScanSpan::functions(set);
+    QVERIFY(functions);
+
+    const quint32 *src = reinterpret_cast<const quint32 *>(m_Tile.constBits());
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> counts(1, 1000);
+    std::uniform_real_distribution<float> positions(0, TILE_SIZE - 1);
+    QVector<quint32> expected(1024), actual(1024);
+
+    for (int i = 0; i < 2000; i++)
+    {
+        // Spans between two random points inside the tile, as the scanlines of a tile polygon
+        int count = counts(random);
+        float u1 = positions(random), v1 = positions(random);
+        float u2 = positions(random), v2 = positions(random);
+        float du = (u2 - u1) / count, dv = (v2 - v1) / count;
+
+        int fu = u1 * 65536, fv = v1 * 65536, fdu = du * 65536, fdv = dv * 65536;
+
+        legacyNearest(expected.data(), count, src, TILE_SIZE, fu, fv, fdu, fdv);
+        functions->nearest(actual.data(), count, src, TILE_SIZE, TILE_SIZE, fu, fv, fdu, fdv);
+        for (int x = 0; x < count; x++)
+            QCOMPARE(actual[x], expected[x]);
+
+        // Fixed point weights differ from the float ones by a few levels at most
+        legacyBilinear(expected.data(), count, src, TILE_SIZE, TILE_SIZE, u1, v1, du, dv);
+        functions->bilinear(actual.data(), count, src, TILE_SIZE, TILE_SIZE, fu, fv, fdu, fdv);
+        for (int x = 0; x < count; x++)
+        {
+            QCOMPARE(qAlpha(actual[x]), 255);
+            QVERIFY2(maxChannelDifference(actual[x], expected[x]) <= 3,
+                     qPrintable(QString("Span %1 pixel %2: %3 instead of %4").arg(i).arg(x)
+                                .arg(actual[x], 8, 16).arg(expected[x], 8, 16)));
+        }
+    }
+}
+
+QImage TestScanRender::renderTile(int set, bool bilinear)
+{
+    // The scanline buffer is too large for the stack
+    std::unique_ptr<ScanRender> render(new ScanRender());
+    render->setInstructionSet(static_cast<ScanSpan::InstructionSet>(set));
+    render->setBilinearInterpolationEnabled(bilinear);
+
+    QImage image(1280, 960, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::black);
+
+    // The 4x4 grandchildren of a tile, warped as by a projection and partly off screen
+    auto project = [](double x, double y)
+    {
+        return QPointF(-100 + 1400 * x + 150 * y * y, -50 + 1000 * y + 120 * std::sin(x * 3));
+    };
+
+    for (int gy = 0; gy < 4; gy++)
+    {
+        for (int gx = 0; gx < 4; gx++)
+        {
+            double x0 = gx / 4.0, x1 = (gx + 1) / 4.0, y0 = gy / 4.0, y1 = (gy + 1) / 4.0;
+            QPointF points[4] = { project(x1, y1), project(x0, y1), project(x0, y0), project(x1, y0) };
+            QPointF uv[4] = { QPointF(x1, y1), QPointF(x0, y1), QPointF(x0, y0), QPointF(x1, y0) };
+            render->renderPolygon(3, points, &image, &m_Tile, uv);
+        }
+    }
+
+    return image;
+}
+
+void TestScanRender::testPolygonsMatchGeneric_data()
+{
+    addInstructionSetRows();
+}
+
+void TestScanRender::testPolygonsMatchGeneric()
+{
+    QFETCH(ScanSpan::InstructionSet, set);
+
+    // All the instruction sets draw the same pixels
+    QVERIFY(renderTile(set, false) == renderTile(ScanSpan::GENERIC, false));
+    QVERIFY(renderTile(set, true) == renderTile(ScanSpan::GENERIC, true));
+}
+
+void TestScanRender::benchmarkTile_data()
+{
+    addInstructionSetRows();
+}
+
+void TestScanRender::benchmarkTile()
+{
+    QFETCH(ScanSpan::InstructionSet, set);
+
+    QBENCHMARK
+    {
+        renderTile(set, true);
+    }
+}
+
+QTEST_GUILESS_MAIN(TestScanRender)
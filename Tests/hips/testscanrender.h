@@ -0,0 +1,40 @@
+/*  KStars tests
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#ifndef TESTSCANRENDER_H
+#define TESTSCANRENDER_H
+
+#include <QtTest>
+#include <QImage>
+#include <QObject>
+
+class TestScanRender : public QObject
+{
+    Q_OBJECT
+public:
+    explicit TestScanRender(QObject *parent = nullptr);
+
+private slots:
+    void initTestCase();
+
+    void testSpansMatchLegacy_data();
+    void testSpansMatchLegacy();
+    void testPolygonsMatchGeneric_data();
+    void testPolygonsMatchGeneric();
+
+    void benchmarkTile_data();
+    void benchmarkTile();
+
+private:
+    void addInstructionSetRows();
+    QImage renderTile(int set, bool bilinear);
+
+    QImage m_Tile;
+};
+
+#endif // TESTSCANRENDER_H
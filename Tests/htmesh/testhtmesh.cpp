@@ -0,0 +1,176 @@
+/*  HTMesh tests and aperture benchmarks
+
+    This application is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+*/
+
+#include "testhtmesh.h"
+
+#include "HTMesh.h"
+#include "HtmRange.h"
+#include "MeshIterator.h"
+
+#include <QSet>
+#include <QtTest>
+
+#include <cstdlib>
+
+namespace
+{
+QSet<Trixel> results(HTMesh &mesh)
+{
+    QSet<Trixel> trixels;
+    MeshIterator iterator(&mesh);
+    while (iterator.hasNext())
+        trixels.insert(iterator.next());
+    return trixels;
+}
+
+void addBenchmarkRows()
+{
+    QTest::addColumn<int>("level");
+    QTest::addColumn<double>("radius");
+
+    // From a telescopic field of view to a naked eye one
+    const double radii[] = { 0.5, 5.0, 30.0, 90.0 };
+    for (int level = 3; level <= 7; level++)
+    {
+        for (double radius : radii)
+            QTest::newRow(QString("level %1, %2 deg").arg(level).arg(radius).toLatin1()) << level << radius;
+    }
+}
+}
+
+TestHTMesh::TestHTMesh() : QObject()
+{
+}
+
+void TestHTMesh::testRangeMerge()
+{
+    std::srand(42);
+
+    for (int pass = 0; pass < 20; pass++)
+    {
+        HtmRange range;
+        QSet<Key> expected;
+
+        for (int i = 0; i < 200; i++)
+        {
+            // Mostly increasing, as produced by the intersections, with some out of order ranges
+            Key lo = (i % 5 == 0) ? 1 + std::rand() % 4000 : 1 + i * 20 + std::rand() % 20;
+            Key hi = lo + std::rand() % 30;
+            range.mergeRange(lo, hi);
+            for (Key key = lo; key <= hi; key++)
+                expected.insert(key);
+        }
+
+        QSet<Key> keys;
+        Key previous = 0;
+        for (const HtmRange::Interval &interval : range.intervals())
+        {
+            QVERIFY(interval.lo <= interval.hi);
+            // Sorted, disjoint and not adjacent
+            QVERIFY(interval.lo > previous + 1);
+            previous = interval.hi;
+            for (Key key = interval.lo; key <= interval.hi; key++)
+                keys.insert(key);
+        }
+        QCOMPARE(keys, expected);
+    }
+}
+
+void TestHTMesh::testCachedCoversCircle_data()
+{
+    QTest::addColumn<int>("level");
+    for (int level = 3; level <= 7; level++)
+        QTest::newRow(QString("level %1").arg(level).toLatin1()) << level;
+}
+
+void TestHTMesh::testCachedCoversCircle()
+{
+    QFETCH(int, level);
+    HTMesh mesh(level, level);
+
+    std::srand(level);
+    for (int i = 0; i < 50; i++)
+    {
+        double ra     = std::rand() % 36000 / 100.0;
+        double dec    = std::rand() % 18000 / 100.0 - 90;
+        double radius = 0.1 + std::rand() % 3000 / 100.0;
+
+        mesh.intersect(ra, dec, radius);
+        const QSet<Trixel> exact = results(mesh);
+
+        mesh.intersectCached(ra, dec, radius);
+        const QSet<Trixel> cached = results(mesh);
+
+        QVERIFY2(cached.contains(exact), qPrintable(QString("ra %1 dec %2 radius %3").arg(ra).arg(dec).arg(radius)));
+    }
+}
+
+void TestHTMesh::testCacheHits()
+{
+    HTMesh mesh(5, 5);
+
+    mesh.intersectCached(83.8, -5.4, 10);
+    const QSet<Trixel> first = results(mesh);
+    QCOMPARE(mesh.cacheHits(), 0);
+
+    // Same view
+    mesh.intersectCached(83.8, -5.4, 10);
+    QCOMPARE(mesh.cacheHits(), 1);
+    QCOMPARE(results(mesh), first);
+
+    // Another view
+    mesh.intersectCached(200, 40, 10);
+    QCOMPARE(mesh.cacheHits(), 1);
+
+    mesh.clearCache();
+    mesh.intersectCached(83.8, -5.4, 10);
+    QCOMPARE(mesh.cacheHits(), 1);
+}
+
+void TestHTMesh::benchmarkAperture_data()
+{
+    addBenchmarkRows();
+}
+
+void TestHTMesh::benchmarkAperture()
+{
+    QFETCH(int, level);
+    QFETCH(double, radius);
+    HTMesh mesh(level, level);
+
+    double ra = 0;
+    QBENCHMARK
+    {
+        mesh.intersect(ra, 20, radius);
+        ra += 0.01;
+    }
+}
+
+void TestHTMesh::benchmarkApertureCached_data()
+{
+    addBenchmarkRows();
+}
+
+void TestHTMesh::benchmarkApertureCached()
+{
+    QFETCH(int, level);
+    QFETCH(double, radius);
+    HTMesh mesh(level, level);
+
+    // Small pans around the same view, as while dragging the map
+    double ra = 0;
+    QBENCHMARK
+    {
+        mesh.intersectCached(ra, 20, radius);
+        ra += 0.01;
+        if (ra > 1)
+            ra = 0;
+    }
+}
+
+QTEST_GUILESS_MAIN(TestHTMesh)
@@ -0,0 +1,38 @@
+/*  HTMesh tests and aperture benchmarks
+
+    This application is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+*/
+
+#pragma once
+
+#include <QObject>
+
+/**
+ * @class TestHTMesh
+ * @short Tests of the HTM range and aperture cache, and benchmarks of circle
+ * intersections over typical fields of view at mesh levels 3 to 7.
+ */
+class TestHTMesh : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestHTMesh();
+
+  private slots:
+    void testRangeMerge();
+
+    void testCachedCoversCircle_data();
+    void testCachedCoversCircle();
+
+    void testCacheHits();
+
+    void benchmarkAperture_data();
+    void benchmarkAperture();
+
+    void benchmarkApertureCached_data();
+    void benchmarkApertureCached();
+};
@@ -0,0 +1,209 @@
+/*  KStars tests
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "test_starbatchnode.h"
+
+#include "kstarslite.h"
+#include "skymaplite.h"
+#include "kstarslite/skyitems/rootnode.h"
+#include "kstarslite/skyitems/skynodes/starbatchnode.h"
+
+#include <QElapsedTimer>
+#include <QQuickWindow>
+#include <QSGOpacityNode>
+#include <QSGTextureMaterial>
+#include <QtTest/QtTest>
+
+namespace
+{
+// A star quad is made of two triangles
+const int VERTICES_PER_STAR = 6;
+
+struct BatchState
+{
+    int stars { 0 };
+    QVector<QSGGeometry::TexturedPoint2D> vertices;
+    QSGTexture *texture { nullptr };
+};
+
+BatchState batchState(StarBatchNode *batch)
+{
+    BatchState state;
+    state.stars = batch->starCount();
+
+    const QSGGeometry *geometry          = batch->geometry();
+    const QSGGeometry::TexturedPoint2D *v = geometry->vertexDataAsTexturedPoint2D();
+    for (int i = 0; i < geometry->vertexCount(); ++i)
+        state.vertices.append(v[i]);
+
+    state.texture = static_cast<QSGTextureMaterial *>(batch->material())->texture();
+    return state;
+}
+
+bool isQuadAt(const QVector<QSGGeometry::TexturedPoint2D> &vertices, int star, const QPointF &pos,
+              const RootNode::StarSprite &sprite)
+{
+    const QSGGeometry::TexturedPoint2D *v = vertices.constData() + star * VERTICES_PER_STAR;
+    const QRectF quad(pos.x() - 0.5 * sprite.size.width(), pos.y() - 0.5 * sprite.size.height(),
+                      sprite.size.width(), sprite.size.height());
+
+    return qFuzzyCompare(v[0].x, float(quad.left())) && qFuzzyCompare(v[0].y, float(quad.top())) &&
+           qFuzzyCompare(v[5].x, float(quad.right())) && qFuzzyCompare(v[5].y, float(quad.bottom())) &&
+           qFuzzyCompare(v[0].tx, float(sprite.source.left())) && qFuzzyCompare(v[0].ty, float(sprite.source.top())) &&
+           qFuzzyCompare(v[5].tx, float(sprite.source.right())) &&
+           qFuzzyCompare(v[5].ty, float(sprite.source.bottom()));
+}
+
+bool isCollapsedFrom(const QVector<QSGGeometry::TexturedPoint2D> &vertices, int star)
+{
+    for (int i = star * VERTICES_PER_STAR; i < vertices.size(); ++i)
+    {
+        if (vertices[i].x != 0 || vertices[i].y != 0)
+            return false;
+    }
+    return true;
+}
+}
+
+void TestStarBatchNode::initTestCase()
+{
+    KStarsLite::createInstance(false);
+    QTRY_VERIFY_WITH_TIMEOUT(KStarsLite::Instance()->getMainWindow() != nullptr, 60000);
+    QTRY_VERIFY_WITH_TIMEOUT(SkyMapLite::rootNode() != nullptr, 60000);
+    QVERIFY(runOnSceneGraph([this](RootNode *root) { m_Batch = new StarBatchNode(root); }));
+}
+
+void TestStarBatchNode::cleanupTestCase()
+{
+    delete m_Batch;
+    m_Batch = nullptr;
+}
+
+bool TestStarBatchNode::runOnSceneGraph(const std::function<void(RootNode *)> &function)
+{
+    QQuickWindow *window = KStarsLite::Instance()->getMainWindow();
+    bool done            = false;
+
+    QMetaObject::Connection connection = connect(
+        window, &QQuickWindow::beforeSynchronizing, this,
+        [&]() {
+            if (!done)
+                function(SkyMapLite::rootNode());
+            done = true;
+        },
+        Qt::DirectConnection);
+
+    window->update();
+    QElapsedTimer timer;
+    timer.start();
+    while (!done && timer.elapsed() < 10000)
+        QTest::qWait(10);
+
+    disconnect(connection);
+    return done;
+}
+
+void TestStarBatchNode::testBatch()
+{
+    const QPointF vega(100, 50), sun(200, 80);
+    RootNode::StarSprite vegaSprite, sunSprite;
+    BatchState state;
+
+    QVERIFY(runOnSceneGraph([&](RootNode *root) {
+        vegaSprite = root->starSprite(4, 'A');
+        sunSprite  = root->starSprite(6, 'G');
+
+        m_Batch->beginUpdate();
+        m_Batch->addStar(vega, 4, 'A');
+        m_Batch->addStar(sun, 6, 'G');
+        m_Batch->endUpdate();
+        state = batchState(m_Batch);
+    }));
+
+    QCOMPARE(state.stars, 2);
+    QVERIFY(state.vertices.size() >= 2 * VERTICES_PER_STAR);
+    QCOMPARE(state.vertices.size() % VERTICES_PER_STAR, 0);
+    QVERIFY(isQuadAt(state.vertices, 0, vega, vegaSprite));
+    QVERIFY(isQuadAt(state.vertices, 1, sun, sunSprite));
+    QVERIFY(isCollapsedFrom(state.vertices, 2));
+
+    // A new batch replaces the stars of the previous one in place
+    QVERIFY(runOnSceneGraph([&](RootNode *) {
+        m_Batch->beginUpdate();
+        m_Batch->addStar(sun, 6, 'G');
+        m_Batch->endUpdate();
+        state = batchState(m_Batch);
+    }));
+
+    QCOMPARE(state.stars, 1);
+    QVERIFY(isQuadAt(state.vertices, 0, sun, sunSprite));
+    QVERIFY(isCollapsedFrom(state.vertices, 1));
+}
+
+void TestStarBatchNode::testGrowAndTrim()
+{
+    const int stars = 1000;
+    RootNode::StarSprite sprite;
+    BatchState grown, trimmed;
+
+    QVERIFY(runOnSceneGraph([&](RootNode *root) {
+        sprite = root->starSprite(3, 'K');
+
+        m_Batch->beginUpdate();
+        for (int i = 0; i < stars; ++i)
+            m_Batch->addStar(QPointF(i, 2 * i), 3, 'K');
+        m_Batch->endUpdate();
+        grown = batchState(m_Batch);
+
+        m_Batch->beginUpdate();
+        for (int i = 0; i < 3; ++i)
+            m_Batch->addStar(QPointF(i, 2 * i), 3, 'K');
+        m_Batch->endUpdate();
+        trimmed = batchState(m_Batch);
+    }));
+
+    // The quads added before the buffer grew are kept
+    QCOMPARE(grown.stars, stars);
+    QVERIFY(grown.vertices.size() >= stars * VERTICES_PER_STAR);
+    QVERIFY(isQuadAt(grown.vertices, 0, QPointF(0, 0), sprite));
+    QVERIFY(isQuadAt(grown.vertices, stars - 1, QPointF(stars - 1, 2 * (stars - 1)), sprite));
+
+    // Most of the buffer is unused after zooming in, so it is trimmed
+    QCOMPARE(trimmed.stars, 3);
+    QVERIFY(trimmed.vertices.size() < stars * VERTICES_PER_STAR / 4);
+    QVERIFY(isQuadAt(trimmed.vertices, 2, QPointF(2, 4), sprite));
+    QVERIFY(isCollapsedFrom(trimmed.vertices, 3));
+}
+
+void TestStarBatchNode::testAtlasSwap()
+{
+    QSGTexture *oldAtlas = nullptr, *newAtlas = nullptr;
+    BatchState state;
+
+    // The batch of a hidden trixel still refers to the atlas and has to follow the swap
+    QVERIFY(runOnSceneGraph([&](RootNode *root) {
+        QSGOpacityNode *hiddenTrixel = new QSGOpacityNode();
+        hiddenTrixel->setOpacity(0);
+        hiddenTrixel->appendChildNode(m_Batch);
+        root->appendChildNode(hiddenTrixel);
+
+        oldAtlas = root->starAtlas();
+        root->genCachedTextures();
+        newAtlas = root->starAtlas();
+        state    = batchState(m_Batch);
+
+        hiddenTrixel->removeChildNode(m_Batch);
+        root->removeChildNode(hiddenTrixel);
+        delete hiddenTrixel;
+    }));
+
+    QVERIFY(oldAtlas != newAtlas);
+    QCOMPARE(state.texture, newAtlas);
+}
+
+QTEST_MAIN(TestStarBatchNode)
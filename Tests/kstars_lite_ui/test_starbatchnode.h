@@ -0,0 +1,42 @@
+/*  KStars tests
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#pragma once
+
+#include <QObject>
+
+#include <functional>
+
+class RootNode;
+class StarBatchNode;
+
+/**
+ * @class TestStarBatchNode
+ * @short Tests of the batched star geometry of KStars Lite, in an offscreen Qt Quick window
+ */
+class TestStarBatchNode : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestStarBatchNode() = default;
+
+  private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testBatch();
+    void testGrowAndTrim();
+    void testAtlasSwap();
+
+  private:
+    /** Run function on the next scene graph synchronization, when the scene graph may be modified */
+    bool runOnSceneGraph(const std::function<void(RootNode *)> &function);
+
+    StarBatchNode *m_Batch { nullptr };
+};
@@ -0,0 +1,57 @@
+/*  KStars tests
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#include "testconstellationartcache.h"
+
+#include "constellationartcache.h"
+#include "texturemanager.h"
+
+TestConstellationArtCache::TestConstellationArtCache(QObject *parent) : QObject(parent)
+{
+}
+
+void TestConstellationArtCache::initTestCase()
+{
+    // The western culture image copied next to the test by the build, found as installed data
+    QStandardPaths::setTestModeEnabled(true);
+    qputenv("XDG_DATA_DIRS", QString(QCoreApplication::applicationDirPath() + "/share").toLocal8Bit());
+}
+
+void TestConstellationArtCache::testFindCultureImage()
+{
+    // The sky culture database names the images without their directory
+    const QString filename = TextureManager::findTextureFile("andromeda");
+    QVERIFY(!filename.isEmpty());
+    QVERIFY(filename.endsWith("skycultures/western/andromeda.png"));
+}
+
+void TestConstellationArtCache::testDecodeLevel()
+{
+    ConstellationArtCache *cache = ConstellationArtCache::Instance();
+
+    // Nothing is decoded yet, the image is requested in the background
+    QVERIFY(cache->image("andromeda", 100).isNull());
+    cache->waitForDone();
+
+    const QImage image = cache->image("andromeda", 100);
+    QVERIFY(!image.isNull());
+    QCOMPARE(qMax(image.width(), image.height()), ConstellationArtCache::levelForSize(100));
+    QCOMPARE(image.format(), QImage::Format_ARGB32_Premultiplied);
+    QVERIFY(cache->bytes() > 0);
+}
+
+void TestConstellationArtCache::testMissingImage()
+{
+    ConstellationArtCache *cache = ConstellationArtCache::Instance();
+
+    QVERIFY(cache->image("no-such-constellation", 100).isNull());
+    cache->waitForDone();
+    QVERIFY(cache->image("no-such-constellation", 100).isNull());
+}
+
+QTEST_GUILESS_MAIN(TestConstellationArtCache)
@@ -0,0 +1,29 @@
+/*  KStars tests
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+ */
+
+#ifndef TESTCONSTELLATIONARTCACHE_H
+#define TESTCONSTELLATIONARTCACHE_H
+
+#include <QtTest>
+#include <QObject>
+
+class TestConstellationArtCache : public QObject
+{
+    Q_OBJECT
+public:
+    explicit TestConstellationArtCache(QObject *parent = nullptr);
+
+private slots:
+    void initTestCase();
+
+    void testFindCultureImage();
+    void testDecodeLevel();
+    void testMissingImage();
+};
+
+#endif // TESTCONSTELLATIONARTCACHE_H
@@ -477,6 +477,68 @@ void TestSkyPoint::compareSkyPointLibNova()
     compare("original", Ra, Dec, sp.RA0.Hours(), sp.Dec0.Degrees());
 }
 
+void TestSkyPoint::testCachedNumbers()
+{
+    long double jd = KStarsDateTime::fromString("2028-04-27T06:30").djd();
+
+    std::shared_ptr<const KSNumbers> cached = KSNumbers::cached(jd);
+    QVERIFY(cached.get() == KSNumbers::cached(jd).get());
+    QVERIFY(cached.get() != KSNumbers::cached(jd + 1).get());
+
+    KSNumbers num(jd);
+    QCOMPARE(cached->julianDay(), num.julianDay());
+    QCOMPARE(cached->dEcLong(), num.dEcLong());
+    QCOMPARE(cached->dObliq(), num.dObliq());
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            QCOMPARE(cached->p2(i, j), num.p2(i, j));
+}
+
+void TestSkyPoint::testApparentCoords_data()
+{
+    QTest::addColumn<double>("jd0");
+    QTest::addColumn<double>("jdf");
+
+    QTest::newRow("J2000 to 2028") << static_cast<double>(J2000L) << 2461890.77;
+    QTest::newRow("1980 to 2028") << 2444239.5 << 2461890.77;
+    QTest::newRow("2028 to J2000") << 2461890.77 << static_cast<double>(J2000L);
+    QTest::newRow("same epoch") << 2461890.77 << 2461890.77;
+    QTest::newRow("B1950 to 2028") << static_cast<double>(B1950L) << 2461890.77;
+}
+
+void TestSkyPoint::testApparentCoords()
+{
+    Options::setUseRelativistic(false);
+
+    QFETCH(double, jd0);
+    QFETCH(double, jdf);
+    // The epoch constants are long doubles
+    long double ljd0 = jd0 == static_cast<double>(J2000L) ? J2000L : (jd0 == static_cast<double>(B1950L) ? B1950L : jd0);
+    long double ljdf = jdf == static_cast<double>(J2000L) ? J2000L : jdf;
+
+    CachingDms LST(123.4), lat(48.2);
+    QVector<SkyPoint> points;
+    for (double ra = 0; ra < 360; ra += 37)
+        for (double dec = -85; dec <= 85; dec += 17)
+            points.append(SkyPoint(ra / 15.0, dec));
+
+    QVector<SkyPoint> batch = points;
+    SkyPoint::apparentCoords(batch, ljd0, ljdf, &LST, &lat);
+
+    // The precession matrices are combined, so that the results only differ by rounding
+    for (int i = 0; i < points.size(); ++i)
+    {
+        SkyPoint &p = points[i];
+        p.apparentCoord(ljd0, ljdf);
+        p.EquatorialToHorizontal(&LST, &lat);
+
+        QVERIFY(fabs(p.ra().Degrees() - batch[i].ra().Degrees()) < 1e-9);
+        QVERIFY(fabs(p.dec().Degrees() - batch[i].dec().Degrees()) < 1e-9);
+        QVERIFY(fabs(p.az().Degrees() - batch[i].az().Degrees()) < 1e-9);
+        QVERIFY(fabs(p.alt().Degrees() - batch[i].alt().Degrees()) < 1e-9);
+    }
+}
+
 void TestSkyPoint::compare(QString msg, SkyPoint *sp, SkyPoint *sp1)
 {
     compare(msg, sp->ra0().Degrees(), sp->dec0().Degrees(), sp1->ra().Degrees(), sp1->dec().Degrees());
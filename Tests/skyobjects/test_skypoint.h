@@ -70,6 +70,11 @@ class TestSkyPoint : public QObject
         void compareSkyPointLibNova_data();
         void compareSkyPointLibNova();
 
+        void testCachedNumbers();
+
+        void testApparentCoords_data();
+        void testApparentCoords();
+
     private:
         bool useRelativistic {false};
 };
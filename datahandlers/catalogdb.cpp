@@ -20,18 +20,147 @@
 #include "catalogdata.h"
 #include "catalogentrydata.h"
 #include "kstars/version.h"
+#include "../kstars/nan.h"
 #include "../kstars/auxiliary/kspaths.h"
 #include "starobject.h"
 #include "deepskyobject.h"
 #include "skycomponent.h"
+#include "HTMesh.h"
+#include "MeshIterator.h"
 
+#include <QElapsedTimer>
 #include <QSqlField>
 #include <QSqlQuery>
 #include <QSqlRecord>
 #include <QSqlTableModel>
+#include <QVector>
 
 #include <catalog_debug.h>
 
+#include <cmath>
+#include <memory>
+
+namespace
+{
+// Fuzz used to decide whether an incoming object is already in the DSO table.
+// RA and Dec are stored in degrees.
+constexpr double FUZZ_COORD     = 0.0016;
+constexpr double FUZZ_MAGNITUDE = 0.1;
+
+int countLines(const QString &filename)
+{
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly))
+        return 0;
+
+    int lines = 0;
+    while (!file.atEnd())
+    {
+        file.readLine();
+        ++lines;
+    }
+    return lines;
+}
+}
+
+/**
+ * Bulk import state. The DSO table is read once into a grid of cells the size
+ * of the fuzz box, so each duplicate lookup only has to check the 3x3 cells
+ * around the incoming object instead of scanning the table.
+ */
+class CatalogDB::BulkImport
+{
+  public:
+    explicit BulkImport(const QSqlDatabase &db) : add_dso(db), add_od(db), add_od_next_id(db) {}
+
+    bool prepare()
+    {
+        bool ok = add_dso.prepare("INSERT INTO DSO (RA, Dec, Type, Magnitude, PositionAngle,"
+                                  " MajorAxis, MinorAxis, Flux, Trixel) VALUES (:RA, :Dec, :Type,"
+                                  " :Magnitude, :PositionAngle, :MajorAxis, :MinorAxis,"
+                                  " :Flux, :Trixel)");
+        ok &= add_od.prepare("INSERT INTO ObjectDesignation (id_Catalog, UID_DSO, LongName"
+                             ", IDNumber) VALUES (:catid, :rowuid, :longname, :id)");
+        ok &= add_od_next_id.prepare("INSERT INTO ObjectDesignation (id_Catalog, UID_DSO, LongName"
+                                     ", IDNumber) VALUES (:catid, :rowuid, :longname,"
+                                     "(SELECT MAX(ISNULL(IDNumber,1))+1 FROM ObjectDesignation WHERE id_Catalog = :catid) )");
+        return ok;
+    }
+
+    /** Loads all existing DSO rows into the spatial index */
+    bool loadIndex(const QSqlDatabase &db)
+    {
+        QSqlQuery query(db);
+        query.setForwardOnly(true);
+        if (!query.exec("SELECT UID, RA, Dec, Magnitude FROM DSO"))
+        {
+            qCWarning(KSTARS_CATALOG) << query.lastError();
+            return false;
+        }
+        while (query.next())
+        {
+            const QVariant mag = query.value(3);
+            insert(query.value(0).toInt(), query.value(1).toDouble(), query.value(2).toDouble(),
+                   mag.isNull() ? NaN::d : mag.toDouble());
+        }
+        return true;
+    }
+
+    /** @return UID of the first indexed row within the fuzz box, or -1 */
+    int find(double ra, double dec, double magnitude) const
+    {
+        const qint64 ra_cell  = cell(ra);
+        const qint64 dec_cell = cell(dec);
+        int uid               = -1;
+
+        for (qint64 i = ra_cell - 1; i <= ra_cell + 1; ++i)
+        {
+            for (qint64 j = dec_cell - 1; j <= dec_cell + 1; ++j)
+            {
+                auto bucket = m_Cells.constFind(key(i, j));
+                if (bucket == m_Cells.constEnd())
+                    continue;
+
+                for (const Entry &e : bucket.value())
+                {
+                    if (std::fabs(e.ra - ra) <= FUZZ_COORD && std::fabs(e.dec - dec) <= FUZZ_COORD &&
+                        std::fabs(e.magnitude - magnitude) <= FUZZ_MAGNITUDE && (uid == -1 || e.uid < uid))
+                        uid = e.uid;
+                }
+            }
+        }
+        return uid;
+    }
+
+    void insert(int uid, double ra, double dec, double magnitude)
+    {
+        m_Cells[key(cell(ra), cell(dec))].append({ uid, ra, dec, magnitude });
+    }
+
+    QSqlQuery add_dso;
+    QSqlQuery add_od;
+    QSqlQuery add_od_next_id;
+
+  private:
+    struct Entry
+    {
+        int uid;
+        double ra;
+        double dec;
+        double magnitude;
+    };
+
+    static qint64 cell(double degrees) { return static_cast<qint64>(std::floor(degrees / FUZZ_COORD)); }
+    static quint64 key(qint64 ra_cell, qint64 dec_cell)
+    {
+        return (static_cast<quint64>(static_cast<quint32>(ra_cell)) << 32) | static_cast<quint32>(dec_cell);
+    }
+
+    QHash<quint64, QVector<Entry>> m_Cells;
+};
+
+CatalogDB::CatalogDB() = default;
+
 bool CatalogDB::Initialize()
 {
     skydb_         = QSqlDatabase::addDatabase("QSQLITE", "skydb");
@@ -59,6 +188,7 @@ bool CatalogDB::Initialize()
         {
             FirstRun();
         }
+        UpgradeSchema();
     }
     skydb_.close();
     return true;
@@ -107,7 +237,8 @@ void CatalogDB::FirstRun()
                   "Add1 VARCHAR DEFAULT NULL,"
                   "Add2 INTEGER DEFAULT NULL,"
                   "Add3 INTEGER DEFAULT NULL,"
-                  "Add4 INTEGER DEFAULT NULL)");
+                  "Add4 INTEGER DEFAULT NULL,"
+                  "Trixel INTEGER DEFAULT NULL)");
 
     for (int i = 0; i < tables.count(); ++i)
     {
@@ -119,6 +250,62 @@ void CatalogDB::FirstRun()
     }
 }
 
+void CatalogDB::UpgradeSchema()
+{
+    QSqlQuery query(skydb_);
+
+    bool has_trixel = false;
+    if (query.exec("PRAGMA table_info(DSO)"))
+    {
+        while (query.next())
+        {
+            if (query.value(1).toString() == QLatin1String("Trixel"))
+                has_trixel = true;
+        }
+    }
+    if (!has_trixel && !query.exec("ALTER TABLE DSO ADD COLUMN Trixel INTEGER DEFAULT NULL"))
+        qCWarning(KSTARS_CATALOG) << query.lastError();
+
+    // Fill in the trixels of rows written by older versions
+    QVector<QPair<int, int>> missing;
+    if (query.exec("SELECT UID, RA, Dec FROM DSO WHERE Trixel IS NULL"))
+    {
+        while (query.next())
+            missing.append(qMakePair(query.value(0).toInt(),
+                                     static_cast<int>(Mesh()->index(query.value(1).toDouble(), query.value(2).toDouble()))));
+    }
+    if (!missing.isEmpty())
+    {
+        qCInfo(KSTARS_CATALOG) << "Computing trixels of" << missing.size() << "DSO entries";
+        skydb_.transaction();
+        QSqlQuery update(skydb_);
+        update.prepare("UPDATE DSO SET Trixel = :trixel WHERE UID = :uid");
+        for (const auto &row : missing)
+        {
+            update.bindValue(":trixel", row.second);
+            update.bindValue(":uid", row.first);
+            if (!update.exec())
+                qCWarning(KSTARS_CATALOG) << update.lastError();
+        }
+        skydb_.commit();
+    }
+
+    const QStringList indexes = { "CREATE INDEX IF NOT EXISTS DSO_RA_Dec ON DSO (RA, Dec)",
+                                  "CREATE INDEX IF NOT EXISTS DSO_Trixel ON DSO (Trixel)" };
+    for (const auto &index : indexes)
+    {
+        if (!query.exec(index))
+            qCWarning(KSTARS_CATALOG) << query.lastError();
+    }
+}
+
+HTMesh *CatalogDB::Mesh()
+{
+    if (!mesh_)
+        mesh_.reset(new HTMesh(HTM_LEVEL, HTM_LEVEL));
+    return mesh_.get();
+}
+
 CatalogDB::~CatalogDB()
 {
     skydb_.close();
@@ -260,31 +447,25 @@ int CatalogDB::FindFuzzyEntry(const double ra, const double dec, const double ma
      * with certain fuzz. If found, store it in rowuid
      * This Fuzz has not been established after due discussion
     */
-    //skydb_.open();
-    QSqlTableModel dsoentries(nullptr, skydb_);
-
-    QString filter = "((RA - " + QString().setNum(ra) +
-                     ") between -0.0016 and 0.0016) and "
-                     "((Dec - " +
-                     QString().setNum(dec) +
-                     ") between -0.0016 and 0.0016) and"
-                     "((Magnitude - " +
-                     QString().setNum(magnitude) + ") between -0.1 and 0.1)";
-    //   qDebug() << filter;
-    dsoentries.setTable("DSO");
-    dsoentries.setFilter(filter);
-    dsoentries.select();
-
-    int entry_count   = dsoentries.rowCount();
-    QSqlRecord record = dsoentries.record(0);
+    // Bound ranges let SQLite use the DSO_RA_Dec index instead of scanning the table
+    QSqlQuery dsoentries(skydb_);
+    dsoentries.prepare("SELECT UID FROM DSO WHERE RA BETWEEN :ra_min AND :ra_max AND "
+                       "Dec BETWEEN :dec_min AND :dec_max AND "
+                       "Magnitude BETWEEN :mag_min AND :mag_max ORDER BY UID LIMIT 1");
+    dsoentries.bindValue(":ra_min", ra - FUZZ_COORD);
+    dsoentries.bindValue(":ra_max", ra + FUZZ_COORD);
+    dsoentries.bindValue(":dec_min", dec - FUZZ_COORD);
+    dsoentries.bindValue(":dec_max", dec + FUZZ_COORD);
+    dsoentries.bindValue(":mag_min", magnitude - FUZZ_MAGNITUDE);
+    dsoentries.bindValue(":mag_max", magnitude + FUZZ_MAGNITUDE);
 
     int returnval = -1;
-    if (entry_count > 0)
-        returnval = record.value("UID").toInt();
+    if (!dsoentries.exec())
+        qCWarning(KSTARS_CATALOG) << dsoentries.lastError();
+    else if (dsoentries.next())
+        returnval = dsoentries.value(0).toInt();
 
     dsoentries.clear();
-    //skydb_.close();
-    //   qDebug() << returnval;
     return returnval;
 }
 
@@ -301,7 +482,7 @@ bool CatalogDB::AddEntry(const CatalogEntryData &catalog_entry, int catid)
     return retVal;
 }
 
-bool CatalogDB::_AddEntry(const CatalogEntryData &catalog_entry, int catid)
+bool CatalogDB::_AddEntry(const CatalogEntryData &catalog_entry, int catid, BulkImport *bulk)
 {
     // Verification step
     // If RA, Dec are Null, it denotes an invalid object and should not be written
@@ -317,21 +498,27 @@ bool CatalogDB::_AddEntry(const CatalogEntryData &catalog_entry, int catid)
                  << " Long Name: " << catalog_entry.long_name;
         return false;
     }
-    // Part 1: Adding in DSO table
-    // I will not use QSQLTableModel as I need to execute a query to find
-    // out the lastInsertId
 
-    // Part 2: Fuzzy Match or Create New Entry
-    int rowuid = FindFuzzyEntry(catalog_entry.ra, catalog_entry.dec, catalog_entry.magnitude);
-    //skydb_.open();
+    // A single entry gets its own set of prepared queries
+    std::unique_ptr<BulkImport> single;
+    if (bulk == nullptr)
+    {
+        single.reset(new BulkImport(skydb_));
+        if (!single->prepare())
+        {
+            qCWarning(KSTARS_CATALOG) << LastError();
+            return false;
+        }
+    }
+    BulkImport *import = bulk ? bulk : single.get();
+
+    // Part 1: Fuzzy Match or Create New Entry in DSO table
+    int rowuid = bulk ? bulk->find(catalog_entry.ra, catalog_entry.dec, catalog_entry.magnitude) :
+                        FindFuzzyEntry(catalog_entry.ra, catalog_entry.dec, catalog_entry.magnitude);
 
     if (rowuid == -1) //i.e. No fuzzy match found. Proceed to add new entry
     {
-        QSqlQuery add_query(skydb_);
-        add_query.prepare("INSERT INTO DSO (RA, Dec, Type, Magnitude, PositionAngle,"
-                          " MajorAxis, MinorAxis, Flux) VALUES (:RA, :Dec, :Type,"
-                          " :Magnitude, :PositionAngle, :MajorAxis, :MinorAxis,"
-                          " :Flux)");
+        QSqlQuery &add_query = import->add_dso;
         add_query.bindValue(":RA", catalog_entry.ra);
         add_query.bindValue(":Dec", catalog_entry.dec);
         add_query.bindValue(":Type", catalog_entry.type);
@@ -340,16 +527,19 @@ bool CatalogDB::_AddEntry(const CatalogEntryData &catalog_entry, int catid)
         add_query.bindValue(":MajorAxis", catalog_entry.major_axis);
         add_query.bindValue(":MinorAxis", catalog_entry.minor_axis);
         add_query.bindValue(":Flux", catalog_entry.flux);
+        add_query.bindValue(":Trixel", static_cast<int>(Mesh()->index(catalog_entry.ra, catalog_entry.dec)));
         if (!add_query.exec())
         {
             qCWarning(KSTARS_CATALOG) << "Custom Catalog Insert Query FAILED!";
             qCWarning(KSTARS_CATALOG) << add_query.lastQuery();
             qCWarning(KSTARS_CATALOG) << add_query.lastError();
+            return false;
         }
 
         // Find UID of the Row just added
         rowuid = add_query.lastInsertId().toInt();
-        add_query.clear();
+        if (bulk)
+            bulk->insert(rowuid, catalog_entry.ra, catalog_entry.dec, catalog_entry.magnitude);
     }
     int ID = catalog_entry.ID;
 
@@ -361,26 +551,10 @@ bool CatalogDB::_AddEntry(const CatalogEntryData &catalog_entry, int catid)
      *    this is to be rarely used.
      */
 
-    // Find ID of catalog
-    //skydb_.close();
-    //catid = FindCatalog(catalog_entry.catalog_name);
-
-    // Part 3: Add in Object Designation
-    //skydb_.open();
-    QSqlQuery add_od(skydb_);
+    // Part 2: Add in Object Designation
+    QSqlQuery &add_od = (ID >= 0) ? import->add_od : import->add_od_next_id;
     if (ID >= 0)
-    {
-        add_od.prepare("INSERT INTO ObjectDesignation (id_Catalog, UID_DSO, LongName"
-                       ", IDNumber) VALUES (:catid, :rowuid, :longname, :id)");
         add_od.bindValue(":id", ID);
-    }
-    else
-    {
-        //qWarning() << "FIXME: This query has not been tested!!!!";
-        add_od.prepare("INSERT INTO ObjectDesignation (id_Catalog, UID_DSO, LongName"
-                       ", IDNumber) VALUES (:catid, :rowuid, :longname,"
-                       "(SELECT MAX(ISNULL(IDNumber,1))+1 FROM ObjectDesignation WHERE id_Catalog = :catid) )");
-    }
     add_od.bindValue(":catid", catid);
     add_od.bindValue(":rowuid", rowuid);
     add_od.bindValue(":longname", catalog_entry.long_name);
@@ -392,8 +566,6 @@ bool CatalogDB::_AddEntry(const CatalogEntryData &catalog_entry, int catid)
         qWarning() << skydb_.lastError();
         retVal = false;
     }
-    add_od.clear();
-    //skydb_.close();
 
     return retVal;
 }
@@ -538,15 +710,31 @@ bool CatalogDB::AddCatalogContents(const QString &fname)
         // Part 2) Read file and store into DB
         KSParser catalog_text_parser(filename, '#', sequence, delimiter);
 
+        catalog_text_parser.SetProgress(i18n("Importing %1", catalog_name), countLines(filename), 10);
+
         int catid = FindCatalog(catalog_name);
 
+        QElapsedTimer timer;
+        timer.start();
+
         skydb_.open();
         skydb_.transaction();
 
+        BulkImport bulk(skydb_);
+        if (!bulk.prepare() || !bulk.loadIndex(skydb_))
+        {
+            qCWarning(KSTARS_CATALOG) << "Unable to prepare bulk import of" << catalog_name << LastError();
+            skydb_.rollback();
+            skydb_.close();
+            return false;
+        }
+
+        int added = 0, rejected = 0;
         QHash<QString, QVariant> row_content;
         while (catalog_text_parser.HasNextRow())
         {
             row_content = catalog_text_parser.ReadNextRow();
+            catalog_text_parser.ShowProgress();
 
             CatalogEntryData catalog_entry;
 
@@ -565,11 +753,17 @@ bool CatalogDB::AddCatalogContents(const QString &fname)
             catalog_entry.minor_axis     = row_content["Mn"].toFloat();
             catalog_entry.flux           = row_content["Flux"].toFloat();
 
-            _AddEntry(catalog_entry, catid);
+            if (_AddEntry(catalog_entry, catid, &bulk))
+                added++;
+            else
+                rejected++;
         }
 
         skydb_.commit();
         skydb_.close();
+
+        qCInfo(KSTARS_CATALOG) << "Imported" << added << "objects into" << catalog_name << "in" << timer.elapsed()
+                               << "ms," << rejected << "rejected.";
     }
     return true;
 }
@@ -906,12 +1100,132 @@ void CatalogDB::GetAllObjects(const QString &catalog, QList<SkyObject *> &sky_li
     //     qWarning() << get_query.lastError();
     //     qWarning() << FindCatalog(catalog);
 
+    BuildObjects(get_query, sky_list, &object_names, catalog_ptr, includeCatalogDesignation);
+
+    get_query.clear();
+    skydb_.close();
+}
+
+int CatalogDB::GetObjectsInCone(const QString &catalog_name, const SkyPoint &center, double radius, float faint_mag,
+                                QList<SkyObject *> &sky_list, CatalogComponent *catalog_pointer,
+                                bool includeCatalogDesignation)
+{
+    return GetObjectsInTrixels(catalog_name, CoveringTrixels(catalog_name, center, radius), faint_mag, sky_list,
+                               catalog_pointer, includeCatalogDesignation, [&center, radius](const SkyPoint &p, float)
+    {
+        return center.angularDistanceTo(&p).Degrees() <= radius;
+    });
+}
+
+int CatalogDB::GetObjectsInRect(const QString &catalog_name, double ra_min, double ra_max, double dec_min,
+                                double dec_max, float faint_mag, QList<SkyObject *> &sky_list,
+                                CatalogComponent *catalog_pointer, bool includeCatalogDesignation)
+{
+    const bool wraps   = ra_min > ra_max;
+    const double width = wraps ? ra_max + 360.0 - ra_min : ra_max - ra_min;
+
+    // Cover the rectangle with the circle through its farthest corner and filter the result exactly.
+    // For rectangles up to 180 degrees wide, no point of the border is farther from the center than the corners.
+    SkyPoint center(dms(ra_min + width / 2.0).reduce(), dms((dec_min + dec_max) / 2.0));
+    double radius = 180.0;
+    if (width <= 180.0)
+    {
+        radius = 0;
+        for (double ra : { ra_min, ra_max })
+        {
+            for (double dec : { dec_min, dec_max })
+            {
+                SkyPoint corner { dms(ra), dms(dec) };
+                radius = qMax(radius, center.angularDistanceTo(&corner).Degrees());
+            }
+        }
+    }
+
+    return GetObjectsInTrixels(catalog_name, CoveringTrixels(catalog_name, center, radius), faint_mag, sky_list,
+                               catalog_pointer, includeCatalogDesignation, [ = ](const SkyPoint &p, float)
+    {
+        const double ra  = p.ra().Degrees();
+        const double dec = p.dec().Degrees();
+        if (dec < dec_min || dec > dec_max)
+            return false;
+        return wraps ? (ra >= ra_min || ra <= ra_max) : (ra >= ra_min && ra <= ra_max);
+    });
+}
+
+QVector<int> CatalogDB::CoveringTrixels(const QString &catalog_name, const SkyPoint &center, double radius)
+{
+    CatalogData catalog_data;
+    GetCatalogData(catalog_name, catalog_data);
+
+    // Trixels are computed from the stored coordinates, which for B1950 catalogs
+    // are up to ~0.7 degrees away from J2000. Widen the search to cover that.
+    if (catalog_data.epoch != 2000)
+        radius += 1.0;
+
+    QVector<int> trixels;
+    // Beyond a hemisphere nearly every trixel is hit, so don't constrain the query at all
+    if (radius >= 90.0)
+        return trixels;
+
+    Mesh()->intersect(center.ra().Degrees(), center.dec().Degrees(), radius);
+    MeshIterator iterator(Mesh());
+    while (iterator.hasNext())
+        trixels.append(iterator.next());
+
+    return trixels;
+}
+
+int CatalogDB::GetObjectsInTrixels(const QString &catalog_name, const QVector<int> &trixels, float faint_mag,
+                                   QList<SkyObject *> &sky_list, CatalogComponent *catalog_pointer,
+                                   bool includeCatalogDesignation,
+                                   const std::function<bool(const SkyPoint &, float)> &accept)
+{
+    const int catid = FindCatalog(catalog_name);
+
+    QString trixel_filter;
+    if (!trixels.isEmpty())
+    {
+        QStringList trixel_list;
+        trixel_list.reserve(trixels.size());
+        for (int trixel : trixels)
+            trixel_list.append(QString::number(trixel));
+        trixel_filter = " AND DSO.Trixel IN (" + trixel_list.join(',') + ')';
+    }
+
+    skydb_.open();
+    QSqlQuery get_query(skydb_);
+    get_query.setForwardOnly(true);
+    get_query.prepare("SELECT Epoch, Type, RA, Dec, Magnitude, Prefix, "
+                      "IDNumber, LongName, MajorAxis, MinorAxis, "
+                      "PositionAngle, Flux FROM DSO "
+                      "JOIN ObjectDesignation ON ObjectDesignation.UID_DSO = DSO.UID "
+                      "JOIN Catalog ON ObjectDesignation.id_Catalog = Catalog.id "
+                      "WHERE Catalog.id = :catID AND (Magnitude IS NULL OR Magnitude <= :faintMag)" +
+                      trixel_filter);
+    get_query.bindValue(":catID", catid);
+    get_query.bindValue(":faintMag", faint_mag);
+
+    int count = BuildObjects(get_query, sky_list, nullptr, catalog_pointer, includeCatalogDesignation, accept);
+
+    get_query.clear();
+    skydb_.close();
+
+    return count;
+}
+
+int CatalogDB::BuildObjects(QSqlQuery &get_query, QList<SkyObject *> &sky_list,
+                            QList<QPair<int, QString>> *object_names, CatalogComponent *catalog_ptr,
+                            bool includeCatalogDesignation,
+                            const std::function<bool(const SkyPoint &, float)> &accept)
+{
     if (!get_query.exec())
     {
         qWarning() << get_query.lastQuery();
         qWarning() << get_query.lastError();
+        return 0;
     }
 
+    int count = 0;
     while (get_query.next())
     {
         int cat_epoch       = get_query.value(0).toInt();
@@ -961,6 +1275,9 @@ void CatalogDB::GetAllObjects(const QString &catalog, QList<SkyObject *> &sky_li
                           " J2000.0";
         }
 
+        if (accept && !accept(t, mag))
+            continue;
+
         RA  = t.ra();
         Dec = t.dec();
 
@@ -985,20 +1302,20 @@ void CatalogDB::GetAllObjects(const QString &catalog, QList<SkyObject *> &sky_li
             sky_list.append(o);
 
             // Add name to the list of object names
-            if (!name.isEmpty())
+            if (object_names && !name.isEmpty())
             {
-                object_names.append(qMakePair<int, QString>(iType, name));
+                object_names->append(qMakePair<int, QString>(iType, name));
             }
         }
+        count++;
 
-        if (!lname.isEmpty() && lname != name)
+        if (object_names && !lname.isEmpty() && lname != name)
         {
-            object_names.append(qMakePair<int, QString>(iType, lname));
+            object_names->append(qMakePair<int, QString>(iType, lname));
         }
     }
 
-    get_query.clear();
-    skydb_.close();
+    return count;
 }
 
 QList<QPair<QString, KSParser::DataTypes>> CatalogDB::buildParserSequence(const QStringList &Columns)
@@ -26,8 +26,15 @@
 
 #include <QSqlDatabase>
 #include <QSqlError>
+#include <QVector>
 
+#include <functional>
+#include <memory>
+
+class HTMesh;
+class QSqlQuery;
 class SkyObject;
+class SkyPoint;
 class CatalogComponent;
 class CatalogData;
 class CatalogEntryData;
@@ -38,11 +45,19 @@ class CatalogEntryData;
  *    hence, the uid is a qint64 i.e. a 64 bit signed integer. Coincidentally,
  *    this is the max limit of an int in Sqlite3.
  *    Hence, the db is compatible with the uid, but doesn't use it as of now.
+ * 2) Every DSO row carries the id of the HTM trixel (at CatalogDB::HTM_LEVEL)
+ *    containing its stored coordinates. The column is indexed so that region
+ *    queries only read the rows of the trixels covering the region.
  */
 
 class CatalogDB
 {
   public:
+    /** @short HTM level of the trixel ids stored in the DSO table (32768 trixels) */
+    static constexpr int HTM_LEVEL = 6;
+
+    CatalogDB();
+
     /**
      * @brief Initializes the database and sets up pointers to Catalog DB
      * Performs the following actions:
@@ -89,6 +104,12 @@ class CatalogDB
     /**
      * @short Add contents of custom catalog to the program database
      *
+     * The import runs in bulk mode: all rows are written inside a single
+     * transaction through prepared statements, and fuzzy duplicate matching
+     * is done against an in-memory spatial index of the DSO table instead of
+     * querying the table once per row. Progress is reported through
+     * KStarsData::progressText().
+     *
      * @p filename the name of the file containing the data to be read
      * @return true if catalog was successfully added
      */
@@ -133,6 +154,42 @@ class CatalogDB
                        QList<QPair<int, QString>> &object_names, CatalogComponent *catalog_pointer,
                        bool includeCatalogDesignation = true);
 
+    /**
+     * @brief Creates the objects of a catalog that lie within a circle on the sky
+     *
+     * Only the rows of the trixels covering the circle are read from the database.
+     * The objects are appended to @p sky_list and are owned by the caller.
+     *
+     * @param catalog_name Name of the catalog whose objects are needed.
+     * @param center J2000.0 center of the circle
+     * @param radius Radius of the circle in degrees
+     * @param faint_mag Objects fainter than this magnitude are skipped. Objects
+     * without a magnitude are always returned.
+     * @param sky_list List the objects are appended to
+     * @param catalog_pointer pointer to the catalogcomponent objects
+     * @param includeCatalogDesignation see GetAllObjects()
+     * @return number of objects appended
+     **/
+    int GetObjectsInCone(const QString &catalog_name, const SkyPoint &center, double radius, float faint_mag,
+                         QList<SkyObject *> &sky_list, CatalogComponent *catalog_pointer,
+                         bool includeCatalogDesignation = true);
+
+    /**
+     * @brief Creates the objects of a catalog that lie within a J2000.0 RA/Dec rectangle
+     *
+     * If @p ra_min is larger than @p ra_max, the rectangle wraps around RA 0h.
+     * See GetObjectsInCone() for ownership and magnitude handling.
+     *
+     * @param ra_min Lower RA bound in degrees
+     * @param ra_max Upper RA bound in degrees
+     * @param dec_min Lower Dec bound in degrees
+     * @param dec_max Upper Dec bound in degrees
+     * @return number of objects appended
+     **/
+    int GetObjectsInRect(const QString &catalog_name, double ra_min, double ra_max, double dec_min, double dec_max,
+                         float faint_mag, QList<SkyObject *> &sky_list, CatalogComponent *catalog_pointer,
+                         bool includeCatalogDesignation = true);
+
     /**
      * @brief Get information about the catalog like Prefix etc
      *
@@ -193,6 +250,13 @@ class CatalogDB
     void AddCatalog(const CatalogData &catalog_data);
 
   private:
+    /**
+     * @brief State shared by all rows of a bulk import: prepared insert
+     * queries and the spatial index used for fuzzy duplicate matching.
+     * Defined in catalogdb.cpp.
+     **/
+    class BulkImport;
+
     /**
      * @brief Used to add a cross referenced entry into the database
      *
@@ -201,9 +265,11 @@ class CatalogDB
      *
      * @param catalog_entry Data structure with entry details
      * @param catid Category ID in the database
+     * @param bulk Bulk import state, or nullptr to prepare the queries and
+     * look up duplicates in the database for this single entry
      * @return false if adding was unsuccessful
      **/
-    bool _AddEntry(const CatalogEntryData &catalog_entry, int catid);
+    bool _AddEntry(const CatalogEntryData &catalog_entry, int catid, BulkImport *bulk = nullptr);
 
     /**
      * @brief Database object for the sky object. Assigned and Initialized by Initialize()
@@ -259,4 +325,49 @@ class CatalogDB
      * @return void
      **/
     void FirstRun();
+
+    /**
+     * @brief Brings databases created by older versions up to date: adds and
+     * fills the DSO trixel column and creates the indexes used by fuzzy
+     * matching and region queries.
+     *
+     * @return void
+     **/
+    void UpgradeSchema();
+
+    /**
+     * @return the mesh used to compute DSO trixel ids, created on first use
+     **/
+    HTMesh *Mesh();
+
+    /**
+     * @brief Executes @p get_query, which must select the same columns as
+     * GetAllObjects(), and creates a SkyObject for each row.
+     *
+     * @param accept Optional filter called with the J2000.0 position and
+     * magnitude of each row. Rows it rejects are not created.
+     * @return number of objects appended to @p sky_list
+     **/
+    int BuildObjects(QSqlQuery &get_query, QList<SkyObject *> &sky_list, QList<QPair<int, QString>> *object_names,
+                     CatalogComponent *catalog_ptr, bool includeCatalogDesignation,
+                     const std::function<bool(const SkyPoint &, float)> &accept = nullptr);
+
+    /**
+     * @brief Returns the trixels covering a circle, widened for catalogs not in J2000.0.
+     * An empty list means the circle is too large to be worth constraining.
+     **/
+    QVector<int> CoveringTrixels(const QString &catalog_name, const SkyPoint &center, double radius);
+
+    /**
+     * @brief Selects the objects of a catalog in the given trixels (all of them if
+     * @p trixels is empty) and builds those accepted by @p accept
+     **/
+    int GetObjectsInTrixels(const QString &catalog_name, const QVector<int> &trixels, float faint_mag,
+                            QList<SkyObject *> &sky_list, CatalogComponent *catalog_pointer,
+                            bool includeCatalogDesignation, const std::function<bool(const SkyPoint &, float)> &accept);
+
+    /**
+     * @brief Mesh of level HTM_LEVEL used to compute trixel ids
+     **/
+    std::unique_ptr<HTMesh> mesh_;
 };
@@ -0,0 +1,318 @@
+/*  City index, searches the city databases without loading every city
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+*/
+
+#include "cityindex.h"
+
+#include "geolocation.h"
+#include "kstars_debug.h"
+#include "timezonerule.h"
+
+#include <QSqlError>
+#include <QSqlQuery>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// Earth radius used for distances between cities, in kilometers
+const double EARTH_RADIUS = 6378.135;
+
+double distance(double longitude1, double latitude1, double longitude2, double latitude2)
+{
+    const double lat1 = latitude1 * dms::DegToRad, lat2 = latitude2 * dms::DegToRad;
+    const double dLat = lat2 - lat1;
+    const double dLng = (longitude2 - longitude1) * dms::DegToRad;
+
+    const double a = sin(dLat / 2) * sin(dLat / 2) + cos(lat1) * cos(lat2) * sin(dLng / 2) * sin(dLng / 2);
+    return 2 * EARTH_RADIUS * atan2(sqrt(a), sqrt(1 - a));
+}
+}
+
+CityIndex::CityIndex(QMap<QString, TimeZoneRule> *rulebook) : m_Rulebook(rulebook)
+{
+}
+
+CityIndex::~CityIndex()
+{
+    qDeleteAll(m_Locations);
+}
+
+bool CityIndex::load(QSqlDatabase &citydb, bool readOnly)
+{
+    QSqlQuery get_query(citydb);
+    get_query.setForwardOnly(true);
+    if (!get_query.exec("SELECT Name, Province, Country, Latitude, Longitude, TZ, TZRule, Elevation FROM city"))
+    {
+        qCCritical(KSTARS) << get_query.lastError();
+        return false;
+    }
+
+    bool citiesFound = false;
+    // get_query.size() always returns -1 so we set citiesFound if at least one city is found
+    while (get_query.next())
+    {
+        citiesFound = true;
+
+        City city;
+        city.name      = get_query.value(0).toString();
+        city.province  = get_query.value(1).toString();
+        city.country   = get_query.value(2).toString();
+        city.latitude  = dms(get_query.value(3).toString()).Degrees();
+        city.longitude = dms(get_query.value(4).toString()).Degrees();
+        city.tz        = get_query.value(5).toDouble();
+        city.tzRule    = get_query.value(6).toString();
+        city.elevation = get_query.value(7).toDouble();
+        city.readOnly  = readOnly;
+        m_Cities.append(city);
+    }
+
+    m_Complete           = false;
+    m_NameIndexValid     = false;
+    m_LatitudeIndexValid = false;
+    return citiesFound;
+}
+
+int CityIndex::count() const
+{
+    int count = 0;
+    for (const City &city : m_Cities)
+    {
+        if (city.removed == false)
+            count++;
+    }
+    return count;
+}
+
+GeoLocation *CityIndex::materialize(City &city)
+{
+    if (city.location == nullptr)
+    {
+        city.location = new GeoLocation(dms(city.longitude), dms(city.latitude), city.name, city.province, city.country,
+                                        city.tz, &(*m_Rulebook)[city.tzRule], city.elevation, city.readOnly, 4);
+        m_Locations.append(city.location);
+    }
+    return city.location;
+}
+
+void CityIndex::assign(City &city, const GeoLocation *location)
+{
+    city.name      = location->name();
+    city.province  = location->province();
+    city.country   = location->country();
+    city.longitude = location->lng()->Degrees();
+    city.latitude  = location->lat()->Degrees();
+    city.tz        = location->TZ0();
+    city.elevation = location->elevation();
+    city.readOnly  = location->isReadOnly();
+    city.keysValid = false;
+}
+
+int CityIndex::indexOf(const GeoLocation *location) const
+{
+    for (int i = 0; i < m_Cities.size(); i++)
+    {
+        if (m_Cities[i].location == location && m_Cities[i].removed == false)
+            return i;
+    }
+    return -1;
+}
+
+void CityIndex::buildNameIndex()
+{
+    if (m_NameIndexValid)
+        return;
+
+    m_ByName.clear();
+    for (int i = 0; i < m_Cities.size(); i++)
+    {
+        City &city = m_Cities[i];
+        if (city.removed)
+            continue;
+
+        if (city.keysValid == false)
+        {
+            // Translated the same way as the GeoLocation, without creating it
+            const GeoLocation location(dms(city.longitude), dms(city.latitude), city.name, city.province, city.country,
+                                       city.tz, nullptr, city.elevation, city.readOnly, 4);
+            city.nameKey     = location.translatedName().toCaseFolded();
+            city.provinceKey = city.province.isEmpty() ? QString("") : location.translatedProvince().toCaseFolded();
+            city.countryKey  = location.translatedCountry().toCaseFolded();
+            city.keysValid   = true;
+        }
+        m_ByName.append(i);
+    }
+
+    std::sort(m_ByName.begin(), m_ByName.end(), [this](int a, int b)
+    {
+        return m_Cities.at(a).nameKey < m_Cities.at(b).nameKey;
+    });
+    m_NameIndexValid = true;
+}
+
+void CityIndex::buildLatitudeIndex()
+{
+    if (m_LatitudeIndexValid)
+        return;
+
+    m_ByLatitude.clear();
+    for (int i = 0; i < m_Cities.size(); i++)
+    {
+        if (m_Cities[i].removed == false)
+            m_ByLatitude.append(i);
+    }
+
+    std::sort(m_ByLatitude.begin(), m_ByLatitude.end(), [this](int a, int b)
+    {
+        return m_Cities.at(a).latitude < m_Cities.at(b).latitude;
+    });
+    m_LatitudeIndexValid = true;
+}
+
+QList<GeoLocation *> CityIndex::search(const QString &city, const QString &province, const QString &country)
+{
+    buildNameIndex();
+
+    const QString cityKey = city.toCaseFolded(), provinceKey = province.toCaseFolded(),
+                  countryKey = country.toCaseFolded();
+
+    // Names starting with the city key follow each other in the name index
+    auto first = std::lower_bound(m_ByName.begin(), m_ByName.end(), cityKey, [this](int index, const QString &key)
+    {
+        return m_Cities.at(index).nameKey < key;
+    });
+
+    QList<GeoLocation *> result;
+    for (auto it = first; it != m_ByName.end() && m_Cities[*it].nameKey.startsWith(cityKey); ++it)
+    {
+        City &record = m_Cities[*it];
+        if (record.provinceKey.startsWith(provinceKey) && record.countryKey.startsWith(countryKey))
+            result.append(materialize(record));
+    }
+    return result;
+}
+
+GeoLocation *CityIndex::find(const QString &city, const QString &province, const QString &country)
+{
+    for (GeoLocation *location : search(city, QString(), QString()))
+    {
+        if (location->translatedName() == city && (province.isEmpty() || location->translatedProvince() == province) &&
+                (country.isEmpty() || location->translatedCountry() == country))
+            return location;
+    }
+    return nullptr;
+}
+
+GeoLocation *CityIndex::nearest(double longitude, double latitude)
+{
+    buildLatitudeIndex();
+    if (m_ByLatitude.isEmpty())
+        return nullptr;
+
+    // Walk away from the given latitude on both sides, until the latitude difference alone
+    // is larger than the nearest distance found
+    auto start = std::lower_bound(m_ByLatitude.begin(), m_ByLatitude.end(), latitude, [this](int index, double value)
+    {
+        return m_Cities.at(index).latitude < value;
+    });
+
+    int above = start - m_ByLatitude.begin(), below = above - 1;
+    int nearest = -1;
+    double nearestDistance = 0;
+
+    while (above < m_ByLatitude.size() || below >= 0)
+    {
+        for (int *side : { &above, &below })
+        {
+            if (*side < 0 || *side >= m_ByLatitude.size())
+                continue;
+
+            const City &city = m_Cities[m_ByLatitude[*side]];
+            if (nearest >= 0 &&
+                    std::fabs(city.latitude - latitude) * dms::DegToRad * EARTH_RADIUS > nearestDistance)
+            {
+                // Cities further on this side are further away
+                *side = (side == &above) ? m_ByLatitude.size() : -1;
+                continue;
+            }
+
+            const double cityDistance = distance(city.longitude, city.latitude, longitude, latitude);
+            if (nearest < 0 || cityDistance < nearestDistance)
+            {
+                nearest         = m_ByLatitude[*side];
+                nearestDistance = cityDistance;
+            }
+            *side += (side == &above) ? 1 : -1;
+        }
+    }
+
+    return nearest >= 0 ? materialize(m_Cities[nearest]) : nullptr;
+}
+
+QList<GeoLocation *> &CityIndex::locations()
+{
+    if (m_Complete == false)
+    {
+        // Listed in database order, as they were before the index existed
+        QList<GeoLocation *> locations;
+        locations.reserve(m_Cities.size());
+        for (City &city : m_Cities)
+        {
+            if (city.removed == false)
+                locations.append(materialize(city));
+        }
+        m_Locations = locations;
+        m_Complete  = true;
+    }
+    return m_Locations;
+}
+
+void CityIndex::add(GeoLocation *location)
+{
+    City city;
+    assign(city, location);
+    for (auto it = m_Rulebook->constBegin(); it != m_Rulebook->constEnd(); ++it)
+    {
+        if (location->tzrule() == &it.value())
+        {
+            city.tzRule = it.key();
+            break;
+        }
+    }
+    city.location = location;
+    m_Cities.append(city);
+    m_Locations.append(location);
+
+    m_NameIndexValid     = false;
+    m_LatitudeIndexValid = false;
+}
+
+void CityIndex::update(GeoLocation *location)
+{
+    const int index = indexOf(location);
+    if (index < 0)
+        return;
+
+    assign(m_Cities[index], location);
+    m_NameIndexValid     = false;
+    m_LatitudeIndexValid = false;
+}
+
+void CityIndex::remove(GeoLocation *location)
+{
+    const int index = indexOf(location);
+    if (index < 0)
+        return;
+
+    m_Cities[index].removed  = true;
+    m_Cities[index].location = nullptr;
+    m_Locations.removeOne(location);
+
+    m_NameIndexValid     = false;
+    m_LatitudeIndexValid = false;
+}
@@ -0,0 +1,121 @@
+/*  City index, searches the city databases without loading every city
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+*/
+
+#pragma once
+
+#include <QList>
+#include <QMap>
+#include <QString>
+#include <QVector>
+
+class GeoLocation;
+class QSqlDatabase;
+class TimeZoneRule;
+
+/**
+ * @class CityIndex
+ * Index of the cities read from the city databases.
+ *
+ * Cities are kept as compact records, and a GeoLocation is only created when a city is
+ * returned to the caller. Searches use an index of the translated names sorted for prefix
+ * lookups, built on the first search, and nearest city lookups use an index sorted by
+ * latitude.
+ *
+ * The index owns the GeoLocation objects it returns.
+ */
+class CityIndex
+{
+    public:
+        /** @param rulebook daylight saving rules the cities refer to */
+        explicit CityIndex(QMap<QString, TimeZoneRule> *rulebook);
+        ~CityIndex();
+
+        /**
+         * @brief Read the cities of a city database.
+         * @param citydb open database.
+         * @param readOnly true if the cities cannot be edited.
+         * @return false if the database cannot be read, or has no city.
+         */
+        bool load(QSqlDatabase &citydb, bool readOnly);
+
+        /** @return number of cities */
+        int count() const;
+
+        /**
+         * @brief Find the cities whose translated name, province and country start with the given strings.
+         * The comparison is case insensitive, and empty strings match all cities.
+         * @return matching cities, in no particular order.
+         */
+        QList<GeoLocation *> search(const QString &city, const QString &province, const QString &country);
+
+        /**
+         * @return first city with the given translated name, province and country, or nullptr.
+         * Empty province or country match all cities.
+         */
+        GeoLocation *find(const QString &city, const QString &province, const QString &country);
+
+        /** @return city nearest to the given coordinates in degrees, or nullptr if there is no city */
+        GeoLocation *nearest(double longitude, double latitude);
+
+        /** @return all cities, creating the GeoLocation objects not created yet */
+        QList<GeoLocation *> &locations();
+
+        /** Add a city, the index takes ownership of it */
+        void add(GeoLocation *location);
+
+        /** Update the index after the name or the position of a city changed */
+        void update(GeoLocation *location);
+
+        /** Remove a city from the index, the caller takes ownership of it */
+        void remove(GeoLocation *location);
+
+    private:
+        struct City
+        {
+            QString name;
+            QString province;
+            QString country;
+            QString tzRule;
+            double longitude { 0 };
+            double latitude { 0 };
+            double tz { 0 };
+            double elevation { 0 };
+            bool readOnly { true };
+            bool removed { false };
+
+            // Case folded translations, set when the name index is built
+            QString nameKey;
+            QString provinceKey;
+            QString countryKey;
+            bool keysValid { false };
+
+            GeoLocation *location { nullptr };
+        };
+
+        // Create the GeoLocation of a city if needed
+        GeoLocation *materialize(City &city);
+        // Fill the record of a city from its GeoLocation
+        static void assign(City &city, const GeoLocation *location);
+        int indexOf(const GeoLocation *location) const;
+
+        void buildNameIndex();
+        void buildLatitudeIndex();
+
+        QMap<QString, TimeZoneRule> *m_Rulebook { nullptr };
+        QVector<City> m_Cities;
+        // Cities sorted by translated name key
+        QVector<int> m_ByName;
+        // Cities sorted by latitude
+        QVector<int> m_ByLatitude;
+        bool m_NameIndexValid { false };
+        bool m_LatitudeIndexValid { false };
+
+        QList<GeoLocation *> m_Locations;
+        // True when all cities have a GeoLocation
+        bool m_Complete { false };
+};
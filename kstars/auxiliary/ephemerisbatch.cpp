@@ -0,0 +1,75 @@
+/*  Batch computation of rise/set/transit times and altitude curves
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+*/
+
+#include "ephemerisbatch.h"
+
+#include "geolocation.h"
+#include "skyobjects/skyobject.h"
+
+#include <QtConcurrent>
+
+namespace EphemerisBatch
+{
+
+QVector<QVector<RiseSetTransit>> riseSetTransit(const QList<const SkyObject *> &objects,
+        const QVector<KStarsDateTime> &dates, const GeoLocation *geo)
+{
+    QVector<QVector<RiseSetTransit>> results(objects.size(), QVector<RiseSetTransit>(dates.size()));
+
+    QVector<int> indexes(dates.size());
+    for (int i = 0; i < indexes.size(); ++i)
+        indexes[i] = i;
+
+    // Each task writes a distinct column of the results, so no locking is needed
+    QtConcurrent::blockingMap(indexes, [&](int date)
+    {
+        const KStarsDateTime &dt = dates.at(date);
+        for (int i = 0; i < objects.size(); ++i)
+        {
+            const SkyObject *object = objects.at(i);
+            RiseSetTransit &result  = results[i][date];
+
+            result.rise            = object->riseSetTime(dt, geo, true, true);
+            result.set             = object->riseSetTime(dt, geo, false, true);
+            result.transit         = object->transitTime(dt, geo);
+            result.transitAltitude = object->transitAltitude(dt, geo).Degrees();
+        }
+    });
+
+    return results;
+}
+
+QVector<QVector<double>> altitudes(const QList<const SkyPoint *> &points, const KStarsDateTime &start, double step,
+                                   int count, const GeoLocation *geo)
+{
+    // The sidereal times are the same for every point
+    QVector<CachingDms> lst;
+    lst.reserve(count);
+    for (int i = 0; i < count; ++i)
+        lst.append(geo->GSTtoLST(start.addSecs(i * step).gst()));
+
+    QVector<QVector<double>> results(points.size());
+    QVector<int> indexes(points.size());
+    for (int i = 0; i < indexes.size(); ++i)
+        indexes[i] = i;
+
+    QtConcurrent::blockingMap(indexes, [&](int index)
+    {
+        SkyPoint p(*points.at(index));
+        QVector<double> &curve = results[index];
+        curve.resize(count);
+        for (int i = 0; i < count; ++i)
+        {
+            p.EquatorialToHorizontal(&lst.at(i), geo->lat());
+            curve[i] = p.alt().Degrees();
+        }
+    });
+
+    return results;
+}
+}
@@ -0,0 +1,67 @@
+/*  Batch computation of rise/set/transit times and altitude curves
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+*/
+
+#pragma once
+
+#include "kstarsdatetime.h"
+
+#include <QList>
+#include <QTime>
+#include <QVector>
+
+class GeoLocation;
+class SkyObject;
+class SkyPoint;
+
+/**
+ * @namespace EphemerisBatch
+ * Computes ephemerides of many objects at many dates concurrently.
+ *
+ * Work is split by date: each task handles every object for one date, so the
+ * per-date state (sidereal times, the private Earth used for solar system
+ * bodies) is computed once and shared by all objects of that date.
+ * The objects themselves are never modified.
+ */
+namespace EphemerisBatch
+{
+
+/** Rise, set and transit of one object on one date, in local time of the location */
+struct RiseSetTransit
+{
+    /// Invalid if the object does not rise or set on that date
+    QTime rise;
+    QTime set;
+    QTime transit;
+    /// Altitude at transit in degrees
+    double transitAltitude { 0 };
+};
+
+/**
+ * @short Compute rise, set and transit times of each object for each date
+ * @param objects objects to compute, solar system bodies included
+ * @param dates local dates and times as accepted by SkyObject::riseSetTime()
+ * @param geo location of the observer
+ * @return one vector per object, holding one entry per date
+ */
+QVector<QVector<RiseSetTransit>> riseSetTransit(const QList<const SkyObject *> &objects,
+        const QVector<KStarsDateTime> &dates, const GeoLocation *geo);
+
+/**
+ * @short Compute altitude curves of fixed equatorial positions
+ * The sidereal time of each sample is computed once and shared by all points,
+ * and the points are processed concurrently.
+ * @param points current equatorial positions
+ * @param start universal time of the first sample
+ * @param step interval between samples in seconds
+ * @param count number of samples
+ * @param geo location of the observer
+ * @return one vector of @p count altitudes in degrees per point
+ */
+QVector<QVector<double>> altitudes(const QList<const SkyPoint *> &points, const KStarsDateTime &start, double step,
+                                   int count, const GeoLocation *geo);
+}
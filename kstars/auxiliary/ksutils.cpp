@@ -27,6 +27,7 @@
 #include "Options.h"
 #include "starobject.h"
 #include "auxiliary/kspaths.h"
+#include "auxiliary/logwriter.h"
 
 #ifndef KSTARS_LITE
 #include <KMessageBox>
@@ -917,6 +918,7 @@ QString constGenetiveToAbbrev(const QString &genetive_)
 }
 
 QString Logging::_filename;
+LogWriter *Logging::_writer = nullptr;
 
 void Logging::UseFile()
 {
@@ -935,18 +937,35 @@ void Logging::UseFile()
         file.close();
     }
 
+    if (_writer == nullptr)
+    {
+        _writer = new LogWriter(_filename);
+        _writer->start(QThread::LowPriority);
+        qAddPostRoutine(Shutdown);
+    }
+
     qSetMessagePattern("[%{time yyyy-MM-dd h:mm:ss.zzz t} %{if-debug}DEBG%{endif}%{if-info}INFO%{endif}%{if-warning}WARN%{endif}%{if-critical}CRIT%{endif}%{if-fatal}FATL%{endif}] %{if-category}[%{category}]%{endif} - %{message}");
     qInstallMessageHandler(File);
 }
 
 void Logging::File(QtMsgType type, const QMessageLogContext &context, const QString &msg)
 {
-    QFile file(_filename);
-    if (file.open(QFile::Append | QIODevice::Text))
-    {
-        QTextStream stream(&file);
-        Write(stream, type, context, msg);
-    }
+    // Only formatted here, the writer thread does the file operations
+    QString line;
+    QTextStream stream(&line, QIODevice::WriteOnly);
+    Write(stream, type, context, msg);
+    _writer->append(line);
+
+    // The application aborts right after a fatal message
+    if (type == QtFatalMsg)
+        _writer->flush();
+}
+
+void Logging::Shutdown()
+{
+    qInstallMessageHandler(nullptr);
+    delete _writer;
+    _writer = nullptr;
 }
 
 void Logging::UseStdout()
@@ -45,6 +45,7 @@
 
 #include <cstddef>
 
+class LogWriter;
 class QFile;
 class QString;
 class QTextStream;
@@ -242,7 +243,9 @@ class Logging
 
     private:
         static QString _filename;
+        static LogWriter *_writer;
 
+        static void Shutdown();
         static void Disabled(QtMsgType type, const QMessageLogContext &context, const QString &msg);
         static void File(QtMsgType type, const QMessageLogContext &context, const QString &msg);
         static void Stdout(QtMsgType type, const QMessageLogContext &context, const QString &msg);
@@ -0,0 +1,152 @@
+/*  Asynchronous log file writer
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+*/
+
+#include "logwriter.h"
+
+#include <QDateTime>
+
+namespace
+{
+// Time the writer sleeps when there is nothing to write, in milliseconds
+const int IDLE_INTERVAL = 50;
+// Bytes written to the file at once at most
+const int MAX_BATCH_SIZE = 256 * 1024;
+}
+
+LogWriter::LogWriter(const QString &filename, int capacity, QObject *parent) : QThread(parent), m_Filename(filename),
+    m_File(filename)
+{
+    quint32 size = 2;
+    while (size < static_cast<quint32>(capacity))
+        size *= 2;
+
+    m_Slots.reset(new Slot[size]);
+    m_Mask = size - 1;
+    for (quint32 i = 0; i < size; i++)
+        m_Slots[i].sequence.storeRelease(i);
+
+    m_File.open(QFile::Append | QIODevice::Text);
+    m_Running.storeRelease(1);
+}
+
+LogWriter::~LogWriter()
+{
+    stop();
+    flush();
+}
+
+bool LogWriter::append(const QString &line)
+{
+    // Bounded multi-producer queue: each slot sequence tells whether the slot is free for the
+    // position being appended, or still holds a line from the previous round
+    quint32 position = m_Head.loadAcquire();
+    Slot *slot = nullptr;
+    forever
+    {
+        slot = &m_Slots[position & m_Mask];
+        const qint32 difference = static_cast<qint32>(slot->sequence.loadAcquire() - position);
+
+        if (difference == 0)
+        {
+            if (m_Head.testAndSetOrdered(position, position + 1, position))
+                break;
+        }
+        else if (difference < 0)
+        {
+            m_Dropped.fetchAndAddRelaxed(1);
+            m_TotalDropped.fetchAndAddRelaxed(1);
+            return false;
+        }
+        else
+            position = m_Head.loadAcquire();
+    }
+
+    slot->line = line;
+    slot->sequence.storeRelease(position + 1);
+    return true;
+}
+
+bool LogWriter::dequeue(QString &line)
+{
+    Slot &slot = m_Slots[m_Tail & m_Mask];
+    if (static_cast<qint32>(slot.sequence.loadAcquire() - (m_Tail + 1)) < 0)
+        return false;
+
+    line.swap(slot.line);
+    slot.line.clear();
+    slot.sequence.storeRelease(m_Tail + m_Mask + 1);
+    m_Tail++;
+    return true;
+}
+
+bool LogWriter::writeQueued()
+{
+    QMutexLocker locker(&m_WriteMutex);
+
+    QByteArray batch;
+    QString line;
+    while (batch.size() < MAX_BATCH_SIZE && dequeue(line))
+        batch += line.toUtf8();
+
+    const quint32 dropped = m_Dropped.fetchAndStoreRelaxed(0);
+    if (dropped > 0)
+        batch += QDateTime::currentDateTime().toString("[yyyy-MM-ddThh:mm:ss.zzz t WARN ] - ").toUtf8() +
+                 QByteArray::number(dropped) + " log messages dropped, the log buffer was full.\n";
+
+    if (batch.isEmpty())
+        return false;
+
+    if (m_File.isOpen())
+    {
+        m_File.write(batch);
+        m_File.flush();
+
+        if (m_MaxFileSize > 0 && m_File.size() > m_MaxFileSize)
+            rotate();
+    }
+
+    return true;
+}
+
+void LogWriter::rotate()
+{
+    m_File.close();
+
+    if (m_MaxRotatedFiles > 0)
+    {
+        QFile::remove(QString("%1.%2").arg(m_Filename).arg(m_MaxRotatedFiles));
+        for (int i = m_MaxRotatedFiles - 1; i > 0; i--)
+            QFile::rename(QString("%1.%2").arg(m_Filename).arg(i), QString("%1.%2").arg(m_Filename).arg(i + 1));
+        QFile::rename(m_Filename, m_Filename + ".1");
+    }
+
+    m_File.open(QFile::WriteOnly | QFile::Truncate | QIODevice::Text);
+}
+
+void LogWriter::flush()
+{
+    while (writeQueued())
+        ;
+}
+
+void LogWriter::stop()
+{
+    m_Running.storeRelease(0);
+    wait();
+}
+
+void LogWriter::run()
+{
+    while (m_Running.loadAcquire())
+    {
+        if (writeQueued() == false)
+            msleep(IDLE_INTERVAL);
+    }
+
+    flush();
+}
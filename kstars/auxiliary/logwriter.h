@@ -0,0 +1,104 @@
+/*  Asynchronous log file writer
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+*/
+
+#pragma once
+
+#include <QAtomicInteger>
+#include <QFile>
+#include <QMutex>
+#include <QScopedArrayPointer>
+#include <QThread>
+
+/**
+ * @class LogWriter
+ * Writes log lines to a file from a background thread.
+ *
+ * Any thread may append lines: they go into a bounded lock-free ring buffer, so logging never
+ * waits on the disk nor on other logging threads. The writer thread drains the buffer in batches
+ * into a file kept open, and rotates it once it grows past the maximum size.
+ *
+ * When the buffer is full, lines are dropped and counted. The count is reported in the log file
+ * with the next batch.
+ */
+class LogWriter : public QThread
+{
+    public:
+        /**
+         * @param filename log file, its previous content is kept.
+         * @param capacity number of lines the buffer holds, rounded up to a power of two.
+         */
+        explicit LogWriter(const QString &filename, int capacity = 8192, QObject *parent = nullptr);
+        ~LogWriter() override;
+
+        /**
+         * @brief Queue a line to be written, newline included. Lock-free, safe from any thread.
+         * @return false if the buffer is full and the line is dropped.
+         */
+        bool append(const QString &line);
+
+        /** Write the queued lines now from the calling thread, e.g. before the application aborts */
+        void flush();
+
+        /** Stop the writer thread once the queued lines are written */
+        void stop();
+
+        /** @return number of lines dropped since the writer was created */
+        quint32 dropped() const
+        {
+            return m_TotalDropped.loadAcquire();
+        }
+
+        /** Set the size in bytes above which the log file is rotated, 0 to never rotate */
+        void setMaxFileSize(qint64 size)
+        {
+            m_MaxFileSize = size;
+        }
+
+        /** Set how many rotated files, named filename.1, filename.2 and so on, are kept */
+        void setMaxRotatedFiles(int count)
+        {
+            m_MaxRotatedFiles = count;
+        }
+
+        const QString &filename() const
+        {
+            return m_Filename;
+        }
+
+    protected:
+        void run() override;
+
+    private:
+        struct Slot
+        {
+            QAtomicInteger<quint32> sequence;
+            QString line;
+        };
+
+        bool dequeue(QString &line);
+        // Write a batch of queued lines, returns false if there was nothing to write
+        bool writeQueued();
+        void rotate();
+
+        QString m_Filename;
+        QFile m_File;
+        qint64 m_MaxFileSize { 64 * 1024 * 1024 };
+        int m_MaxRotatedFiles { 3 };
+
+        QScopedArrayPointer<Slot> m_Slots;
+        quint32 m_Mask { 0 };
+        // Next position to append to, shared by the producers
+        QAtomicInteger<quint32> m_Head { 0 };
+        // Next position to write, only used with m_WriteMutex locked
+        quint32 m_Tail { 0 };
+
+        QAtomicInteger<quint32> m_Dropped { 0 };
+        QAtomicInteger<quint32> m_TotalDropped { 0 };
+        QAtomicInt m_Running { 0 };
+        QMutex m_WriteMutex;
+};
@@ -0,0 +1,132 @@
+/*  Binary snapshots of parsed data files
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+*/
+
+#include "snapshotcache.h"
+
+#include "kspaths.h"
+#include "kstars_debug.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include <cstring>
+
+namespace
+{
+const char SNAPSHOT_MAGIC[8] = { 'K', 'S', 'S', 'N', 'A', 'P', 'S', 'H' };
+// Version of the header layout, common to all snapshots
+const quint32 HEADER_VERSION = 1;
+// Magic, header version, snapshot version, then the source key
+const int KEY_SIZE    = 20;
+const int HEADER_SIZE = sizeof(SNAPSHOT_MAGIC) + 2 * sizeof(quint32) + KEY_SIZE;
+}
+
+SnapshotCache::SnapshotCache(const QString &name, const QStringList &sources, quint32 version) : m_Sources(sources),
+    m_Version(version)
+{
+    m_Filename = KSPaths::writableLocation(QStandardPaths::GenericCacheLocation) + "snapshots/" + name + ".bin";
+}
+
+QByteArray SnapshotCache::sourceKey() const
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    for (const QString &source : m_Sources)
+    {
+        QFile file(source);
+        if (file.open(QIODevice::ReadOnly) == false)
+            return QByteArray();
+
+        // A touched file is parsed again even if its content did not change
+        const QFileInfo info(source);
+        hash.addData(source.toUtf8());
+        hash.addData(QByteArray::number(info.size()));
+        hash.addData(QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+        if (hash.addData(&file) == false)
+            return QByteArray();
+    }
+
+    return hash.result();
+}
+
+void SnapshotCache::prepare(QDataStream &stream)
+{
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+}
+
+bool SnapshotCache::load()
+{
+    m_Key = sourceKey();
+    if (m_Key.isEmpty())
+        return false;
+
+    m_File.setFileName(m_Filename);
+    if (m_File.open(QIODevice::ReadOnly) == false || m_File.size() < HEADER_SIZE)
+        return false;
+
+    const uchar *mapped = m_File.map(0, m_File.size());
+    if (mapped == nullptr)
+        return false;
+
+    QByteArray header = QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), HEADER_SIZE);
+    QDataStream headerStream(header);
+    prepare(headerStream);
+
+    char magic[sizeof(SNAPSHOT_MAGIC)];
+    quint32 headerVersion = 0, version = 0;
+    QByteArray key(KEY_SIZE, 0);
+    headerStream.readRawData(magic, sizeof(magic));
+    headerStream >> headerVersion >> version;
+    headerStream.readRawData(key.data(), KEY_SIZE);
+
+    if (std::memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) != 0 || headerVersion != HEADER_VERSION || version != m_Version ||
+            key != m_Key)
+    {
+        qCDebug(KSTARS) << "Snapshot" << m_Filename << "is out of date.";
+        m_File.unmap(const_cast<uchar *>(mapped));
+        m_File.close();
+        return false;
+    }
+
+    // Read in place from the mapping, which lives as long as the file stays open
+    m_Data = QByteArray::fromRawData(reinterpret_cast<const char *>(mapped) + HEADER_SIZE, m_File.size() - HEADER_SIZE);
+    m_Stream.reset(new QDataStream(m_Data));
+    prepare(*m_Stream);
+    return true;
+}
+
+bool SnapshotCache::save(const QByteArray &data)
+{
+    if (m_Key.isEmpty())
+        m_Key = sourceKey();
+    if (m_Key.isEmpty())
+        return false;
+
+    QDir().mkpath(QFileInfo(m_Filename).absolutePath());
+
+    // Written to a temporary file first, so that a snapshot is never left half written
+    QSaveFile file(m_Filename);
+    if (file.open(QIODevice::WriteOnly) == false)
+    {
+        qCWarning(KSTARS) << "Unable to write snapshot" << m_Filename;
+        return false;
+    }
+
+    QDataStream stream(&file);
+    prepare(stream);
+    stream.writeRawData(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    stream << HEADER_VERSION << m_Version;
+    stream.writeRawData(m_Key.constData(), KEY_SIZE);
+    stream.writeRawData(data.constData(), data.size());
+
+    return file.commit();
+}
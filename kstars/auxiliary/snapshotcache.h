@@ -0,0 +1,112 @@
+/*  Binary snapshots of parsed data files
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QFile>
+#include <QStringList>
+
+#include <memory>
+
+/**
+ * @class SnapshotCache
+ * Caches the result of parsing data files in a binary snapshot, so that later runs can read
+ * it back instead of parsing the files again.
+ *
+ * The snapshot is stamped with the format version given by its user and with a hash of the
+ * path, size, modification time and content of its source files. It is ignored as soon as
+ * either changes, and written again after the next successful parse.
+ *
+ * The snapshot file is memory-mapped and read with a QDataStream. Records that can be streamed
+ * are most easily cached with loadOrParse():
+ * @code
+ * SnapshotCache cache("ngcic", QStringList(file_name), 1);
+ * QVector<Record> records = cache.loadOrParse<QVector<Record>>([&]() { return parse(file_name); });
+ * @endcode
+ */
+class SnapshotCache
+{
+    public:
+        /**
+         * @param name snapshot name, unique among snapshots.
+         * @param sources data files the snapshot is built from.
+         * @param version format version of the snapshot content, to be increased when it changes.
+         */
+        SnapshotCache(const QString &name, const QStringList &sources, quint32 version);
+
+        /** @return true if a snapshot matching the sources and the version was found, see stream() */
+        bool load();
+
+        /** @return stream over the snapshot content, valid after load() succeeded */
+        QDataStream &stream()
+        {
+            return *m_Stream;
+        }
+
+        /**
+         * @brief Write a new snapshot.
+         * @param data content of the snapshot, written with a stream set up by prepare().
+         * @return true if the snapshot was written.
+         */
+        bool save(const QByteArray &data);
+
+        /**
+         * @brief Read records from the snapshot, or parse them and write a new snapshot.
+         * A snapshot whose content cannot be read completely, e.g. a truncated one, is ignored.
+         * @param parse returns the records parsed from the sources, empty if parsing failed.
+         * Empty records are not written to the snapshot.
+         * @return the records read or parsed
+         */
+        template <typename Records, typename Parser>
+        Records loadOrParse(Parser parse)
+        {
+            Records records;
+            if (load())
+            {
+                stream() >> records;
+                if (stream().status() == QDataStream::Ok && records.isEmpty() == false)
+                    return records;
+                records = Records();
+            }
+
+            records = parse();
+            if (records.isEmpty() == false)
+            {
+                QByteArray data;
+                QDataStream out(&data, QIODevice::WriteOnly);
+                prepare(out);
+                out << records;
+                save(data);
+            }
+            return records;
+        }
+
+        /** Set up a stream to write or read snapshot content */
+        static void prepare(QDataStream &stream);
+
+        /** @return path of the snapshot file */
+        const QString &filename() const
+        {
+            return m_Filename;
+        }
+
+    private:
+        // Hash of the source files path, size, modification time and content, empty if a source cannot be read
+        QByteArray sourceKey() const;
+
+        QString m_Filename;
+        QStringList m_Sources;
+        quint32 m_Version { 0 };
+        QByteArray m_Key;
+
+        QFile m_File;
+        QByteArray m_Data;
+        std::unique_ptr<QDataStream> m_Stream;
+};
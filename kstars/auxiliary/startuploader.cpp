@@ -0,0 +1,312 @@
+/*  Startup loader, runs startup tasks according to their dependencies
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+*/
+
+#include "startuploader.h"
+
+#include "kstars_debug.h"
+#include "tracer.h"
+
+#include <QtConcurrent>
+
+StartupLoader::StartupLoader(const QString &title, QObject *parent) : QObject(parent), m_Title(title)
+{
+    m_Clock.start();
+}
+
+StartupLoader::~StartupLoader()
+{
+    waitForDone();
+}
+
+void StartupLoader::addTask(const QString &name, const std::function<bool()> &task, const QStringList &dependencies,
+                            Affinity affinity, bool essential)
+{
+    Task newTask;
+    newTask.name      = name;
+    newTask.function  = task;
+    newTask.affinity  = affinity;
+    newTask.essential = false;
+
+    for (const QString &dependency : dependencies)
+    {
+        int index = 0;
+        while (index < m_Tasks.size() && m_Tasks[index].name != dependency)
+            index++;
+
+        if (index < m_Tasks.size())
+            newTask.dependencies.append(index);
+        else
+            qCWarning(KSTARS) << "Startup task" << name << "depends on the undeclared task" << dependency;
+    }
+
+    m_Tasks.append(newTask);
+    if (essential)
+        markEssential(m_Tasks.size() - 1);
+}
+
+void StartupLoader::markEssential(int task)
+{
+    if (m_Tasks[task].essential)
+        return;
+
+    m_Tasks[task].essential = true;
+    for (int dependency : m_Tasks[task].dependencies)
+        markEssential(dependency);
+}
+
+bool StartupLoader::run()
+{
+    runUntilDone(true);
+
+    // The remaining tasks are scheduled from the event loop
+    if (isDone(false) == false)
+        QMetaObject::invokeMethod(this, "processCompletions", Qt::QueuedConnection);
+
+    checkFinished();
+    return m_FailedTask.isEmpty();
+}
+
+void StartupLoader::waitForDone()
+{
+    runUntilDone(false);
+    checkFinished();
+}
+
+void StartupLoader::runUntilDone(bool essentialOnly)
+{
+    if (m_Scheduling)
+        return;
+
+    m_Scheduling = true;
+    forever
+    {
+        applyCompletions();
+        if (isDone(essentialOnly))
+            break;
+
+        if (schedule(true) == false)
+        {
+            // Dependencies are declared first, so something is always running at this point
+            if (isRunning() == false)
+                break;
+            waitForCompletion();
+        }
+    }
+    m_Scheduling = false;
+}
+
+void StartupLoader::processCompletions()
+{
+    // A main thread task is processing events, only start the worker tasks now ready
+    if (m_Scheduling)
+    {
+        applyCompletions();
+        schedule(false);
+        return;
+    }
+
+    m_Scheduling = true;
+    forever
+    {
+        applyCompletions();
+        if (schedule(true) == false)
+            break;
+    }
+    m_Scheduling = false;
+
+    checkFinished();
+}
+
+bool StartupLoader::schedule(bool runMainTask)
+{
+    bool started = false;
+    int mainTask = -1;
+
+    for (int i = 0; i < m_Tasks.size(); i++)
+    {
+        Task &task = m_Tasks[i];
+        if (task.state != PENDING)
+            continue;
+
+        bool ready = true, failed = false;
+        for (int dependency : task.dependencies)
+        {
+            const State state = m_Tasks[dependency].state;
+            if (state == FAILED || state == SKIPPED)
+                failed = true;
+            else if (state != DONE)
+                ready = false;
+        }
+
+        if (failed)
+        {
+            task.state = SKIPPED;
+            if (task.essential && m_FailedTask.isEmpty())
+                m_FailedTask = task.name;
+            qCWarning(KSTARS) << "Startup task" << task.name << "skipped, a task it depends on failed.";
+            emit taskFinished(task.name, false);
+            started = true;
+        }
+        else if (ready && task.affinity == WORKER_THREAD)
+        {
+            task.state = RUNNING;
+            started = true;
+
+            const std::function<bool()> function = task.function;
+            const QString name = task.name;
+            QtConcurrent::run([this, i, function, name]()
+            {
+                const qint64 start = m_Clock.elapsed();
+                bool success = false;
+                {
+                    TraceZone zone(name, "startup");
+                    success = function();
+                }
+                const qint64 end = m_Clock.elapsed();
+
+                Completion completion;
+                completion.task     = i;
+                completion.success  = success;
+                completion.start    = start;
+                completion.duration = end - start;
+
+                QMutexLocker locker(&m_CompletionMutex);
+                m_Completions.append(completion);
+                m_CompletionCondition.wakeAll();
+                QMetaObject::invokeMethod(this, "processCompletions", Qt::QueuedConnection);
+            });
+        }
+        else if (ready && mainTask < 0)
+            mainTask = i;
+    }
+
+    // Worker tasks are started first, so that they run while the main thread is busy
+    if (runMainTask && mainTask >= 0)
+    {
+        Task &task = m_Tasks[mainTask];
+        task.state = RUNNING;
+
+        const qint64 start = m_Clock.elapsed();
+        bool success = false;
+        {
+            TraceZone zone(task.name, "startup");
+            success = task.function();
+        }
+        complete(mainTask, success, start, m_Clock.elapsed() - start);
+        started = true;
+    }
+
+    return started;
+}
+
+void StartupLoader::applyCompletions()
+{
+    QVector<Completion> completions;
+    {
+        QMutexLocker locker(&m_CompletionMutex);
+        completions.swap(m_Completions);
+    }
+
+    for (const Completion &completion : completions)
+        complete(completion.task, completion.success, completion.start, completion.duration);
+}
+
+void StartupLoader::waitForCompletion()
+{
+    QMutexLocker locker(&m_CompletionMutex);
+    while (m_Completions.isEmpty())
+        m_CompletionCondition.wait(&m_CompletionMutex);
+}
+
+void StartupLoader::complete(int task, bool success, qint64 start, qint64 duration)
+{
+    Task &completed    = m_Tasks[task];
+    completed.state    = success ? DONE : FAILED;
+    completed.start    = start;
+    completed.duration = duration;
+
+    if (success == false)
+    {
+        qCWarning(KSTARS) << "Startup task" << completed.name << "failed.";
+        if (completed.essential && m_FailedTask.isEmpty())
+            m_FailedTask = completed.name;
+    }
+
+    emit taskFinished(completed.name, success);
+}
+
+bool StartupLoader::isDone(bool essentialOnly) const
+{
+    for (const Task &task : m_Tasks)
+    {
+        if ((task.state == PENDING || task.state == RUNNING) && (task.essential || essentialOnly == false))
+            return false;
+    }
+    return true;
+}
+
+bool StartupLoader::isRunning() const
+{
+    for (const Task &task : m_Tasks)
+    {
+        if (task.state == RUNNING)
+            return true;
+    }
+    return false;
+}
+
+bool StartupLoader::isReady(const QString &name) const
+{
+    for (const Task &task : m_Tasks)
+    {
+        if (task.name == name)
+            return task.state == DONE;
+    }
+    return false;
+}
+
+void StartupLoader::checkFinished()
+{
+    if (m_Reported || isDone(false) == false)
+        return;
+
+    m_Reported = true;
+    qCInfo(KSTARS).noquote() << report();
+    emit finished();
+}
+
+QString StartupLoader::report() const
+{
+    QString report = QString("%1 timing:").arg(m_Title);
+    qint64 end = 0;
+
+    for (const Task &task : m_Tasks)
+    {
+        report += QString("\n  %1 %2").arg(task.name + ':', -32).arg(task.affinity == MAIN_THREAD ? "main  " : "worker");
+
+        switch (task.state)
+        {
+            case DONE:
+            case FAILED:
+                report += QString(" started at %1 ms, took %2 ms").arg(task.start, 6).arg(task.duration, 6);
+                if (task.state == FAILED)
+                    report += " (failed)";
+                end = qMax(end, task.start + task.duration);
+                break;
+            case SKIPPED:
+                report += " skipped";
+                break;
+            default:
+                report += " not completed";
+                break;
+        }
+    }
+
+    report += QString("\n  Total: %1 ms").arg(end);
+    return report;
+}
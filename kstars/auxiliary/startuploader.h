@@ -0,0 +1,133 @@
+/*  Startup loader, runs startup tasks according to their dependencies
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+*/
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QObject>
+#include <QStringList>
+#include <QVector>
+#include <QWaitCondition>
+
+#include <functional>
+
+/**
+ * @class StartupLoader
+ * Runs the tasks loading data at startup, in parallel where their dependencies allow it.
+ *
+ * Each task declares the tasks it depends on, and the thread it must run in. Worker tasks run on
+ * the global thread pool as soon as their dependencies are completed, while main thread tasks run
+ * one at a time in declaration order. Tasks depending on a failed task are skipped.
+ *
+ * run() returns once the essential tasks are completed. The other tasks complete in the
+ * background, taskFinished() tells when each of them is ready.
+ *
+ * The start time and duration of every task are logged once all tasks are completed.
+ */
+class StartupLoader : public QObject
+{
+        Q_OBJECT
+
+    public:
+        typedef enum { WORKER_THREAD, MAIN_THREAD } Affinity;
+
+        explicit StartupLoader(const QString &title, QObject *parent = nullptr);
+        /** Waits for the background tasks */
+        ~StartupLoader() override;
+
+        /**
+         * @brief Declare a task.
+         * @param name unique name, used for dependencies and in the timing report.
+         * @param task returns false on failure.
+         * @param dependencies names of the tasks to complete first, which must be declared already.
+         * @param affinity thread the task runs in.
+         * @param essential if false, run() does not wait for the task. Tasks an essential task depends on are essential.
+         */
+        void addTask(const QString &name, const std::function<bool()> &task, const QStringList &dependencies = QStringList(),
+                     Affinity affinity = WORKER_THREAD, bool essential = true);
+
+        /**
+         * @brief Run tasks until the essential ones are completed. Must be called from the main thread.
+         * @return false if an essential task failed or was skipped, see failedTask().
+         */
+        bool run();
+
+        /** Wait until all tasks are completed, including the background ones */
+        void waitForDone();
+
+        /** @return true if the task completed successfully */
+        bool isReady(const QString &name) const;
+
+        /** @return name of the first essential task that failed */
+        const QString &failedTask() const
+        {
+            return m_FailedTask;
+        }
+
+        /** @return start time and duration of the tasks in milliseconds, one task per line */
+        QString report() const;
+
+    signals:
+        /** Emitted in the main thread when a task completed, or was skipped */
+        void taskFinished(const QString &name, bool success);
+        /** Emitted in the main thread when all tasks completed */
+        void finished();
+
+    private slots:
+        void processCompletions();
+
+    private:
+        typedef enum { PENDING, RUNNING, DONE, FAILED, SKIPPED } State;
+
+        struct Task
+        {
+            QString name;
+            std::function<bool()> function;
+            QVector<int> dependencies;
+            Affinity affinity { WORKER_THREAD };
+            bool essential { true };
+            State state { PENDING };
+            qint64 start { -1 };
+            qint64 duration { -1 };
+        };
+
+        struct Completion
+        {
+            int task { -1 };
+            bool success { false };
+            qint64 start { 0 };
+            qint64 duration { 0 };
+        };
+
+        // Run tasks until they are all completed, or only the essential ones
+        void runUntilDone(bool essentialOnly);
+        // Start the worker tasks whose dependencies are completed, skip those depending on a failure,
+        // and run the next main thread task if requested. Returns false if nothing was started.
+        bool schedule(bool runMainTask);
+        void applyCompletions();
+        void waitForCompletion();
+        void complete(int task, bool success, qint64 start, qint64 duration);
+        bool isDone(bool essentialOnly) const;
+        bool isRunning() const;
+        void markEssential(int task);
+        void checkFinished();
+
+        QString m_Title;
+        QVector<Task> m_Tasks;
+        QString m_FailedTask;
+        QElapsedTimer m_Clock;
+        bool m_Reported { false };
+        // Set while tasks are scheduled, as main thread tasks may process events
+        bool m_Scheduling { false };
+
+        // Completions of worker tasks, not processed yet in the main thread
+        QMutex m_CompletionMutex;
+        QWaitCondition m_CompletionCondition;
+        QVector<Completion> m_Completions;
+};
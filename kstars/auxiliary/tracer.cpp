@@ -0,0 +1,214 @@
+/*  Performance tracer, records timed zones and exports them as a Chrome trace
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+*/
+
+#include "tracer.h"
+
+#include "kspaths.h"
+#include "kstars_debug.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QThread>
+
+namespace
+{
+// Events kept by each thread, the oldest are overwritten
+const int MAX_EVENTS_PER_THREAD = 65536;
+}
+
+QAtomicInt Tracer::_enabled;
+
+Tracer *Tracer::Instance()
+{
+    // Zones may be recorded from any thread, the first one creates the tracer
+    static Tracer tracer;
+    return &tracer;
+}
+
+Tracer::Tracer()
+{
+    m_Clock.start();
+}
+
+int Tracer::capacity()
+{
+    return MAX_EVENTS_PER_THREAD;
+}
+
+void Tracer::setEnabled(bool enabled)
+{
+    if (enabled && m_SaveOnExitRegistered == false && QCoreApplication::instance())
+    {
+        m_SaveOnExitRegistered = true;
+        qAddPostRoutine(SaveOnExit);
+    }
+
+    _enabled.storeRelease(enabled ? 1 : 0);
+    qCInfo(KSTARS) << "Performance tracing" << (enabled ? "enabled." : "disabled.");
+}
+
+void Tracer::SaveOnExit()
+{
+    if (isEnabled())
+        Instance()->saveToLogs();
+}
+
+Tracer::Buffer *Tracer::buffer()
+{
+    // Buffers are owned by the tracer, so that the events of finished threads can still be saved
+    thread_local Buffer *threadBuffer = nullptr;
+    if (threadBuffer == nullptr)
+    {
+        Buffer *newBuffer = new Buffer;
+        newBuffer->events.reserve(1024);
+
+        QThread *thread = QThread::currentThread();
+        if (QCoreApplication::instance() && thread == QCoreApplication::instance()->thread())
+            newBuffer->threadName = "Main";
+        else if (thread->objectName().isEmpty() == false)
+            newBuffer->threadName = thread->objectName();
+
+        QMutexLocker locker(&m_BuffersMutex);
+        newBuffer->thread = m_Buffers.size() + 1;
+        if (newBuffer->threadName.isEmpty())
+            newBuffer->threadName = QString("Thread %1").arg(newBuffer->thread);
+        m_Buffers.append(newBuffer);
+        threadBuffer = newBuffer;
+    }
+    return threadBuffer;
+}
+
+void Tracer::record(const Event &event)
+{
+    Buffer *threadBuffer = buffer();
+    QMutexLocker locker(&threadBuffer->mutex);
+
+    if (threadBuffer->events.size() < MAX_EVENTS_PER_THREAD)
+        threadBuffer->events.append(event);
+    else
+        threadBuffer->events[threadBuffer->next] = event;
+    threadBuffer->next = (threadBuffer->next + 1) % MAX_EVENTS_PER_THREAD;
+}
+
+void Tracer::complete(const char *name, const char *category, qint64 start)
+{
+    Event event;
+    event.name     = name;
+    event.category = category;
+    event.start    = start;
+    event.duration = now() - start;
+    record(event);
+}
+
+void Tracer::complete(const QString &name, const char *category, qint64 start)
+{
+    Event event;
+    event.dynamicName = name;
+    event.category    = category;
+    event.start       = start;
+    event.duration    = now() - start;
+    record(event);
+}
+
+void Tracer::instant(const QString &name, const char *category)
+{
+    if (isEnabled() == false)
+        return;
+
+    Event event;
+    event.dynamicName = name;
+    event.category    = category;
+    event.start       = now();
+    event.phase       = 'i';
+    record(event);
+}
+
+void Tracer::clear()
+{
+    QMutexLocker locker(&m_BuffersMutex);
+    for (Buffer *threadBuffer : m_Buffers)
+    {
+        QMutexLocker bufferLocker(&threadBuffer->mutex);
+        threadBuffer->events.clear();
+        threadBuffer->next = 0;
+    }
+}
+
+bool Tracer::save(const QString &filename)
+{
+    const qint64 pid = QCoreApplication::applicationPid();
+    QJsonArray events;
+
+    QMutexLocker locker(&m_BuffersMutex);
+    for (Buffer *threadBuffer : m_Buffers)
+    {
+        QMutexLocker bufferLocker(&threadBuffer->mutex);
+
+        QJsonObject threadName;
+        threadName["name"] = "thread_name";
+        threadName["ph"]   = "M";
+        threadName["pid"]  = pid;
+        threadName["tid"]  = threadBuffer->thread;
+        threadName["args"] = QJsonObject({{"name", threadBuffer->threadName}});
+        events.append(threadName);
+
+        // Oldest event first once the ring wrapped around
+        const int count = threadBuffer->events.size();
+        const int first = (count < MAX_EVENTS_PER_THREAD) ? 0 : threadBuffer->next;
+        for (int i = 0; i < count; i++)
+        {
+            const Event &event = threadBuffer->events.at((first + i) % count);
+
+            QJsonObject object;
+            object["name"] = event.name ? QString::fromUtf8(event.name) : event.dynamicName;
+            object["cat"]  = QString::fromUtf8(event.category);
+            object["ph"]   = QString(QChar(event.phase));
+            object["ts"]   = event.start;
+            object["pid"]  = pid;
+            object["tid"]  = threadBuffer->thread;
+            if (event.phase == 'X')
+                object["dur"] = event.duration;
+            else
+                object["s"] = "g";
+            events.append(object);
+        }
+    }
+    locker.unlock();
+
+    QJsonObject trace;
+    trace["traceEvents"]     = events;
+    trace["displayTimeUnit"] = "ms";
+
+    QSaveFile file(filename);
+    if (file.open(QIODevice::WriteOnly) == false)
+    {
+        qCWarning(KSTARS) << "Unable to write trace file" << filename;
+        return false;
+    }
+    file.write(QJsonDocument(trace).toJson(QJsonDocument::Compact));
+    return file.commit();
+}
+
+QString Tracer::saveToLogs()
+{
+    QString path = KSPaths::writableLocation(QStandardPaths::GenericDataLocation) + "logs/" +
+                   QDateTime::currentDateTime().toString("yyyy-MM-dd");
+    QDir().mkpath(path);
+
+    QString filename = path + "/trace_" + QDateTime::currentDateTime().toString("HH-mm-ss") + ".json";
+    if (save(filename) == false)
+        return QString();
+
+    qCInfo(KSTARS) << "Performance trace saved to" << filename;
+    return filename;
+}
@@ -0,0 +1,163 @@
+/*  Performance tracer, records timed zones and exports them as a Chrome trace
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+*/
+
+#pragma once
+
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+/**
+ * @class Tracer
+ * Records the time spent in zones of the code, to find performance regressions without rebuilding.
+ *
+ * Tracing is enabled at runtime. When disabled, a zone costs a single atomic load. When enabled,
+ * each thread records its events into its own ring buffer, which only keeps the most recent
+ * events of the thread.
+ *
+ * Events are saved in the Chrome trace event JSON format, which chrome://tracing and the Perfetto
+ * UI open.
+ *
+ * Zones are usually recorded with TraceZone:
+ * @code
+ * void FITSData::findStars()
+ * {
+ *     TraceZone zone("Detect stars", "fits");
+ *     ...
+ * }
+ * @endcode
+ */
+class Tracer
+{
+    public:
+        static Tracer *Instance();
+
+        /** @return true if events are recorded */
+        static bool isEnabled()
+        {
+            return _enabled.loadAcquire() != 0;
+        }
+
+        /** Start or stop recording events. Recorded events are kept when stopping, see save(). */
+        void setEnabled(bool enabled);
+
+        /** @return time elapsed since the tracer was created, in microseconds */
+        qint64 now() const
+        {
+            return m_Clock.nsecsElapsed() / 1000;
+        }
+
+        /**
+         * @brief Record a zone ending now.
+         * @param name zone name, which must be a string literal.
+         * @param category category of the zone, which must be a string literal.
+         * @param start start time of the zone, see now().
+         */
+        void complete(const char *name, const char *category, qint64 start);
+
+        /** Record a zone whose name is built at runtime */
+        void complete(const QString &name, const char *category, qint64 start);
+
+        /** Record a point in time, such as a state change */
+        void instant(const QString &name, const char *category);
+
+        /** Discard the recorded events */
+        void clear();
+
+        /**
+         * @brief Save the recorded events.
+         * @param filename JSON file to write.
+         * @return true if the file was written.
+         */
+        bool save(const QString &filename);
+
+        /** Save the recorded events in the log folder. @return path of the trace file, empty on failure. */
+        QString saveToLogs();
+
+        /** @return number of events recorded by each thread at most */
+        static int capacity();
+
+    private:
+        Tracer();
+
+        struct Event
+        {
+            // Either a string literal, or null when the name is built at runtime
+            const char *name { nullptr };
+            QString dynamicName;
+            const char *category { nullptr };
+            qint64 start { 0 };
+            qint64 duration { 0 };
+            char phase { 'X' };
+        };
+
+        struct Buffer
+        {
+            // Only contended while the events are saved
+            QMutex mutex;
+            QVector<Event> events;
+            // Index of the next event to write in the ring
+            int next { 0 };
+            int thread { 0 };
+            QString threadName;
+        };
+
+        // Buffer of the calling thread, created on first use
+        Buffer *buffer();
+        void record(const Event &event);
+
+        static QAtomicInt _enabled;
+        static void SaveOnExit();
+
+        QElapsedTimer m_Clock;
+        QMutex m_BuffersMutex;
+        QList<Buffer *> m_Buffers;
+        bool m_SaveOnExitRegistered { false };
+};
+
+/**
+ * @class TraceZone
+ * Records a zone of the code, from construction to destruction, if tracing is enabled.
+ */
+class TraceZone
+{
+    public:
+        TraceZone(const char *name, const char *category) : m_Name(name), m_Category(category)
+        {
+            if (Tracer::isEnabled())
+                m_Start = Tracer::Instance()->now();
+        }
+
+        TraceZone(const QString &name, const char *category) : m_DynamicName(name), m_Category(category)
+        {
+            if (Tracer::isEnabled())
+                m_Start = Tracer::Instance()->now();
+        }
+
+        ~TraceZone()
+        {
+            if (m_Start < 0)
+                return;
+
+            if (m_Name)
+                Tracer::Instance()->complete(m_Name, m_Category, m_Start);
+            else
+                Tracer::Instance()->complete(m_DynamicName, m_Category, m_Start);
+        }
+
+    private:
+        Q_DISABLE_COPY(TraceZone)
+
+        const char *m_Name { nullptr };
+        QString m_DynamicName;
+        const char *m_Category { nullptr };
+        qint64 m_Start { -1 };
+};
@@ -180,7 +180,7 @@ void LocationDialog::enqueueFilterCity()
         timer->setSingleShot(true);
         connect(timer, SIGNAL(timeout()), this, SLOT(filterCity()));
     }
-    timer->start(500);
+    timer->start(100);
 }
 
 void LocationDialog::filterCity()
@@ -196,21 +196,11 @@ void LocationDialog::filterCity()
     ld->AddCityButton->setEnabled(false);
     ld->UpdateButton->setEnabled(false);
 
-    foreach (GeoLocation *loc, data->getGeoList())
+    foreach (GeoLocation *loc,
+             data->searchLocations(ld->CityFilter->text(), ld->ProvinceFilter->text(), ld->CountryFilter->text()))
     {
-        QString sc(loc->translatedName());
-        QString ss(loc->translatedCountry());
-        QString sp = "";
-        if (!loc->province().isEmpty())
-            sp = loc->translatedProvince();
-
-        if (sc.startsWith(ld->CityFilter->text(), Qt::CaseInsensitive) &&
-                sp.startsWith(ld->ProvinceFilter->text(), Qt::CaseInsensitive) &&
-                ss.startsWith(ld->CountryFilter->text(), Qt::CaseInsensitive))
-        {
-            ld->GeoBox->addItem(loc->fullName());
-            filteredCityList.append(loc);
-        }
+        ld->GeoBox->addItem(loc->fullName());
+        filteredCityList.append(loc);
     }
 
     ld->GeoBox->sortItems();
@@ -416,7 +406,7 @@ bool LocationDialog::updateCity(CityOperation operation)
 
             //Add city to geoList...don't need to insert it alphabetically, since we always sort GeoList
             g = new GeoLocation(lng, lat, name, province, country, TZ, &KStarsData::Instance()->Rulebook[TZrule], Elevation);
-            KStarsData::Instance()->getGeoList().append(g);
+            KStarsData::Instance()->addLocation(g);
         }
         break;
 
@@ -453,6 +443,7 @@ bool LocationDialog::updateCity(CityOperation operation)
             g->setTZ0(TZ);
             g->setTZRule(&KStarsData::Instance()->Rulebook[TZrule]);
             g->setElevation(height);
+            KStarsData::Instance()->updateLocation(g);
 
         }
         break;
@@ -472,7 +463,7 @@ bool LocationDialog::updateCity(CityOperation operation)
             }
 
             filteredCityList.removeOne(g);
-            KStarsData::Instance()->getGeoList().removeOne(g);
+            KStarsData::Instance()->removeLocation(g);
             delete g;
             g = nullptr;
         }
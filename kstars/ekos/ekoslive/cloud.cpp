@@ -14,6 +14,7 @@
 #include "commands.h"
 #include "profileinfo.h"
 
+#include "fitsviewer/fitscompressor.h"
 #include "fitsviewer/fitsview.h"
 #include "fitsviewer/fitsdata.h"
 #include "fitsviewer/fpack.h"
@@ -191,7 +192,13 @@ void Cloud::asyncUpload()
         int isLossLess = 0;
         fpstate	fpvar;
         fp_init (&fpvar);
-        if (fp_pack(filepath.toLatin1().data(), compressedFile.toLatin1().data(), fpvar, &isLossLess) < 0)
+        int result = 0;
+        {
+            // Frames may be compressed in the background at the same time
+            QMutexLocker locker(&FITSCompressor::fpackMutex());
+            result = fp_pack(filepath.toLatin1().data(), compressedFile.toLatin1().data(), fpvar, &isLossLess);
+        }
+        if (result < 0)
         {
             if (filepath.startsWith(QDir::tempPath()))
                 QFile::remove(filepath);
@@ -133,6 +133,9 @@ enum COMMANDS
     OPTION_SET_IMAGE_TRANSFER,
     OPTION_SET_NOTIFICATIONS,
     OPTION_SET_CLOUD_STORAGE,
+    OPTION_SET_BINARY_TELEMETRY,
+    OPTION_SET_DELTA_TELEMETRY,
+    OPTION_SET_PROGRESSIVE_IMAGE,
 
     // Storage Options
     SET_BLOBS,
@@ -264,6 +267,9 @@ static QMap<COMMANDS, QString> const commands =
     {OPTION_SET_IMAGE_TRANSFER, "option_set_image_transfer"},
     {OPTION_SET_NOTIFICATIONS, "option_set_notifications"},
     {OPTION_SET_CLOUD_STORAGE, "option_set_cloud_storage"},
+    {OPTION_SET_BINARY_TELEMETRY, "option_set_binary_telemetry"},
+    {OPTION_SET_DELTA_TELEMETRY, "option_set_delta_telemetry"},
+    {OPTION_SET_PROGRESSIVE_IMAGE, "option_set_progressive_image"},
 
     {SET_BLOBS, "set_blobs"},
 
@@ -0,0 +1,190 @@
+/*  Ekos Live Client
+
+    Image Encoder
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "imageencoder.h"
+
+#include <QBuffer>
+#include <QJsonDocument>
+
+#include <cmath>
+#include <limits>
+
+namespace EkosLive
+{
+
+namespace
+{
+// Target transfer time of a complete image, and of a video frame, in seconds
+const double IMAGE_LATENCY = 1.0;
+const double FRAME_LATENCY = 0.1;
+// Preview width and quality of progressive images
+const int PREVIEW_WIDTH = 160;
+const int PREVIEW_QUALITY = 40;
+// Size of the refinement tiles in pixels
+const int TILE_SIZE = 256;
+// Lowest settings the link rate may lead to
+const int MIN_WIDTH = 160;
+const int MIN_QUALITY = 20;
+}
+
+ImageEncoder::ImageEncoder(QObject *parent) : QObject(parent)
+{
+    m_Writer.setFormat("jpg");
+}
+
+void ImageEncoder::setLinkRate(double bytesPerSecond)
+{
+    m_LinkRate.storeRelease(static_cast<int>(qBound(0.0, bytesPerSecond, double(std::numeric_limits<int>::max()))));
+}
+
+ImageEncoder::Settings ImageEncoder::adapt(const Settings &ceiling, const QSize &imageSize, double bytesPerPixel,
+        double bytesPerSecond, double latency)
+{
+    Settings settings;
+    settings.width   = qMin(ceiling.width, imageSize.width());
+    settings.quality = ceiling.quality;
+
+    if (bytesPerPixel <= 0 || bytesPerSecond <= 0 || imageSize.isEmpty())
+        return settings;
+
+    const double pixels    = settings.width * (double(settings.width) * imageSize.height() / imageSize.width());
+    const double predicted = pixels * bytesPerPixel * settings.quality / 100.0;
+    const double ratio     = bytesPerSecond * latency / predicted;
+    if (ratio >= 1)
+        return settings;
+
+    // Reduce the width first, the encoded size scales with the number of pixels
+    const double scale = qMax(std::sqrt(ratio), qMin(1.0, double(MIN_WIDTH) / settings.width));
+    settings.width = static_cast<int>(settings.width * scale);
+
+    // Then the quality, the size being roughly proportional to it
+    const double remaining = ratio / (scale * scale);
+    if (remaining < 1)
+        settings.quality = qMax(MIN_QUALITY, static_cast<int>(settings.quality * remaining));
+
+    return settings;
+}
+
+const QByteArray &ImageEncoder::encode(const QImage &image, int quality, double *bytesPerPixel)
+{
+    // Keeps the allocation unless the previous encoding is still referenced, e.g. queued for sending
+    const int capacity = m_Buffer.capacity();
+    m_Buffer.resize(0);
+    if (m_Buffer.capacity() < capacity)
+        m_Buffer.reserve(capacity);
+
+    QBuffer buffer(&m_Buffer);
+    buffer.open(QIODevice::WriteOnly);
+    m_Writer.setDevice(&buffer);
+    m_Writer.setQuality(quality);
+    m_Writer.write(image);
+    m_Writer.setDevice(nullptr);
+    buffer.close();
+
+    if (bytesPerPixel && image.width() > 0 && image.height() > 0 && quality > 0)
+    {
+        const double sample = m_Buffer.size() * 100.0 / quality / (double(image.width()) * image.height());
+        *bytesPerPixel = (*bytesPerPixel > 0) ? 0.7 * *bytesPerPixel + 0.3 * sample : sample;
+    }
+
+    return m_Buffer;
+}
+
+void ImageEncoder::emitImage(const QJsonObject &metadata, const QByteArray &image)
+{
+    emit newMetadata(QJsonDocument(metadata).toJson(QJsonDocument::Compact));
+    emit newImage(image);
+}
+
+void ImageEncoder::encodeImage(const QImage &image, const QJsonObject &metadata, int width, int quality,
+                               bool progressive, int generation)
+{
+    if (image.isNull())
+        return;
+
+    Settings ceiling;
+    ceiling.width   = width;
+    ceiling.quality = quality;
+    const Settings settings = adapt(ceiling, image.size(), m_ImageBytesPerPixel, m_LinkRate.loadAcquire(), IMAGE_LATENCY);
+
+    const QImage scaledImage = (settings.width < image.width()) ?
+                               image.scaledToWidth(settings.width, Qt::SmoothTransformation) : image;
+
+    if (progressive == false || scaledImage.width() <= PREVIEW_WIDTH)
+    {
+        emitImage(metadata, encode(scaledImage, settings.quality, &m_ImageBytesPerPixel));
+        return;
+    }
+
+    // Preview first, so that the user sees the frame at once
+    QJsonObject previewMetadata = metadata;
+    previewMetadata.insert("progressive", QJsonObject(
+    {
+        {"stage", "preview"},
+        {"width", scaledImage.width()},
+        {"height", scaledImage.height()}
+    }));
+    emitImage(previewMetadata, encode(scaledImage.scaledToWidth(PREVIEW_WIDTH), PREVIEW_QUALITY, nullptr));
+
+    // Then the refinement tiles, unless a newer image is pending
+    const int columns = (scaledImage.width() + TILE_SIZE - 1) / TILE_SIZE;
+    const int rows    = (scaledImage.height() + TILE_SIZE - 1) / TILE_SIZE;
+    const int count   = columns * rows;
+    int bytes = 0;
+    for (int index = 0; index < count; index++)
+    {
+        if (m_ImageGeneration.loadAcquire() != generation)
+            return;
+
+        const int x = (index % columns) * TILE_SIZE;
+        const int y = (index / columns) * TILE_SIZE;
+
+        QJsonObject tileMetadata =
+        {
+            {"uuid", metadata["uuid"]},
+            {
+                "progressive", QJsonObject(
+                {
+                    {"stage", "tile"},
+                    {"x", x},
+                    {"y", y},
+                    {"index", index},
+                    {"count", count}
+                })
+            }
+        };
+
+        const QRect rect(x, y, qMin(TILE_SIZE, scaledImage.width() - x), qMin(TILE_SIZE, scaledImage.height() - y));
+        const QByteArray &tile = encode(scaledImage.copy(rect), settings.quality, nullptr);
+        bytes += tile.size();
+        emitImage(tileMetadata, tile);
+    }
+
+    // Estimate from the whole refinement, tiles alone are too small to be representative
+    const double sample = bytes * 100.0 / settings.quality / (double(scaledImage.width()) * scaledImage.height());
+    m_ImageBytesPerPixel = (m_ImageBytesPerPixel > 0) ? 0.7 * m_ImageBytesPerPixel + 0.3 * sample : sample;
+}
+
+void ImageEncoder::encodeFrame(const QImage &frame, int width, int quality)
+{
+    if (frame.isNull() == false)
+    {
+        Settings ceiling;
+        ceiling.width   = width;
+        ceiling.quality = quality;
+        const Settings settings = adapt(ceiling, frame.size(), m_FrameBytesPerPixel, m_LinkRate.loadAcquire(), FRAME_LATENCY);
+
+        const QImage scaledFrame = (settings.width < frame.width()) ? frame.scaledToWidth(settings.width) : frame;
+        emit newImage(encode(scaledFrame, settings.quality, &m_FrameBytesPerPixel));
+    }
+
+    m_FrameBusy.storeRelease(0);
+}
+}
@@ -0,0 +1,115 @@
+/*  Ekos Live Client
+
+    Image Encoder
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QImage>
+#include <QImageWriter>
+#include <QJsonObject>
+#include <QObject>
+
+namespace EkosLive
+{
+/**
+ * @class ImageEncoder
+ * ImageEncoder JPEG-encodes images and video frames for the Ekos Live media channel.
+ *
+ * It is meant to live in its own thread, so that encoding never blocks the capture pipeline.
+ * The encoded size is adapted to the measured link rate: the width, then the quality, are reduced
+ * until the encoded data is expected to go through the link within a target latency.
+ *
+ * Progressive images are sent as a small preview first, followed by refinement tiles. Each binary
+ * message is preceded by its JSON metadata, whose "progressive" object describes the stage:
+ * - {"stage": "preview", "width", "height"}: the preview is to be stretched to width x height.
+ * - {"stage": "tile", "x", "y", "index", "count"}: tile to draw at x,y of the width x height image.
+ */
+class ImageEncoder : public QObject
+{
+        Q_OBJECT
+
+    public:
+        /** Encoding settings */
+        struct Settings
+        {
+            int width { 0 };
+            int quality { 0 };
+        };
+
+        explicit ImageEncoder(QObject *parent = nullptr);
+
+        /** Set the measured link rate in bytes per second, 0 if unknown. Thread-safe. */
+        void setLinkRate(double bytesPerSecond);
+
+        /**
+         * @brief Start a new image, cancelling the tiles of the previous one not sent yet. Thread-safe.
+         * @return the generation to pass to encodeImage()
+         */
+        int beginImage()
+        {
+            return m_ImageGeneration.fetchAndAddOrdered(1) + 1;
+        }
+
+        /**
+         * @brief Reserve the encoder for a video frame. Thread-safe.
+         * @return false if the previous frame is still being encoded, in which case the new frame should be dropped.
+         */
+        bool beginFrame()
+        {
+            return m_FrameBusy.testAndSetOrdered(0, 1);
+        }
+
+        /**
+         * @brief Reduce encoding settings so that the encoded image fits the link budget.
+         * @param ceiling best settings allowed, the width is also limited to the image width.
+         * @param imageSize size of the image to encode.
+         * @param bytesPerPixel estimated encoded bytes per pixel at quality 100, 0 if unknown.
+         * @param bytesPerSecond link rate, 0 if unknown.
+         * @param latency target transfer time in seconds.
+         */
+        static Settings adapt(const Settings &ceiling, const QSize &imageSize, double bytesPerPixel, double bytesPerSecond,
+                              double latency);
+
+    public slots:
+        /**
+         * @brief Encode an image and emit it with its metadata.
+         * @param width largest width allowed.
+         * @param quality best JPEG quality allowed.
+         * @param progressive send a preview followed by refinement tiles instead of a single image.
+         * @param generation value returned by beginImage().
+         */
+        void encodeImage(const QImage &image, const QJsonObject &metadata, int width, int quality, bool progressive,
+                         int generation);
+
+        /** Encode a video frame reserved with beginFrame() and emit it. */
+        void encodeFrame(const QImage &frame, int width, int quality);
+
+    signals:
+        void newMetadata(const QByteArray &metadata);
+        void newImage(const QByteArray &image);
+
+    private:
+        const QByteArray &encode(const QImage &image, int quality, double *bytesPerPixel);
+        void emitImage(const QJsonObject &metadata, const QByteArray &image);
+
+        QImageWriter m_Writer;
+        // Reused between encodings while its previous content is not referenced anymore
+        QByteArray m_Buffer;
+
+        QAtomicInt m_LinkRate { 0 };
+        QAtomicInt m_ImageGeneration { 0 };
+        QAtomicInt m_FrameBusy { 0 };
+
+        // Running estimates of encoded bytes per pixel, normalized to quality 100
+        double m_ImageBytesPerPixel { 0 };
+        double m_FrameBytesPerPixel { 0 };
+};
+}
@@ -12,6 +12,7 @@
 
 #include "media.h"
 #include "commands.h"
+#include "imageencoder.h"
 #include "profileinfo.h"
 
 #include "fitsviewer/fitsview.h"
@@ -31,8 +32,23 @@ Media::Media(Ekos::Manager * manager): m_Manager(manager)
     connect(&m_WebSocket, &QWebSocket::disconnected, this, &Media::onDisconnected);
     connect(&m_WebSocket, static_cast<void(QWebSocket::*)(QAbstractSocket::SocketError)>(&QWebSocket::error), this, &Media::onError);
 
+    connect(&m_WebSocket, &QWebSocket::bytesWritten, this, &Media::onBytesWritten);
+
     connect(this, &Media::newMetadata, this, &Media::uploadMetadata);
     connect(this, &Media::newImage, this, &Media::uploadImage);
+
+    m_Encoder = new ImageEncoder();
+    m_Encoder->moveToThread(&m_EncoderThread);
+    connect(&m_EncoderThread, &QThread::finished, m_Encoder, &QObject::deleteLater);
+    connect(m_Encoder, &ImageEncoder::newMetadata, this, &Media::uploadMetadata);
+    connect(m_Encoder, &ImageEncoder::newImage, this, &Media::uploadImage);
+    m_EncoderThread.start();
+}
+
+Media::~Media()
+{
+    m_EncoderThread.quit();
+    m_EncoderThread.wait();
 }
 
 void Media::connectServer()
@@ -89,6 +105,11 @@ void Media::onDisconnected()
 
     m_sendBlobs = true;
 
+    m_PendingBytes = 0;
+    m_BurstBytes = 0;
+    m_LinkRate = 0;
+    m_Encoder->setLinkRate(0);
+
     for (const QString &oneFile : temporaryFiles)
         QFile::remove(oneFile);
     temporaryFiles.clear();
@@ -107,6 +128,33 @@ void Media::onError(QAbstractSocket::SocketError error)
     }
 }
 
+void Media::onBytesWritten(qint64 bytes)
+{
+    m_PendingBytes = qMax<qint64>(0, m_PendingBytes - bytes);
+    if (m_PendingBytes > 0 || m_BurstBytes < MIN_RATE_SAMPLE_BYTES)
+        return;
+
+    // Bytes are written as fast as the link drains the socket buffers, so large bursts
+    // give a usable estimate of the link rate. Small ones would only measure local copies.
+    const double rate = m_BurstBytes * 1000.0 / qMax<qint64>(1, m_BurstTimer.elapsed());
+    m_LinkRate = (m_LinkRate > 0) ? 0.7 * m_LinkRate + 0.3 * rate : rate;
+    m_BurstBytes = 0;
+
+    m_Encoder->setLinkRate(m_LinkRate);
+}
+
+void Media::trackUpload(qint64 bytes)
+{
+    if (m_PendingBytes == 0)
+    {
+        m_BurstBytes = 0;
+        m_BurstTimer.start();
+    }
+
+    m_PendingBytes += bytes;
+    m_BurstBytes += bytes;
+}
+
 void Media::onTextReceived(const QString &message)
 {
     qCInfo(KSTARS_EKOS) << "Media Text Websocket Message" << message;
@@ -192,13 +240,6 @@ void Media::sendImage()
 
 void Media::upload(FITSView * view)
 {
-    QByteArray jpegData;
-    QBuffer buffer(&jpegData);
-    buffer.open(QIODevice::WriteOnly);
-    QImage scaledImage = view->getDisplayImage().scaledToWidth(m_Options[OPTION_SET_HIGH_BANDWIDTH] ? HB_WIDTH : HB_WIDTH / 2);
-    scaledImage.save(&buffer, "jpg", m_Options[OPTION_SET_HIGH_BANDWIDTH] ? HB_IMAGE_QUALITY : HB_IMAGE_QUALITY / 2);
-    buffer.close();
-
     const FITSData * imageData = view->getImageData();
     QString resolution = QString("%1x%2").arg(imageData->width()).arg(imageData->height());
     QString sizeBytes = KFormat().formatByteSize(imageData->size());
@@ -223,11 +264,16 @@ void Media::upload(FITSView * view)
         {"uuid", uuid},
     };
 
-    emit newMetadata(QJsonDocument(metadata).toJson(QJsonDocument::Compact));
-    emit newImage(jpegData);
-
-    //m_WebSocket.sendTextMessage(QJsonDocument(metadata).toJson(QJsonDocument::Compact));
-    //m_WebSocket.sendBinaryMessage(jpegData);
+    // Scaling and encoding take place in the encoder thread
+    const int width = m_Options[OPTION_SET_HIGH_BANDWIDTH] ? HB_WIDTH : HB_WIDTH / 2;
+    const int quality = m_Options[OPTION_SET_HIGH_BANDWIDTH] ? HB_IMAGE_QUALITY : HB_IMAGE_QUALITY / 2;
+    QMetaObject::invokeMethod(m_Encoder, "encodeImage", Qt::QueuedConnection,
+                              Q_ARG(QImage, view->getDisplayImage()),
+                              Q_ARG(QJsonObject, metadata),
+                              Q_ARG(int, width),
+                              Q_ARG(int, quality),
+                              Q_ARG(bool, m_Options[OPTION_SET_PROGRESSIVE_IMAGE]),
+                              Q_ARG(int, m_Encoder->beginImage()));
 
     if (view == previewImage.get())
         previewImage.reset();
@@ -265,7 +311,7 @@ void Media::sendUpdatedFrame(FITSView * view)
     displayPixmap.save(&buffer, "jpg", m_Options[OPTION_SET_HIGH_BANDWIDTH] ? HB_PAH_IMAGE_QUALITY : HB_PAH_IMAGE_QUALITY / 2);
     buffer.close();
 
-    m_WebSocket.sendBinaryMessage(jpegData);
+    trackUpload(m_WebSocket.sendBinaryMessage(jpegData));
 }
 
 void Media::sendVideoFrame(std::shared_ptr<QImage> frame)
@@ -273,31 +319,16 @@ void Media::sendVideoFrame(std::shared_ptr<QImage> frame)
     if (m_isConnected == false || m_Options[OPTION_SET_IMAGE_TRANSFER] == false || m_sendBlobs == false || !frame)
         return;
 
-    int32_t width = m_Options[OPTION_SET_HIGH_BANDWIDTH] ? HB_WIDTH : HB_WIDTH / 2;
-
-    // TODO Scale should be configurable
-    QImage oneFrame;
-    if (frame.get()->width() > width)
-        oneFrame = frame.get()->scaledToWidth(width);
-
-    QByteArray array;
-    QBuffer buffer(&array);
-    QImageWriter writer;
-    writer.setDevice(&buffer);
-    writer.setFormat("JPEG");
-    writer.setCompression(7);
-    writer.write(oneFrame);
-    m_WebSocket.sendBinaryMessage(array);
-    //    QTemporaryFile jpegFile;
-    //    jpegFile.open();
-    //    jpegFile.close();
-
-    //    // TODO Quality should be configurable
-    //    scaledImage.save(jpegFile.fileName(), "jpg", m_Options[OPTION_SET_HIGH_BANDWIDTH] ? HB_VIDEO_QUALITY : HB_VIDEO_QUALITY / 2);
-
-    //    jpegFile.open();
+    // Drop the frame rather than queueing it while the link or the encoder cannot keep up
+    if (m_PendingBytes > MAX_PENDING_FRAME_BYTES || m_Encoder->beginFrame() == false)
+        return;
 
-    //m_WebSocket.sendBinaryMessage(jpegFile.readAll());
+    const int width = m_Options[OPTION_SET_HIGH_BANDWIDTH] ? HB_WIDTH : HB_WIDTH / 2;
+    const int quality = m_Options[OPTION_SET_HIGH_BANDWIDTH] ? HB_VIDEO_QUALITY : HB_VIDEO_QUALITY / 2;
+    QMetaObject::invokeMethod(m_Encoder, "encodeFrame", Qt::QueuedConnection,
+                              Q_ARG(QImage, *frame),
+                              Q_ARG(int, width),
+                              Q_ARG(int, quality));
 }
 
 void Media::registerCameras()
@@ -321,12 +352,12 @@ void Media::resetPolarView()
 
 void Media::uploadMetadata(const QByteArray &metadata)
 {
-    m_WebSocket.sendTextMessage(metadata);
+    trackUpload(m_WebSocket.sendTextMessage(metadata));
 }
 
 void Media::uploadImage(const QByteArray &image)
 {
-    m_WebSocket.sendBinaryMessage(image);
+    trackUpload(m_WebSocket.sendBinaryMessage(image));
 }
 
 void Media::processNewBLOB(IBLOB *bp)
@@ -13,6 +13,8 @@
 #pragma once
 
 #include <QtWebSockets/QWebSocket>
+#include <QElapsedTimer>
+#include <QThread>
 #include <memory>
 
 #include "ekos/ekos.h"
@@ -22,13 +24,15 @@ class FITSView;
 
 namespace EkosLive
 {
+class ImageEncoder;
+
 class Media : public QObject
 {
         Q_OBJECT
 
     public:
         explicit Media(Ekos::Manager * manager);
-        virtual ~Media() = default;
+        virtual ~Media();
 
         void sendResponse(const QString &command, const QJsonObject &payload);
         void sendResponse(const QString &command, const QJsonArray &payload);
@@ -87,6 +91,7 @@ class Media : public QObject
         void onConnected();
         void onDisconnected();
         void onError(QAbstractSocket::SocketError error);
+        void onBytesWritten(qint64 bytes);
 
         // Communication
         void onTextReceived(const QString &message);
@@ -101,6 +106,7 @@ class Media : public QObject
 
     private:
         void upload(FITSView * view);
+        void trackUpload(qint64 bytes);
 
         QWebSocket m_WebSocket;
         QJsonObject m_AuthResponse;
@@ -119,6 +125,16 @@ class Media : public QObject
         bool m_isConnected { false };
         bool m_sendBlobs { true};
 
+        // Images and video frames are encoded in a dedicated thread
+        QThread m_EncoderThread;
+        ImageEncoder *m_Encoder { nullptr };
+
+        // Link rate measurement: bytes queued on the socket since it was last drained
+        qint64 m_PendingBytes { 0 };
+        qint64 m_BurstBytes { 0 };
+        QElapsedTimer m_BurstTimer;
+        double m_LinkRate { 0 };
+
         // Image width for high-bandwidth setting
         static const uint16_t HB_WIDTH = 640;
         // Image high bandwidth image quality (jpg)
@@ -129,6 +145,10 @@ class Media : public QObject
         static const uint8_t HB_PAH_IMAGE_QUALITY = 50;
         // Video high bandwidth video quality (jpg) for PAH
         static const uint8_t HB_PAH_VIDEO_QUALITY = 25;
+        // Video frames are dropped while more bytes are waiting to be sent
+        static const uint32_t MAX_PENDING_FRAME_BYTES = 256 * 1024;
+        // Smallest drained burst used to measure the link rate
+        static const uint32_t MIN_RATE_SAMPLE_BYTES = 16 * 1024;
 
         // Retry every 5 seconds in case remote server is down
         static const uint16_t RECONNECT_INTERVAL = 5000;
@@ -26,12 +26,18 @@
 namespace EkosLive
 {
 
-Message::Message(Ekos::Manager *manager): m_Manager(manager)
+Message::Message(Ekos::Manager *manager): m_Telemetry(&m_WebSocket), m_Manager(manager)
 {
     connect(&m_WebSocket, &QWebSocket::connected, this, &Message::onConnected);
     connect(&m_WebSocket, &QWebSocket::disconnected, this, &Message::onDisconnected);
     connect(&m_WebSocket, static_cast<void(QWebSocket::*)(QAbstractSocket::SocketError)>(&QWebSocket::error), this, &Message::onError);
 
+    // Fields the client reads together
+    m_Telemetry.addFieldGroup(commands[NEW_FOCUS_STATE], QStringList() << "hfr" << "pos");
+    m_Telemetry.addFieldGroup(commands[NEW_GUIDE_STATE], QStringList() << "rarms" << "derms");
+    m_Telemetry.addFieldGroup(commands[NEW_MOUNT_STATE], QStringList() << "ra" << "de" << "az" << "at");
+    m_Telemetry.addFieldGroup(commands[NEW_CAPTURE_STATE], QStringList() << "seqv" << "seqr" << "seql");
+    m_Telemetry.addFieldGroup(commands[NEW_CAPTURE_STATE], QStringList() << "expv" << "expr");
 }
 
 void Message::connectServer()
@@ -69,6 +75,7 @@ void Message::onConnected()
 
     m_isConnected = true;
     m_ReconnectTries = 0;
+    m_Telemetry.reset();
 
     connect(&m_WebSocket, &QWebSocket::textMessageReceived,  this, &Message::onTextReceived);
 
@@ -464,7 +471,7 @@ void Message::sendTemperature(double value)
         {"temperature", value}
     };
 
-    sendResponse(commands[NEW_CAMERA_STATE], temperature);
+    m_Telemetry.update(commands[NEW_CAMERA_STATE], temperature, oneCCD->getDeviceName(), false);
 }
 
 void Message::sendFilterWheels()
@@ -941,6 +948,18 @@ void Message::processOptionsCommands(const QString &command, const QJsonObject &
         m_Options[OPTION_SET_NOTIFICATIONS] = payload["value"].toBool(true);
     else if (command == commands[OPTION_SET_CLOUD_STORAGE])
         m_Options[OPTION_SET_CLOUD_STORAGE] = payload["value"].toBool(false);
+    else if (command == commands[OPTION_SET_BINARY_TELEMETRY])
+    {
+        m_Options[OPTION_SET_BINARY_TELEMETRY] = payload["value"].toBool(false);
+        m_Telemetry.setEncoding(m_Options[OPTION_SET_BINARY_TELEMETRY] ? Telemetry::ENCODING_BINARY : Telemetry::ENCODING_JSON);
+    }
+    else if (command == commands[OPTION_SET_DELTA_TELEMETRY])
+    {
+        m_Options[OPTION_SET_DELTA_TELEMETRY] = payload["value"].toBool(false);
+        m_Telemetry.setDeltaEnabled(m_Options[OPTION_SET_DELTA_TELEMETRY]);
+    }
+    else if (command == commands[OPTION_SET_PROGRESSIVE_IMAGE])
+        m_Options[OPTION_SET_PROGRESSIVE_IMAGE] = payload["value"].toBool(false);
 
     emit optionsChanged(m_Options);
 }
@@ -998,7 +1017,7 @@ void Message::processDeviceCommands(const QString &command, const QJsonObject &p
     {
         QJsonObject propObject;
         if (oneDevice->getJSONProperty(payload["property"].toString(), propObject, payload["compact"].toBool(true)))
-            m_WebSocket.sendTextMessage(QJsonDocument({{"type", commands[DEVICE_PROPERTY_GET]}, {"payload", propObject}}).toJson(QJsonDocument::Compact));
+            m_Telemetry.trackMessage(m_WebSocket.sendTextMessage(QJsonDocument({{"type", commands[DEVICE_PROPERTY_GET]}, {"payload", propObject}}).toJson(QJsonDocument::Compact)));
     }
     // Set specific property
     else if (command == commands[DEVICE_PROPERTY_SET])
@@ -1016,7 +1035,7 @@ void Message::processDeviceCommands(const QString &command, const QJsonObject &p
                 properties.append(singleProp);
         }
 
-        m_WebSocket.sendTextMessage(QJsonDocument({{"type", commands[DEVICE_GET]}, {"payload", properties}}).toJson(QJsonDocument::Compact));
+        m_Telemetry.trackMessage(m_WebSocket.sendTextMessage(QJsonDocument({{"type", commands[DEVICE_GET]}, {"payload", properties}}).toJson(QJsonDocument::Compact)));
     }
     // Subscribe to one or more properties
     // When subscribed, the updates are immediately pushed as soon as they are received.
@@ -1032,22 +1051,22 @@ void Message::processDeviceCommands(const QString &command, const QJsonObject &p
 
 void Message::requestDSLRInfo(const QString &cameraName)
 {
-    m_WebSocket.sendTextMessage(QJsonDocument({{"type", commands[DSLR_GET_INFO]}, {"payload", cameraName}}).toJson(QJsonDocument::Compact));
+    m_Telemetry.trackMessage(m_WebSocket.sendTextMessage(QJsonDocument({{"type", commands[DSLR_GET_INFO]}, {"payload", cameraName}}).toJson(QJsonDocument::Compact)));
 }
 
 void Message::sendDialog(const QJsonObject &message)
 {
-    m_WebSocket.sendTextMessage(QJsonDocument({{"type", commands[DIALOG_GET_INFO]}, {"payload", message}}).toJson(QJsonDocument::Compact));
+    m_Telemetry.trackMessage(m_WebSocket.sendTextMessage(QJsonDocument({{"type", commands[DIALOG_GET_INFO]}, {"payload", message}}).toJson(QJsonDocument::Compact)));
 }
 
 void Message::sendResponse(const QString &command, const QJsonObject &payload)
 {
-    m_WebSocket.sendTextMessage(QJsonDocument({{"type", command}, {"payload", payload}}).toJson(QJsonDocument::Compact));
+    m_Telemetry.trackMessage(m_WebSocket.sendTextMessage(QJsonDocument({{"type", command}, {"payload", payload}}).toJson(QJsonDocument::Compact)));
 }
 
 void Message::sendResponse(const QString &command, const QJsonArray &payload)
 {
-    m_WebSocket.sendTextMessage(QJsonDocument({{"type", command}, {"payload", payload}}).toJson(QJsonDocument::Compact));
+    m_Telemetry.trackMessage(m_WebSocket.sendTextMessage(QJsonDocument({{"type", command}, {"payload", payload}}).toJson(QJsonDocument::Compact)));
 }
 
 void Message::updateMountStatus(const QJsonObject &status)
@@ -1055,7 +1074,7 @@ void Message::updateMountStatus(const QJsonObject &status)
     if (m_isConnected == false)
         return;
 
-    sendResponse(commands[NEW_MOUNT_STATE], status);
+    m_Telemetry.update(commands[NEW_MOUNT_STATE], status);
 }
 
 void Message::updateCaptureStatus(const QJsonObject &status)
@@ -1063,7 +1082,7 @@ void Message::updateCaptureStatus(const QJsonObject &status)
     if (m_isConnected == false)
         return;
 
-    sendResponse(commands[NEW_CAPTURE_STATE], status);
+    m_Telemetry.update(commands[NEW_CAPTURE_STATE], status);
 }
 
 void Message::updateFocusStatus(const QJsonObject &status)
@@ -1071,7 +1090,7 @@ void Message::updateFocusStatus(const QJsonObject &status)
     if (m_isConnected == false)
         return;
 
-    sendResponse(commands[NEW_FOCUS_STATE], status);
+    m_Telemetry.update(commands[NEW_FOCUS_STATE], status);
 }
 
 void Message::updateGuideStatus(const QJsonObject &status)
@@ -1079,7 +1098,7 @@ void Message::updateGuideStatus(const QJsonObject &status)
     if (m_isConnected == false)
         return;
 
-    sendResponse(commands[NEW_GUIDE_STATE], status);
+    m_Telemetry.update(commands[NEW_GUIDE_STATE], status);
 }
 
 void Message::updateDomeStatus(const QJsonObject &status)
@@ -1087,7 +1106,7 @@ void Message::updateDomeStatus(const QJsonObject &status)
     if (m_isConnected == false)
         return;
 
-    sendResponse(commands[NEW_DOME_STATE], status);
+    m_Telemetry.update(commands[NEW_DOME_STATE], status);
 }
 
 void Message::updateCapStatus(const QJsonObject &status)
@@ -1095,7 +1114,7 @@ void Message::updateCapStatus(const QJsonObject &status)
     if (m_isConnected == false)
         return;
 
-    sendResponse(commands[NEW_CAP_STATE], status);
+    m_Telemetry.update(commands[NEW_CAP_STATE], status);
 }
 
 void Message::sendConnection()
@@ -1196,7 +1215,7 @@ void Message::processNewNumber(INumberVectorProperty *nvp)
     {
         QJsonObject propObject;
         ISD::propertyToJson(nvp, propObject);
-        m_WebSocket.sendTextMessage(QJsonDocument({{"type", commands[DEVICE_PROPERTY_GET]}, {"payload", propObject}}).toJson(QJsonDocument::Compact));
+        m_Telemetry.update(commands[DEVICE_PROPERTY_GET], propObject, QString("%1.%2").arg(nvp->device, nvp->name), false);
     }
 }
 
@@ -1206,7 +1225,7 @@ void Message::processNewText(ITextVectorProperty *tvp)
     {
         QJsonObject propObject;
         ISD::propertyToJson(tvp, propObject);
-        m_WebSocket.sendTextMessage(QJsonDocument({{"type", commands[DEVICE_PROPERTY_GET]}, {"payload", propObject}}).toJson(QJsonDocument::Compact));
+        m_Telemetry.update(commands[DEVICE_PROPERTY_GET], propObject, QString("%1.%2").arg(tvp->device, tvp->name), false);
     }
 }
 
@@ -1216,7 +1235,7 @@ void Message::processNewSwitch(ISwitchVectorProperty *svp)
     {
         QJsonObject propObject;
         ISD::propertyToJson(svp, propObject);
-        m_WebSocket.sendTextMessage(QJsonDocument({{"type", commands[DEVICE_PROPERTY_GET]}, {"payload", propObject}}).toJson(QJsonDocument::Compact));
+        m_Telemetry.update(commands[DEVICE_PROPERTY_GET], propObject, QString("%1.%2").arg(svp->device, svp->name), false);
     }
 }
 
@@ -1226,7 +1245,7 @@ void Message::processNewLight(ILightVectorProperty *lvp)
     {
         QJsonObject propObject;
         ISD::propertyToJson(lvp, propObject);
-        m_WebSocket.sendTextMessage(QJsonDocument({{"type", commands[DEVICE_PROPERTY_GET]}, {"payload", propObject}}).toJson(QJsonDocument::Compact));
+        m_Telemetry.update(commands[DEVICE_PROPERTY_GET], propObject, QString("%1.%2").arg(lvp->device, lvp->name), false);
     }
 }
 
@@ -0,0 +1,377 @@
+/*  Ekos Live Client
+
+    Telemetry Channel
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "telemetry.h"
+
+#include "ekos_debug.h"
+
+#include <QDataStream>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QtWebSockets/QWebSocket>
+
+#include <cmath>
+#include <limits>
+
+namespace EkosLive
+{
+
+namespace
+{
+enum FieldTag : quint8
+{
+    TAG_NULL,
+    TAG_FALSE,
+    TAG_TRUE,
+    TAG_DOUBLE,
+    TAG_INT,
+    TAG_STRING,
+    TAG_JSON
+};
+
+const quint8 BINARY_VERSION = 1;
+
+void writeString16(QDataStream &stream, const QString &value)
+{
+    const QByteArray utf8 = value.toUtf8();
+    stream << static_cast<quint16>(utf8.size());
+    stream.writeRawData(utf8.constData(), utf8.size());
+}
+
+void writeString32(QDataStream &stream, const QByteArray &utf8)
+{
+    stream << static_cast<quint32>(utf8.size());
+    stream.writeRawData(utf8.constData(), utf8.size());
+}
+
+template <typename Length>
+bool readString(QDataStream &stream, QByteArray &utf8)
+{
+    Length length = 0;
+    stream >> length;
+    if (stream.status() != QDataStream::Ok || length > static_cast<quint64>(stream.device()->bytesAvailable()))
+        return false;
+    utf8.resize(static_cast<int>(length));
+    return stream.readRawData(utf8.data(), static_cast<int>(length)) == static_cast<int>(length);
+}
+}
+
+Telemetry::Telemetry(QWebSocket *socket, QObject *parent) : QObject(parent), m_Socket(socket)
+{
+    m_Timer.setSingleShot(true);
+    m_Timer.setInterval(DEFAULT_INTERVAL);
+    connect(&m_Timer, &QTimer::timeout, this, &Telemetry::flush);
+    connect(m_Socket, &QWebSocket::bytesWritten, this, &Telemetry::onBytesWritten);
+}
+
+void Telemetry::addFieldGroup(const QString &type, const QStringList &fields)
+{
+    m_Groups[type].append(fields);
+}
+
+void Telemetry::update(const QString &type, const QJsonObject &state, const QString &key, bool delta)
+{
+    const QString id = key.isEmpty() ? type : type + '/' + key;
+
+    auto latest = m_Latest.constFind(id);
+    bool queue = (latest == m_Latest.constEnd());
+
+    // A transition not sent yet must not be replaced by the next one
+    if (!queue && delta)
+    {
+        const QJsonObject &queuedState = m_Queued.at(latest.value()).state;
+        for (const QString &field : m_TransitionFields)
+        {
+            if (state.contains(field) && queuedState.contains(field))
+                queue = true;
+        }
+    }
+
+    if (queue)
+    {
+        Queued queued;
+        queued.id    = id;
+        queued.type  = type;
+        queued.state = state;
+        queued.delta = delta;
+        m_Queued.append(queued);
+        m_Latest.insert(id, m_Queued.size() - 1);
+    }
+    else
+    {
+        Queued &queued = m_Queued[latest.value()];
+        if (delta)
+        {
+            for (auto field = state.constBegin(); field != state.constEnd(); ++field)
+                queued.state.insert(field.key(), field.value());
+        }
+        else
+            queued.state = state;
+    }
+
+    if (!m_Timer.isActive())
+        m_Timer.start();
+}
+
+void Telemetry::flush()
+{
+    if (m_Queued.isEmpty() || m_Socket->state() != QAbstractSocket::ConnectedState)
+        return;
+
+    // Let the link drain first, queued states keep merging meanwhile
+    if (m_PendingBytes > m_MaxPendingBytes)
+    {
+        qCDebug(KSTARS_EKOS) << "Ekos Live telemetry deferred," << m_PendingBytes << "bytes pending.";
+        m_Timer.start();
+        return;
+    }
+
+    QList<Change> changes;
+    for (const Queued &queued : m_Queued)
+    {
+        QJsonObject &sent = m_Sent[queued.id];
+        QJsonObject payload;
+        const bool delta = queued.delta && m_DeltaEnabled;
+
+        if (delta)
+        {
+            for (auto field = queued.state.constBegin(); field != queued.state.constEnd(); ++field)
+            {
+                auto previous = sent.constFind(field.key());
+                if (previous == sent.constEnd() || previous.value() != field.value() ||
+                        m_TransitionFields.contains(field.key()))
+                    payload.insert(field.key(), field.value());
+            }
+
+            // Complete the groups of which a field changed
+            for (const QStringList &group : m_Groups.value(queued.type))
+            {
+                bool changed = false;
+                for (const QString &field : group)
+                    changed = changed || payload.contains(field);
+                if (!changed)
+                    continue;
+
+                for (const QString &field : group)
+                {
+                    if (payload.contains(field))
+                        continue;
+                    if (queued.state.contains(field))
+                        payload.insert(field, queued.state.value(field));
+                    else if (sent.contains(field))
+                        payload.insert(field, sent.value(field));
+                }
+            }
+
+            for (auto field = payload.constBegin(); field != payload.constEnd(); ++field)
+                sent.insert(field.key(), field.value());
+        }
+        else if (queued.delta)
+        {
+            // Sent as queued, the client expects each update in full
+            payload = queued.state;
+        }
+        else if (queued.state != sent)
+        {
+            payload = queued.state;
+            sent    = queued.state;
+        }
+
+        if (!payload.isEmpty())
+        {
+            Change change;
+            change.type    = queued.type;
+            change.payload = payload;
+            change.delta   = delta;
+            changes.append(change);
+        }
+    }
+
+    m_Queued.clear();
+    m_Latest.clear();
+
+    if (changes.isEmpty())
+        return;
+
+    if (m_Encoding == ENCODING_BINARY)
+        m_PendingBytes += m_Socket->sendBinaryMessage(encode(changes));
+    else
+    {
+        for (const Change &change : changes)
+        {
+            QJsonObject message({{"type", change.type}, {"payload", change.payload}});
+            if (change.delta)
+                message.insert("delta", true);
+            const QByteArray json = QJsonDocument(message).toJson(QJsonDocument::Compact);
+            m_PendingBytes += m_Socket->sendTextMessage(QString::fromUtf8(json));
+        }
+    }
+}
+
+void Telemetry::reset()
+{
+    m_Timer.stop();
+    m_Queued.clear();
+    m_Latest.clear();
+    m_Sent.clear();
+    m_PendingBytes = 0;
+}
+
+void Telemetry::onBytesWritten(qint64 bytes)
+{
+    m_PendingBytes = qMax<qint64>(0, m_PendingBytes - bytes);
+}
+
+QByteArray Telemetry::encode(const QList<Change> &changes)
+{
+    QByteArray frame;
+    QDataStream stream(&frame, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+
+    stream << BINARY_VERSION << static_cast<quint16>(changes.size());
+    for (const Change &change : changes)
+    {
+        writeString16(stream, change.type);
+        stream << static_cast<quint8>(change.delta ? 1 : 0) << static_cast<quint16>(change.payload.size());
+
+        for (auto field = change.payload.constBegin(); field != change.payload.constEnd(); ++field)
+        {
+            writeString16(stream, field.key());
+
+            const QJsonValue value = field.value();
+            switch (value.type())
+            {
+                case QJsonValue::Bool:
+                    stream << static_cast<quint8>(value.toBool() ? TAG_TRUE : TAG_FALSE);
+                    break;
+
+                case QJsonValue::Double:
+                {
+                    const double number = value.toDouble();
+                    if (std::floor(number) == number && number >= std::numeric_limits<qint32>::min() &&
+                            number <= std::numeric_limits<qint32>::max())
+                        stream << static_cast<quint8>(TAG_INT) << static_cast<qint32>(number);
+                    else
+                        stream << static_cast<quint8>(TAG_DOUBLE) << number;
+                }
+                break;
+
+                case QJsonValue::String:
+                    stream << static_cast<quint8>(TAG_STRING);
+                    writeString32(stream, value.toString().toUtf8());
+                    break;
+
+                case QJsonValue::Array:
+                    stream << static_cast<quint8>(TAG_JSON);
+                    writeString32(stream, QJsonDocument(value.toArray()).toJson(QJsonDocument::Compact));
+                    break;
+
+                case QJsonValue::Object:
+                    stream << static_cast<quint8>(TAG_JSON);
+                    writeString32(stream, QJsonDocument(value.toObject()).toJson(QJsonDocument::Compact));
+                    break;
+
+                default:
+                    stream << static_cast<quint8>(TAG_NULL);
+                    break;
+            }
+        }
+    }
+
+    return frame;
+}
+
+QList<Telemetry::Change> Telemetry::decode(const QByteArray &frame)
+{
+    QDataStream stream(frame);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+
+    quint8 version = 0;
+    quint16 count = 0;
+    stream >> version >> count;
+    if (stream.status() != QDataStream::Ok || version != BINARY_VERSION)
+        return QList<Change>();
+
+    QList<Change> changes;
+    for (int i = 0; i < count; i++)
+    {
+        Change change;
+        QByteArray utf8;
+        quint8 flags = 0;
+        quint16 fields = 0;
+
+        if (!readString<quint16>(stream, utf8))
+            return QList<Change>();
+        change.type = QString::fromUtf8(utf8);
+        stream >> flags >> fields;
+        change.delta = flags & 1;
+
+        for (int j = 0; j < fields; j++)
+        {
+            if (!readString<quint16>(stream, utf8))
+                return QList<Change>();
+            const QString name = QString::fromUtf8(utf8);
+
+            quint8 tag = TAG_NULL;
+            stream >> tag;
+            switch (tag)
+            {
+                case TAG_NULL:
+                    change.payload.insert(name, QJsonValue());
+                    break;
+                case TAG_FALSE:
+                case TAG_TRUE:
+                    change.payload.insert(name, tag == TAG_TRUE);
+                    break;
+                case TAG_DOUBLE:
+                {
+                    double number = 0;
+                    stream >> number;
+                    change.payload.insert(name, number);
+                }
+                break;
+                case TAG_INT:
+                {
+                    qint32 number = 0;
+                    stream >> number;
+                    change.payload.insert(name, number);
+                }
+                break;
+                case TAG_STRING:
+                    if (!readString<quint32>(stream, utf8))
+                        return QList<Change>();
+                    change.payload.insert(name, QString::fromUtf8(utf8));
+                    break;
+                case TAG_JSON:
+                {
+                    if (!readString<quint32>(stream, utf8))
+                        return QList<Change>();
+                    const QJsonDocument document = QJsonDocument::fromJson(utf8);
+                    if (document.isArray())
+                        change.payload.insert(name, document.array());
+                    else
+                        change.payload.insert(name, document.object());
+                }
+                break;
+                default:
+                    return QList<Change>();
+            }
+        }
+
+        if (stream.status() != QDataStream::Ok)
+            return QList<Change>();
+        changes.append(change);
+    }
+
+    return changes;
+}
+}
@@ -0,0 +1,192 @@
+/*  Ekos Live Client
+
+    Telemetry Channel
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include <QHash>
+#include <QJsonObject>
+#include <QObject>
+#include <QPair>
+#include <QStringList>
+#include <QTimer>
+
+class QWebSocket;
+
+namespace EkosLive
+{
+/**
+ * @class Telemetry
+ * Telemetry batches state updates sent over an Ekos Live websocket.
+ *
+ * Updates are queued per state and sent once per tick. Several updates of the same state within
+ * a tick are merged. Transition fields such as "status" are never merged nor skipped, so that every
+ * transition reaches the client. While the socket has more unsent bytes than allowed, nothing is
+ * sent and queued states keep being merged, so a slow link receives fewer and fresher updates
+ * instead of a growing backlog.
+ *
+ * Delta encoding is off by default, and each state is sent as it was queued. Clients that enable
+ * it, see setDeltaEnabled(), only receive the fields of delta states that changed since they were
+ * last sent. Fields of a group, see addFieldGroup(), are then sent together whenever one of them
+ * changed.
+ *
+ * With the JSON encoding each changed state is sent as a regular {"type", "payload"} text message,
+ * with an additional "delta": true when the payload only holds the changed fields. With the binary
+ * encoding all the changes of a tick are sent in one binary message, see encode().
+ */
+class Telemetry : public QObject
+{
+        Q_OBJECT
+
+    public:
+        typedef enum { ENCODING_JSON, ENCODING_BINARY } Encoding;
+
+        /** A state change as sent over the socket */
+        struct Change
+        {
+            QString type;
+            QJsonObject payload;
+            /// True if payload only holds the fields that changed
+            bool delta { true };
+        };
+
+        explicit Telemetry(QWebSocket *socket, QObject *parent = nullptr);
+
+        void setEncoding(Encoding encoding)
+        {
+            m_Encoding = encoding;
+        }
+        Encoding encoding() const
+        {
+            return m_Encoding;
+        }
+
+        /**
+         * @brief Enable or disable delta encoding, as negotiated with the client.
+         * The last sent states are forgotten, so the next update of each state is sent in full.
+         * Enabling it again thus also requests a full snapshot.
+         */
+        void setDeltaEnabled(bool enabled)
+        {
+            m_DeltaEnabled = enabled;
+            m_Sent.clear();
+        }
+        bool deltaEnabled() const
+        {
+            return m_DeltaEnabled;
+        }
+
+        /** Set the interval between two sends, in milliseconds */
+        void setInterval(int msecs)
+        {
+            m_Timer.setInterval(msecs);
+        }
+
+        /** Set the number of unsent socket bytes above which sending is deferred */
+        void setMaxPendingBytes(qint64 bytes)
+        {
+            m_MaxPendingBytes = bytes;
+        }
+
+        /**
+         * @brief Declare fields of a delta state that the client reads together.
+         * When any of them changed, all of them are sent.
+         * @param type message type, e.g. new_focus_state.
+         * @param fields names of the fields, e.g. hfr and pos.
+         */
+        void addFieldGroup(const QString &type, const QStringList &fields);
+
+        /**
+         * @brief Queue a state update, to be sent at the next tick.
+         * @param type message type, e.g. new_mount_state.
+         * @param state new state. A delta state is merged field by field with the previous updates,
+         * otherwise it replaces them.
+         * @param key distinguishes several states of the same type, e.g. the device name.
+         * @param delta if true and delta encoding is enabled, only the fields that changed since the
+         * last send are sent. If false, the complete state is sent whenever it changed.
+         */
+        void update(const QString &type, const QJsonObject &state, const QString &key = QString(), bool delta = true);
+
+        /** Send the queued changes now, unless the socket is congested. */
+        void flush();
+
+        /** Forget queued and sent states, e.g. after a reconnection. Everything is sent in full again. */
+        void reset();
+
+        /**
+         * @brief Account for a message sent on the socket by another sender.
+         * The socket reports written bytes for all messages, so every message must be accounted for,
+         * otherwise the pending bytes drift down and sending is never deferred.
+         * @param bytes size returned by QWebSocket::sendTextMessage() or sendBinaryMessage()
+         */
+        void trackMessage(qint64 bytes)
+        {
+            m_PendingBytes += bytes;
+        }
+
+        /** @return number of bytes handed to the socket and not written yet */
+        qint64 pendingBytes() const
+        {
+            return m_PendingBytes;
+        }
+
+        /** @return number of states waiting to be sent */
+        int queuedCount() const
+        {
+            return m_Latest.size();
+        }
+
+        /**
+         * @brief Encode changes in the binary format.
+         * All integers are little endian. A frame is:
+         * - uint8 version (1), uint16 number of changes, then for each change:
+         * - uint16 length + UTF-8 type, uint8 flags (bit 0: delta), uint16 number of fields, then for each field:
+         * - uint16 length + UTF-8 name, uint8 tag and value:
+         *   0 null, 1 false, 2 true, 3 float64, 4 int32, 5 uint32 length + UTF-8 string,
+         *   6 uint32 length + compact JSON for arrays and objects.
+         */
+        static QByteArray encode(const QList<Change> &changes);
+
+        /** @return changes decoded from a binary frame, or an empty list if the frame is invalid */
+        static QList<Change> decode(const QByteArray &frame);
+
+    private slots:
+        void onBytesWritten(qint64 bytes);
+
+    private:
+        struct Queued
+        {
+            QString id;
+            QString type;
+            QJsonObject state;
+            bool delta { true };
+        };
+
+        QWebSocket *m_Socket { nullptr };
+        QTimer m_Timer;
+        Encoding m_Encoding { ENCODING_JSON };
+        bool m_DeltaEnabled { false };
+        qint64 m_MaxPendingBytes { DEFAULT_MAX_PENDING_BYTES };
+        qint64 m_PendingBytes { 0 };
+
+        /// Queued states, in the order they were queued. A state is queued again for a new transition.
+        QList<Queued> m_Queued;
+        /// Index of the last queued state by identifier
+        QHash<QString, int> m_Latest;
+        /// Last sent state by identifier
+        QHash<QString, QJsonObject> m_Sent;
+        /// Field groups by message type
+        QHash<QString, QList<QStringList>> m_Groups;
+        /// Fields sent for every update
+        QStringList m_TransitionFields { "status" };
+
+        static const int DEFAULT_INTERVAL = 250;
+        static const qint64 DEFAULT_MAX_PENDING_BYTES = 64 * 1024;
+};
+}
@@ -21,6 +21,7 @@
 #include "auxiliary/darklibrary.h"
 #include "auxiliary/QProgressIndicator.h"
 #include "auxiliary/ksmessagebox.h"
+#include "auxiliary/tracer.h"
 #include "capture/sequencejob.h"
 #include "fitsviewer/fitstab.h"
 #include "fitsviewer/fitsview.h"
@@ -2232,6 +2233,10 @@ void Manager::initAlign()
     int index = toolsWidget->addTab(alignProcess.get(), QIcon(":/icons/ekos_align.png"), "");
     toolsWidget->tabBar()->setTabToolTip(index, i18n("Align"));
     connect(alignProcess.get(), &Ekos::Align::newLog, this, &Ekos::Manager::updateLog);
+    connect(alignProcess.get(), &Ekos::Align::newStatus, this, [](Ekos::AlignState status)
+    {
+        Tracer::Instance()->instant("Align: " + Ekos::getAlignStatusString(status), "ekos");
+    });
     if (Options::ekosLeftIcons())
     {
         QTransform trans;
@@ -2808,6 +2813,7 @@ void Manager::updateMountStatus(ISD::Telescope::Status status)
 
     mountStatus->setText(dynamic_cast<ISD::Telescope *>(managedDevices[KSTARS_TELESCOPE])->getStatusString(status));
     mountStatus->setStyleSheet(QString());
+    Tracer::Instance()->instant("Mount: " + mountStatus->text(), "ekos");
 
     switch (status)
     {
@@ -2866,6 +2872,7 @@ void Manager::updateMountCoords(const QString &ra, const QString &dec, const QSt
 void Manager::updateCaptureStatus(Ekos::CaptureState status)
 {
     captureStatus->setText(Ekos::getCaptureStatusString(status));
+    Tracer::Instance()->instant("Capture: " + captureStatus->text(), "ekos");
     captureProgress->setValue(captureProcess->getProgressPercentage());
 
     overallCountDown.setHMS(0, 0, 0);
@@ -3035,6 +3042,7 @@ void Manager::updateFocusProfilePixmap(QPixmap &profilePixmap)
 void Manager::setFocusStatus(Ekos::FocusState status)
 {
     focusStatus->setText(Ekos::getFocusStatusString(status));
+    Tracer::Instance()->instant("Focus: " + focusStatus->text(), "ekos");
 
     if (status >= Ekos::FOCUS_PROGRESS)
     {
@@ -3065,6 +3073,7 @@ void Manager::setFocusStatus(Ekos::FocusState status)
 void Manager::updateGuideStatus(Ekos::GuideState status)
 {
     guideStatus->setText(Ekos::getGuideStatusString(status));
+    Tracer::Instance()->instant("Guide: " + guideStatus->text(), "ekos");
 
     switch (status)
     {
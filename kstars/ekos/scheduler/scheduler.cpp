@@ -3106,8 +3106,14 @@ void Scheduler::checkProcessExit(int exitCode)
 
 bool Scheduler::checkStatus()
 {
+    // The current altitudes of all targets are computed in one batch
+    QList<SkyPoint> targets;
     for (auto job : jobs)
-        job->updateJobCells();
+        targets.append(job->getTargetCoords());
+    QVector<bool> settings;
+    QVector<double> const altitudes = SchedulerJob::findAltitudes(targets, QDateTime(), &settings);
+    for (int i = 0; i < jobs.size(); i++)
+        jobs.at(i)->updateJobCells(altitudes.at(i), settings.at(i));
 
     if (state == SCHEDULER_PAUSED)
     {
@@ -24,6 +24,20 @@
 #define BAD_SCORE -1000
 #define MIN_ALTITUDE 15.0
 
+namespace
+{
+// Whether a target with these apparent coordinates passed the meridian, hours being reduced to [0,24[
+bool passedMeridian(const CachingDms &LST, const SkyPoint &p)
+{
+    double offset = LST.Hours() - p.ra().Hours();
+    if (24.0 <= offset)
+        offset -= 24.0;
+    else if (offset < 0.0)
+        offset += 24.0;
+    return 0.0 <= offset && offset < 12.0;
+}
+}
+
 SchedulerJob::SchedulerJob()
 {
     moon = dynamic_cast<KSMoon *>(KStarsData::Instance()->skyComposite()->findByName(i18n("Moon")));
@@ -425,6 +439,13 @@ void SchedulerJob::setTargetCoords(dms &ra, dms &dec)
 }
 
 void SchedulerJob::updateJobCells()
+{
+    bool is_setting = false;
+    double const alt = (nullptr != altitudeCell) ? findAltitude(targetCoords, QDateTime(), &is_setting) : 0;
+    updateJobCells(alt, is_setting);
+}
+
+void SchedulerJob::updateJobCells(double altitude, bool is_setting)
 {
     if (nullptr != nameCell)
     {
@@ -538,13 +559,9 @@ void SchedulerJob::updateJobCells()
 
     if (nullptr != altitudeCell)
     {
-        // FIXME: Cache altitude calculations
-        bool is_setting = false;
-        double const alt = findAltitude(targetCoords, QDateTime(), &is_setting);
-
         altitudeCell->setText(QString("%1%L2°")
                               .arg(QChar(is_setting ? 0x2193 : 0x2191))
-                              .arg(alt, 0, 'f', 1));
+                              .arg(altitude, 0, 'f', 1));
 
         if (nullptr != altitudeCell->tableWidget())
             altitudeCell->tableWidget()->resizeColumnToContents(altitudeCell->column());
@@ -735,8 +752,8 @@ int16_t SchedulerJob::getAltitudeScore(QDateTime const &when) const
     o.setDec0(target.dec0());
 
     // Update RA/DEC of the target for the current fraction of the day
-    KSNumbers numbers(ltWhen.djd());
-    o.updateCoordsNow(&numbers);
+    std::shared_ptr<const KSNumbers> numbers = KSNumbers::cached(ltWhen.djd());
+    o.updateCoordsNow(numbers.get());
 
     // Compute local sidereal time for the current fraction of the day, calculate altitude
     CachingDms const LST = geo->GSTtoLST(geo->LTtoUT(ltWhen).gst());
@@ -807,15 +824,15 @@ int16_t SchedulerJob::getMoonSeparationScore(QDateTime const &when) const
     o.setDec0(target.dec0());
 
     // Update RA/DEC of the target for the current fraction of the day
-    KSNumbers numbers(ltWhen.djd());
-    o.updateCoordsNow(&numbers);
+    std::shared_ptr<const KSNumbers> numbers = KSNumbers::cached(ltWhen.djd());
+    o.updateCoordsNow(numbers.get());
 
     // Update moon
     //ut = geo->LTtoUT(ltWhen);
     //KSNumbers ksnum(ut.djd()); // BUG: possibly LT.djd() != UT.djd() because of translation
     //LST = geo->GSTtoLST(ut.gst());
     CachingDms LST = geo->GSTtoLST(geo->LTtoUT(ltWhen).gst());
-    moon->updateCoords(&numbers, true, geo->lat(), &LST, true);
+    moon->updateCoords(numbers.get(), true, geo->lat(), &LST, true);
 
     double const moonAltitude = moon->alt().Degrees();
 
@@ -881,15 +898,15 @@ double SchedulerJob::getCurrentMoonSeparation() const
     o.setDec0(target.dec0());
 
     // Update RA/DEC of the target for the current fraction of the day
-    KSNumbers numbers(ltWhen.djd());
-    o.updateCoordsNow(&numbers);
+    std::shared_ptr<const KSNumbers> numbers = KSNumbers::cached(ltWhen.djd());
+    o.updateCoordsNow(numbers.get());
 
     // Update moon
     //ut = geo->LTtoUT(ltWhen);
     //KSNumbers ksnum(ut.djd()); // BUG: possibly LT.djd() != UT.djd() because of translation
     //LST = geo->GSTtoLST(ut.gst());
     CachingDms LST = geo->GSTtoLST(geo->LTtoUT(ltWhen).gst());
-    moon->updateCoords(&numbers, true, geo->lat(), &LST, true);
+    moon->updateCoords(numbers.get(), true, geo->lat(), &LST, true);
 
     // Moon/Sky separation p
     return moon->angularDistanceTo(&o).Degrees();
@@ -922,8 +939,8 @@ QDateTime SchedulerJob::calculateAltitudeTime(QDateTime const &when) const
         KStarsDateTime const ltOffset(ltWhen.addSecs(minute * 60));
 
         // Update RA/DEC of the target for the current fraction of the day
-        KSNumbers numbers(ltOffset.djd());
-        o.updateCoordsNow(&numbers);
+        std::shared_ptr<const KSNumbers> numbers = KSNumbers::cached(ltOffset.djd());
+        o.updateCoordsNow(numbers.get());
 
         // Compute local sidereal time for the current fraction of the day, calculate altitude
         CachingDms const LST = geo->GSTtoLST(geo->LTtoUT(ltOffset).gst());
@@ -973,8 +990,8 @@ QDateTime SchedulerJob::calculateCulmination(QDateTime const &when) const
     o.setDec0(target.dec0());
 
     // Update RA/DEC for the argument date/time
-    KSNumbers numbers(ltWhen.djd());
-    o.updateCoordsNow(&numbers);
+    std::shared_ptr<const KSNumbers> numbers = KSNumbers::cached(ltWhen.djd());
+    o.updateCoordsNow(numbers.get());
 
     // Calculate transit date/time at the argument date - transitTime requires UT and returns LocalTime
     KStarsDateTime transitDateTime(ltWhen.date(), o.transitTime(geo->LTtoUT(ltWhen), geo), Qt::LocalTime);
@@ -1022,20 +1039,14 @@ double SchedulerJob::findAltitude(const SkyPoint &target, const QDateTime &when,
     o.setDec0(target.dec0());
 
     // Update RA/DEC of the target for the current fraction of the day
-    KSNumbers numbers(ltWhen.djd());
-    o.updateCoordsNow(&numbers);
+    std::shared_ptr<const KSNumbers> numbers = KSNumbers::cached(ltWhen.djd());
+    o.updateCoordsNow(numbers.get());
 
     // Calculate alt/az coordinates using KStars instance's geolocation
     CachingDms const LST = geo->GSTtoLST(geo->LTtoUT(ltWhen).gst());
     o.EquatorialToHorizontal(&LST, geo->lat());
 
-    // Hours are reduced to [0,24[, meridian being at 0
-    double offset = LST.Hours() - o.ra().Hours();
-    if (24.0 <= offset)
-        offset -= 24.0;
-    else if (offset < 0.0)
-        offset += 24.0;
-    bool const passed_meridian = 0.0 <= offset && offset < 12.0;
+    bool const passed_meridian = passedMeridian(LST, o);
 
     if (debug)
         qCDebug(KSTARS_EKOS_SCHEDULER) << QString("When:%9 LST:%8 RA:%1 RA0:%2 DEC:%3 DEC0:%4 alt:%5 setting:%6 HA:%7")
@@ -1054,3 +1065,35 @@ double SchedulerJob::findAltitude(const SkyPoint &target, const QDateTime &when,
 
     return o.alt().Degrees();
 }
+
+QVector<double> SchedulerJob::findAltitudes(const QList<SkyPoint> &targets, const QDateTime &when, QVector<bool> *is_setting)
+{
+    GeoLocation * const geo = KStarsData::Instance()->geo();
+
+    // Retrieve the argument date/time, or fall back to current time - don't use QDateTime's timezone!
+    KStarsDateTime ltWhen(when.isValid() ?
+                          Qt::UTC == when.timeSpec() ? geo->UTtoLT(KStarsDateTime(when)) : when :
+                          KStarsData::Instance()->lt());
+
+    // Bring the catalog coordinates of all targets to the argument time at once, as findAltitude() does for one
+    QVector<SkyPoint> points;
+    points.reserve(targets.size());
+    for (SkyPoint const &target : targets)
+        points.append(SkyPoint(target.ra0(), target.dec0()));
+
+    CachingDms const LST = geo->GSTtoLST(geo->LTtoUT(ltWhen).gst());
+    SkyPoint::apparentCoords(points, J2000L, ltWhen.djd(), &LST, geo->lat());
+
+    QVector<double> altitudes;
+    altitudes.reserve(points.size());
+    if (is_setting)
+        is_setting->clear();
+    for (SkyPoint const &p : points)
+    {
+        altitudes.append(p.alt().Degrees());
+        if (is_setting)
+            is_setting->append(passedMeridian(LST, p));
+    }
+
+    return altitudes;
+}
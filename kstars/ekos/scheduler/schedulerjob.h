@@ -13,6 +13,7 @@
 
 #include <QUrl>
 #include <QMap>
+#include <QVector>
 #include "ksmoon.h"
 
 class QTableWidgetItem;
@@ -334,6 +335,13 @@ class SchedulerJob
     /** @brief Refresh all cells connected to this SchedulerJob. */
     void updateJobCells();
 
+    /**
+     * @brief Refresh all cells connected to this SchedulerJob, with the current altitude of the target.
+     * @param altitude current altitude of the target, see findAltitudes().
+     * @param is_setting whether the target is currently setting.
+     */
+    void updateJobCells(double altitude, bool is_setting);
+
     /** @brief Resetting a job to original values:
      * - idle state and stage
      * - original startup, none if asap, else user original setting
@@ -433,6 +441,17 @@ class SchedulerJob
          */
     static double findAltitude(const SkyPoint &target, const QDateTime &when, bool *is_setting = nullptr, bool debug = false);
 
+    /**
+         * @brief findAltitudes Find the altitudes of several targets at the same time
+         * @param targets Targets, brought to the argument time in one batch
+         * @param when date time to find altitudes
+         * @param is_setting filled with whether each target is setting at the argument time (optional).
+         * @return Altitudes of the targets at the specific date and time given, in the order of the targets.
+         * @warning This function uses the current KStars geolocation.
+         */
+    static QVector<double> findAltitudes(const QList<SkyPoint> &targets, const QDateTime &when,
+                                         QVector<bool> *is_setting = nullptr);
+
 private:
     QString name;
     SkyPoint targetCoords;
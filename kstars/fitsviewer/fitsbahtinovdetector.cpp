@@ -25,6 +25,7 @@
 #include "hough/houghline.h"
 
 #include <QElapsedTimer>
+#include <QtConcurrent>
 
 FITSStarDetector &FITSBahtinovDetector::configure(const QString &setting, const QVariant &value)
 {
@@ -88,6 +89,148 @@ int FITSBahtinovDetector::findSources(QList<Edge*> &starCenters, QRect const &bo
     return 0;
 }
 
+namespace
+{
+// Minimum angle between two Bahtinov spikes, in degrees
+const int MIN_BAHTINOV_ANGLE_OFFSET = 18;
+// Angle steps of the coarse-to-fine search, in degrees, after the initial one degree step
+const double REFINE_STEPS[] = { 0.25, 0.05 };
+
+/**
+ * Radon projection of a bounded region of an image.
+ * For an angle, the pixels of the region are summed along the lines that would become the rows of
+ * the region rotated by that angle. This gives the row averages of the rotated region without
+ * resampling it. As with a rotation, only the pixels of the square inscribed in the circle inscribed
+ * in the region are used, so that the projection does not depend on the corners of the region.
+ */
+class RadonProjection
+{
+    public:
+        template <typename T>
+        RadonProjection(const T *buffer, int dataWidth, uint32_t samplesPerChannel, int channels, const QRect &region,
+                        int averageRows);
+
+        /** @return the line of maximum average pixel value at angle, in degrees */
+        BahtinovLineAverage maxAverage(double angle) const;
+
+    private:
+        int m_Width { 0 };
+        int m_Height { 0 };
+        int m_AverageRows { 1 };
+        double m_HX { 0 };
+        double m_HY { 0 };
+        QRect m_Square;
+        // Channel averaged pixels of the square, row by row
+        QVector<float> m_Values;
+};
+
+template <typename T>
+RadonProjection::RadonProjection(const T *buffer, int dataWidth, uint32_t samplesPerChannel, int channels,
+                                 const QRect &region, int averageRows)
+    : m_Width(region.width()), m_Height(region.height()), m_AverageRows(averageRows)
+{
+    const int hx = qFloor((m_Width + 1) / 2.0);
+    const int hy = qFloor((m_Height + 1) / 2.0);
+    m_HX = hx;
+    m_HY = hy;
+
+    const double innerCircleRadius = (0.5 * qSqrt(2.0) * qMin(hx, hy));
+    m_Square = QRect(QPoint(qCeil(hx - innerCircleRadius), qCeil(hy - innerCircleRadius)),
+                     QPoint(qFloor(hx + innerCircleRadius) - 1, qFloor(hy + innerCircleRadius) - 1))
+               .intersected(QRect(0, 0, m_Width, m_Height));
+
+    channels = qMax(1, channels);
+    m_Values.reserve(m_Square.width() * m_Square.height());
+    for (int y = m_Square.top(); y <= m_Square.bottom(); y++)
+    {
+        const T *row = buffer + (region.y() + y) * dataWidth + region.x();
+        for (int x = m_Square.left(); x <= m_Square.right(); x++)
+        {
+            double channelSum = 0;
+            for (int i = 0; i < channels; i++)
+                channelSum += row[x + samplesPerChannel * i];
+            m_Values.append(channelSum / channels);
+        }
+    }
+}
+
+BahtinovLineAverage RadonProjection::maxAverage(double angle) const
+{
+    const double angleInRad = angle * M_PI / 180.0;
+    const double sinAngle = qSin(angleInRad);
+    const double cosAngle = qCos(angleInRad);
+
+    // Contributions of the columns and rows to the row offset in the rotated region
+    QVector<double> columnOffsets(m_Square.width());
+    for (int x = 0; x < m_Square.width(); x++)
+        columnOffsets[x] = (m_Square.left() + x - m_HX) * sinAngle;
+
+    QVector<double> rowSums(m_Height, 0.0);
+    const float *value = m_Values.constData();
+    for (int y = m_Square.top(); y <= m_Square.bottom(); y++)
+    {
+        const double rowOffset = m_HY + (y - m_HY) * cosAngle;
+        for (int x = 0; x < m_Square.width(); x++, value++)
+        {
+            // Split each pixel between the two nearest rows, rounding to a single row favours the diagonals
+            const double offset = rowOffset + columnOffsets[x];
+            const int row = static_cast<int>(offset);
+            const double fraction = offset - row;
+            if (row >= 0 && row + 1 < m_Height)
+            {
+                rowSums[row] += *value * (1 - fraction);
+                rowSums[row + 1] += *value * fraction;
+            }
+        }
+    }
+
+    // Average over multiple rows, wrapping around the region as the rotated image did
+    BahtinovLineAverage lineAverage;
+    QVector<double> averages(m_Height);
+    const int halfRows = (m_AverageRows - 1) / 2;
+    int maxRow = 0;
+    for (int y = 0; y < m_Height; y++)
+    {
+        double multiRowSum = 0;
+        for (int y1 = y - halfRows; y1 <= y + halfRows; y1++)
+            multiRowSum += rowSums[(y1 % m_Height + m_Height) % m_Height];
+
+        averages[y] = multiRowSum / (static_cast<double>(m_Width) * m_AverageRows);
+        if (averages[y] > lineAverage.average)
+        {
+            lineAverage.average = averages[y];
+            maxRow = y;
+        }
+    }
+
+    // Sub-row offset of the line from a parabola through the peak and its neighbours
+    lineAverage.offset = maxRow;
+    if (maxRow > 0 && maxRow < m_Height - 1)
+    {
+        const double curvature = averages[maxRow - 1] - 2 * averages[maxRow] + averages[maxRow + 1];
+        if (curvature < 0)
+            lineAverage.offset += 0.5 * (averages[maxRow - 1] - averages[maxRow + 1]) / curvature;
+    }
+
+    return lineAverage;
+}
+
+struct AngleAverage
+{
+    double angle { 0 };
+    BahtinovLineAverage line;
+};
+
+/** @short Evaluate the projection at all the angles in parallel */
+void projectAngles(const RadonProjection &projection, QVector<AngleAverage> &angles)
+{
+    QtConcurrent::blockingMap(angles, [&projection](AngleAverage & angle)
+    {
+        angle.line = projection.maxAverage(angle.angle);
+    });
+}
+}
+
 template <typename T>
 int FITSBahtinovDetector::findBahtinovStar(QList<Edge*> &starCenters, const QRect &boundary)
 {
@@ -104,70 +247,26 @@ int FITSBahtinovDetector::findBahtinovStar(QList<Edge*> &starCenters, const QRec
     int subW = (boundary.isNull() ? image_data->width() : boundary.width());
     int subH = (boundary.isNull() ? image_data->height() : boundary.height());
 
-    int BBP = image_data->getBytesPerPixel();
-    uint16_t dataWidth = image_data->width();
-
-    // #1 Find offsets
-    uint32_t size   = subW * subH;
-    uint32_t offset = subX + subY * dataWidth;
-
-    // #2 Create new buffer
-    auto * buffer = new uint8_t[size * BBP];
-    // If there is no offset, copy whole buffer in one go
-    if (offset == 0)
-    {
-        memcpy(buffer, image_data->getImageBuffer(), size * BBP);
-    }
-    else
-    {
-        uint8_t * dataPtr = buffer;
-        const uint8_t * origDataPtr = image_data->getImageBuffer();
-        // Copy data line by line
-        for (int height = subY; height < (subY + subH); height++)
-        {
-            uint32_t lineOffset = (subX + height * dataWidth) * BBP;
-            memcpy(dataPtr, origDataPtr + lineOffset, subW * BBP);
-            dataPtr += (subW * BBP);
-        }
-    }
-
-    // #3 Create new FITSData to hold it
-    FITSData::Statistic stats;
-    stats.width = subW;
-    stats.height = subH;
-    stats.bitpix = image_data->getStatistics().bitpix;
-    stats.bytesPerPixel = BBP;
-    stats.samples_per_channel = size;
-    FITSData* boundedImage = new FITSData();
-    boundedImage->restoreStatistics(stats);
-    boundedImage->setProperty("dataType", image_data->property("dataType"));
-
-    // #4 Set image buffer
-    boundedImage->setImageBuffer(buffer);
-
-    boundedImage->calculateStats(true);
-
     QElapsedTimer timer1;
-
-    // Rotate image 180 degrees in steps of 1 degree
-    QMap<int, BahtinovLineAverage> lineAveragesPerAngle;
-    const int steps = 180;
-    double radPerStep = M_PI / steps;
-
     timer1.start();
 
+    // The projection reads the bounded region directly from the image buffer
+    const RadonProjection projection(reinterpret_cast<const T *>(image_data->getImageBuffer()), image_data->width(),
+                                     image_data->getStatistics().samples_per_channel, image_data->channels(),
+                                     QRect(subX, subY, subW, subH), NUMBER_OF_AVERAGE_ROWS);
+
+    // Evaluate 180 degrees in steps of 1 degree
+    const int steps = 180;
+    QVector<AngleAverage> coarseAngles(steps);
     for (int angle = 0; angle < steps; angle++)
-    {
-        // TODO Apply multi threading to speed up calculation
-        BahtinovLineAverage lineAverage = calculateMaxAverage<T>(boundedImage, angle);
-        // Store line average in map
-        lineAveragesPerAngle.insert(angle, lineAverage);
-    }
+        coarseAngles[angle].angle = angle;
+    projectAngles(projection, coarseAngles);
 
-    qCDebug(KSTARS_FITS) << "Getting max average for all 180 rotations took" << timer1.elapsed() << "milliseconds";
+    QMap<int, BahtinovLineAverage> lineAveragesPerAngle;
+    for (int angle = 0; angle < steps; angle++)
+        lineAveragesPerAngle.insert(angle, coarseAngles[angle].line);
 
-    // Not needed anymore
-    delete boundedImage;
+    const qint64 coarseTime = timer1.elapsed();
 
     // Calculate Bahtinov angles
     QVector<HoughLine*> bahtinov_angles;
@@ -176,27 +275,61 @@ int FITSBahtinovDetector::findBahtinovStar(QList<Edge*> &starCenters, const QRec
     for (int index1 = 0; index1 < 3; index1++)
     {
         double maxAverage = 0.0;
-        double maxAngle = 0.0;
-        int maxAverageOffset = 0;
-        for (int angle = 0; angle < steps; angle++)
+        int maxAngle = 0;
+        double maxAverageOffset = 0;
+        for (auto it = lineAveragesPerAngle.constBegin(); it != lineAveragesPerAngle.constEnd(); ++it)
         {
-            BahtinovLineAverage lineAverage = lineAveragesPerAngle[angle];
-            if (lineAverage.average > maxAverage)
+            if (it.value().average > maxAverage)
+            {
+                maxAverage = it.value().average;
+                maxAverageOffset = it.value().offset;
+                maxAngle = it.key();
+            }
+        }
+
+        // Refine the peak around its one degree estimate
+        double refinedAngle = maxAngle;
+        double range = 1.0;
+        for (const double step : REFINE_STEPS)
+        {
+            QVector<AngleAverage> fineAngles;
+            for (int i = -qRound(range / step); i <= qRound(range / step); i++)
+            {
+                AngleAverage fineAngle;
+                fineAngle.angle = refinedAngle + i * step;
+                fineAngles.append(fineAngle);
+            }
+            projectAngles(projection, fineAngles);
+
+            for (const AngleAverage &fineAngle : fineAngles)
             {
-                maxAverage = lineAverage.average;
-                maxAverageOffset = lineAverage.offset;
-                maxAngle = angle;
+                if (fineAngle.line.average > maxAverage)
+                {
+                    maxAverage = fineAngle.line.average;
+                    maxAverageOffset = fineAngle.line.offset;
+                    refinedAngle = fineAngle.angle;
+                }
             }
+            range = step;
+        }
+
+        // Keep the angle within [0, 180[, the offset of the line depends on it
+        if (refinedAngle < 0 || refinedAngle >= steps)
+        {
+            refinedAngle = std::fmod(refinedAngle + steps, static_cast<double>(steps));
+            BahtinovLineAverage lineAverage = projection.maxAverage(refinedAngle);
+            maxAverage = lineAverage.average;
+            maxAverageOffset = lineAverage.offset;
         }
-        HoughLine* pHoughLine = new HoughLine(maxAngle * radPerStep, maxAverageOffset, subW, subH, maxAverage);
+
+        HoughLine* pHoughLine = new HoughLine(refinedAngle * M_PI / 180.0, maxAverageOffset, subW, subH, maxAverage);
         if (pHoughLine != nullptr)
         {
             bahtinov_angles.append(pHoughLine);
         }
 
         // Remove data around peak to prevent it from being detected again
-        int minBahtinovAngleOffset = 18;
-        for (int subAngle = maxAngle - minBahtinovAngleOffset; subAngle < maxAngle + minBahtinovAngleOffset; subAngle++)
+        for (int subAngle = maxAngle - MIN_BAHTINOV_ANGLE_OFFSET; subAngle < maxAngle + MIN_BAHTINOV_ANGLE_OFFSET; subAngle++)
         {
             int angleInRange = subAngle;
             if (angleInRange < 0)
@@ -211,6 +344,9 @@ int FITSBahtinovDetector::findBahtinovStar(QList<Edge*> &starCenters, const QRec
         }
     }
 
+    qCDebug(KSTARS_FITS) << "Bahtinov projection of a" << subW << "x" << subH << "region took" << timer1.elapsed()
+                         << "milliseconds, of which" << coarseTime << "for all 180 one degree angles";
+
     // Proceed with focus offset calculation, but only when at least 3 lines have been detected
     QVector<HoughLine*> top3Lines;
     if (bahtinov_angles.size() >= 3)
@@ -293,161 +429,3 @@ int FITSBahtinovDetector::findBahtinovStar(QList<Edge*> &starCenters, const QRec
 
     return 1;
 }
-
-template <typename T>
-BahtinovLineAverage FITSBahtinovDetector::calculateMaxAverage(const FITSData *data, int angle)
-{
-    int BBP = data->getBytesPerPixel();
-    int size = data->getStatistics().samples_per_channel;
-    int width = data->width();
-    int height = data->height();
-    int numChannels = data->channels();
-
-    BahtinovLineAverage lineAverage;
-    auto * rotimage = new T[size * BBP];
-
-    rotateImage(data, angle, rotimage);
-
-    // Calculate average pixel value for each row
-    auto * rotBuffer = reinterpret_cast<T *>(rotimage);
-
-    //    printf("Angle;%d;Width;%d;Height;%d;Rows;%d;;RowSum;", angle, width, height, NUMBER_OF_AVERAGE_ROWS);
-
-    for (int y = 0; y < height; y++)
-    {
-        int yMin = y - ((NUMBER_OF_AVERAGE_ROWS - 1) / 2);
-        int yMax = y + ((NUMBER_OF_AVERAGE_ROWS - 1) / 2);
-
-        unsigned long multiRowSum = 0;
-        // Calculate average over multiple rows
-        for (int y1 = yMin; y1 <= yMax; y1++)
-        {
-            int y2 = y1;
-            if (y2 < 0)
-            {
-                y2 += height;
-            }
-            if (y2 >= height)
-            {
-                y2 -= height;
-            }
-            if (y2 < 0 || y2 >= height)
-            {
-                qCWarning(KSTARS_FITS) << "Y still out of bounds: 0 <=" << y2 << "<" << height;
-            }
-
-            for (int x1 = 0; x1 < width; x1++)
-            {
-                int index = y2 * width + x1;
-                unsigned long channelAverage = 0;
-                for (int i = 0; i < numChannels; i++)
-                {
-                    int offset = size * i;
-                    channelAverage += rotBuffer[index + offset];
-                }
-                multiRowSum += qRound(channelAverage / static_cast<double>(numChannels));
-            }
-        }
-        //        printf("%lu;", multiRowSum);
-
-        double average = multiRowSum / static_cast<double>(width * NUMBER_OF_AVERAGE_ROWS);
-        if (average > lineAverage.average)
-        {
-            lineAverage.average = average;
-            lineAverage.offset = y;
-        }
-    }
-    //    printf(";;MaxAverage;%.3f;MaxAverageIndex;%lu\r\n", lineAverage.average, lineAverage.offset);
-    //    fflush(stdout);
-
-    rotBuffer = nullptr;
-    delete[] rotimage;
-    rotimage = nullptr;
-
-    return lineAverage;
-}
-
-/** Rotate an image by angle degrees.
- * verbose generates extra info on stdout.
- * return true if successful and rotated image.
- * @param angle The angle over which the image needs to be rotated
- * @param rotImage The image that needs to be rotated, also the rotated image return value
- */
-template <typename T>
-bool FITSBahtinovDetector::rotateImage(const FITSData *data, int angle, T * rotImage)
-{
-    int BBP = data->getBytesPerPixel();
-    int size = data->getStatistics().samples_per_channel;
-    int width = data->width();
-    int height = data->height();
-    int numChannels = data->channels();
-
-    int hx, hy;
-    size_t bufferSize;
-
-    /* Check allocation buffer for rotated image */
-    if (rotImage == nullptr)
-    {
-        qWarning() << "No memory allocated for rotated image buffer!";
-        return false;
-    }
-
-    while (angle < 0)
-    {
-        angle = angle + 360;
-    }
-    while (angle >= 360)
-    {
-        angle = angle - 360;
-    }
-
-    hx = qFloor((width + 1) / 2.0);
-    hy = qFloor((height + 1) / 2.0);
-
-    bufferSize = size * numChannels * BBP;
-    memset(rotImage, 0, bufferSize);
-
-    auto * rotBuffer = reinterpret_cast<T *>(rotImage);
-    auto * buffer = reinterpret_cast<const T *>(data->getImageBuffer());
-
-    double innerCircleRadius = (0.5 * qSqrt(2.0) * qMin(hx, hy));
-    double angleInRad = angle * M_PI / 180.0;
-    double sinAngle = qSin(angleInRad);
-    double cosAngle = qCos(angleInRad);
-    int leftEdge = qCeil(hx - innerCircleRadius);
-    int rightEdge = qFloor(hx + innerCircleRadius);
-    int topEdge = qCeil(hy - innerCircleRadius);
-    int bottomEdge = qFloor(hy + innerCircleRadius);
-
-    for (int i = 0; i < numChannels; i++)
-    {
-        int offset = size * i;
-        for (int x1 = leftEdge; x1 < rightEdge; x1++)
-        {
-            for (int y1 = topEdge; y1 < bottomEdge; y1++)
-            {
-                // translate point back to origin:
-                double x2 = x1 - hx;
-                double y2 = y1 - hy;
-
-                // rotate point
-                double xnew = x2 * cosAngle - y2 * sinAngle;
-                double ynew = x2 * sinAngle + y2 * cosAngle;
-
-                // translate point back:
-                x2 = xnew + hx;
-                y2 = ynew + hy;
-
-                int orgIndex = y1 * height + x1;
-                int newIndex = qRound(y2) * height + qRound(x2);
-
-                if (newIndex >= 0 && newIndex < static_cast<int>(bufferSize))
-                {
-                    rotBuffer[newIndex + offset] = buffer[orgIndex + offset];
-                } // else index out of bounds, do not update pixel
-            }
-        }
-    }
-
-    return true;
-}
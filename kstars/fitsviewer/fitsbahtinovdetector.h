@@ -26,12 +26,13 @@ class BahtinovLineAverage
         BahtinovLineAverage()
         {
             average = 0.0;
-            offset = 0;
+            offset = 0.0;
         }
         virtual ~BahtinovLineAverage() = default;
 
         double average;
-        size_t offset;
+        /// Row of the line in the region rotated by its angle, with sub-row precision
+        double offset;
 };
 
 class FITSBahtinovDetector: public FITSStarDetector
@@ -62,16 +63,13 @@ public:
 
 protected:
     /** @internal Find sources in the parent FITS data file, dependent of the pixel depth.
+     * The angles of the three Bahtinov spikes are found with a Radon projection of the bounded region:
+     * for each angle, pixels are summed along lines of that angle and the strongest line is kept.
+     * All angles are evaluated in parallel at a one degree step, then the three peaks are refined.
      * @see FITSGradientDetector::findSources.
      */
     template <typename T>
     int findBahtinovStar(QList<Edge*> &starCenters, const QRect &boundary);
-
-private:
-    template <typename T>
-    BahtinovLineAverage calculateMaxAverage(const FITSData *data, int angle);
-    template <typename T>
-    bool rotateImage(const FITSData *data, int angle, T * rotimage);
 };
 
 #endif // FITSBAHTINOVDETECTOR_H
@@ -0,0 +1,258 @@
+/*  FITS Compressor
+    Background fpack compression of saved FITS frames.
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#include "fitscompressor.h"
+
+#include "fits_debug.h"
+
+#include <fitsio.h>
+#include "fpack.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+// Number of pixels compared at once when verifying a compressed file
+const long VERIFY_CHUNK = 1 << 20;
+
+bool readImageInfo(fitsfile *fptr, int *datatype, int *size, int *naxis, long *naxes, int *status)
+{
+    int equivtype = 0;
+    if (fits_get_img_equivtype(fptr, &equivtype, status) || fits_get_img_dim(fptr, naxis, status) ||
+            *naxis > 3 || fits_get_img_size(fptr, 3, naxes, status))
+        return false;
+
+    switch (equivtype)
+    {
+        case BYTE_IMG:
+            *datatype = TBYTE;
+            *size = 1;
+            break;
+        case SBYTE_IMG:
+            *datatype = TSBYTE;
+            *size = 1;
+            break;
+        case SHORT_IMG:
+            *datatype = TSHORT;
+            *size = 2;
+            break;
+        case USHORT_IMG:
+            *datatype = TUSHORT;
+            *size = 2;
+            break;
+        case LONG_IMG:
+            *datatype = TINT;
+            *size = 4;
+            break;
+        case ULONG_IMG:
+            *datatype = TUINT;
+            *size = 4;
+            break;
+        case LONGLONG_IMG:
+            *datatype = TLONGLONG;
+            *size = 8;
+            break;
+        case FLOAT_IMG:
+            *datatype = TFLOAT;
+            *size = 4;
+            break;
+        case DOUBLE_IMG:
+            *datatype = TDOUBLE;
+            *size = 8;
+            break;
+        default:
+            return false;
+    }
+
+    return true;
+}
+}
+
+FITSCompressor *FITSCompressor::_FITSCompressor = nullptr;
+
+FITSCompressor *FITSCompressor::Instance()
+{
+    if (_FITSCompressor == nullptr)
+        _FITSCompressor = new FITSCompressor(qApp);
+
+    return _FITSCompressor;
+}
+
+FITSCompressor::FITSCompressor(QObject *parent) : QObject(parent)
+{
+    // fpack keeps its state in globals, so files are compressed one at a time
+    m_Pool.setMaxThreadCount(1);
+}
+
+QMutex &FITSCompressor::fpackMutex()
+{
+    static QMutex mutex;
+    return mutex;
+}
+
+bool FITSCompressor::enqueue(const QString &filename, Compression compression, bool removeOriginal)
+{
+    if (compression == COMPRESSION_NONE)
+        return false;
+
+    int backlog = m_Backlog.loadAcquire();
+    do
+    {
+        if (backlog >= m_MaxBacklog.loadAcquire())
+        {
+            qCWarning(KSTARS_FITS) << "FITS compression queue is full," << filename << "is left uncompressed.";
+            return false;
+        }
+    }
+    while (m_Backlog.testAndSetOrdered(backlog, backlog + 1, backlog) == false);
+
+    QtConcurrent::run(&m_Pool, [this, filename, compression, removeOriginal]()
+    {
+        process(filename, compression, removeOriginal);
+    });
+
+    return true;
+}
+
+void FITSCompressor::process(const QString &filename, Compression compression, bool removeOriginal)
+{
+    QElapsedTimer timer;
+    timer.start();
+    const qint64 size = QFileInfo(filename).size();
+
+    QString compressedFilename, error;
+    if (compress(filename, compression, removeOriginal, &compressedFilename, &error))
+        qCDebug(KSTARS_FITS) << "Compressed" << filename << "from" << size << "to"
+                             << QFileInfo(compressedFilename).size() << "bytes in" << timer.elapsed() << "ms";
+    else
+        qCWarning(KSTARS_FITS) << "Failed to compress" << filename << ":" << error;
+
+    m_Backlog.fetchAndSubOrdered(1);
+}
+
+bool FITSCompressor::compress(const QString &filename, Compression compression, bool removeOriginal,
+                              QString *compressedFilename, QString *error)
+{
+    const QString finalFilename = filename + ".fz";
+    const QString partFilename  = finalFilename + ".part";
+    QFile::remove(partFilename);
+
+    fpstate fpvar;
+    fp_init(&fpvar);
+    fpvar.comptype = (compression == COMPRESSION_HCOMPRESS) ? HCOMPRESS_1 : RICE_1;
+
+    int isLossless = 1, result = 0;
+    {
+        QMutexLocker locker(&fpackMutex());
+        result = fp_pack(filename.toLocal8Bit().data(), partFilename.toLocal8Bit().data(), fpvar, &isLossless);
+    }
+    // fp_pack removes the output file when it fails, not always reporting the error
+    if (result < 0 || QFile::exists(partFilename) == false)
+    {
+        *error = QStringLiteral("fpack failed");
+        return false;
+    }
+
+    if (isLossless == 0)
+    {
+        QFile::remove(partFilename);
+        *error = QStringLiteral("compression would lose data");
+        return false;
+    }
+
+    // fpack keeps an empty primary HDU in front of the compressed image
+    if (verify(filename, 1, partFilename, 2, error) == false)
+    {
+        QFile::remove(partFilename);
+        return false;
+    }
+
+    QFile::remove(finalFilename);
+    if (QFile::rename(partFilename, finalFilename) == false)
+    {
+        QFile::remove(partFilename);
+        *error = QStringLiteral("unable to rename %1").arg(partFilename);
+        return false;
+    }
+
+    if (removeOriginal)
+        QFile::remove(filename);
+    *compressedFilename = finalFilename;
+    return true;
+}
+
+bool FITSCompressor::verify(const QString &original, int originalHDU, const QString &compressed, int compressedHDU,
+                            QString *error)
+{
+    int status = 0;
+    fitsfile *originalPtr = nullptr, *compressedPtr = nullptr;
+    int datatype[2] = { 0, 0 }, size[2] = { 0, 0 }, naxis[2] = { 0, 0 };
+    long naxes[2][3] = { { 1, 1, 1 }, { 1, 1, 1 } };
+
+    // Use open diskfile as it does not use extended file names which has problems opening
+    // files with [ ] or ( ) in their names.
+    if (fits_open_diskfile(&originalPtr, original.toLocal8Bit(), READONLY, &status) ||
+            fits_movabs_hdu(originalPtr, originalHDU, nullptr, &status) ||
+            readImageInfo(originalPtr, &datatype[0], &size[0], &naxis[0], naxes[0], &status) == false ||
+            fits_open_diskfile(&compressedPtr, compressed.toLocal8Bit(), READONLY, &status) ||
+            fits_movabs_hdu(compressedPtr, compressedHDU, nullptr, &status) ||
+            readImageInfo(compressedPtr, &datatype[1], &size[1], &naxis[1], naxes[1], &status) == false)
+    {
+        char errmsg[FLEN_ERRMSG];
+        fits_get_errstatus(status, errmsg);
+        *error = status ? QString::fromLatin1(errmsg) : QStringLiteral("unsupported image");
+        status = 0;
+        if (compressedPtr)
+            fits_close_file(compressedPtr, &status);
+        if (originalPtr)
+            fits_close_file(originalPtr, &status);
+        return false;
+    }
+
+    bool identical = datatype[0] == datatype[1] && naxis[0] == naxis[1] &&
+                     std::equal(naxes[0], naxes[0] + 3, naxes[1]);
+
+    const LONGLONG pixels = static_cast<LONGLONG>(naxes[0][0]) * naxes[0][1] * naxes[0][2];
+    std::vector<char> originalBuffer, compressedBuffer;
+    for (LONGLONG first = 1; identical && first <= pixels; first += VERIFY_CHUNK)
+    {
+        const LONGLONG count = qMin<LONGLONG>(VERIFY_CHUNK, pixels - first + 1);
+        originalBuffer.resize(count * size[0]);
+        compressedBuffer.resize(count * size[0]);
+
+        if (fits_read_img(originalPtr, datatype[0], first, count, nullptr, originalBuffer.data(), nullptr, &status) ||
+                fits_read_img(compressedPtr, datatype[0], first, count, nullptr, compressedBuffer.data(), nullptr, &status))
+            break;
+
+        identical = std::memcmp(originalBuffer.data(), compressedBuffer.data(), originalBuffer.size()) == 0;
+    }
+
+    if (status)
+    {
+        char errmsg[FLEN_ERRMSG];
+        fits_get_errstatus(status, errmsg);
+        *error = QString::fromLatin1(errmsg);
+        identical = false;
+    }
+    else if (identical == false)
+        *error = QStringLiteral("compressed image differs from the original");
+
+    status = 0;
+    fits_close_file(compressedPtr, &status);
+    fits_close_file(originalPtr, &status);
+    return identical;
+}
@@ -0,0 +1,94 @@
+/*  FITS Compressor
+    Background fpack compression of saved FITS frames.
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+*/
+
+#pragma once
+
+#include <QAtomicInt>
+#include <QMutex>
+#include <QObject>
+#include <QThreadPool>
+
+/**
+ * @class FITSCompressor
+ * FITSCompressor compresses saved FITS frames with fpack in the background.
+ *
+ * Frames are queued once they are written to disk, and compressed one at a time since the fpack
+ * routines share global state. The queue is bounded: when it is full, new frames are left
+ * uncompressed rather than delaying the capture.
+ *
+ * Each compressed file is read back and compared pixel by pixel with the original. Compressions
+ * that would lose data, such as quantized floating point images, are discarded. The original frame
+ * is kept unless its removal is requested, as the FITS viewer or EkosLive may still be reading it.
+ */
+class FITSCompressor : public QObject
+{
+        Q_OBJECT
+
+    public:
+        typedef enum { COMPRESSION_NONE, COMPRESSION_RICE, COMPRESSION_HCOMPRESS } Compression;
+
+        static FITSCompressor *Instance();
+
+        /**
+         * @brief Queue a FITS file for compression. Thread-safe.
+         * @param filename FITS file, compressed to filename.fz.
+         * @param compression compression algorithm.
+         * @param removeOriginal remove filename once the compressed file is verified.
+         * @return false if the file was not queued, because the queue is full or compression is disabled.
+         */
+        bool enqueue(const QString &filename, Compression compression, bool removeOriginal = false);
+
+        /** @return number of files queued or being compressed. Thread-safe. */
+        int backlog() const
+        {
+            return m_Backlog.loadAcquire();
+        }
+
+        /** Set the number of files that may be queued, including the one being compressed */
+        void setMaxBacklog(int maxBacklog)
+        {
+            m_MaxBacklog.storeRelease(qMax(1, maxBacklog));
+        }
+
+        /** Wait until all queued files are compressed */
+        void waitForDone()
+        {
+            m_Pool.waitForDone();
+        }
+
+        /**
+         * @brief Compress a FITS file and verify the result.
+         * @param filename FITS file to compress.
+         * @param compression compression algorithm.
+         * @param removeOriginal remove filename on success.
+         * @param compressedFilename set to the compressed file name on success.
+         * @param error set to the reason of the failure.
+         * @return true if the file was compressed losslessly.
+         */
+        static bool compress(const QString &filename, Compression compression, bool removeOriginal,
+                             QString *compressedFilename, QString *error);
+
+        /** @return true if both files hold the same image, pixel by pixel */
+        static bool verify(const QString &original, int originalHDU, const QString &compressed, int compressedHDU,
+                           QString *error);
+
+        /** The fpack routines keep their state in globals, every fp_pack() call must hold this lock */
+        static QMutex &fpackMutex();
+
+    private:
+        explicit FITSCompressor(QObject *parent = nullptr);
+
+        void process(const QString &filename, Compression compression, bool removeOriginal);
+
+        static FITSCompressor *_FITSCompressor;
+
+        QThreadPool m_Pool;
+        QAtomicInt m_Backlog { 0 };
+        QAtomicInt m_MaxBacklog { 8 };
+};
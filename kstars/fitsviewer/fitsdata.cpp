@@ -24,13 +24,12 @@
 #include "fitscentroiddetector.h"
 #include "fitssepdetector.h"
 
-#include "fpack.h"
-
 #include "kstarsdata.h"
 #include "ksutils.h"
 #include "kspaths.h"
 #include "Options.h"
 #include "skymapcomposite.h"
+#include "tracer.h"
 #include "auxiliary/ksnotification.h"
 
 #include <KFormat>
@@ -181,39 +180,20 @@ bool fitsOpenError(int status, const QString &message, bool silent)
 
 bool FITSData::privateLoad(void *fits_buffer, size_t fits_buffer_size, bool silent)
 {
+    TraceZone zone("Load FITS", "fits");
+
     int status = 0, anynull = 0;
     long naxes[3];
     QString errMessage;
 
     m_isTemporary = m_Filename.startsWith(m_TemporaryPath);
 
-    if (fits_buffer == nullptr && m_Filename.endsWith(".fz"))
-    {
-        // Store so we don't lose.
+    // fpack (.fz) files hold the tile-compressed image in their first extension. It is decompressed
+    // by cfitsio while reading, straight into the image buffer.
+    m_isCompressed = (fits_buffer == nullptr && m_Filename.endsWith(".fz"));
+    if (m_isCompressed)
         m_compressedFilename = m_Filename;
 
-        QString uncompressedFile = QDir::tempPath() + QString("/%1").arg(QUuid::createUuid().toString().remove(
-                                       QRegularExpression("[-{}]")));
-        fpstate	fpvar;
-        fp_init (&fpvar);
-        if (fp_unpack(m_Filename.toLatin1().data(), uncompressedFile.toLatin1().data(), fpvar) < 0)
-        {
-            errMessage = i18n("Failed to unpack compressed fits");
-            if (!silent)
-                KSNotification::error(errMessage, i18n("FITS Open"));
-            qCCritical(KSTARS_FITS) << errMessage;
-            return false;
-        }
-
-        // Remove compressed .fz if it was temporary
-        if (m_isTemporary && autoRemoveTemporaryFITS)
-            QFile::remove(m_Filename);
-
-        m_Filename = uncompressedFile;
-        m_isTemporary = true;
-        m_isCompressed = true;
-    }
-
     if (fits_buffer == nullptr)
     {
         // Use open diskfile as it does not use extended file names which has problems opening
@@ -235,7 +215,7 @@ bool FITSData::privateLoad(void *fits_buffer, size_t fits_buffer_size, bool sile
             stats.size = fits_buffer_size;
     }
 
-    if (fits_movabs_hdu(fptr, 1, IMAGE_HDU, &status))
+    if (fits_movabs_hdu(fptr, m_isCompressed ? 2 : 1, IMAGE_HDU, &status))
         return fitsOpenError(status, i18n("Could not locate image HDU."), silent);
 
     if (fits_get_img_param(fptr, 3, &(stats.bitpix), &(stats.ndim), naxes, &status))
@@ -334,7 +314,12 @@ bool FITSData::privateLoad(void *fits_buffer, size_t fits_buffer_size, bool sile
     flipVCounter   = 0;
     long nelements = stats.samples_per_channel * m_Channels;
 
-    if (fits_read_img(fptr, m_DataType, 1, nelements, nullptr, m_ImageBuffer, &anynull, &status))
+    if (m_isCompressed)
+    {
+        if (!readCompressedImage(status))
+            return fitsOpenError(status, i18n("Error reading image."), silent);
+    }
+    else if (fits_read_img(fptr, m_DataType, 1, nelements, nullptr, m_ImageBuffer, &anynull, &status))
         return fitsOpenError(status, i18n("Error reading image."), silent);
 
     parseHeader();
@@ -363,6 +348,85 @@ bool FITSData::privateLoad(void *fits_buffer, size_t fits_buffer_size, bool sile
     return true;
 }
 
+bool FITSData::readCompressedImage(int &status)
+{
+    int anynull = 0;
+    long tileSize[3] = { 0, 0, 0 };
+    if (fits_get_tile_dim(fptr, 3, tileSize, &status))
+        return false;
+
+    // Bands are made of whole rows of tiles, so that no tile is decompressed twice
+    const long height   = stats.height;
+    const long tileRows = qMax(1L, tileSize[1]);
+    const long tiles    = (height + tileRows - 1) / tileRows;
+    const int bands     = static_cast<int>(qMin<long>(QThread::idealThreadCount(), tiles));
+
+    // Each band needs its own file handle, which cfitsio only supports when built reentrant
+    if (bands < 2 || !fits_is_reentrant())
+    {
+        long nelements = stats.samples_per_channel * m_Channels;
+        return fits_read_img(fptr, m_DataType, 1, nelements, nullptr, m_ImageBuffer, &anynull, &status) == 0;
+    }
+
+    // Handles opened on the same disk file share their state in cfitsio, including with fptr, so the
+    // file is read once and each band decompresses it through its own memory file handle
+    QFile file(m_Filename);
+    if (file.open(QIODevice::ReadOnly) == false)
+    {
+        status = FILE_NOT_OPENED;
+        return false;
+    }
+    const QByteArray compressed = file.readAll();
+    file.close();
+
+    const long bandRows = ((tiles + bands - 1) / bands) * tileRows;
+    QList<QFuture<int>> futures;
+    for (long firstRow = 0; firstRow < height; firstRow += bandRows)
+        futures.append(QtConcurrent::run(this, &FITSData::readCompressedRows, compressed, firstRow,
+                                         qMin(height, firstRow + bandRows)));
+
+    for (QFuture<int> &future : futures)
+    {
+        if (status == 0)
+            status = future.result();
+        else
+            future.waitForFinished();
+    }
+
+    return status == 0;
+}
+
+int FITSData::readCompressedRows(const QByteArray &compressed, long firstRow, long lastRow)
+{
+    int status = 0, anynull = 0;
+    fitsfile *bandFptr = nullptr;
+
+    // Read only, so cfitsio never reallocates the buffer
+    void *buffer = const_cast<char *>(compressed.constData());
+    size_t bufferSize = static_cast<size_t>(compressed.size());
+    if (fits_open_memfile(&bandFptr, m_Filename.toLatin1().data(), READONLY, &buffer, &bufferSize, 0, nullptr, &status))
+        return status;
+
+    if (fits_movabs_hdu(bandFptr, 2, IMAGE_HDU, &status) == 0)
+    {
+        for (int channel = 0; channel < m_Channels && status == 0; channel++)
+        {
+            // Pixel ranges are one-based and inclusive
+            long fpixel[3] = { 1, firstRow + 1, channel + 1 };
+            long lpixel[3] = { stats.width, lastRow, channel + 1 };
+            long inc[3]    = { 1, 1, 1 };
+            uint8_t *rows  = m_ImageBuffer + (channel * stats.samples_per_channel + firstRow * stats.width) * stats.bytesPerPixel;
+
+            fits_read_subset(bandFptr, m_DataType, fpixel, lpixel, inc, nullptr, rows, &anynull, &status);
+        }
+    }
+
+    int closeStatus = 0;
+    fits_close_file(bandFptr, &closeStatus);
+
+    return status;
+}
+
 int FITSData::saveFITS(const QString &newFilename)
 {
     if (newFilename == m_Filename)
@@ -911,7 +975,7 @@ bool FITSData::parseHeader()
     char * header = nullptr;
     int status = 0, nkeys = 0;
 
-    if (fits_hdr2str(fptr, 0, nullptr, 0, &header, &nkeys, &status))
+    if (fits_convert_hdr2str(fptr, 0, nullptr, 0, &header, &nkeys, &status))
     {
         fits_report_error(stderr, status);
         free(header);
@@ -980,6 +1044,8 @@ bool FITSData::getRecordValue(const QString &key, QVariant &value) const
 
 int FITSData::findStars(StarAlgorithm algorithm, const QRect &trackingBox)
 {
+    TraceZone zone("Detect stars", "fits");
+
     int count = 0;
     starAlgorithm = algorithm;
 
@@ -1596,7 +1662,7 @@ bool FITSData::checkForWCS()
         m_wcs = nullptr;
     }
 
-    if (fits_hdr2str(fptr, 1, nullptr, 0, &header, &nkeyrec, &status))
+    if (fits_convert_hdr2str(fptr, 1, nullptr, 0, &header, &nkeyrec, &status))
     {
         char errmsg[512];
         fits_get_errstatus(status, errmsg);
@@ -1668,7 +1734,7 @@ bool FITSData::loadWCS()
     int w  = width();
     int h = height();
 
-    if (fits_hdr2str(fptr, 1, nullptr, 0, &header, &nkeyrec, &status))
+    if (fits_convert_hdr2str(fptr, 1, nullptr, 0, &header, &nkeyrec, &status))
     {
         char errmsg[512];
         fits_get_errstatus(status, errmsg);
@@ -1838,7 +1904,7 @@ void FITSData::findObjectsInImage(double world[], double phi, double theta, doub
     int h = height();
     int status = 0;
     char date[64];
-    KSNumbers * num = nullptr;
+    std::shared_ptr<const KSNumbers> num;
 
     if (fits_read_keyword(fptr, "DATE-OBS", date, nullptr, &status) == 0)
     {
@@ -1850,10 +1916,10 @@ void FITSData::findObjectsInImage(double world[], double phi, double theta, doub
         QDateTime ts = QDateTime::fromString(tsString, Qt::ISODate);
 
         if (ts.isValid())
-            num = new KSNumbers(KStarsDateTime(ts).djd());
+            num = KSNumbers::cached(KStarsDateTime(ts).djd());
     }
-    if (num == nullptr)
-        num = new KSNumbers(KStarsData::Instance()->ut().djd()); //Set to current time if the above does not work.
+    if (!num)
+        num = KSNumbers::cached(KStarsData::Instance()->ut().djd()); //Set to current time if the above does not work.
 
     SkyMapComposite * map = KStarsData::Instance()->skyComposite();
 
@@ -1867,11 +1933,11 @@ void FITSData::findObjectsInImage(double world[], double phi, double theta, doub
         SkyPoint p1;
         p1.setRA0(dms(wcs_coord[0].ra));
         p1.setDec0(dms(wcs_coord[0].dec));
-        p1.updateCoordsNow(num);
+        p1.updateCoordsNow(num.get());
         SkyPoint p2;
         p2.setRA0(dms(wcs_coord[size - 1].ra));
         p2.setDec0(dms(wcs_coord[size - 1].dec));
-        p2.updateCoordsNow(num);
+        p2.updateCoordsNow(num.get());
         QList<SkyObject *> list = map->findObjectsInArea(p1, p2);
 
         foreach (SkyObject * object, list)
@@ -1904,8 +1970,6 @@ void FITSData::findObjectsInImage(double world[], double phi, double theta, doub
                 objList.append(new FITSSkyObject(object, x, y));
         }
     }
-
-    delete (num);
 }
 #endif
 
@@ -418,6 +418,9 @@ class FITSData : public QObject
     private:
         void loadCommon(const QString &inFilename);
         bool privateLoad(void *fits_buffer, size_t fits_buffer_size, bool silent);
+        // Decompress the image of an fpack file into the image buffer, in parallel bands of whole tiles
+        bool readCompressedImage(int &status);
+        int readCompressedRows(const QByteArray &compressed, long firstRow, long lastRow);
         void rotWCSFITS(int angle, int mirror);
         int calculateMinMax(bool refresh = false);
         bool checkDebayer();
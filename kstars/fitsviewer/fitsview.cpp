@@ -20,6 +20,7 @@
 #include "skymap.h"
 #include "fits_debug.h"
 #include "stretch.h"
+#include "tracer.h"
 
 #ifdef HAVE_INDI
 #include "basedevice.h"
@@ -448,6 +449,8 @@ int FITSView::saveFITS(const QString &newFilename)
 
 bool FITSView::rescale(FITSZoom type)
 {
+    TraceZone zone("Stretch FITS", "fits");
+
     switch (imageData->property("dataType").toInt())
     {
         case TBYTE:
@@ -66,6 +66,9 @@ X(0),X(1),X(4),X(5)
 #undef Z
 };
 
+// Tiles kept for each order, the table of an order is emptied once full
+static const int MAX_TILES_PER_ORDER = 8192;
+
 static short xoffset[] = { -1,-1, 0, 1, 1, 1, 0,-1 };
 static short yoffset[] = {  0, 1, 1, 1, 0,-1,-1,-1 };
 
@@ -106,8 +109,6 @@ static double fmodulo(double v1, double v2)
 void HEALPix::getCornerPoints(int level, int pix, SkyPoint *skyCoords)
 {
   QVector3D v[4];
-  // Transform from HealPIX convention to KStars
-  QVector3D transformed[4];
 
   int nside = 1 << level;
   boundaries(nside, pix, 1, v);
@@ -115,34 +116,103 @@ void HEALPix::getCornerPoints(int level, int pix, SkyPoint *skyCoords)
   // From rectangular coordinates to Sky coordinates
   for (int i = 0; i < 4; i++)
   {
-      transformed[i].setX(v[i].x());
-      transformed[i].setY(v[i].y());
-      transformed[i].setZ(v[i].z());
+      double ra0 = 0, dec0 = 0;
+      toCatalog(v[i], ra0, dec0);
+      skyCoords[i].setRA0(ra0);
+      skyCoords[i].setDec0(dec0);
 
-      double ra=0, de=0;
-      xyz2sph(transformed[i], ra, de);
-      de /= dms::DegToRad;
-      ra /= dms::DegToRad;
+      skyCoords[i].updateCoords(KStarsData::Instance()->updateNum(), false);
+      skyCoords[i].EquatorialToHorizontal(KStarsData::Instance()->lst(), KStarsData::Instance()->geo()->lat());
+  }
 
-      if (HIPSManager::Instance()->getCurrentFrame() == HIPSManager::HIPS_EQUATORIAL_FRAME)
-      {
-          skyCoords[i].setRA0(ra/15.0);
-          skyCoords[i].setDec0(de);
-      }
-      else
+}
+
+void HEALPix::toCatalog(const QVector3D &vec, double &ra0, double &dec0)
+{
+  // Transform from HealPIX convention to KStars
+  double ra=0, de=0;
+  xyz2sph(vec, ra, de);
+  de /= dms::DegToRad;
+  ra /= dms::DegToRad;
+
+  if (HIPSManager::Instance()->getCurrentFrame() == HIPSManager::HIPS_EQUATORIAL_FRAME)
+  {
+      ra0 = ra/15.0;
+      dec0 = de;
+  }
+  else
+  {
+      SkyPoint point;
+      dms galacticLong(ra);
+      dms galacticLat(de);
+      point.GalacticToEquatorial1950(&galacticLong, &galacticLat);
+      point.B1950ToJ2000();
+      ra0 = point.ra().Hours();
+      dec0 = point.dec().Degrees();
+  }
+}
+
+HEALPix::Tile HEALPix::tile(int level, int pix)
+{
+  // The grid is in J2000 coordinates, so the tables depend on the frame of the survey
+  if (m_TilesFrame != HIPSManager::Instance()->getCurrentFrame())
+  {
+      m_Tiles.clear();
+      m_TilesFrame = HIPSManager::Instance()->getCurrentFrame();
+  }
+
+  if (m_Tiles.size() <= level)
+      m_Tiles.resize(level + 1);
+
+  QHash<int, Tile> &table = m_Tiles[level];
+  auto cached = table.constFind(pix);
+  if (cached != table.constEnd())
+      return cached.value();
+
+  // Only the tiles near the views drawn recently are kept at high orders
+  if (table.size() >= MAX_TILES_PER_ORDER)
+      table.clear();
+
+  Tile tile;
+  int ix, iy, face;
+  int nside = 1 << level;
+  nest2xyf(nside, pix, &ix, &iy, &face);
+
+  // Points of the grid are evaluated once, instead of once for each grandchild sharing them
+  QVector3D grid[GRID_SIZE * GRID_SIZE];
+  for (int y = 0; y < GRID_SIZE; y++)
+  {
+      for (int x = 0; x < GRID_SIZE; x++)
       {
-        dms galacticLong(ra);
-        dms galacticLat(de);
-        skyCoords[i].GalacticToEquatorial1950(&galacticLong, &galacticLat);
-        skyCoords[i].B1950ToJ2000();
-        skyCoords[i].setRA0(skyCoords[i].ra());
-        skyCoords[i].setDec0(skyCoords[i].dec());
+          int index = y * GRID_SIZE + x;
+          double fx = (ix + x / (GRID_SIZE - 1.0)) / nside;
+          double fy = (iy + y / (GRID_SIZE - 1.0)) / nside;
+          toCatalog(toVec3(fx, fy, face), tile.ra0[index], tile.dec0[index]);
+
+          double ra = tile.ra0[index] * 15.0 * dms::DegToRad;
+          double dec = tile.dec0[index] * dms::DegToRad;
+          grid[index] = QVector3D(cos(dec) * cos(ra), cos(dec) * sin(ra), sin(dec));
       }
-
-      skyCoords[i].updateCoords(KStarsData::Instance()->updateNum(), false);
-      skyCoords[i].EquatorialToHorizontal(KStarsData::Instance()->lst(), KStarsData::Instance()->geo()->lat());
   }
 
+  // The center of the tile is the center point of the grid, its radius reaches the farthest border point
+  const int middle = (GRID_SIZE * GRID_SIZE) / 2;
+  tile.center = grid[middle];
+  double minDot = 1;
+  for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++)
+      minDot = qMin(minDot, static_cast<double>(QVector3D::dotProduct(tile.center, grid[i])));
+  // Borders bulge slightly between grid points
+  tile.radius = acos(qBound(-1.0, minDot, 1.0)) * 1.05;
+
+  int dirs[8];
+  neighbours(nside, pix, dirs);
+  tile.neighbours[0] = dirs[0];
+  tile.neighbours[1] = dirs[2];
+  tile.neighbours[2] = dirs[4];
+  tile.neighbours[3] = dirs[6];
+
+  table.insert(pix, tile);
+  return tile;
 }
 
 void HEALPix::boundaries(qint32 nside, qint32 pix, int step, QVector3D *out)
@@ -34,6 +34,8 @@
 
 #include "hips.h"
 
+#include <QHash>
+#include <QVector>
 #include <QVector3D>
 
 class SkyPoint;
@@ -43,6 +45,33 @@ class HEALPix
 public:
   HEALPix() = default;
 
+  /** Number of points along each side of the grid of a tile */
+  static const int GRID_SIZE = 5;
+
+  /**
+   * Geometry of a tile, which does not change from one frame to the next.
+   * The grid spans the 4x4 grandchildren of the tile, point (x, y) being at index y * GRID_SIZE + x.
+   * Its corners are the corners of the tile, see getCornerPoints().
+   */
+  struct Tile
+  {
+      // J2000 coordinates of the grid points, RA in hours and Dec in degrees
+      double ra0[GRID_SIZE * GRID_SIZE];
+      double dec0[GRID_SIZE * GRID_SIZE];
+      // J2000 unit vector of the tile center, and angular radius of the tile around it in radians
+      QVector3D center;
+      float radius;
+      // Tiles sharing an edge with this one: SW, NW, NE and SE
+      int neighbours[4];
+  };
+
+  /**
+   * @brief Get the geometry of a tile. Tiles are computed once, and kept in per-order tables.
+   * @param level order of the tile.
+   * @param pix tile index in the nested scheme.
+   */
+  Tile tile(int level, int pix);
+
   void getCornerPoints(int level, int pix, SkyPoint *skyCoords);
   void neighbours(int nside, qint32 ipix, int *result);
   int  getPix(int level, double ra, double dec);
@@ -53,6 +82,13 @@ private:
   QVector3D toVec3(double fx, double fy, int face);
   void boundaries(qint32 nside, qint32 pix, int step, QVector3D *out);
   int ang2pix_nest_z_phi(qint32 nside_, double z, double phi);
-  void xyz2sph(const QVector3D &vec, double &l, double &b);  
+  void xyz2sph(const QVector3D &vec, double &l, double &b);
+  // Convert a vector of the current HiPS frame to J2000 coordinates, RA in hours and Dec in degrees
+  void toCatalog(const QVector3D &vec, double &ra0, double &dec0);
+
+  // Tiles computed so far, indexed by order
+  QVector<QHash<int, Tile>> m_Tiles;
+  // Frame the tiles were computed in
+  int m_TilesFrame { -1 };
 };
 
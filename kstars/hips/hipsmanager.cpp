@@ -344,7 +344,12 @@ void HIPSManager::slotDone(QNetworkReply::NetworkError error, QByteArray &data,
 
     item->image = new QImage();
     if (item->image->loadFromData(data))
-    {      
+    {
+      // Tiles are converted once, the renderer samples 32 bit premultiplied pixels.
+      // Opaque RGB32 pixels are already premultiplied.
+      if (item->image->format() != QImage::Format_ARGB32_Premultiplied && item->image->format() != QImage::Format_RGB32)
+        *item->image = item->image->convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
       addToMemoryCache(key, item);
 
       //SkyMap::Instance()->forceUpdate();
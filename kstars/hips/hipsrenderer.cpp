@@ -21,12 +21,22 @@
 #include "hipsrenderer.h"
 
 #include "colorscheme.h"
+#include "geolocation.h"
+#include "kstarsdata.h"
 #include "kstars_debug.h"
 #include "Options.h"
 #include "skymap.h"
 #include "skyqpainter.h"
 #include "projections/projector.h"
 
+namespace
+{
+// Number of points in the grid of a tile
+const int GRID_POINTS = HEALPix::GRID_SIZE * HEALPix::GRID_SIZE;
+// Indexes of the tile corners in the grid, in the order of HEALPix::getCornerPoints()
+const int CORNERS[4] = { GRID_POINTS - 1, GRID_POINTS - HEALPix::GRID_SIZE, 0, HEALPix::GRID_SIZE - 1 };
+}
+
 HIPSRenderer::HIPSRenderer()
 {
     m_scanRender.reset(new ScanRender());
@@ -82,20 +92,24 @@ bool HIPSRenderer::render(uint16_t w, uint16_t h, QImage *hipsImage, const Proje
     allSky = false;
   }         
 
-  int centerPix = m_HEALpix->getPix(level, ra, de);
-
-  SkyPoint cornerSkyCoords[4];
-  QPointF tileLine[2];
-  m_HEALpix->getCornerPoints(level, centerPix, cornerSkyCoords);
+  m_updateNum = KStarsData::Instance()->updateNum();
+  m_lst = KStarsData::Instance()->lst();
+  m_lat = KStarsData::Instance()->geo()->lat();
 
-  //qCDebug(KSTARS) << "#" << i+1 << "RA0" << cornerSkyCoords[i].ra0().toHMSString();
-  //qCDebug(KSTARS) << "#" << i+1 << "DE0" << cornerSkyCoords[i].dec0().toHMSString();
+  // Cone around the view in J2000 coordinates, the tiles drawn are the ones intersecting it.
+  // Away from the center, non linear projections show more sky than the field of view.
+  m_viewCenter = QVector3D(cos(de) * cos(ra), cos(de) * sin(ra), sin(de));
+  m_viewRadius = qMin(dms::PI, 1.6 * m_proj->fov() * dms::DegToRad + 2 * dms::DegToRad);
 
-  //qCDebug(KSTARS) << "#" << i+1 << "X" << tileLine[i].x();
-  //qCDebug(KSTARS) << "#" << i+1 << "Y" << tileLine[i].y();
+  int centerPix = m_HEALpix->getPix(level, ra, de);
+  const HEALPix::Tile centerTile = m_HEALpix->tile(level, centerPix);
 
+  QPointF tileLine[2];
   for (int i=0; i < 2; i++)
-      tileLine[i] = m_projector->toScreen(&cornerSkyCoords[i]);
+  {
+      SkyPoint corner = toSkyPoint(centerTile, CORNERS[i]);
+      tileLine[i] = m_projector->toScreen(&corner);
+  }
 
   int size = std::sqrt(std::pow(tileLine[0].x()-tileLine[1].x(), 2) + std::pow(tileLine[0].y()-tileLine[1].y(), 2));
   if (size < 0)
@@ -113,43 +127,87 @@ bool HIPSRenderer::render(uint16_t w, uint16_t h, QImage *hipsImage, const Proje
 
 void HIPSRenderer::renderRec(bool allsky, int level, int pix, QImage *pDest)
 {
-  if (m_renderedMap.contains(pix))
-  {
-    return;
-  }
+  // Tiles are visited breadth first from the center, through the neighbours intersecting the view
+  QVector<int> queue;
+  queue.append(pix);
+  m_renderedMap.insert(pix);
 
-  if (renderPix(allsky, level, pix, pDest))
+  for (int i = 0; i < queue.size(); i++)
   {
-    m_renderedMap.insert(pix);
-    int dirs[8];
-    int nside = 1 << level;
+    const HEALPix::Tile tile = m_HEALpix->tile(level, queue[i]);
+    if (isInView(tile) == false)
+      continue;
 
-    m_HEALpix->neighbours(nside, pix, dirs);
+    renderPix(allsky, level, queue[i], tile, pDest);
 
-    renderRec(allsky, level, dirs[0], pDest);
-    renderRec(allsky, level, dirs[2], pDest);
-    renderRec(allsky, level, dirs[4], pDest);
-    renderRec(allsky, level, dirs[6], pDest);
+    for (int neighbour : tile.neighbours)
+    {
+      if (neighbour >= 0 && m_renderedMap.contains(neighbour) == false)
+      {
+        m_renderedMap.insert(neighbour);
+        queue.append(neighbour);
+      }
+    }
   }
 }
 
-bool HIPSRenderer::renderPix(bool allsky, int level, int pix, QImage *pDest)
+bool HIPSRenderer::isInView(const HEALPix::Tile &tile) const
 {
-  SkyPoint cornerSkyCoords[4];
-  QPointF cornerScreenCoords[4];
-  bool freeImage = false;
+  double cosDistance = qBound(-1.0, static_cast<double>(QVector3D::dotProduct(m_viewCenter, tile.center)), 1.0);
+  return std::acos(cosDistance) <= m_viewRadius + tile.radius;
+}
 
-  m_HEALpix->getCornerPoints(level, pix, cornerSkyCoords);
+SkyPoint HIPSRenderer::toSkyPoint(const HEALPix::Tile &tile, int index) const
+{
+  SkyPoint point;
+  point.setRA0(tile.ra0[index]);
+  point.setDec0(tile.dec0[index]);
+  point.updateCoords(m_updateNum, false);
+  point.EquatorialToHorizontal(m_lst, m_lat);
+  return point;
+}
+
+bool HIPSRenderer::projectCorners(const HEALPix::Tile &tile, QPointF *grid) const
+{
   bool isVisible = false;
 
-  for (int i=0; i < 4; i++)
+  for (int index : CORNERS)
   {
-      cornerScreenCoords[i] = m_projector->toScreen(&cornerSkyCoords[i]);
-      isVisible |= m_projector->checkVisibility(&cornerSkyCoords[i]);
-  }  
+    SkyPoint point = toSkyPoint(tile, index);
+    grid[index] = m_projector->toScreen(&point);
+    isVisible |= m_projector->checkVisibility(&point);
+  }
+
+  return isVisible;
+}
 
-  //if (SKPLANECheckFrustumToPolygon(trfGetFrustum(), pts, 4))
-  // Is the right way to do this?
+void HIPSRenderer::projectGrid(const HEALPix::Tile &tile, QPointF *grid) const
+{
+  const int last = HEALPix::GRID_SIZE - 1;
+
+  for (int index = 0; index < GRID_POINTS; index++)
+  {
+    int x = index % HEALPix::GRID_SIZE;
+    int y = index / HEALPix::GRID_SIZE;
+    // Corners are already projected
+    if ((x == 0 || x == last) && (y == 0 || y == last))
+      continue;
+
+    SkyPoint point = toSkyPoint(tile, index);
+    grid[index] = m_projector->toScreen(&point);
+  }
+}
+
+bool HIPSRenderer::renderPix(bool allsky, int level, int pix, const HEALPix::Tile &tile, QImage *pDest)
+{
+  QPointF grid[GRID_POINTS];
+  bool freeImage = false;
+
+  bool isVisible = projectCorners(tile, grid);
+
+  QPointF cornerScreenCoords[4];
+  for (int i = 0; i < 4; i++)
+    cornerScreenCoords[i] = grid[CORNERS[i]];
 
   if (isVisible)
   {
@@ -202,34 +260,18 @@ bool HIPSRenderer::renderPix(bool allsky, int level, int pix, QImage *pDest)
                            {QPointF(1, 1), QPointF(1, 0.75), QPointF(.75, .75),QPointF(.75, 1)},
                           };
 
-      int childPixelID[4];
+      // The 4x4 grandchildren are drawn from the grid of the tile, which is projected once
+      projectGrid(tile, grid);
 
-      // Find all the 4 children of the current pixel
-      m_HEALpix->getPixChilds(pix, childPixelID);
-
-      int j = 0;
-      for (int id : childPixelID)
+      for (int j = 0; j < 16; j++)
       {
-        int grandChildPixelID[4];
-        // Find the children of this child (i.e. grand child)
-        // Then we have 4x4 pixels under the primary pixel
-        // The image is interpolated and rendered over these pixels
-        // coordinate to minimize any distortions due to the projection
-        // system.
-        m_HEALpix->getPixChilds(id, grandChildPixelID);
-
-        QPointF fineScreenCoords[4];
-
-        for (int id2 : grandChildPixelID)
-        {
-          SkyPoint fineSkyPoints[4];
-          m_HEALpix->getCornerPoints(level + 2, id2, fineSkyPoints);
-
-          for (int i = 0; i < 4; i++)
-              fineScreenCoords[i] = m_projector->toScreen(&fineSkyPoints[i]);
-          m_scanRender->renderPolygon(3, fineScreenCoords, pDest, image, uv[j]);
-          j++;
-        }
+        // Grandchild j is child j % 4 of child j / 4, and the nested scheme interleaves the x and y bits
+        int x = ((j >> 2) & 1) * 2 + (j & 1);
+        int y = ((j >> 3) & 1) * 2 + ((j >> 1) & 1);
+
+        QPointF fineScreenCoords[4] = { grid[(y + 1) * HEALPix::GRID_SIZE + x + 1], grid[(y + 1) * HEALPix::GRID_SIZE + x],
+                                        grid[y * HEALPix::GRID_SIZE + x], grid[y * HEALPix::GRID_SIZE + x + 1] };
+        m_scanRender->renderPolygon(3, fineScreenCoords, pDest, image, uv[j]);
       }
 
       if (freeImage)
@@ -26,6 +26,8 @@
 
 #include <memory>
 
+class CachingDms;
+class KSNumbers;
 class Projector;
 
 class HIPSRenderer : public QObject
@@ -36,13 +38,22 @@ public:
   //void render(mapView_t *view, CSkPainter *painter, QImage *pDest);
   bool render(uint16_t w, uint16_t h, QImage *hipsImage, const Projector *m_proj);
   void renderRec(bool allsky, int level, int pix, QImage *pDest);
-  bool renderPix(bool allsky, int level, int pix, QImage *pDest);
+  bool renderPix(bool allsky, int level, int pix, const HEALPix::Tile &tile, QImage *pDest);
 
 signals:
 
 public slots:
 
-private:  
+private:
+  // True if a tile intersects the cone around the view
+  bool isInView(const HEALPix::Tile &tile) const;
+  // Coordinates of a point of a tile grid, for the frame being drawn
+  SkyPoint toSkyPoint(const HEALPix::Tile &tile, int index) const;
+  // Project the corners of a tile grid, return true if one of them is visible
+  bool projectCorners(const HEALPix::Tile &tile, QPointF *grid) const;
+  // Project the other points of a tile grid
+  void projectGrid(const HEALPix::Tile &tile, QPointF *grid) const;
+
   int m_blocks { 0 };
   int m_rendered { 0 };
   int m_size { 0 };
@@ -50,5 +61,11 @@ private:
   std::unique_ptr<HEALPix> m_HEALpix;
   std::unique_ptr<ScanRender> m_scanRender;
   const Projector *m_projector;
+  // State of the frame being drawn
+  const KSNumbers *m_updateNum { nullptr };
+  const CachingDms *m_lst { nullptr };
+  const CachingDms *m_lat { nullptr };
+  QVector3D m_viewCenter;
+  double m_viewRadius { 0 };
   QColor gridColor;
 };
@@ -335,10 +335,33 @@ void ScanRender::setOpacity(float opacity)
   m_opacity = opacity;
 }
 
+bool ScanRender::setInstructionSet(ScanSpan::InstructionSet set)
+{
+  const ScanSpan::Functions *span = ScanSpan::functions(set);
+  if (span == nullptr)
+    return false;
+
+  m_span = span;
+  return true;
+}
+
+ScanSpan::InstructionSet ScanRender::instructionSet() const
+{
+  return m_span->set;
+}
+
 /////////////////////////////////////////////////////////
 void ScanRender::renderPolygon(QImage *dst, QImage *src)
 /////////////////////////////////////////////////////////
 {
+  // Sources are expected in premultiplied ARGB32, see HIPSManager
+  if (src->depth() != 32)
+  {
+    QImage converted = src->convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    renderPolygon(dst, &converted);
+    return;
+  }
+
   if (bBilinear)
     renderPolygonBI(dst, src);
   else
@@ -425,7 +448,6 @@ void ScanRender::renderPolygonNI(QImage *dst, QImage *src)
   const quint32 *bitsSrc = (quint32 *)src->constBits();
   quint32 *bitsDst = (quint32 *)dst->bits();
   bkScan_t *scan = scLR;
-  bool bw = src->format() == QImage::Format_Indexed8 || src->format() == QImage::Format_Grayscale8;      
 
   //#pragma omp parallel for
   for (int y = plMinY; y <= plMaxY; y++)
@@ -485,33 +507,8 @@ void ScanRender::renderPolygonNI(QImage *dst, QImage *src)
     fuv[0] = CLAMP(fuv[0], 0, (sw - 1) * 65536.);
     fuv[1] = CLAMP(fuv[1], 0, (sh - 1) * 65536.);
 
-    if (bw)
-    {
-      for (int x = px1; x < px2; x++)
-      {
-        const uchar *pSrc = (uchar *)bitsSrc + (fuv[0] >> 16) + ((fuv[1] >> 16) * sw);
-        *pDst = qRgb(*pSrc, *pSrc, *pSrc);
-        pDst++;
-
-        fuv[0] += fduv[0];
-        fuv[1] += fduv[1];
-      }      
-    }
-    else
-    {                  
-      for (int x = px1; x < px2; x++)
-      {        
-        int offset = (fuv[0] >> 16) + ((fuv[1] >> 16) * sw);        
-
-        const quint32 *pSrc = bitsSrc + offset;
-        *pDst = (*pSrc) | (0xFF << 24);
-
-        pDst++;
-
-        fuv[0] += fduv[0];
-        fuv[1] += fduv[1];
-      }
-    }
+    if (px2 > px1)
+      m_span->nearest(pDst, px2 - px1, bitsSrc, sw, sh, fuv[0], fuv[1], fduv[0], fduv[1]);
   }
 }
 
@@ -526,10 +523,8 @@ void ScanRender::renderPolygonBI(QImage *dst, QImage *src)
   float tsx = src->width() - 1;
   float tsy = src->height() - 1;
   const quint32 *bitsSrc = (quint32 *)src->constBits();
-  const uchar *bitsSrc8 = (uchar *)src->constBits();
   quint32 *bitsDst = (quint32 *)dst->bits();
   bkScan_t *scan = scLR;
-  bool bw = src->format() == QImage::Format_Indexed8 || src->format() == QImage::Format_Grayscale8;
 
 #ifdef PARALLEL_OMP
   #pragma omp parallel for
@@ -577,76 +572,11 @@ void ScanRender::renderPolygonBI(QImage *dst, QImage *src)
     duv[0] *= tsx;
     duv[1] *= tsy;
 
-    int size = sw * sh;
-
     quint32 *pDst = bitsDst + (y * w) + px1;
-    if (bw)
-    {
-      for (int x = px1; x < px2; x++)
-      {
-        float x_diff = uv[0] - static_cast<int>(uv[0]);
-        float y_diff = uv[1] - static_cast<int>(uv[1]);
-        float x_1diff = 1 - x_diff;
-        float y_1diff = 1 - y_diff;
-
-        int index = ((int)uv[0] + ((int)uv[1] * sw));
 
-        uchar a = bitsSrc8[index];
-        uchar b = bitsSrc8[(index + 1) % size];
-        uchar c = bitsSrc8[(index + sw) % size];
-        uchar d = bitsSrc8[(index + sw + 1) % size];
-
-        int val = (a&0xff)*(x_1diff)*(y_1diff) + (b&0xff)*(x_diff)*(y_1diff) +
-                  (c&0xff)*(y_diff)*(x_1diff)   + (d&0xff)*(x_diff*y_diff);
-
-        *pDst = 0xff000000 |
-                ((((int)val)<<16)&0xff0000) |
-                ((((int)val)<<8)&0xff00) |
-                ((int)val) ;
-        pDst++;
-
-        uv[0] += duv[0];
-        uv[1] += duv[1];
-      }
-    }
-    else
-    {
-      for (int x = px1; x < px2; x++)
-      {
-        float x_diff = uv[0] - static_cast<int>(uv[0]);
-        float y_diff = uv[1] - static_cast<int>(uv[1]);
-        float x_1diff = 1 - x_diff;
-        float y_1diff = 1 - y_diff;
-
-        int index = ((int)uv[0] + ((int)uv[1] * sw));
-
-        quint32 a = bitsSrc[index];
-        quint32 b = bitsSrc[(index + 1) % size];
-        quint32 c = bitsSrc[(index + sw) % size];
-        quint32 d = bitsSrc[(index + sw + 1) % size];
-
-        int qxy1 = (x_1diff * y_1diff) * 65536;
-        int qxy2 =(x_diff * y_1diff) * 65536;
-        int qxy = (x_diff * y_diff) * 65536;
-        int qyx1 = (y_diff * x_1diff) * 65536;
-
-        // blue element
-        int blue = ((a&0xff)*(qxy1) + (b&0xff)*(qxy2) + (c&0xff)*(qyx1)  + (d&0xff)*(qxy)) >> 16;
-
-        // green element
-        int green = (((a>>8)&0xff)*(qxy1) + ((b>>8)&0xff)*(qxy2) + ((c>>8)&0xff)*(qyx1)  + ((d>>8)&0xff)*(qxy)) >> 16;
-
-        // red element
-        int red = (((a>>16)&0xff)*(qxy1) + ((b>>16)&0xff)*(qxy2) +((c>>16)&0xff)*(qyx1)  + ((d>>16)&0xff)*(qxy)) >> 16;
-
-        *pDst = 0xff000000 | (((red)<<16)&0xff0000) | (((green)<<8)&0xff00) | (blue);
-
-        pDst++;
-
-        uv[0] += duv[0];
-        uv[1] += duv[1];
-      }
-    }
+    // Samples are positioned in 16.16 fixed point, and clamped to the source by the span functions
+    if (px2 > px1)
+      m_span->bilinear(pDst, px2 - px1, bitsSrc, sw, sh, uv[0] * 65536, uv[1] * 65536, duv[0] * 65536, duv[1] * 65536);
   }
 }
 
@@ -795,7 +725,8 @@ void ScanRender::renderPolygonAlphaBI(QImage *dst, QImage *src)
           int gd = qGreen(*pDst);
           int bd = qBlue(*pDst);
 
-          *pDst = qRgb(LERP(alpha, rd,  red), LERP(alpha, gd, green),  LERP(alpha, bd, blue));
+          // Source channels are premultiplied by their alpha
+          *pDst = qRgb(red * m_opacity + rd * (1 - alpha), green * m_opacity + gd * (1 - alpha), blue * m_opacity + bd * (1 - alpha));
         }
 
         pDst++;
@@ -878,9 +809,10 @@ void ScanRender::renderPolygonAlphaNI(QImage *dst, QImage *src)
 
       if (a > 0.00390625f)
       {
-        *pDst = qRgb(LERP(a, qRed(rgbd), qRed(rgbs)),
-                     LERP(a, qGreen(rgbd), qGreen(rgbs)),
-                     LERP(a, qBlue(rgbd), qBlue(rgbs))
+        // Source channels are premultiplied by their alpha
+        *pDst = qRgb(qRed(rgbs) * m_opacity + qRed(rgbd) * (1 - a),
+                     qGreen(rgbs) * m_opacity + qGreen(rgbd) * (1 - a),
+                     qBlue(rgbs) * m_opacity + qBlue(rgbd) * (1 - a)
                      );        
       }
       pDst++;
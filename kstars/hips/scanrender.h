@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include "scanspan.h"
+
 #include <QtCore>
 #include <QtGui>
 
@@ -55,6 +57,10 @@ class ScanRender
     void renderPolygonAlpha(QColor col, QImage *dst);
     void setOpacity(float opacity);
 
+    /** Draw the textured polygons with the span functions of an instruction set, returns false if it is not supported */
+    bool setInstructionSet(ScanSpan::InstructionSet set);
+    ScanSpan::InstructionSet instructionSet() const;
+
 private:
     float    m_opacity { 1.0f };
     int      plMinY { 0 };
@@ -63,4 +69,5 @@ private:
     int      m_sy { 0 };
     bkScan_t scLR[MAX_BK_SCANLINES];
     bool     bBilinear { false };
+    const ScanSpan::Functions *m_span { ScanSpan::best() };
 };
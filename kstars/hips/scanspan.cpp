@@ -0,0 +1,380 @@
+/*  Span functions of the HiPS scanline renderer, for the instruction sets of the CPU
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+*/
+
+#include "scanspan.h"
+
+#include "kstars_debug.h"
+
+// SSE2 is part of x86-64, and NEON of ARMv8, so both are used as soon as the compiler targets them.
+// AVX2 code is compiled for its own functions only, and used if the CPU supports it.
+#if defined(__SSE2__) || defined(_M_X64)
+#define SCANSPAN_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SCANSPAN_AVX2
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SCANSPAN_NEON
+#include <arm_neon.h>
+#endif
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wcast-align"
+
+namespace
+{
+const quint32 OPAQUE = 0xff000000;
+
+// Average of two pixels, channel by channel, with weights summing to 256
+inline quint32 interpolate256(quint32 x, uint a, quint32 y, uint b)
+{
+  quint32 t = (x & 0xff00ff) * a + (y & 0xff00ff) * b;
+  t >>= 8;
+  t &= 0xff00ff;
+
+  x = ((x >> 8) & 0xff00ff) * a + ((y >> 8) & 0xff00ff) * b;
+  x &= 0xff00ff00;
+
+  return x | t;
+}
+
+// Four pixels around a source position, and the weights of the right and bottom ones out of 256.
+// Positions are clamped to the source, so that borders are repeated.
+inline void fetchSample(const quint32 *src, int sw, int sh, int u, int v,
+                        quint32 &tl, quint32 &tr, quint32 &bl, quint32 &br, uint &dx, uint &dy)
+{
+  int x0 = qBound(0, u >> 16, sw - 1);
+  int y0 = qBound(0, v >> 16, sh - 1);
+  int x1 = qMin(x0 + 1, sw - 1);
+  int y1 = qMin(y0 + 1, sh - 1);
+
+  const quint32 *row0 = src + y0 * sw;
+  const quint32 *row1 = src + y1 * sw;
+
+  tl = row0[x0];
+  tr = row0[x1];
+  bl = row1[x0];
+  br = row1[x1];
+  dx = (u >> 8) & 0xff;
+  dy = (v >> 8) & 0xff;
+}
+
+void nearestGeneric(quint32 *dst, int count, const quint32 *src, int sw, int sh, int u, int v, int du, int dv)
+{
+  Q_UNUSED(sh);
+
+  for (int i = 0; i < count; i++)
+  {
+    dst[i] = src[(u >> 16) + (v >> 16) * sw] | OPAQUE;
+    u += du;
+    v += dv;
+  }
+}
+
+void bilinearGeneric(quint32 *dst, int count, const quint32 *src, int sw, int sh, int u, int v, int du, int dv)
+{
+  for (int i = 0; i < count; i++)
+  {
+    quint32 tl, tr, bl, br;
+    uint dx, dy;
+    fetchSample(src, sw, sh, u, v, tl, tr, bl, br, dx, dy);
+
+    quint32 top = interpolate256(tl, 256 - dx, tr, dx);
+    quint32 bottom = interpolate256(bl, 256 - dx, br, dx);
+    dst[i] = interpolate256(top, 256 - dy, bottom, dy) | OPAQUE;
+
+    u += du;
+    v += dv;
+  }
+}
+
+#ifdef SCANSPAN_SSE2
+// Channels are widened to 16 bits, two pixels per register. The products of a channel and of a
+// weight out of 256 fit in 16 bits, so (p * (256 - w) + q * w) >> 8 is computed exactly as interpolate256().
+inline __m128i interpolateSSE2(__m128i p, __m128i q, __m128i w)
+{
+  const __m128i full = _mm_set1_epi16(256);
+  __m128i sum = _mm_add_epi16(_mm_mullo_epi16(p, _mm_sub_epi16(full, w)), _mm_mullo_epi16(q, w));
+  return _mm_srli_epi16(sum, 8);
+}
+
+// Spread the weights of four pixels over the 16 bit channels of the first two, and of the last two
+inline void expandWeightsSSE2(__m128i w, __m128i &low, __m128i &high)
+{
+  low = _mm_unpacklo_epi32(w, w);
+  high = _mm_unpackhi_epi32(w, w);
+  low = _mm_shufflehi_epi16(_mm_shufflelo_epi16(low, _MM_SHUFFLE(0, 0, 0, 0)), _MM_SHUFFLE(0, 0, 0, 0));
+  high = _mm_shufflehi_epi16(_mm_shufflelo_epi16(high, _MM_SHUFFLE(0, 0, 0, 0)), _MM_SHUFFLE(0, 0, 0, 0));
+}
+
+void bilinearSSE2(quint32 *dst, int count, const quint32 *src, int sw, int sh, int u, int v, int du, int dv)
+{
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i opaque = _mm_set1_epi32(static_cast<int>(OPAQUE));
+
+  int i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    // SSE2 has no gather, the pixels are fetched one by one and interpolated four at a time.
+    // Registers are built from the values directly, loading them from memory right after storing
+    // them would stall store forwarding.
+    quint32 tl[4], tr[4], bl[4], br[4];
+    uint dx[4], dy[4];
+    for (int k = 0; k < 4; k++)
+    {
+      fetchSample(src, sw, sh, u, v, tl[k], tr[k], bl[k], br[k], dx[k], dy[k]);
+      u += du;
+      v += dv;
+    }
+
+    __m128i dxLow, dxHigh, dyLow, dyHigh;
+    expandWeightsSSE2(_mm_setr_epi32(dx[0], dx[1], dx[2], dx[3]), dxLow, dxHigh);
+    expandWeightsSSE2(_mm_setr_epi32(dy[0], dy[1], dy[2], dy[3]), dyLow, dyHigh);
+
+    __m128i topLeft = _mm_setr_epi32(tl[0], tl[1], tl[2], tl[3]);
+    __m128i topRight = _mm_setr_epi32(tr[0], tr[1], tr[2], tr[3]);
+    __m128i bottomLeft = _mm_setr_epi32(bl[0], bl[1], bl[2], bl[3]);
+    __m128i bottomRight = _mm_setr_epi32(br[0], br[1], br[2], br[3]);
+
+    __m128i topLow = interpolateSSE2(_mm_unpacklo_epi8(topLeft, zero), _mm_unpacklo_epi8(topRight, zero), dxLow);
+    __m128i topHigh = interpolateSSE2(_mm_unpackhi_epi8(topLeft, zero), _mm_unpackhi_epi8(topRight, zero), dxHigh);
+    __m128i bottomLow = interpolateSSE2(_mm_unpacklo_epi8(bottomLeft, zero), _mm_unpacklo_epi8(bottomRight, zero), dxLow);
+    __m128i bottomHigh = interpolateSSE2(_mm_unpackhi_epi8(bottomLeft, zero), _mm_unpackhi_epi8(bottomRight, zero), dxHigh);
+
+    __m128i low = interpolateSSE2(topLow, bottomLow, dyLow);
+    __m128i high = interpolateSSE2(topHigh, bottomHigh, dyHigh);
+
+    _mm_storeu_si128((__m128i *)(dst + i), _mm_or_si128(_mm_packus_epi16(low, high), opaque));
+  }
+
+  bilinearGeneric(dst + i, count - i, src, sw, sh, u, v, du, dv);
+}
+#endif
+
+#ifdef SCANSPAN_AVX2
+// Same as the SSE2 functions, in each 128 bit lane of the AVX2 registers
+__attribute__((target("avx2"))) inline __m256i interpolateAVX2(__m256i p, __m256i q, __m256i w)
+{
+  const __m256i full = _mm256_set1_epi16(256);
+  __m256i sum = _mm256_add_epi16(_mm256_mullo_epi16(p, _mm256_sub_epi16(full, w)), _mm256_mullo_epi16(q, w));
+  return _mm256_srli_epi16(sum, 8);
+}
+
+__attribute__((target("avx2"))) inline void expandWeightsAVX2(__m256i w, __m256i &low, __m256i &high)
+{
+  low = _mm256_unpacklo_epi32(w, w);
+  high = _mm256_unpackhi_epi32(w, w);
+  low = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(low, _MM_SHUFFLE(0, 0, 0, 0)), _MM_SHUFFLE(0, 0, 0, 0));
+  high = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(high, _MM_SHUFFLE(0, 0, 0, 0)), _MM_SHUFFLE(0, 0, 0, 0));
+}
+
+__attribute__((target("avx2")))
+void nearestAVX2(quint32 *dst, int count, const quint32 *src, int sw, int sh, int u, int v, int du, int dv)
+{
+  const __m256i steps = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  const __m256i width = _mm256_set1_epi32(sw);
+  const __m256i opaque = _mm256_set1_epi32(static_cast<int>(OPAQUE));
+  const __m256i du8 = _mm256_set1_epi32(du * 8);
+  const __m256i dv8 = _mm256_set1_epi32(dv * 8);
+
+  __m256i uu = _mm256_add_epi32(_mm256_set1_epi32(u), _mm256_mullo_epi32(steps, _mm256_set1_epi32(du)));
+  __m256i vv = _mm256_add_epi32(_mm256_set1_epi32(v), _mm256_mullo_epi32(steps, _mm256_set1_epi32(dv)));
+
+  int i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    __m256i offset = _mm256_add_epi32(_mm256_srai_epi32(uu, 16), _mm256_mullo_epi32(_mm256_srai_epi32(vv, 16), width));
+    __m256i pixels = _mm256_i32gather_epi32((const int *)src, offset, 4);
+    _mm256_storeu_si256((__m256i *)(dst + i), _mm256_or_si256(pixels, opaque));
+
+    uu = _mm256_add_epi32(uu, du8);
+    vv = _mm256_add_epi32(vv, dv8);
+    u += du * 8;
+    v += dv * 8;
+  }
+
+  nearestGeneric(dst + i, count - i, src, sw, sh, u, v, du, dv);
+}
+
+__attribute__((target("avx2")))
+void bilinearAVX2(quint32 *dst, int count, const quint32 *src, int sw, int sh, int u, int v, int du, int dv)
+{
+  const __m256i steps = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i width = _mm256_set1_epi32(sw);
+  const __m256i maxX = _mm256_set1_epi32(sw - 1);
+  const __m256i maxY = _mm256_set1_epi32(sh - 1);
+  const __m256i one = _mm256_set1_epi32(1);
+  const __m256i fraction = _mm256_set1_epi32(0xff);
+  const __m256i opaque = _mm256_set1_epi32(static_cast<int>(OPAQUE));
+  const __m256i du8 = _mm256_set1_epi32(du * 8);
+  const __m256i dv8 = _mm256_set1_epi32(dv * 8);
+
+  __m256i uu = _mm256_add_epi32(_mm256_set1_epi32(u), _mm256_mullo_epi32(steps, _mm256_set1_epi32(du)));
+  __m256i vv = _mm256_add_epi32(_mm256_set1_epi32(v), _mm256_mullo_epi32(steps, _mm256_set1_epi32(dv)));
+
+  int i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    __m256i x0 = _mm256_min_epi32(_mm256_max_epi32(_mm256_srai_epi32(uu, 16), zero), maxX);
+    __m256i y0 = _mm256_min_epi32(_mm256_max_epi32(_mm256_srai_epi32(vv, 16), zero), maxY);
+    __m256i x1 = _mm256_min_epi32(_mm256_add_epi32(x0, one), maxX);
+    __m256i y1 = _mm256_min_epi32(_mm256_add_epi32(y0, one), maxY);
+    __m256i row0 = _mm256_mullo_epi32(y0, width);
+    __m256i row1 = _mm256_mullo_epi32(y1, width);
+
+    __m256i topLeft = _mm256_i32gather_epi32((const int *)src, _mm256_add_epi32(row0, x0), 4);
+    __m256i topRight = _mm256_i32gather_epi32((const int *)src, _mm256_add_epi32(row0, x1), 4);
+    __m256i bottomLeft = _mm256_i32gather_epi32((const int *)src, _mm256_add_epi32(row1, x0), 4);
+    __m256i bottomRight = _mm256_i32gather_epi32((const int *)src, _mm256_add_epi32(row1, x1), 4);
+
+    __m256i dxLow, dxHigh, dyLow, dyHigh;
+    expandWeightsAVX2(_mm256_and_si256(_mm256_srai_epi32(uu, 8), fraction), dxLow, dxHigh);
+    expandWeightsAVX2(_mm256_and_si256(_mm256_srai_epi32(vv, 8), fraction), dyLow, dyHigh);
+
+    __m256i topLow = interpolateAVX2(_mm256_unpacklo_epi8(topLeft, zero), _mm256_unpacklo_epi8(topRight, zero), dxLow);
+    __m256i topHigh = interpolateAVX2(_mm256_unpackhi_epi8(topLeft, zero), _mm256_unpackhi_epi8(topRight, zero), dxHigh);
+    __m256i bottomLow = interpolateAVX2(_mm256_unpacklo_epi8(bottomLeft, zero), _mm256_unpacklo_epi8(bottomRight, zero), dxLow);
+    __m256i bottomHigh = interpolateAVX2(_mm256_unpackhi_epi8(bottomLeft, zero), _mm256_unpackhi_epi8(bottomRight, zero), dxHigh);
+
+    __m256i low = interpolateAVX2(topLow, bottomLow, dyLow);
+    __m256i high = interpolateAVX2(topHigh, bottomHigh, dyHigh);
+
+    // Unpacking and packing both work within 128 bit lanes, so the pixels are back in order
+    _mm256_storeu_si256((__m256i *)(dst + i), _mm256_or_si256(_mm256_packus_epi16(low, high), opaque));
+
+    uu = _mm256_add_epi32(uu, du8);
+    vv = _mm256_add_epi32(vv, dv8);
+    u += du * 8;
+    v += dv * 8;
+  }
+
+  bilinearGeneric(dst + i, count - i, src, sw, sh, u, v, du, dv);
+}
+#endif
+
+#ifdef SCANSPAN_NEON
+inline uint16x8_t interpolateNEON(uint16x8_t p, uint16x8_t q, uint16x8_t w)
+{
+  const uint16x8_t full = vdupq_n_u16(256);
+  return vshrq_n_u16(vmlaq_u16(vmulq_u16(p, vsubq_u16(full, w)), q, w), 8);
+}
+
+void bilinearNEON(quint32 *dst, int count, const quint32 *src, int sw, int sh, int u, int v, int du, int dv)
+{
+  const uint32x4_t opaque = vdupq_n_u32(OPAQUE);
+
+  int i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    quint32 tl[4], tr[4], bl[4], br[4];
+    // Weights of each channel of the four pixels
+    quint16 dx[16], dy[16];
+    for (int k = 0; k < 4; k++)
+    {
+      uint wx, wy;
+      fetchSample(src, sw, sh, u, v, tl[k], tr[k], bl[k], br[k], wx, wy);
+      for (int c = 0; c < 4; c++)
+      {
+        dx[k * 4 + c] = wx;
+        dy[k * 4 + c] = wy;
+      }
+      u += du;
+      v += dv;
+    }
+
+    uint8x16_t topLeft = vreinterpretq_u8_u32(vld1q_u32(tl));
+    uint8x16_t topRight = vreinterpretq_u8_u32(vld1q_u32(tr));
+    uint8x16_t bottomLeft = vreinterpretq_u8_u32(vld1q_u32(bl));
+    uint8x16_t bottomRight = vreinterpretq_u8_u32(vld1q_u32(br));
+
+    uint16x8_t dxLow = vld1q_u16(dx), dxHigh = vld1q_u16(dx + 8);
+    uint16x8_t dyLow = vld1q_u16(dy), dyHigh = vld1q_u16(dy + 8);
+
+    uint16x8_t topLow = interpolateNEON(vmovl_u8(vget_low_u8(topLeft)), vmovl_u8(vget_low_u8(topRight)), dxLow);
+    uint16x8_t topHigh = interpolateNEON(vmovl_u8(vget_high_u8(topLeft)), vmovl_u8(vget_high_u8(topRight)), dxHigh);
+    uint16x8_t bottomLow = interpolateNEON(vmovl_u8(vget_low_u8(bottomLeft)), vmovl_u8(vget_low_u8(bottomRight)), dxLow);
+    uint16x8_t bottomHigh = interpolateNEON(vmovl_u8(vget_high_u8(bottomLeft)), vmovl_u8(vget_high_u8(bottomRight)), dxHigh);
+
+    uint8x16_t pixels = vcombine_u8(vmovn_u16(interpolateNEON(topLow, bottomLow, dyLow)),
+                                    vmovn_u16(interpolateNEON(topHigh, bottomHigh, dyHigh)));
+    vst1q_u32(dst + i, vorrq_u32(vreinterpretq_u32_u8(pixels), opaque));
+  }
+
+  bilinearGeneric(dst + i, count - i, src, sw, sh, u, v, du, dv);
+}
+#endif
+}
+
+#pragma GCC diagnostic pop
+
+const ScanSpan::Functions *ScanSpan::functions(InstructionSet set)
+{
+  static const Functions generic = { GENERIC, "generic", nearestGeneric, bilinearGeneric };
+
+  switch (set)
+  {
+    case GENERIC:
+      return &generic;
+
+    case SSE2:
+#ifdef SCANSPAN_SSE2
+    {
+      // Nearest neighbour sampling is a load per pixel, SSE2 has nothing to add without a gather
+      static const Functions sse2 = { SSE2, "SSE2", nearestGeneric, bilinearSSE2 };
+      return &sse2;
+    }
+#else
+      return nullptr;
+#endif
+
+    case AVX2:
+#ifdef SCANSPAN_AVX2
+      if (__builtin_cpu_supports("avx2"))
+      {
+        static const Functions avx2 = { AVX2, "AVX2", nearestAVX2, bilinearAVX2 };
+        return &avx2;
+      }
+#endif
+      return nullptr;
+
+    case NEON:
+#ifdef SCANSPAN_NEON
+    {
+      static const Functions neon = { NEON, "NEON", nearestGeneric, bilinearNEON };
+      return &neon;
+    }
+#else
+      return nullptr;
+#endif
+  }
+
+  return nullptr;
+}
+
+const ScanSpan::Functions *ScanSpan::best()
+{
+  static const Functions *selected = []() -> const Functions *
+  {
+    for (InstructionSet set : { AVX2, NEON, SSE2 })
+    {
+      if (const Functions *candidate = functions(set))
+      {
+        qCInfo(KSTARS) << "HiPS rendering uses" << candidate->name << "instructions.";
+        return candidate;
+      }
+    }
+    return functions(GENERIC);
+  }();
+
+  return selected;
+}
@@ -0,0 +1,50 @@
+/*  Span functions of the HiPS scanline renderer, for the instruction sets of the CPU
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+*/
+
+#pragma once
+
+#include <QtGlobal>
+
+/**
+ * A span function draws a horizontal run of destination pixels, sampling a premultiplied ARGB32
+ * source image along a line of texture coordinates. The drawn pixels are opaque.
+ *
+ * Texture coordinates are pixel positions in 16.16 fixed point, stepped by integer additions, so
+ * that all the instruction sets draw exactly the same pixels.
+ */
+namespace ScanSpan
+{
+/**
+ * @param dst first destination pixel.
+ * @param count number of pixels to draw.
+ * @param src source pixels.
+ * @param sw source width.
+ * @param sh source height.
+ * @param u horizontal source position of the first pixel.
+ * @param v vertical source position of the first pixel.
+ * @param du horizontal step between pixels.
+ * @param dv vertical step between pixels.
+ */
+typedef void (*Function)(quint32 *dst, int count, const quint32 *src, int sw, int sh, int u, int v, int du, int dv);
+
+typedef enum { GENERIC, SSE2, AVX2, NEON } InstructionSet;
+
+typedef struct
+{
+  InstructionSet set;
+  const char *name;
+  Function nearest;
+  Function bilinear;
+} Functions;
+
+/** @return the span functions of an instruction set, or nullptr if the build or the CPU does not support it */
+const Functions *functions(InstructionSet set);
+
+/** @return the span functions of the fastest instruction set supported, selected on first use */
+const Functions *best();
+}
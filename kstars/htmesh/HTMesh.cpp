@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <iostream>
 
@@ -9,7 +11,11 @@
 #include "SpatialIndex.h"
 #include "RangeConvex.h"
 #include "HtmRange.h"
-#include "HtmRangeIterator.h"
+
+// Number of circle intersections kept by intersectCached()
+#define CACHE_SIZE 8
+// Rounding grid of intersectCached(), in fractions of a trixel edge
+#define CACHE_GRID 16
 
 /******************************************************************************
  * Note: There is "complete" checking for duplicate points in the line and
@@ -20,7 +26,7 @@
  *****************************************************************************/
 
 HTMesh::HTMesh(int level, int buildLevel, int numBuffers)
-    : m_level(level), m_buildLevel(buildLevel), m_numBuffers(numBuffers), htmDebug(0)
+    : m_level(level), m_buildLevel(buildLevel), m_numBuffers(numBuffers), htmDebug(0), m_cacheStamp(0), m_cacheHits(0)
 {
     name = "HTMesh";
     if (m_buildLevel > 0)
@@ -47,6 +53,7 @@ HTMesh::HTMesh(int level, int buildLevel, int numBuffers)
 
     magicNum   = numTrixels;
     degree2Rad = 3.1415926535897932385E0 / 180.0;
+    m_quantum  = edge / degree2Rad / CACHE_GRID;
 
     // Allocate MeshBuffers
     m_meshBuffer = (MeshBuffer **)malloc(sizeof(MeshBuffer *) * numBuffers);
@@ -82,13 +89,13 @@ bool HTMesh::performIntersection(RangeConvex *convex, BufNum bufNum)
     convex->setOlevel(m_level);
     HtmRange range;
     convex->intersect(htm, &range);
-    HtmRangeIterator iterator(&range);
 
     MeshBuffer *buffer = m_meshBuffer[bufNum];
     buffer->reset();
-    while (iterator.hasNext())
+    for (const HtmRange::Interval &interval : range.intervals())
     {
-        buffer->append((Trixel)iterator.next() - magicNum);
+        for (Key id = interval.lo; id <= interval.hi; id++)
+            buffer->append((Trixel)id - magicNum);
     }
 
     if (buffer->error())
@@ -112,6 +119,63 @@ void HTMesh::intersect(double ra, double dec, double radius, BufNum bufNum)
         printf("In intersect(%f, %f, %f)\n", ra, dec, radius);
 }
 
+void HTMesh::intersectCached(double ra, double dec, double radius, BufNum bufNum)
+{
+    if (!validBufNum(bufNum))
+        return;
+
+    ra = fmod(ra, 360.0);
+    if (ra < 0)
+        ra += 360.0;
+
+    int qRa     = (int)lround(ra / m_quantum);
+    int qDec    = (int)lround(dec / m_quantum);
+    int qRadius = (int)ceil(radius / m_quantum);
+
+    MeshBuffer *buffer = m_meshBuffer[bufNum];
+    m_cacheStamp++;
+
+    for (CacheEntry &entry : m_cache)
+    {
+        if (entry.ra == qRa && entry.dec == qDec && entry.radius == qRadius)
+        {
+            entry.stamp = m_cacheStamp;
+            buffer->reset();
+            for (Trixel trixel : entry.trixels)
+                buffer->append(trixel);
+            m_cacheHits++;
+            return;
+        }
+    }
+
+    // The rounded center is less than one grid step away from the actual one,
+    // so one more step of radius covers the requested circle.
+    double qra  = qRa * m_quantum;
+    double qdec = std::max(-90.0, std::min(90.0, qDec * m_quantum));
+    intersect(qra, qdec, std::min(180.0, (qRadius + 1) * m_quantum), bufNum);
+    if (buffer->error())
+        return;
+
+    // Replace the least recently used entry once the cache is full
+    std::vector<CacheEntry>::iterator entry;
+    if (m_cache.size() < (size_t)CACHE_SIZE)
+        entry = m_cache.insert(m_cache.end(), CacheEntry());
+    else
+        entry = std::min_element(m_cache.begin(), m_cache.end(),
+                                 [](const CacheEntry &a, const CacheEntry &b) { return a.stamp < b.stamp; });
+
+    entry->ra     = qRa;
+    entry->dec    = qDec;
+    entry->radius = qRadius;
+    entry->stamp  = m_cacheStamp;
+    entry->trixels.assign(buffer->buffer(), buffer->buffer() + buffer->size());
+}
+
+void HTMesh::clearCache()
+{
+    m_cache.clear();
+}
+
 // TRIANGLE
 void HTMesh::intersect(double ra1, double dec1, double ra2, double dec2, double ra3, double dec3, BufNum bufNum)
 {
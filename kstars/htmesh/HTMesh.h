@@ -16,6 +16,7 @@
 #define HTMESH_H
 
 #include <cstdio>
+#include <vector>
 #include "typedef.h"
 
 class SpatialIndex;
@@ -98,6 +99,32 @@ class HTMesh
          */
     void intersect(double ra, double dec, double radius, BufNum bufNum = 0);
 
+    /**
+         *@short finds the trixels that cover the specified circle, reusing
+         * recent results.
+         *
+         * The center and the radius are rounded to a grid a few times finer
+         * than the trixels, and the radius is enlarged so that the circle
+         * remains covered.  Redraws of the same view and small pans are then
+         * answered from a small cache of recent results instead of a new
+         * intersection.  The result may hold a few more trixels than
+         * intersect() would return.
+         *@param ra Central ra in degrees
+         *@param dec Central dec in degrees
+         *@param radius Radius of the circle in degrees
+         *@param bufNum the output buffer to hold the results
+         */
+    void intersectCached(double ra, double dec, double radius, BufNum bufNum = 0);
+
+    /** @short empties the cache used by intersectCached().
+         */
+    void clearCache();
+
+    /** @short returns the number of intersectCached() calls answered
+         * from the cache since the mesh was created.
+         */
+    int cacheHits() const { return m_cacheHits; }
+
     /** @short finds the trixels that cover the specified line segment
          */
     void intersect(double ra1, double dec1, double ra2, double dec2, BufNum bufNum = 0);
@@ -151,6 +178,20 @@ class HTMesh
 
     int htmDebug;
 
+    // Recent circle intersections, keyed by the rounded center and radius
+    struct CacheEntry
+    {
+        int ra;
+        int dec;
+        int radius;
+        unsigned int stamp;
+        std::vector<Trixel> trixels;
+    };
+    std::vector<CacheEntry> m_cache;
+    unsigned int m_cacheStamp;
+    int m_cacheHits;
+    double m_quantum;
+
     /** @short fills the specified buffer with the intersection results in the
          * RangeConvex.
          */
@@ -1,102 +1,90 @@
 #include <HtmRange.h>
 
-#include <stdio.h>
-#include <string.h>
+#include <algorithm>
 
-#define INSIDE         1
-#define OUTSIDE        -1
-#define INTERSECT      0
-#define GAP_HISTO_SIZE 10000
-
-extern "C" {
-int cc_ID2name(char *name, uint64 id);
-}
-
-HtmRange::HtmRange()
+HtmRange::HtmRange() : my_cursor(0)
 {
-    my_los = new SkipList;
-    my_his = new SkipList;
 }
 
 HtmRange::~HtmRange()
 {
-    my_los->freeRange(-1, KEY_MAX);
-    my_his->freeRange(-1, KEY_MAX);
-    delete my_los;
-    delete my_his;
 }
 
 InclusionType HtmRange::tinside(const Key mid) const
 {
-    // clearly out, inside, share a boundary, off by one to some boundary
-    InclusionType t1, t2;
+    // First interval ending at or after mid
+    auto it = std::lower_bound(my_intervals.begin(), my_intervals.end(), mid,
+                               [](const Interval &interval, Key key) { return interval.hi < key; });
 
-    Key GH = my_his->findMAX(mid);
-    Key GL = my_los->findMAX(mid);
-
-    if (GH < GL)
-        t1 = InclInside;
-    else
-        t1 = InclOutside;
-
-    Key SH = my_his->findMIN(mid);
-    Key SL = my_los->findMIN(mid);
-    if (SH < SL)
-        t2 = InclInside;
-    else
-        t2 = InclOutside;
-
-    if (t1 == t2)
-        return t1;
-    if (t1 == InclInside)
-        return InclHi;
-    else
+    if (it == my_intervals.end() || it->lo > mid)
+        return InclOutside;
+    if (it->lo == mid)
         return InclLo;
+    if (it->hi == mid)
+        return InclHi;
+    return InclInside;
 }
 
 void HtmRange::mergeRange(const Key lo, const Key hi)
 {
-    int lo_flag = tinside(lo);
-    int hi_flag = tinside(hi);
-
-    // delete all nodes (key) in his and los where lo < key < hi
-    my_his->freeRange(lo, hi);
-    my_los->freeRange(lo, hi);
-
-    // add if not inside a pre-existing interval
-    if (lo_flag == InclHi)
+    // Fast path: ids mostly come in increasing order
+    if (my_intervals.empty() || lo > my_intervals.back().hi + 1)
     {
+        Interval interval;
+        interval.lo = lo;
+        interval.hi = hi;
+        my_intervals.push_back(interval);
+        return;
     }
-    else if (lo_flag == InclLo || (lo_flag == InclOutside))
+    else if (lo >= my_intervals.back().lo)
     {
-        my_los->insert(lo, 33);
+        my_intervals.back().hi = std::max(my_intervals.back().hi, hi);
+        return;
     }
 
-    if (hi_flag == InclLo)
+    // General case: replace all the intervals overlapping or adjacent to [lo, hi] by their union
+    auto first = std::lower_bound(my_intervals.begin(), my_intervals.end(), lo,
+                                  [](const Interval &interval, Key key) { return interval.hi + 1 < key; });
+    auto last = first;
+    Interval merged;
+    merged.lo = lo;
+    merged.hi = hi;
+    while (last != my_intervals.end() && last->lo <= hi + 1)
     {
+        merged.lo = std::min(merged.lo, last->lo);
+        merged.hi = std::max(merged.hi, last->hi);
+        ++last;
     }
-    else if (hi_flag == InclOutside || hi_flag == InclHi)
+
+    if (first == last)
+        my_intervals.insert(first, merged);
+    else
     {
-        my_his->insert(hi, 33);
+        *first = merged;
+        my_intervals.erase(first + 1, last);
     }
 }
 
 void HtmRange::reset()
 {
-    my_los->reset();
-    my_his->reset();
+    my_cursor = 0;
+}
+
+void HtmRange::clear()
+{
+    my_intervals.clear();
+    my_cursor = 0;
 }
 
 int HtmRange::getNext(Key *lo, Key *hi)
 {
-    *lo = my_los->getkey();
-    if (*lo <= (Key)0)
+    if (my_cursor >= my_intervals.size())
     {
         *hi = *lo = (Key)0;
         return 0;
     }
-    *hi = my_his->getkey();
-    my_his->step();
-    my_los->step();
+    *lo = my_intervals[my_cursor].lo;
+    *hi = my_intervals[my_cursor].hi;
+    my_cursor++;
     return 1;
 }
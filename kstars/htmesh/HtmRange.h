@@ -1,7 +1,11 @@
 #ifndef _HTMHANGE_H_
 #define _HTMHANGE_H_
 
-#include <SkipList.h>
+#include <SpatialGeneral.h>
+
+#include <vector>
+
+typedef int64 Key; // key type
 
 enum InclusionType
 {
@@ -12,9 +16,24 @@ enum InclusionType
     InclAdjacentXXX
 };
 
+/**
+ * @class HtmRange
+ * A set of HTM ids stored as disjoint intervals.
+ *
+ * The intervals are kept sorted in one flat array. The intersection routines
+ * produce them mostly in increasing order, so merging usually appends to or
+ * extends the last interval.
+ */
 class LINKAGE HtmRange
 {
   public:
+    /** @short one closed interval of ids */
+    struct Interval
+    {
+        Key lo;
+        Key hi;
+    };
+
     HtmRange();
     ~HtmRange();
 
@@ -23,12 +42,18 @@ class LINKAGE HtmRange
     void mergeRange(const Key lo, const Key hi);
     void reset();
 
+    /** @short removes all the intervals */
+    void clear();
+
+    /** @short the sorted, disjoint and non-adjacent intervals */
+    const std::vector<Interval> &intervals() const { return my_intervals; }
+
   protected:
     InclusionType tinside(const Key mid) const;
 
   private:
-    SkipList *my_los;
-    SkipList *my_his;
+    std::vector<Interval> my_intervals;
+    size_t my_cursor;
 };
 
 #endif
@@ -65,6 +65,13 @@ GUIManager::GUIManager(QWidget *parent) : QWidget(parent, Qt::Window)
 
     mainLayout->addWidget(mainTabWidget);
 
+    // Device panels do not refresh hidden widgets, so catch up once they are shown
+    connect(mainTabWidget, &QTabWidget::currentChanged, this, [this]()
+    {
+        for (auto oneGUIDevice : guidevices)
+            oneGUIDevice->scheduleUpdates();
+    });
+
     setWindowIcon(QIcon::fromTheme("kstars_indi"));
 
     setWindowTitle(i18n("INDI Control Panel"));
@@ -128,6 +135,9 @@ void GUIManager::showEvent(QShowEvent * /*event*/)
     QAction *a = KStars::Instance()->actionCollection()->action("show_control_panel");
     a->setEnabled(true);
     a->setChecked(true);
+
+    for (auto oneGUIDevice : guidevices)
+        oneGUIDevice->scheduleUpdates();
 }
 
 /*********************************************************************
@@ -24,6 +24,7 @@
 //#include "ekos/manager.h"
 #ifdef HAVE_CFITSIO
 #include "fitsviewer/fitsdata.h"
+#include "fitsviewer/fitscompressor.h"
 #endif
 
 #include <KNotifications/KNotification>
@@ -102,6 +103,16 @@ bool WriteImageFileInternal(const QString &filename, char *buffer, const size_t
     return true;
 }
 
+#ifdef HAVE_CFITSIO
+// Internal function to write a FITS blob to disk, then queue it for background compression.
+void WriteAndCompressImageFileInternal(const QString &filename, char *buffer, const size_t size,
+                                       const QString &filter, FITSCompressor::Compression compression, bool removeOriginal)
+{
+    if (WriteImageFileInternal(filename, buffer, size, true, filter))
+        FITSCompressor::Instance()->enqueue(filename, compression, removeOriginal);
+}
+#endif
+
 // Internal function to write a temporary file image blob to disk.
 bool writeTempImageFile(const QString &format, char * buffer, size_t size, QString *filename)
 {
@@ -1154,80 +1165,70 @@ void CCD::processLight(ILightVectorProperty *lvp)
 
 void CCD::processNumber(INumberVectorProperty *nvp)
 {
-    if (!strcmp(nvp->name, "CCD_EXPOSURE"))
-    {
-        INumber *np = IUFindNumber(nvp, "CCD_EXPOSURE_VALUE");
-        if (np)
-            emit newExposureValue(primaryChip.get(), np->value, nvp->s);
-        if (nvp->s == IPS_ALERT)
-            emit captureFailed();
-    }
-    else if (!strcmp(nvp->name, "CCD_TEMPERATURE"))
-    {
-        HasCooler   = true;
-        INumber *np = IUFindNumber(nvp, "CCD_TEMPERATURE_VALUE");
-        if (np)
-            emit newTemperatureValue(np->value);
-    }
-    else if (!strcmp(nvp->name, "GUIDER_EXPOSURE"))
-    {
-        INumber *np = IUFindNumber(nvp, "GUIDER_EXPOSURE_VALUE");
-        if (np)
-            emit newExposureValue(guideChip.get(), np->value, nvp->s);
-    }
-    else if (!strcmp(nvp->name, "FPS"))
-    {
-        emit newFPS(nvp->np[0].value, nvp->np[1].value);
-    }
-    else if (!strcmp(nvp->name, "CCD_RAPID_GUIDE_DATA"))
+    switch (getPropertyID(nvp))
     {
-        double dx = -1, dy = -1, fit = -1;
-        INumber *np = nullptr;
-
-        if (nvp->s == IPS_ALERT)
+        case CCD_EXPOSURE:
         {
-            emit newGuideStarData(primaryChip.get(), -1, -1, -1);
+            INumber *np = IUFindNumber(nvp, "CCD_EXPOSURE_VALUE");
+            if (np)
+                emit newExposureValue(primaryChip.get(), np->value, nvp->s);
+            if (nvp->s == IPS_ALERT)
+                emit captureFailed();
         }
-        else
+        break;
+
+        case CCD_TEMPERATURE:
         {
-            np = IUFindNumber(nvp, "GUIDESTAR_X");
-            if (np)
-                dx = np->value;
-            np = IUFindNumber(nvp, "GUIDESTAR_Y");
-            if (np)
-                dy = np->value;
-            np = IUFindNumber(nvp, "GUIDESTAR_FIT");
+            HasCooler   = true;
+            INumber *np = IUFindNumber(nvp, "CCD_TEMPERATURE_VALUE");
             if (np)
-                fit = np->value;
-
-            if (dx >= 0 && dy >= 0 && fit >= 0)
-                emit newGuideStarData(primaryChip.get(), dx, dy, fit);
+                emit newTemperatureValue(np->value);
         }
-    }
-    else if (!strcmp(nvp->name, "GUIDER_RAPID_GUIDE_DATA"))
-    {
-        double dx = -1, dy = -1, fit = -1;
-        INumber *np = nullptr;
+        break;
 
-        if (nvp->s == IPS_ALERT)
+        case GUIDER_EXPOSURE:
         {
-            emit newGuideStarData(guideChip.get(), -1, -1, -1);
+            INumber *np = IUFindNumber(nvp, "GUIDER_EXPOSURE_VALUE");
+            if (np)
+                emit newExposureValue(guideChip.get(), np->value, nvp->s);
         }
-        else
+        break;
+
+        case FPS:
+            emit newFPS(nvp->np[0].value, nvp->np[1].value);
+            break;
+
+        case CCD_RAPID_GUIDE_DATA:
+        case GUIDER_RAPID_GUIDE_DATA:
         {
-            np = IUFindNumber(nvp, "GUIDESTAR_X");
-            if (np)
-                dx = np->value;
-            np = IUFindNumber(nvp, "GUIDESTAR_Y");
-            if (np)
-                dy = np->value;
-            np = IUFindNumber(nvp, "GUIDESTAR_FIT");
-            if (np)
-                fit = np->value;
+            CCDChip *chip = (getPropertyID(nvp) == CCD_RAPID_GUIDE_DATA) ? primaryChip.get() : guideChip.get();
+            double dx = -1, dy = -1, fit = -1;
+            INumber *np = nullptr;
 
-            if (dx >= 0 && dy >= 0 && fit >= 0)
-                emit newGuideStarData(guideChip.get(), dx, dy, fit);
+            if (nvp->s == IPS_ALERT)
+            {
+                emit newGuideStarData(chip, -1, -1, -1);
+            }
+            else
+            {
+                np = IUFindNumber(nvp, "GUIDESTAR_X");
+                if (np)
+                    dx = np->value;
+                np = IUFindNumber(nvp, "GUIDESTAR_Y");
+                if (np)
+                    dy = np->value;
+                np = IUFindNumber(nvp, "GUIDESTAR_FIT");
+                if (np)
+                    fit = np->value;
+
+                if (dx >= 0 && dy >= 0 && fit >= 0)
+                    emit newGuideStarData(chip, dx, dy, fit);
+            }
         }
+        break;
+
+        default:
+            break;
     }
 
     DeviceDecorator::processNumber(nvp);
@@ -1235,13 +1236,15 @@ void CCD::processNumber(INumberVectorProperty *nvp)
 
 void CCD::processSwitch(ISwitchVectorProperty *svp)
 {
-    if (!strcmp(svp->name, "CCD_COOLER"))
+    const stdProperties id = getPropertyID(svp);
+
+    if (id == CCD_COOLER)
     {
         // Can turn cooling on/off
         HasCoolerControl = true;
         emit coolerToggled(svp->sp[0].s == ISS_ON);
     }
-    else if (QString(svp->name).endsWith("VIDEO_STREAM"))
+    else if (id == CCD_VIDEO_STREAM)
     {
         // If BLOB is not enabled for this camera, then ignore all VIDEO_STREAM calls.
         if (isBLOBEnabled() == false)
@@ -1295,7 +1298,7 @@ void CCD::processSwitch(ISwitchVectorProperty *svp)
             emit videoStreamToggled(svp->sp[0].s == ISS_ON);
         }
     }
-    else if (!strcmp(svp->name, "CCD_TRANSFER_FORMAT"))
+    else if (id == CCD_TRANSFER_FORMAT)
     {
         ISwitch *format = IUFindSwitch(svp, "FORMAT_NATIVE");
 
@@ -1304,7 +1307,7 @@ void CCD::processSwitch(ISwitchVectorProperty *svp)
         else
             transferFormat = FORMAT_FITS;
     }
-    else if (!strcmp(svp->name, "RECORD_STREAM"))
+    else if (id == RECORD_STREAM)
     {
         ISwitch *recordOFF = IUFindSwitch(svp, "RECORD_OFF");
 
@@ -1319,7 +1322,7 @@ void CCD::processSwitch(ISwitchVectorProperty *svp)
             KNotification::event(QLatin1String("RecordingStarted"), i18n("Video Recording Started"));
         }
     }
-    else if (!strcmp(svp->name, "TELESCOPE_TYPE"))
+    else if (id == TELESCOPE_TYPE)
     {
         ISwitch *format = IUFindSwitch(svp, "TELESCOPE_PRIMARY");
         if (format && format->s == ISS_ON)
@@ -1327,7 +1330,7 @@ void CCD::processSwitch(ISwitchVectorProperty *svp)
         else
             telescopeType = TELESCOPE_GUIDE;
     }
-    else if (!strcmp(svp->name, "CCD_EXPOSURE_LOOP"))
+    else if (id == CCD_EXPOSURE_LOOP)
     {
         ISwitch *looping = IUFindSwitch(svp, "LOOP_ON");
         if (looping && looping->s == ISS_ON)
@@ -1335,7 +1338,7 @@ void CCD::processSwitch(ISwitchVectorProperty *svp)
         else
             IsLooping = false;
     }
-    else if (streamWindow && !strcmp(svp->name, "CONNECTION"))
+    else if (streamWindow && id == CONNECTION)
     {
         ISwitch *dSwitch = IUFindSwitch(svp, "DISCONNECT");
 
@@ -1356,7 +1359,7 @@ void CCD::processSwitch(ISwitchVectorProperty *svp)
 
 void CCD::processText(ITextVectorProperty *tvp)
 {
-    if (!strcmp(tvp->name, "CCD_FILE_PATH"))
+    if (getPropertyID(tvp) == CCD_FILE_PATH)
     {
         IText *filepath = IUFindText(tvp, "FILE_PATH");
         if (filepath)
@@ -1488,8 +1491,27 @@ bool CCD::writeImageFile(const QString &filename, IBLOB *bp, bool is_fits)
         // Copy memory, and write file on a separate thread.
         // Probably too late to return an error if the file couldn't write.
         memcpy(fileWriteBuffer, bp->blob, bp->size);
-        fileWriteThread = QtConcurrent::run(WriteImageFileInternal, fileWriteFilename,
-                                            fileWriteBuffer, bp->size, is_fits, filter);
+#ifdef HAVE_CFITSIO
+        const auto compression = static_cast<FITSCompressor::Compression>(Options::fITSCompression());
+        if (compression != FITSCompressor::COMPRESSION_NONE)
+        {
+            // Created here so that it lives in the main thread
+            FITSCompressor::Instance();
+            const QString writeFilename = fileWriteFilename, writeFilter = filter;
+            char *writeBuffer = fileWriteBuffer;
+            const size_t writeSize = bp->size;
+            const bool removeOriginal = Options::fITSCompressionRemoveOriginal();
+            fileWriteThread = QtConcurrent::run([writeFilename, writeBuffer, writeSize, writeFilter, compression,
+                                                 removeOriginal]()
+            {
+                WriteAndCompressImageFileInternal(writeFilename, writeBuffer, writeSize, writeFilter, compression,
+                                                  removeOriginal);
+            });
+        }
+        else
+#endif
+            fileWriteThread = QtConcurrent::run(WriteImageFileInternal, fileWriteFilename,
+                                                fileWriteBuffer, bp->size, is_fits, filter);
         filter = "";
     }
     else
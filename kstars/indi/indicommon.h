@@ -148,8 +148,24 @@ enum stdProperties
     FOCUS_MOTION,
     FOCUS_TIMER, /* Focuser */
     FILTER_SLOT, /* Filter */
-    WATCHDOG_HEARTBEAT
-}; /* Watchdog */
+    WATCHDOG_HEARTBEAT, /* Watchdog */
+    DRIVER_INFO,
+    SYSTEM_PORTS,
+    TELESCOPE_PIER_SIDE, /* Telescope */
+    TELESCOPE_TRACK_MODE,
+    GUIDER_EXPOSURE, /* CCD */
+    CCD_TEMPERATURE,
+    CCD_COOLER,
+    CCD_TRANSFER_FORMAT,
+    CCD_EXPOSURE_LOOP,
+    CCD_FILE_PATH,
+    CCD_RAPID_GUIDE_DATA,
+    GUIDER_RAPID_GUIDE_DATA,
+    TELESCOPE_TYPE,
+    RECORD_STREAM, /* Video */
+    FPS,
+    UNKNOWN_PROPERTY /* Any property without dedicated handling */
+};
 
 /* Devices families that we explicitly support (i.e. with std properties) */
 typedef enum
@@ -72,6 +72,12 @@ INDI_D::INDI_D(INDI::BaseDevice *in_dv, ClientManager *in_cm) : QDialog()
     deviceVBox->addWidget(groupContainer);
     deviceVBox->addWidget(msgST_w);
 
+    updateTimer.setSingleShot(true);
+    updateTimer.setInterval(UPDATE_INTERVAL);
+    connect(&updateTimer, &QTimer::timeout, this, &INDI_D::flushUpdates);
+    // Properties of the newly selected group may have changed while hidden
+    connect(groupContainer, &QTabWidget::currentChanged, this, &INDI_D::scheduleUpdates);
+
     //parent->mainTabWidget->addTab(deviceVBox, label);
 }
 
@@ -143,6 +149,7 @@ bool INDI_D::removeProperty(const QString &device, const QString &name)
         {
             if (name == oneProperty->getName())
             {
+                pendingUpdates.remove(oneProperty);
                 bool rc = oneGroup->removeProperty(name);
                 if (oneGroup->size() == 0)
                 {
@@ -160,129 +167,123 @@ bool INDI_D::removeProperty(const QString &device, const QString &name)
 
 bool INDI_D::updateSwitchGUI(ISwitchVectorProperty *svp)
 {
-    INDI_P *guiProp = nullptr;
-    QString propName(svp->name);
-
     if (m_Name != svp->device)
         return false;
 
-    for (const auto &pg : groupsList)
-    {
-        if ((guiProp = pg->getProperty(propName)) != nullptr)
-            break;
-    }
-
-    if (guiProp == nullptr)
-        return false;
-
-    guiProp->updateStateLED();
-
-    if (guiProp->getGUIType() == PG_MENU)
-        guiProp->updateMenuGUI();
-    else
-    {
-        for (const auto &lp : guiProp->getElements())
-            lp->syncSwitch();
-    }
-
-    return true;
+    return queueUpdate(svp->name, INDI_SWITCH);
 }
 
 bool INDI_D::updateTextGUI(ITextVectorProperty *tvp)
 {
-    INDI_P *guiProp = nullptr;
-    QString propName(tvp->name);
-
     if (m_Name != tvp->device)
         return false;
 
-    for (const auto &pg : groupsList)
-    {
-        if ((guiProp = pg->getProperty(propName)) != nullptr)
-            break;
-    }
-
-    if (guiProp == nullptr)
-        return false;
-
-    guiProp->updateStateLED();
-
-    for (const auto &lp : guiProp->getElements())
-        lp->syncText();
-
-    return true;
+    return queueUpdate(tvp->name, INDI_TEXT);
 }
 
 bool INDI_D::updateNumberGUI(INumberVectorProperty *nvp)
 {
-    INDI_P *guiProp = nullptr;
-    QString propName(nvp->name);
-
     if (m_Name != nvp->device)
         return false;
 
-    for (const auto &pg : groupsList)
-    {
-        if ((guiProp = pg->getProperty(propName)) != nullptr)
-            break;
-    }
+    return queueUpdate(nvp->name, INDI_NUMBER);
+}
 
-    if (guiProp == nullptr)
+bool INDI_D::updateLightGUI(ILightVectorProperty *lvp)
+{
+    if (m_Name != lvp->device)
         return false;
 
-    guiProp->updateStateLED();
+    return queueUpdate(lvp->name, INDI_LIGHT);
+}
 
-    for (const auto &lp : guiProp->getElements())
-        lp->syncNumber();
+bool INDI_D::updateBLOBGUI(IBLOB *bp)
+{
+    if (m_Name != bp->bvp->device)
+        return false;
 
-    return true;
+    return queueUpdate(bp->bvp->name, INDI_BLOB);
 }
 
-bool INDI_D::updateLightGUI(ILightVectorProperty *lvp)
+bool INDI_D::queueUpdate(const char *propName, INDI_PROPERTY_TYPE type)
 {
     INDI_P *guiProp = nullptr;
-    QString propName(lvp->name);
-
-    if (m_Name != lvp->device)
-        return false;
+    const QString name(propName);
 
     for (const auto &pg : groupsList)
     {
-        if ((guiProp = pg->getProperty(propName)) != nullptr)
+        if ((guiProp = pg->getProperty(name)) != nullptr)
             break;
     }
 
     if (guiProp == nullptr)
         return false;
 
-    guiProp->updateStateLED();
-
-    for (const auto &lp : guiProp->getElements())
-        lp->syncLight();
+    // Only the latest state matters, the widgets read it from the property when refreshed
+    pendingUpdates.insert(guiProp, type);
+    if (!updateTimer.isActive())
+        updateTimer.start();
 
     return true;
 }
 
-bool INDI_D::updateBLOBGUI(IBLOB *bp)
+void INDI_D::scheduleUpdates()
 {
-    INDI_P *guiProp = nullptr;
-    QString propName(bp->bvp->name);
+    if (!pendingUpdates.isEmpty() && !updateTimer.isActive())
+        updateTimer.start();
+}
 
-    if (m_Name != bp->bvp->device)
-        return false;
+void INDI_D::flushUpdates()
+{
+    auto it = pendingUpdates.begin();
+    while (it != pendingUpdates.end())
+    {
+        // Hidden widgets are left pending until their panel is shown again
+        if (it.key()->getGroup()->getScrollArea()->isVisible() == false)
+        {
+            ++it;
+            continue;
+        }
 
-    for (const auto &pg : groupsList)
+        syncProperty(it.key(), it.value());
+        it = pendingUpdates.erase(it);
+    }
+}
+
+void INDI_D::syncProperty(INDI_P *guiProp, INDI_PROPERTY_TYPE type)
+{
+    guiProp->updateStateLED();
+
+    switch (type)
     {
-        if ((guiProp = pg->getProperty(propName)) != nullptr)
+        case INDI_SWITCH:
+            if (guiProp->getGUIType() == PG_MENU)
+                guiProp->updateMenuGUI();
+            else
+            {
+                for (const auto &lp : guiProp->getElements())
+                    lp->syncSwitch();
+            }
             break;
-    }
 
-    if (guiProp == nullptr)
-        return false;
+        case INDI_TEXT:
+            for (const auto &lp : guiProp->getElements())
+                lp->syncText();
+            break;
 
-    guiProp->updateStateLED();
+        case INDI_NUMBER:
+            for (const auto &lp : guiProp->getElements())
+                lp->syncNumber();
+            break;
 
-    return true;
+        case INDI_LIGHT:
+            for (const auto &lp : guiProp->getElements())
+                lp->syncLight();
+            break;
+
+        default:
+            break;
+    }
 }
 
 void INDI_D::updateMessageLog(INDI::BaseDevice *idv, int messageID)
@@ -16,6 +16,8 @@
 #include <QLabel>
 #include <QVBoxLayout>
 #include <QMutex>
+#include <QHash>
+#include <QTimer>
 
 #include <indiapi.h>
 #include <basedevice.h>
@@ -26,6 +28,7 @@ class QSplitter;
 class GUIManager;
 class ClientManager;
 class INDI_G;
+class INDI_P;
 
 /**
  * @class INDI_D
@@ -70,6 +73,12 @@ class INDI_D : public QDialog
             return m_Name;
         }
 
+        /**
+         * @brief Schedule the update of properties that changed while they were hidden.
+         * Call when the device panel may have become visible.
+         */
+        void scheduleUpdates();
+
     public slots:
         bool buildProperty(INDI::Property *prop);
         //bool removeProperty(INDI::Property *prop);
@@ -82,9 +91,27 @@ class INDI_D : public QDialog
 
         void updateMessageLog(INDI::BaseDevice *idv, int messageID);
 
+    private slots:
+        /** Refresh the widgets of visible properties that changed since the last refresh */
+        void flushUpdates();
+
     private:
+        /**
+         * @brief Record that a property changed. Its widgets are refreshed at most every
+         * UPDATE_INTERVAL ms with its latest state, and only while they are visible.
+         */
+        bool queueUpdate(const char *propName, INDI_PROPERTY_TYPE type);
+        void syncProperty(INDI_P *guiProp, INDI_PROPERTY_TYPE type);
+
+        /// Minimum interval between two refreshes of the property widgets, in milliseconds
+        static constexpr int UPDATE_INTERVAL = 100;
+
         QString m_Name;
 
+        /// Properties that changed since their widgets were last refreshed
+        QHash<INDI_P *, INDI_PROPERTY_TYPE> pendingUpdates;
+        QTimer updateTimer;
+
         // GUI
         QSplitter *deviceVBox { nullptr };
         QTabWidget *groupContainer { nullptr };
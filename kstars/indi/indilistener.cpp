@@ -124,6 +124,23 @@ ISD::GDInterface *INDIListener::getDevice(const QString &name)
     return nullptr;
 }
 
+ISD::GDInterface *INDIListener::findDevice(const void *key, const char *deviceName)
+{
+    auto it = propertyDevices.constFind(key);
+    if (it != propertyDevices.constEnd())
+        return it.value();
+
+    for (auto &oneDevice : devices)
+    {
+        if (oneDevice->getDeviceName() == deviceName)
+        {
+            propertyDevices.insert(key, oneDevice);
+            return oneDevice;
+        }
+    }
+    return nullptr;
+}
+
 void INDIListener::addClient(ClientManager *cm)
 {
     qCDebug(KSTARS_INDI) << "INDIListener: Adding a new client manager to INDI listener..";
@@ -152,6 +169,7 @@ void INDIListener::removeClient(ClientManager *cm)
 
     QList<ISD::GDInterface *>::iterator it = devices.begin();
     clients.removeOne(cm);
+    propertyDevices.clear();
 
     while (it != devices.end())
     {
@@ -223,6 +241,7 @@ void INDIListener::removeDevice(const QString &deviceName)
         {
             emit deviceRemoved(oneDevice);
             devices.removeOne(oneDevice);
+            propertyDevices.clear();
             delete (oneDevice);
             break;
         }
@@ -240,6 +259,8 @@ void INDIListener::registerProperty(INDI::Property *prop)
     {
         if (oneDevice->getDeviceName() == prop->getDeviceName())
         {
+            ISD::GDInterface *genericDevice = oneDevice;
+
             if (!strcmp(prop->getName(), "ON_COORD_SET") ||
                     !strcmp(prop->getName(), "EQUATORIAL_EOD_COORD") ||
                     !strcmp(prop->getName(), "EQUATORIAL_COORD") ||
@@ -359,7 +380,12 @@ void INDIListener::registerProperty(INDI::Property *prop)
                 emit newST4(st4Driver);
             }
 
+            // Decorating the device replaced it in the device list
+            if (oneDevice != genericDevice)
+                propertyDevices.clear();
+
             oneDevice->registerProperty(prop);
+            propertyDevices.insert(prop->getProperty(), oneDevice);
             break;
         }
     }
@@ -371,6 +397,9 @@ void INDIListener::removeProperty(const QString &device, const QString &name)
     {
         if (oneDevice->getDeviceName() == device)
         {
+            INDI::Property *prop = oneDevice->getProperty(name);
+            if (prop != nullptr)
+                propertyDevices.remove(prop->getProperty());
             oneDevice->removeProperty(name);
             return;
         }
@@ -379,74 +408,44 @@ void INDIListener::removeProperty(const QString &device, const QString &name)
 
 void INDIListener::processSwitch(ISwitchVectorProperty *svp)
 {
-    for (auto &oneDevice : devices)
-    {
-        if (oneDevice->getDeviceName() == svp->device)
-        {
-            oneDevice->processSwitch(svp);
-            break;
-        }
-    }
+    ISD::GDInterface *oneDevice = findDevice(svp, svp->device);
+    if (oneDevice)
+        oneDevice->processSwitch(svp);
 }
 
 void INDIListener::processNumber(INumberVectorProperty *nvp)
 {
-    for (auto &oneDevice : devices)
-    {
-        if (oneDevice->getDeviceName() == nvp->device)
-        {
-            oneDevice->processNumber(nvp);
-            break;
-        }
-    }
+    ISD::GDInterface *oneDevice = findDevice(nvp, nvp->device);
+    if (oneDevice)
+        oneDevice->processNumber(nvp);
 }
 
 void INDIListener::processText(ITextVectorProperty *tvp)
 {
-    for (auto &oneDevice : devices)
-    {
-        if (oneDevice->getDeviceName() == tvp->device)
-        {
-            oneDevice->processText(tvp);
-            break;
-        }
-    }
+    ISD::GDInterface *oneDevice = findDevice(tvp, tvp->device);
+    if (oneDevice)
+        oneDevice->processText(tvp);
 }
 
 void INDIListener::processLight(ILightVectorProperty *lvp)
 {
-    for (auto &oneDevice : devices)
-    {
-        if (oneDevice->getDeviceName() == lvp->device)
-        {
-            oneDevice->processLight(lvp);
-            break;
-        }
-    }
+    ISD::GDInterface *oneDevice = findDevice(lvp, lvp->device);
+    if (oneDevice)
+        oneDevice->processLight(lvp);
 }
 
 void INDIListener::processBLOB(IBLOB *bp)
 {
-    for (auto &oneDevice : devices)
-    {
-        if (oneDevice->getDeviceName() == bp->bvp->device)
-        {
-            oneDevice->processBLOB(bp);
-            break;
-        }
-    }
+    ISD::GDInterface *oneDevice = findDevice(bp->bvp, bp->bvp->device);
+    if (oneDevice)
+        oneDevice->processBLOB(bp);
 }
 
 void INDIListener::processMessage(INDI::BaseDevice *dp, int messageID)
 {
-    for (auto &oneDevice : devices)
-    {
-        if (oneDevice->getDeviceName() == dp->getDeviceName())
-        {
-            oneDevice->processMessage(messageID);
-            break;
-        }
-    }
+    ISD::GDInterface *oneDevice = findDevice(dp, dp->getDeviceName());
+    if (oneDevice)
+        oneDevice->processMessage(messageID);
 }
 
 void INDIListener::processUniversalMessage(const QString &message)
@@ -15,6 +15,7 @@
 
 #include <indiproperty.h>
 
+#include <QHash>
 #include <QObject>
 
 class ClientManager;
@@ -82,6 +83,15 @@ class INDIListener : public QObject
         QList<ISD::GDInterface *> devices;
         QList<ISD::ST4 *> st4Devices;
 
+        /**
+         * @brief Find the device owning a property, without comparing device names once known.
+         * @param key the vector property, or the INDI::BaseDevice for messages.
+         * @param deviceName name of the device, used to resolve keys not seen yet.
+         */
+        ISD::GDInterface *findDevice(const void *key, const char *deviceName);
+        /// Owner device of each defined property, cleared whenever the device list changes
+        QHash<const void *, ISD::GDInterface *> propertyDevices;
+
     signals:
         void newDevice(ISD::GDInterface *);
         void newTelescope(ISD::GDInterface *);
@@ -79,6 +79,7 @@ void GenericDevice::registerProperty(INDI::Property *prop)
         return;
 
     properties[name] = prop;
+    propertyIDs.insert(prop->getProperty(), propertyID(prop->getName()));
 
     emit propertyDefined(prop);
 
@@ -178,13 +179,25 @@ void GenericDevice::registerProperty(INDI::Property *prop)
 
 void GenericDevice::removeProperty(const QString &name)
 {
+    INDI::Property *prop = properties.value(name);
+    if (prop != nullptr)
+        propertyIDs.remove(prop->getProperty());
     properties.remove(name);
     emit propertyDeleted(name);
 }
 
+stdProperties GenericDevice::getPropertyID(const void *property, const char *name)
+{
+    auto it = propertyIDs.constFind(property);
+    if (it != propertyIDs.constEnd())
+        return it.value();
+
+    return propertyID(name);
+}
+
 void GenericDevice::processSwitch(ISwitchVectorProperty *svp)
 {
-    if (!strcmp(svp->name, "CONNECTION"))
+    if (getPropertyID(svp) == CONNECTION)
     {
         ISwitch *conSP = IUFindSwitch(svp, "CONNECT");
 
@@ -228,7 +241,9 @@ void GenericDevice::processNumber(INumberVectorProperty *nvp)
     //    uint32_t interface = getDriverInterface();
     //    Q_UNUSED(interface);
 
-    if (!strcmp(nvp->name, "GEOGRAPHIC_COORD") && nvp->s == IPS_OK &&
+    const stdProperties id = getPropertyID(nvp);
+
+    if (id == GEOGRAPHIC_COORD && nvp->s == IPS_OK &&
             ( (Options::useMountSource() && (getDriverInterface() & INDI::BaseDevice::TELESCOPE_INTERFACE)) ||
               (Options::useGPSSource() && (getDriverInterface() & INDI::BaseDevice::GPS_INTERFACE))))
     {
@@ -290,7 +305,7 @@ void GenericDevice::processNumber(INumberVectorProperty *nvp)
 
         KStars::Instance()->data()->setLocation(*geo);
     }
-    else if (!strcmp(nvp->name, "WATCHDOG_HEARTBEAT"))
+    else if (id == WATCHDOG_HEARTBEAT)
     {
         if (watchDogTimer == nullptr)
         {
@@ -1068,6 +1083,11 @@ void DeviceDecorator::processMessage(int messageID)
     interfacePtr->processMessage(messageID);
 }
 
+stdProperties DeviceDecorator::getPropertyID(const void *property, const char *name)
+{
+    return interfacePtr->getPropertyID(property, name);
+}
+
 void DeviceDecorator::registerProperty(INDI::Property * prop)
 {
     interfacePtr->registerProperty(prop);
@@ -1268,6 +1288,67 @@ bool ST4::doPulse(GuideDirection dir, int msecs)
     return true;
 }
 
+stdProperties propertyID(const char *name)
+{
+    // TIME_UTC is not interned since it may be redefined as a macro by time.h
+    static const QHash<QByteArray, stdProperties> table =
+    {
+        {"CONNECTION", CONNECTION},
+        {"DEVICE_PORT", DEVICE_PORT},
+        {"TIME_LST", TIME_LST},
+        {"TIME_UTC_OFFSET", TIME_UTC_OFFSET},
+        {"GEOGRAPHIC_COORD", GEOGRAPHIC_COORD},
+        {"EQUATORIAL_COORD", EQUATORIAL_COORD},
+        {"EQUATORIAL_EOD_COORD", EQUATORIAL_EOD_COORD},
+        {"EQUATORIAL_EOD_COORD_REQUEST", EQUATORIAL_EOD_COORD_REQUEST},
+        {"HORIZONTAL_COORD", HORIZONTAL_COORD},
+        {"TELESCOPE_ABORT_MOTION", TELESCOPE_ABORT_MOTION},
+        {"ON_COORD_SET", ON_COORD_SET},
+        {"SOLAR_SYSTEM", SOLAR_SYSTEM},
+        {"TELESCOPE_MOTION_NS", TELESCOPE_MOTION_NS},
+        {"TELESCOPE_MOTION_WE", TELESCOPE_MOTION_WE},
+        {"TELESCOPE_PARK", TELESCOPE_PARK},
+        {"CCD_EXPOSURE", CCD_EXPOSURE},
+        {"CCD_TEMPERATURE_REQUEST", CCD_TEMPERATURE_REQUEST},
+        {"CCD_FRAME", CCD_FRAME},
+        {"CCD_FRAME_TYPE", CCD_FRAME_TYPE},
+        {"CCD_BINNING", CCD_BINNING},
+        {"CCD_INFO", CCD_INFO},
+        {"CCD_VIDEO_STREAM", CCD_VIDEO_STREAM},
+        {"FOCUS_SPEED", FOCUS_SPEED},
+        {"FOCUS_MOTION", FOCUS_MOTION},
+        {"FOCUS_TIMER", FOCUS_TIMER},
+        {"FILTER_SLOT", FILTER_SLOT},
+        {"WATCHDOG_HEARTBEAT", WATCHDOG_HEARTBEAT},
+        {"DRIVER_INFO", DRIVER_INFO},
+        {"SYSTEM_PORTS", SYSTEM_PORTS},
+        {"TELESCOPE_PIER_SIDE", TELESCOPE_PIER_SIDE},
+        {"TELESCOPE_TRACK_MODE", TELESCOPE_TRACK_MODE},
+        {"GUIDER_EXPOSURE", GUIDER_EXPOSURE},
+        {"CCD_TEMPERATURE", CCD_TEMPERATURE},
+        {"CCD_COOLER", CCD_COOLER},
+        {"CCD_TRANSFER_FORMAT", CCD_TRANSFER_FORMAT},
+        {"CCD_EXPOSURE_LOOP", CCD_EXPOSURE_LOOP},
+        {"CCD_FILE_PATH", CCD_FILE_PATH},
+        {"CCD_RAPID_GUIDE_DATA", CCD_RAPID_GUIDE_DATA},
+        {"GUIDER_RAPID_GUIDE_DATA", GUIDER_RAPID_GUIDE_DATA},
+        {"TELESCOPE_TYPE", TELESCOPE_TYPE},
+        {"RECORD_STREAM", RECORD_STREAM},
+        {"FPS", FPS}
+    };
+
+    const QByteArray key = QByteArray::fromRawData(name, static_cast<int>(strlen(name)));
+    auto it = table.constFind(key);
+    if (it != table.constEnd())
+        return it.value();
+
+    // Any stream property (e.g. GUIDER_VIDEO_STREAM) is handled like the main camera stream
+    if (key.endsWith("VIDEO_STREAM"))
+        return CCD_VIDEO_STREAM;
+
+    return UNKNOWN_PROPERTY;
+}
+
 void propertyToJson(ISwitchVectorProperty *svp, QJsonObject &propObject, bool compact)
 {
     QJsonArray switches;
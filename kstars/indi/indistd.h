@@ -75,6 +75,27 @@ class GDInterface : public QObject
         virtual void processBLOB(IBLOB *bp)                    = 0;
         virtual void processMessage(int messageID)             = 0;
 
+        /**
+         * @brief Get the interned identifier of a property.
+         * The identifier is computed once when the property is defined, so handlers can dispatch on it
+         * instead of comparing property names on every update.
+         * @param property the vector property (e.g. INumberVectorProperty) as defined by the device.
+         * @param name name of the property, used if it was not registered.
+         */
+        virtual stdProperties getPropertyID(const void *property, const char *name) = 0;
+        stdProperties getPropertyID(ISwitchVectorProperty *svp)
+        {
+            return getPropertyID(svp, svp->name);
+        }
+        stdProperties getPropertyID(ITextVectorProperty *tvp)
+        {
+            return getPropertyID(tvp, tvp->name);
+        }
+        stdProperties getPropertyID(INumberVectorProperty *nvp)
+        {
+            return getPropertyID(nvp, nvp->name);
+        }
+
         // Accessors
         virtual const QHash<QString, INDI::Property *> &getProperties() = 0;
         virtual DeviceFamily getType()                  = 0;
@@ -153,6 +174,8 @@ class GenericDevice : public GDInterface
         virtual void processLight(ILightVectorProperty *lvp) override;
         virtual void processBLOB(IBLOB *bp) override;
         virtual void processMessage(int messageID) override;
+        virtual stdProperties getPropertyID(const void *property, const char *name) override;
+        using GDInterface::getPropertyID;
 
         virtual DeviceFamily getType() override
         {
@@ -222,6 +245,8 @@ class GenericDevice : public GDInterface
         ClientManager *clientManager { nullptr };
         QTimer *watchDogTimer { nullptr };
         char BLOBFilename[MAXINDIFILENAME + 1];
+        /// Interned identifiers of the registered properties, keyed by their vector property
+        QHash<const void *, stdProperties> propertyIDs;
 };
 
 /**
@@ -246,6 +271,8 @@ class DeviceDecorator : public GDInterface
         virtual void processLight(ILightVectorProperty *lvp) override;
         virtual void processBLOB(IBLOB *bp) override;
         virtual void processMessage(int messageID) override;
+        virtual stdProperties getPropertyID(const void *property, const char *name) override;
+        using GDInterface::getPropertyID;
 
         virtual DeviceFamily getType() override;
 
@@ -307,6 +334,12 @@ class ST4
         QString m_Name;
 };
 
+/**
+ * @brief Intern an INDI property name.
+ * @return the standard property with this name, or UNKNOWN_PROPERTY if the property has no dedicated handling.
+ */
+stdProperties propertyID(const char *name);
+
 void propertyToJson(ISwitchVectorProperty *svp, QJsonObject &propObject, bool compact = true);
 void propertyToJson(ITextVectorProperty *tvp, QJsonObject &propObject, bool compact = true);
 void propertyToJson(INumberVectorProperty *nvp, QJsonObject &propObject, bool compact = true);
@@ -206,7 +206,9 @@ void Telescope::registerProperty(INDI::Property *prop)
 
 void Telescope::processNumber(INumberVectorProperty *nvp)
 {
-    if (!strcmp(nvp->name, "EQUATORIAL_EOD_COORD") || !strcmp(nvp->name, "EQUATORIAL_COORD"))
+    const stdProperties id = getPropertyID(nvp);
+
+    if (id == EQUATORIAL_EOD_COORD || id == EQUATORIAL_COORD)
     {
         INumber *RA  = IUFindNumber(nvp, "RA");
         INumber *DEC = IUFindNumber(nvp, "DEC");
@@ -218,7 +220,7 @@ void Telescope::processNumber(INumberVectorProperty *nvp)
         currentCoord.setDec(DEC->value);
 
         // If J2000, convert it to JNow
-        if (!strcmp(nvp->name, "EQUATORIAL_COORD"))
+        if (id == EQUATORIAL_COORD)
         {
             currentCoord.setRA0(RA->value);
             currentCoord.setDec0(DEC->value);
@@ -248,7 +250,7 @@ void Telescope::processNumber(INumberVectorProperty *nvp)
 
         KStars::Instance()->map()->update();
     }
-    else if (!strcmp(nvp->name, "HORIZONTAL_COORD"))
+    else if (id == HORIZONTAL_COORD)
     {
         INumber *Az  = IUFindNumber(nvp, "AZ");
         INumber *Alt = IUFindNumber(nvp, "ALT");
@@ -271,7 +273,9 @@ void Telescope::processSwitch(ISwitchVectorProperty *svp)
 {
     bool manualMotionChanged = false;
 
-    if (!strcmp(svp->name, "CONNECTION"))
+    const stdProperties id = getPropertyID(svp);
+
+    if (id == CONNECTION)
     {
         ISwitch *conSP = IUFindSwitch(svp, "CONNECT");
         if (conSP)
@@ -288,7 +292,7 @@ void Telescope::processSwitch(ISwitchVectorProperty *svp)
             }
         }
     }
-    else if (!strcmp(svp->name, "TELESCOPE_PARK"))
+    else if (id == TELESCOPE_PARK)
     {
         ISwitch *sp = IUFindSwitch(svp, "PARK");
         if (sp)
@@ -360,7 +364,7 @@ void Telescope::processSwitch(ISwitchVectorProperty *svp)
             }
         }
     }
-    else if (!strcmp(svp->name, "TELESCOPE_ABORT_MOTION"))
+    else if (id == TELESCOPE_ABORT_MOTION)
     {
         if (svp->s == IPS_OK)
         {
@@ -368,7 +372,7 @@ void Telescope::processSwitch(ISwitchVectorProperty *svp)
             KSNotification::event(QLatin1String("MountAborted"), i18n("Mount motion was aborted"), KSNotification::EVENT_WARN);
         }
     }
-    else if (!strcmp(svp->name, "TELESCOPE_PIER_SIDE"))
+    else if (id == TELESCOPE_PIER_SIDE)
     {
         int currentSide = IUFindOnSwitchIndex(svp);
         if (currentSide != m_PierSide)
@@ -377,7 +381,7 @@ void Telescope::processSwitch(ISwitchVectorProperty *svp)
             emit pierSideChanged(m_PierSide);
         }
     }
-    else if (!strcmp(svp->name, "TELESCOPE_TRACK_MODE"))
+    else if (id == TELESCOPE_TRACK_MODE)
     {
         ISwitch *sp = IUFindOnSwitch(svp);
         if (sp)
@@ -392,9 +396,7 @@ void Telescope::processSwitch(ISwitchVectorProperty *svp)
                 currentTrackMode = TRACK_CUSTOM;
         }
     }
-    else if (!strcmp(svp->name, "TELESCOPE_MOTION_NS"))
-        manualMotionChanged = true;
-    else if (!strcmp(svp->name, "TELESCOPE_MOTION_WE"))
+    else if (id == TELESCOPE_MOTION_NS || id == TELESCOPE_MOTION_WE)
         manualMotionChanged = true;
 
     if (manualMotionChanged)
@@ -21,6 +21,19 @@
 
 #include "kstarsdatetime.h" //for J2000 define
 
+#include <QList>
+#include <QMutex>
+
+namespace
+{
+// Number of Julian Days whose values are kept by KSNumbers::cached()
+const int CACHE_SIZE = 32;
+
+QMutex cacheMutex;
+// Most recently used first
+QList<std::shared_ptr<const KSNumbers>> cache;
+}
+
 // 63 elements
 const int KSNumbers::arguments[NUTTERMS][5] = {
     { 0, 0, 0, 0, 1 },   { -2, 0, 0, 2, 2 },  { 0, 0, 0, 2, 2 },   { 0, 0, 0, 0, 2 },  { 0, 1, 0, 0, 0 },
@@ -102,6 +115,31 @@ const int KSNumbers::amp[NUTTERMS][4] = { { -171996, -1742, 92025, 89 },
                                           { -3, 0, 0, 0 },
                                           { -3, 0, 0, 0 } };
 
+std::shared_ptr<const KSNumbers> KSNumbers::cached(long double jd)
+{
+    QMutexLocker locker(&cacheMutex);
+
+    for (int i = 0; i < cache.size(); ++i)
+    {
+        if (cache[i]->julianDay() == jd)
+        {
+            cache.move(i, 0);
+            return cache.first();
+        }
+    }
+
+    // Other threads may use the cache meanwhile
+    locker.unlock();
+    std::shared_ptr<const KSNumbers> num(new KSNumbers(jd));
+    locker.relock();
+
+    cache.prepend(num);
+    if (cache.size() > CACHE_SIZE)
+        cache.removeLast();
+
+    return num;
+}
+
 KSNumbers::KSNumbers(long double jd)
 {
     K.setD(20.49552 / 3600.); //set the constant of aberration
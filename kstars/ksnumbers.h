@@ -33,6 +33,8 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <memory>
+
 #define NUTTERMS 63
 
 /** @class KSNumbers
@@ -61,6 +63,14 @@ class KSNumbers
     explicit KSNumbers(long double jd);
     ~KSNumbers() = default;
 
+    /**
+     * @short Get the values for a Julian Day from a cache shared by all threads.
+     * The values of the most recently used days are kept, so that converting the
+     * coordinates of many objects at a few times computes them only once per time.
+     * @param jd  Julian Day for which the values are computed on first use
+     */
+    static std::shared_ptr<const KSNumbers> cached(long double jd);
+
     /**
      * @return the current Obliquity (the angle of inclination between
      * the celestial equator and the ecliptic)
@@ -30,6 +30,7 @@
 #include "skymap.h"
 #include "skyqpainter.h"
 #include "texturemanager.h"
+#include "auxiliary/tracer.h"
 #include "dialogs/finddialog.h"
 #include "dialogs/exportimagedialog.h"
 #include "skycomponents/starblockfactory.h"
@@ -85,6 +86,9 @@ KStars::KStars(bool doSplash, bool clockrun, const QString &startdate)
 
     KSUtils::Logging::SyncFilterRules();
 
+    if (Options::performanceTracing())
+        Tracer::Instance()->setEnabled(true);
+
     qCInfo(KSTARS) << "Welcome to KStars" << KSTARS_VERSION;
     qCInfo(KSTARS) << "Build:" << KSTARS_BUILD_TS;
     qCInfo(KSTARS) << "OS:" << QSysInfo::productType();
@@ -19,7 +19,10 @@
 
 #include "ksutils.h"
 #include "Options.h"
+#include "auxiliary/cityindex.h"
 #include "auxiliary/kspaths.h"
+#include "auxiliary/snapshotcache.h"
+#include "auxiliary/startuploader.h"
 #include "skycomponents/supernovaecomponent.h"
 #include "skycomponents/skymapcomposite.h"
 #include "ksnotification.h"
@@ -45,6 +48,28 @@
 
 namespace
 {
+// Versions of the URL and ADV tree snapshot contents, to increase whenever their records change
+const quint32 URL_SNAPSHOT_VERSION = 1;
+const quint32 ADV_SNAPSHOT_VERSION = 1;
+
+/** One entry of the ADV tree as read from advinterface.dat */
+struct ADVRecord
+{
+    QString name;
+    QString link;
+    int type { 0 };
+};
+
+QDataStream &operator<<(QDataStream &stream, const ADVRecord &record)
+{
+    return stream << record.name << record.link << record.type;
+}
+
+QDataStream &operator>>(QDataStream &stream, ADVRecord &record)
+{
+    return stream >> record.name >> record.link >> record.type;
+}
+
 // Report fatal error during data loading to user
 // Calls QApplication::exit
 void fatalErrorMessage(QString fname)
@@ -112,6 +137,7 @@ KStarsData::KStarsData()
 #ifndef KSTARS_LITE
     m_LogObject.reset(new OAL::Log);
 #endif
+    m_CityIndex.reset(new CityIndex(&Rulebook));
     // at startup times run forward
     setTimeDirection(0.0);
 }
@@ -120,9 +146,11 @@ KStarsData::~KStarsData()
 {
     Q_ASSERT(pinstance);
 
+    // Background loaders still use the sky objects
+    m_StartupLoader.reset();
+
     //delete locale;
-    qDeleteAll(geoList);
-    geoList.clear();
+    m_CityIndex.reset();
     qDeleteAll(ADVtreeList);
     ADVtreeList.clear();
 
@@ -133,90 +161,91 @@ KStarsData::~KStarsData()
 
 bool KStarsData::initialize()
 {
+    // Independent loaders run on the thread pool while the main thread builds the sky components,
+    // which index objects into the shared sky mesh and must stay in the main thread.
+    m_StartupLoader.reset(new StartupLoader("Startup"));
+
     //Initialize CatalogDB//
-    catalogdb()->Initialize();
+    m_StartupLoader->addTask("Catalog database", [this]()
+    {
+        catalogdb()->Initialize();
+        return true;
+    }, QStringList(), StartupLoader::MAIN_THREAD);
 
     //Load Time Zone Rules//
-    emit progressText(i18n("Reading time zone rules"));
-    if (!readTimeZoneRulebook())
+    m_StartupLoader->addTask("Time zone rules", [this]()
     {
-        fatalErrorMessage("TZrules.dat");
-        return false;
-    }
-
-
-    emit progressText(i18n("Upgrade existing user city db to support geographic elevation."));
-
-
-    QString dbfile = KSPaths::writableLocation(QStandardPaths::GenericDataLocation) + QDir::separator() + "mycitydb.sqlite";
+        return readTimeZoneRulebook();
+    });
 
     /// This code to add Height column to table city in mycitydb.sqlite is a transitional measure to support a meaningful
     /// geographic elevation.
-    if (QFile::exists(dbfile))
+    m_StartupLoader->addTask("User city database upgrade", []()
     {
-        QSqlDatabase fixcitydb = QSqlDatabase::addDatabase("QSQLITE", "fixcitydb");
-
-        fixcitydb.setDatabaseName(dbfile);
-        fixcitydb.open();
-
-        if (fixcitydb.tables().contains("city", Qt::CaseInsensitive))
-        {
-            QSqlRecord r = fixcitydb.record("city");
-            if (!r.contains("Elevation"))
-            {
-                emit progressText(i18n("Adding \"Elevation\" column to city table."));
-
-                QSqlQuery query(fixcitydb);
-                if (query.exec("alter table city add column Elevation real default -10;") == false)
-                {
-                    emit progressText(QString("failed to add Elevation column to city table in mycitydb.sqlite: &1").arg(query.lastError().text()));
-                }
-            }
-            else
-            {
-                emit progressText(i18n("City table already contains \"Elevation\"."));
-            }
-        }
-        else
-        {
-            emit progressText(i18n("City table missing from database."));
-        }
-        fixcitydb.close();
-    }
-
+        upgradeUserCityDatabase();
+        return true;
+    });
 
     //Load Cities//
-    emit progressText(i18n("Loading city data"));
-    if (!readCityData())
+    m_StartupLoader->addTask("Cities", [this]()
     {
-        fatalErrorMessage("citydb.sqlite");
-        return false;
-    }
+        return readCityData();
+    }, QStringList() << "Time zone rules" << "User city database upgrade");
+    m_StartupLoader->addTask("City database connections", []()
+    {
+        addCityDatabases();
+        return true;
+    }, QStringList() << "Cities", StartupLoader::MAIN_THREAD);
 
     //Initialize User Database//
-    emit progressText(i18n("Loading User Information"));
-    m_ksuserdb.Initialize();
+    m_StartupLoader->addTask("User database", [this]()
+    {
+        emit progressText(i18n("Loading User Information"));
+        m_ksuserdb.Initialize();
+        return true;
+    }, QStringList(), StartupLoader::MAIN_THREAD);
 
     //Initialize SkyMapComposite//
-    emit progressText(i18n("Loading sky objects"));
-    m_SkyComposite.reset(new SkyMapComposite());
-    //Load Image URLs//
-    //#ifndef Q_OS_ANDROID
-    //On Android these 2 calls produce segfault. WARNING
-    emit progressText(i18n("Loading Image URLs"));
-
-    if( !readURLData( "image_url.dat", 0 ) && !nonFatalErrorMessage( "image_url.dat" ) )
-        return false;
-    //QtConcurrent::run(this, &KStarsData::readURLData, QString("image_url.dat"), 0, false);
+    m_StartupLoader->addTask("Sky objects", [this]()
+    {
+        emit progressText(i18n("Loading sky objects"));
+        m_SkyComposite.reset(new SkyMapComposite());
+        return true;
+    }, QStringList() << "Catalog database" << "User database", StartupLoader::MAIN_THREAD);
 
-    //Load Information URLs//
-    //emit progressText(i18n("Loading Information URLs"));
-    if( !readURLData( "info_url.dat", 1 ) && !nonFatalErrorMessage( "info_url.dat" ) )
-        return false;
-    QtConcurrent::run(this, &KStarsData::readURLData, QString("info_url.dat"), 1, false);
+    //Load Image and Information URLs//
+    // Not needed to display the sky, so the files are parsed in the background and
+    // the links attached to the objects from the main thread once they exist
+    m_StartupLoader->addTask("Image URL file", [this]()
+    {
+        return readURLData("image_url.dat", m_ImageURLs);
+    }, QStringList(), StartupLoader::WORKER_THREAD, false);
+    m_StartupLoader->addTask("Image URLs", [this]()
+    {
+        addURLData(m_ImageURLs, 0);
+        m_ImageURLs.clear();
+        return true;
+    }, QStringList() << "Image URL file" << "Sky objects", StartupLoader::MAIN_THREAD, false);
+    m_StartupLoader->addTask("Information URL file", [this]()
+    {
+        return readURLData("info_url.dat", m_InfoURLs);
+    }, QStringList(), StartupLoader::WORKER_THREAD, false);
+    m_StartupLoader->addTask("Information URLs", [this]()
+    {
+        addURLData(m_InfoURLs, 1);
+        m_InfoURLs.clear();
+        return true;
+    }, QStringList() << "Information URL file" << "Sky objects", StartupLoader::MAIN_THREAD, false);
 
-    //#endif
-    //emit progressText( i18n("Loading Variable Stars" ) );
+    if (m_StartupLoader->run() == false)
+    {
+        const QString failed = m_StartupLoader->failedTask();
+        if (failed == "Time zone rules")
+            fatalErrorMessage("TZrules.dat");
+        else
+            fatalErrorMessage("citydb.sqlite");
+        return false;
+    }
 
 #ifndef KSTARS_LITE
     //Initialize Observing List
@@ -361,36 +390,39 @@ void KStarsData::setTimeDirection(float scale)
     TimeRunsForward = scale >= 0;
 }
 
-GeoLocation *KStarsData::locationNamed(const QString &city, const QString &province, const QString &country)
+QList<GeoLocation *> &KStarsData::getGeoList()
 {
-    foreach (GeoLocation *loc, geoList)
-    {
-        if (loc->translatedName() == city && (province.isEmpty() || loc->translatedProvince() == province) &&
-                (country.isEmpty() || loc->translatedCountry() == country))
-        {
-            return loc;
-        }
-    }
-    return nullptr;
+    return m_CityIndex->locations();
 }
 
-GeoLocation *KStarsData::nearestLocation(double longitude, double latitude)
+QList<GeoLocation *> KStarsData::searchLocations(const QString &city, const QString &province, const QString &country)
 {
-    GeoLocation *nearest = nullptr;
-    double distance = 1e6;
+    return m_CityIndex->search(city, province, country);
+}
 
-    dms lng(longitude), lat(latitude);
-    for (auto oneCity : geoList)
-    {
-        double newDistance = oneCity->distanceTo(lng, lat);
-        if (newDistance < distance)
-        {
-            distance = newDistance;
-            nearest = oneCity;
-        }
-    }
+void KStarsData::addLocation(GeoLocation *location)
+{
+    m_CityIndex->add(location);
+}
 
-    return nearest;
+void KStarsData::updateLocation(GeoLocation *location)
+{
+    m_CityIndex->update(location);
+}
+
+void KStarsData::removeLocation(GeoLocation *location)
+{
+    m_CityIndex->remove(location);
+}
+
+GeoLocation *KStarsData::locationNamed(const QString &city, const QString &province, const QString &country)
+{
+    return m_CityIndex->find(city, province, country);
+}
+
+GeoLocation *KStarsData::nearestLocation(double longitude, double latitude)
+{
+    return m_CityIndex->nearest(longitude, latitude);
 }
 
 void KStarsData::setLocationFromOptions()
@@ -433,82 +465,91 @@ SkyObject *KStarsData::objectNamed(const QString &name)
     return skyComposite()->findByName(name);
 }
 
-bool KStarsData::readCityData()
+void KStarsData::upgradeUserCityDatabase()
 {
-    QSqlDatabase citydb = QSqlDatabase::addDatabase("QSQLITE", "citydb");
-    QString dbfile      = KSPaths::locate(QStandardPaths::GenericDataLocation, "citydb.sqlite");
-    citydb.setDatabaseName(dbfile);
-    if (citydb.open() == false)
+    QString dbfile = KSPaths::writableLocation(QStandardPaths::GenericDataLocation) + QDir::separator() + "mycitydb.sqlite";
+
+    if (QFile::exists(dbfile))
     {
-        qCCritical(KSTARS) << "Unable to open city database file " << dbfile << citydb.lastError().text();
-        return false;
-    }
+        QSqlDatabase fixcitydb = QSqlDatabase::addDatabase("QSQLITE", "fixcitydb");
 
-    QSqlQuery get_query(citydb);
+        fixcitydb.setDatabaseName(dbfile);
+        fixcitydb.open();
 
-    //get_query.prepare("SELECT * FROM city");
-    if (!get_query.exec("SELECT * FROM city"))
-    {
-        qCCritical(KSTARS) << get_query.lastError();
-        return false;
+        if (fixcitydb.tables().contains("city", Qt::CaseInsensitive))
+        {
+            QSqlRecord r = fixcitydb.record("city");
+            if (!r.contains("Elevation"))
+            {
+                qCInfo(KSTARS) << "Adding \"Elevation\" column to city table.";
+
+                QSqlQuery query(fixcitydb);
+                if (query.exec("alter table city add column Elevation real default -10;") == false)
+                {
+                    qCWarning(KSTARS) << "Failed to add Elevation column to city table in mycitydb.sqlite:" << query.lastError().text();
+                }
+            }
+        }
+        else
+        {
+            qCWarning(KSTARS) << "City table missing from database.";
+        }
+        fixcitydb.close();
     }
+}
 
+bool KStarsData::readCityData()
+{
+    // The connections are only used by this thread, they are added again in the main thread by addCityDatabases()
     bool citiesFound = false;
-    // get_query.size() always returns -1 so we set citiesFound if at least one city is found
-    while (get_query.next())
     {
-        citiesFound          = true;
-        QString name         = get_query.value(1).toString();
-        QString province     = get_query.value(2).toString();
-        QString country      = get_query.value(3).toString();
-        dms lat              = dms(get_query.value(4).toString());
-        dms lng              = dms(get_query.value(5).toString());
-        double TZ            = get_query.value(6).toDouble();
-        TimeZoneRule *TZrule = &(Rulebook[get_query.value(7).toString()]);
-        double elevation     = get_query.value(8).toDouble();
-
-        // appends city names to list
-        geoList.append(new GeoLocation(lng, lat, name, province, country, TZ, TZrule, elevation, true, 4));
+        QSqlDatabase citydb = QSqlDatabase::addDatabase("QSQLITE", "citydb_loader");
+        QString dbfile      = KSPaths::locate(QStandardPaths::GenericDataLocation, "citydb.sqlite");
+        citydb.setDatabaseName(dbfile);
+        if (citydb.open() == false)
+        {
+            qCCritical(KSTARS) << "Unable to open city database file " << dbfile << citydb.lastError().text();
+        }
+        else
+        {
+            // Only the records are read, the GeoLocation objects are created when looked up
+            citiesFound = m_CityIndex->load(citydb, true);
+            citydb.close();
+        }
     }
-    citydb.close();
+    QSqlDatabase::removeDatabase("citydb_loader");
 
     // Reading local database
-    QSqlDatabase mycitydb = QSqlDatabase::addDatabase("QSQLITE", "mycitydb");
-    dbfile = KSPaths::writableLocation(QStandardPaths::GenericDataLocation) + QDir::separator() + "mycitydb.sqlite";
-
-    if (QFile::exists(dbfile))
     {
-        mycitydb.setDatabaseName(dbfile);
-        if (mycitydb.open())
-        {
-            QSqlQuery get_query(mycitydb);
+        QSqlDatabase mycitydb = QSqlDatabase::addDatabase("QSQLITE", "mycitydb_loader");
+        QString dbfile = KSPaths::writableLocation(QStandardPaths::GenericDataLocation) + QDir::separator() + "mycitydb.sqlite";
 
-            if (!get_query.exec("SELECT * FROM city"))
-            {
-                qDebug() << get_query.lastError();
-                return false;
-            }
-            while (get_query.next())
+        if (QFile::exists(dbfile))
+        {
+            mycitydb.setDatabaseName(dbfile);
+            if (mycitydb.open())
             {
-                QString name         = get_query.value(1).toString();
-                QString province     = get_query.value(2).toString();
-                QString country      = get_query.value(3).toString();
-                dms lat              = dms(get_query.value(4).toString());
-                dms lng              = dms(get_query.value(5).toString());
-                double TZ            = get_query.value(6).toDouble();
-                TimeZoneRule *TZrule = &(Rulebook[get_query.value(7).toString()]);
-                double elevation     = get_query.value(8).toDouble();
-
-                // appends city names to list
-                geoList.append(new GeoLocation(lng, lat, name, province, country, TZ, TZrule, elevation, false, 4));
+                m_CityIndex->load(mycitydb, false);
+                mycitydb.close();
             }
-            mycitydb.close();
         }
     }
+    QSqlDatabase::removeDatabase("mycitydb_loader");
 
     return citiesFound;
 }
 
+void KStarsData::addCityDatabases()
+{
+    QSqlDatabase citydb = QSqlDatabase::addDatabase("QSQLITE", "citydb");
+    citydb.setDatabaseName(KSPaths::locate(QStandardPaths::GenericDataLocation, "citydb.sqlite"));
+
+    QSqlDatabase mycitydb = QSqlDatabase::addDatabase("QSQLITE", "mycitydb");
+    QString dbfile = KSPaths::writableLocation(QStandardPaths::GenericDataLocation) + QDir::separator() + "mycitydb.sqlite";
+    if (QFile::exists(dbfile))
+        mycitydb.setDatabaseName(dbfile);
+}
+
 bool KStarsData::readTimeZoneRulebook()
 {
     QFile file;
@@ -683,8 +724,7 @@ bool KStarsData::openUrlFile(const QString &urlfile, QFile &file)
     return fileFound;
 }
 
-// FIXME: This is a significant contributor to KStars start-up time
-bool KStarsData::readURLData(const QString &urlfile, int type, bool deepOnly)
+bool KStarsData::readURLData(const QString &urlfile, QVector<URLEntry> &entries)
 {
 #ifndef KSTARS_LITE
     if (KStars::Closing)
@@ -695,63 +735,79 @@ bool KStarsData::readURLData(const QString &urlfile, int type, bool deepOnly)
     if (!openUrlFile(urlfile, file))
         return false;
 
-    QTextStream stream(&file);
-
-    while (!stream.atEnd())
+    // The links are parsed once and kept in a snapshot until the file is edited
+    SnapshotCache snapshot(QFileInfo(urlfile).completeBaseName(), QStringList(file.fileName()), URL_SNAPSHOT_VERSION);
+    entries = snapshot.loadOrParse<QVector<URLEntry>>([&]()
     {
-        QString line = stream.readLine();
+        QVector<URLEntry> parsed;
+        QTextStream stream(&file);
 
-        //ignore comment lines
-        if (!line.startsWith('#'))
+        while (!stream.atEnd())
         {
-#ifndef KSTARS_LITE
-            if (KStars::Closing)
+            QString line = stream.readLine();
+
+            //ignore comment lines
+            if (!line.startsWith('#'))
             {
-                file.close();
-                return true;
-            }
+#ifndef KSTARS_LITE
+                // Nothing is kept in the snapshot when closing
+                if (KStars::Closing)
+                    return QVector<URLEntry>();
 #endif
 
-            int idx      = line.indexOf(':');
-            QString name = line.left(idx);
-            if (name == "XXX")
-                continue;
-            QString sub   = line.mid(idx + 1);
-            idx           = sub.indexOf(':');
-            QString title = sub.left(idx);
-            QString url   = sub.mid(idx + 1);
-            // Dirty hack to fix things up for planets
-
-            //            if (name == "Mercury" || name == "Venus" || name == "Mars" || name == "Jupiter" || name == "Saturn" ||
-            //                    name == "Uranus" || name == "Neptune" /* || name == "Pluto" */)
-            //                o = skyComposite()->findByName(i18n(name.toLocal8Bit().data()));
-            //            else
-            SkyObject *o = skyComposite()->findByName(name);
-
-            if (!o)
-            {
-                qCWarning(KSTARS) << i18n("Object named %1 not found", name);
+                int idx      = line.indexOf(':');
+                QString name = line.left(idx);
+                if (name == "XXX")
+                    continue;
+                QString sub   = line.mid(idx + 1);
+                idx           = sub.indexOf(':');
+
+                URLEntry entry;
+                entry.name  = name;
+                entry.title = sub.left(idx);
+                entry.url   = sub.mid(idx + 1);
+                parsed.append(entry);
             }
-            else
+        }
+        return parsed;
+    });
+    file.close();
+    return true;
+}
+
+void KStarsData::addURLData(const QVector<URLEntry> &entries, int type, bool deepOnly)
+{
+    for (const URLEntry &entry : entries)
+    {
+        // Dirty hack to fix things up for planets
+
+        //            if (name == "Mercury" || name == "Venus" || name == "Mars" || name == "Jupiter" || name == "Saturn" ||
+        //                    name == "Uranus" || name == "Neptune" /* || name == "Pluto" */)
+        //                o = skyComposite()->findByName(i18n(name.toLocal8Bit().data()));
+        //            else
+        SkyObject *o = skyComposite()->findByName(entry.name);
+
+        if (!o)
+        {
+            qCWarning(KSTARS) << i18n("Object named %1 not found", entry.name);
+        }
+        else
+        {
+            if (!deepOnly || (o->type() > 2 && o->type() < 9))
             {
-                if (!deepOnly || (o->type() > 2 && o->type() < 9))
+                if (type == 0) //image URL
                 {
-                    if (type == 0) //image URL
-                    {
-                        o->ImageList().append(url);
-                        o->ImageTitle().append(title);
-                    }
-                    else if (type == 1) //info URL
-                    {
-                        o->InfoList().append(url);
-                        o->InfoTitle().append(title);
-                    }
+                    o->ImageList().append(entry.url);
+                    o->ImageTitle().append(entry.title);
+                }
+                else if (type == 1) //info URL
+                {
+                    o->InfoList().append(entry.url);
+                    o->InfoTitle().append(entry.title);
                 }
             }
         }
     }
-    file.close();
-    return true;
 }
 
 // FIXME: Improve the user log system
@@ -825,58 +881,75 @@ bool KStarsData::readUserLog()
 bool KStarsData::readADVTreeData()
 {
     QFile file;
-    QString Interface;
-    QString Name, Link, subName;
 
     if (!KSUtils::openDataFile(file, "advinterface.dat"))
         return false;
 
-    QTextStream stream(&file);
-    QString Line;
-
-    while (!stream.atEnd())
+    // The tree is parsed once and kept in a snapshot until the file is edited
+    SnapshotCache snapshot("advinterface", QStringList(file.fileName()), ADV_SNAPSHOT_VERSION);
+    const QVector<ADVRecord> records = snapshot.loadOrParse<QVector<ADVRecord>>([&]()
     {
-        int Type, interfaceIndex;
+        QVector<ADVRecord> parsed;
+        QString Interface;
+        QString Name, Link, subName;
 
-        Line = stream.readLine();
+        QTextStream stream(&file);
+        QString Line;
 
-        if (Line.startsWith(QLatin1String("[KSLABEL]")))
-        {
-            Name = Line.mid(9);
-            Type = 0;
-        }
-        else if (Line.startsWith(QLatin1String("[END]")))
-            Type = 1;
-        else if (Line.startsWith(QLatin1String("[KSINTERFACE]")))
+        while (!stream.atEnd())
         {
-            Interface = Line.mid(13);
-            continue;
-        }
+            int Type, interfaceIndex;
 
-        else
-        {
-            int idx = Line.indexOf(':');
-            Name    = Line.left(idx);
-            Link    = Line.mid(idx + 1);
+            Line = stream.readLine();
 
-            // Link is empty, using Interface instead
-            if (Link.isEmpty())
+            if (Line.startsWith(QLatin1String("[KSLABEL]")))
             {
-                Link           = Interface;
-                subName        = Name;
-                interfaceIndex = Link.indexOf(QLatin1String("KSINTERFACE"));
-                Link.remove(interfaceIndex, 11);
-                Link = Link.insert(interfaceIndex, subName.replace(' ', '+'));
+                Name = Line.mid(9);
+                Type = 0;
             }
+            else if (Line.startsWith(QLatin1String("[END]")))
+                Type = 1;
+            else if (Line.startsWith(QLatin1String("[KSINTERFACE]")))
+            {
+                Interface = Line.mid(13);
+                continue;
+            }
+
+            else
+            {
+                int idx = Line.indexOf(':');
+                Name    = Line.left(idx);
+                Link    = Line.mid(idx + 1);
 
-            Type = 2;
+                // Link is empty, using Interface instead
+                if (Link.isEmpty())
+                {
+                    Link           = Interface;
+                    subName        = Name;
+                    interfaceIndex = Link.indexOf(QLatin1String("KSINTERFACE"));
+                    Link.remove(interfaceIndex, 11);
+                    Link = Link.insert(interfaceIndex, subName.replace(' ', '+'));
+                }
+
+                Type = 2;
+            }
+
+            ADVRecord record;
+            record.name = Name;
+            record.link = Link;
+            record.type = Type;
+            parsed.append(record);
         }
+        return parsed;
+    });
 
+    for (const ADVRecord &record : records)
+    {
         ADVTreeData *ADVData = new ADVTreeData;
 
-        ADVData->Name = Name;
-        ADVData->Link = Link;
-        ADVData->Type = Type;
+        ADVData->Name = record.name;
+        ADVData->Link = record.link;
+        ADVData->Type = record.type;
 
         ADVtreeList.append(ADVData);
     }
@@ -1453,7 +1526,7 @@ bool KStarsData::executeScript(const QString &scriptname, SkyMap *map)
                 }
 
                 bool cityFound(false);
-                foreach (GeoLocation *loc, geoList)
+                foreach (GeoLocation *loc, searchLocations(city))
                 {
                     if (loc->translatedName() == city &&
                             (province.isEmpty() || loc->translatedProvince() == province) &&
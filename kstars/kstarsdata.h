@@ -29,9 +29,11 @@
 #include "oal/log.h"
 #endif
 
+#include <QDataStream>
 #include <QList>
 #include <QMap>
 #include <QKeySequence>
+#include <QVector>
 
 #include <iostream>
 #include <memory>
@@ -45,12 +47,14 @@
 class QFile;
 
 class Execute;
+class CityIndex;
 class FOV;
 class ImageExporter;
 class SkyMap;
 class SkyMapComposite;
 class SkyObject;
 class ObservingList;
+class StartupLoader;
 class TimeZoneRule;
 
 #ifdef KSTARS_LITE
@@ -89,7 +93,7 @@ class KStarsData : public QObject
         friend class KStars;
         // FIXME: it uses temporary trail and resumeKey
         friend class SkyMap;
-        // FIXME: uses geoList and changes it.
+        // FIXME: uses Rulebook
         friend class LocationDialog;
         friend class LocationDialogLite;
 
@@ -199,6 +203,12 @@ class KStarsData : public QObject
             return &m_catalogdb;
         }
 
+        /** @return loader of the startup data, which tells when data loaded in the background is ready */
+        StartupLoader *startupLoader()
+        {
+            return m_StartupLoader.get();
+        }
+
         /** @return pointer to the simulation Clock object */
         Q_INVOKABLE SimClock *clock()
         {
@@ -217,11 +227,27 @@ class KStarsData : public QObject
             return &m_Geo;
         }
 
-        /** @return list of all geographic locations */
-        QList<GeoLocation *> &getGeoList()
-        {
-            return geoList;
-        }
+        /**
+         * @return list of all geographic locations.
+         * @note Creates every location, prefer searchLocations() or locationNamed() to find some of them.
+         */
+        QList<GeoLocation *> &getGeoList();
+
+        /**
+         * @brief Find the locations whose translated name, province and country start with the given
+         * strings, ignoring case. Empty strings match all locations.
+         */
+        QList<GeoLocation *> searchLocations(const QString &city, const QString &province = QString(),
+                                             const QString &country = QString());
+
+        /** Add a location to the list of geographic locations, which takes ownership of it */
+        void addLocation(GeoLocation *location);
+
+        /** Tell the list of geographic locations that the name or the position of a location changed */
+        void updateLocation(GeoLocation *location);
+
+        /** Remove a location from the list of geographic locations, the caller takes ownership of it */
+        void removeLocation(GeoLocation *location);
 
         GeoLocation *locationNamed(const QString &city, const QString &province = QString(),
                                    const QString &country = QString());
@@ -399,19 +425,45 @@ class KStarsData : public QObject
         void setTimeDirection(float scale);
 
     private:
+        /** One line of the image or information URL files */
+        struct URLEntry
+        {
+            QString name;
+            QString title;
+            QString url;
+
+            friend QDataStream &operator<<(QDataStream &stream, const URLEntry &entry)
+            {
+                return stream << entry.name << entry.title << entry.url;
+            }
+            friend QDataStream &operator>>(QDataStream &stream, URLEntry &entry)
+            {
+                return stream >> entry.name >> entry.title >> entry.url;
+            }
+        };
+
         /**
-         * Populate list of geographic locations from "citydb.sqlite" database. Also check for custom
-         * locations file "mycitydb.sqlite" database, but don't require it.  Each line in the file
-         * provides the information required to create one GeoLocation object.
+         * Index the geographic locations of the "citydb.sqlite" database. Also check for custom
+         * locations file "mycitydb.sqlite" database, but don't require it. The GeoLocation objects
+         * are only created when the locations are looked up.
          * @short Fill list of geographic locations from file(s)
          * @return true if at least one city read successfully.
          * @see KStarsData::processCity()
          */
         bool readCityData();
 
+        /**
+         * Add the "citydb" and "mycitydb" connections used by the location dialogs.
+         * Must run in the main thread, as Qt only lets a connection be used by the thread that created it.
+         */
+        static void addCityDatabases();
+
         /** Read the data file that contains daylight savings time rules. */
         bool readTimeZoneRulebook();
 
+        /** Add the Elevation column to the city table of "mycitydb.sqlite" if missing. */
+        static void upgradeUserCityDatabase();
+
         //TODO JM: ADV tree should use XML instead
         /**
          * Read Advanced interface structure to be used later to construct the list view in
@@ -454,9 +506,20 @@ class KStarsData : public QObject
          * @li Menu text.  The string that should appear in the popup menu to activate the link.
          * @li URL.
          * @short Read in image and information URLs.
+         * Only the file is parsed, so this may run in any thread. See addURLData().
+         * @param urlfile name of the data file
+         * @param entries filled with the links read
          * @return true if data files were successfully read.
          */
-        bool readURLData(const QString &url, int type = 0, bool deepOnly = false);
+        bool readURLData(const QString &urlfile, QVector<URLEntry> &entries);
+
+        /**
+         * @short Attach image or information URLs to their sky objects. Must run in the main thread.
+         * @param entries links returned by readURLData()
+         * @param type 0 for image URLs, 1 for information URLs
+         * @param deepOnly only attach the links of deep-sky objects
+         */
+        void addURLData(const QVector<URLEntry> &entries, int type = 0, bool deepOnly = false);
 
         /**
          * @short open a file containing URL links.
@@ -474,6 +537,9 @@ class KStarsData : public QObject
 
         QList<ADVTreeData *> ADVtreeList;
         std::unique_ptr<SkyMapComposite> m_SkyComposite;
+        std::unique_ptr<StartupLoader> m_StartupLoader;
+        // Links read in the background at startup, waiting to be attached to their objects
+        QVector<URLEntry> m_ImageURLs, m_InfoURLs;
 
         GeoLocation m_Geo;
         SimClock Clock;
@@ -510,8 +576,8 @@ class KStarsData : public QObject
         // FIXME: Used in kstarsdcop.cpp only
         KStarsDateTime StoredDate;
 
-        QList<GeoLocation *> geoList;
         QMap<QString, TimeZoneRule> Rulebook;
+        std::unique_ptr<CityIndex> m_CityIndex;
 
         quint32 m_preUpdateID, m_updateID;
         quint32 m_preUpdateNumID, m_updateNumID;
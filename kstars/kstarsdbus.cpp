@@ -282,7 +282,7 @@ bool KStars::setGeoLocation(const QString &city, const QString &province, const
     //Set the geographic location
     bool cityFound(false);
 
-    foreach (GeoLocation *loc, data()->geoList)
+    foreach (GeoLocation *loc, data()->searchLocations(city))
     {
         if (loc->translatedName() == city && (province.isEmpty() || loc->translatedProvince() == province) &&
                 loc->translatedCountry() == country)
@@ -138,21 +138,11 @@ void LocationDialogLite::filterCity(const QString &city, const QString &province
     QStringList cities;
     filteredCityList.clear();
 
-    foreach (GeoLocation *loc, data->getGeoList())
+    foreach (GeoLocation *loc, data->searchLocations(city, province, country))
     {
-        QString sc(loc->translatedName());
-        QString ss(loc->translatedCountry());
-        QString sp = "";
-        if (!loc->province().isEmpty())
-            sp = loc->translatedProvince();
-
-        if (sc.toLower().startsWith(city.toLower()) && sp.toLower().startsWith(province.toLower()) &&
-            ss.toLower().startsWith(country.toLower()))
-        {
-            QString name = loc->fullName();
-            cities.append(name);
-            filteredCityList.insert(name, loc);
-        }
+        QString name = loc->fullName();
+        cities.append(name);
+        filteredCityList.insert(name, loc);
     }
     m_cityList.setStringList(cities);
     m_cityList.sort(0);
@@ -223,7 +213,7 @@ bool LocationDialogLite::addCity(const QString &city, const QString &province, c
 
         //Add city to geoList
         g = new GeoLocation(lng, lat, City, Province, Country, TZ, &KStarsData::Instance()->Rulebook[TZRule]);
-        KStarsData::Instance()->getGeoList().append(g);
+        KStarsData::Instance()->addLocation(g);
 
         mycitydb.commit();
         mycitydb.close();
@@ -252,7 +242,7 @@ bool LocationDialogLite::deleteCity(const QString &fullName)
         }
 
         filteredCityList.remove(geo->fullName());
-        KStarsData::Instance()->getGeoList().removeOne(geo);
+        KStarsData::Instance()->removeLocation(geo);
         delete (geo);
         mycitydb.commit();
         mycitydb.close();
@@ -302,6 +292,7 @@ bool LocationDialogLite::editCity(const QString &fullName, const QString &city,
         geo->setLong(lng);
         geo->setTZ0(TZ);
         geo->setTZRule(&KStarsData::Instance()->Rulebook[TZRule]);
+        KStarsData::Instance()->updateLocation(geo);
 
         //If we are changing current location update it
         if (m_currentLocation == fullName)
@@ -28,6 +28,7 @@
 #include "htmesh/MeshIterator.h"
 #include "projections/projector.h"
 #include "skynodes/pointsourcenode.h"
+#include "skynodes/starbatchnode.h"
 #include "skynodes/trixelnode.h"
 
 DeepStarItem::DeepStarItem(DeepStarComponent *deepStarComp, RootNode *rootNode)
@@ -180,19 +181,11 @@ void DeepStarItem::update()
 
                     if (trixel->hideCount() > delLim)
                     {
-                        QLinkedList<QPair<SkyObject *, SkyNode *>>::iterator i = trixel->m_nodes.begin();
-
-                        while (i != trixel->m_nodes.end())
+                        //Delete the StarBatchNode
+                        while (QSGNode *n = trixel->firstChild())
                         {
-                            SkyNode *node = (*i).second;
-                            if (node)
-                            {
-                                trixel->removeChildNode(node);
-                                delete node;
-
-                                *i = QPair<SkyObject *, SkyNode *>((*i).first, 0);
-                            }
-                            ++i;
+                            trixel->removeChildNode(n);
+                            delete n;
                         }
                     }
 
@@ -209,70 +202,38 @@ void DeepStarItem::update()
                         regionID = region.next();
                     }
 
-                    QLinkedList<QPair<SkyObject *, SkyNode *>>::iterator i = (&trixel->m_nodes)->begin();
+                    // All the stars of the trixel are drawn by a single node
+                    StarBatchNode *batch = StarBatchNode::trixelBatch(trixel, rootNode());
+                    batch->beginUpdate();
 
-                    while (i != (&trixel->m_nodes)->end())
-                    {
-                        bool hide     = false;
-                        bool hideSlew = false;
+                    // While slewing deep stars are hidden altogether
+                    bool hideSlew = hideFaintStars && hideStarsMag;
 
-                        bool drawLabel = false;
+                    QLinkedList<QPair<SkyObject *, SkyNode *>>::iterator i = (&trixel->m_nodes)->begin();
 
+                    while (!hideSlew && i != (&trixel->m_nodes)->end())
+                    {
                         StarObject *starObj = static_cast<StarObject *>((*i).first);
-                        SkyNode *node       = (*i).second;
-
-                        int mag = starObj->mag();
 
-                        // break loop if maglim is reached
-                        if (mag > maglim)
-                            hide = true;
-                        if (hideFaintStars && hideStarsMag)
-                            hideSlew = true;
+                        // stars are sorted by magnitude, so all the following ones are hidden too
+                        if (starObj->mag() > maglim)
+                            break;
                         if (starObj->updateID != KStarsData::Instance()->updateID())
                             starObj->JITupdate();
 
-                        if (node)
+                        if (projector->checkVisibility(starObj))
                         {
-                            if (node->hideCount() > delLim || hide)
+                            bool visible = false;
+                            QPointF pos  = projector->toScreen(starObj, true, &visible);
+                            if (visible && projector->onScreen(pos))
                             {
-                                trixel->removeChildNode(node);
-                                delete node;
-                                *i = QPair<SkyObject *, SkyNode *>((*i).first, 0);
-                            }
-                            else
-                            {
-                                if (!hideSlew)
-                                {
-                                    node->update(drawLabel);
-                                }
-                                else
-                                {
-                                    node->hide();
-                                }
-                            }
-                        }
-                        else
-                        {
-                            if (!hide && !hideSlew && projector->checkVisibility(starObj))
-                            {
-                                QPointF pos;
-
-                                bool visible = false;
-                                pos          = projector->toScreen(starObj, true, &visible);
-                                if (visible && projector->onScreen(pos))
-                                {
-                                    PointSourceNode *point =
-                                        new PointSourceNode(starObj, rootNode(), LabelsItem::label_t::STAR_LABEL,
-                                                            starObj->spchar(), starObj->mag(), trixelID);
-                                    trixel->appendChildNode(point);
-
-                                    *i = QPair<SkyObject *, SkyNode *>((*i).first, static_cast<SkyNode *>(point));
-                                    point->updatePos(pos, drawLabel);
-                                }
+                                batch->addStar(pos, PointSourceNode::starWidth(starObj->mag()), starObj->spchar());
                             }
                         }
                         ++i;
                     }
+
+                    batch->endUpdate();
                 }
             }
             else if (false)
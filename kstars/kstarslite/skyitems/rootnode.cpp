@@ -42,9 +42,27 @@
 #include "kstarslite/skyitems/telescopesymbolsitem.h"
 
 #include "kstarslite/skyitems/fovitem.h"
+#include "kstarslite/skyitems/skynodes/starbatchnode.h"
 
+#include <QPainter>
 #include <QSGFlatColorMaterial>
 
+namespace
+{
+// Point the star batches below node to the atlas, including those of hidden trixels
+void setStarAtlas(QSGNode *node, QSGTexture *atlas)
+{
+    for (QSGNode *child = node->firstChild(); child != nullptr; child = child->nextSibling())
+    {
+        StarBatchNode *batch = dynamic_cast<StarBatchNode *>(child);
+        if (batch)
+            batch->setAtlas(atlas);
+        else
+            setStarAtlas(child, atlas);
+    }
+}
+}
+
 RootNode::RootNode() : m_skyMapLite(SkyMapLite::Instance())
     {
     SkyMapLite::setRootNode(this);
@@ -164,6 +182,9 @@ RootNode::~RootNode()
             delete m_textureCache[i][c];
         }
     }
+
+    delete m_starAtlas;
+    delete m_oldStarAtlas;
 }
 
 void RootNode::genCachedTextures()
@@ -184,6 +205,49 @@ void RootNode::genCachedTextures()
                 win->createTextureFromImage(images[i][c]->toImage(), QQuickWindow::TextureCanUseAtlas);
         }
     }
+
+    // Star atlas: one row per spectral class, one column per size. Each image is surrounded by a
+    // transparent pixel so that linear filtering does not pick up its neighbours.
+    QSize cell;
+    int columns = 0;
+    for (int i = 0; i < images.length(); ++i)
+    {
+        columns = qMax(columns, images[i].length());
+        for (int c = 1; c < images[i].length(); ++c)
+            cell = cell.expandedTo(images[i][c]->size());
+    }
+    cell += QSize(2, 2);
+
+    QImage atlas(columns * cell.width(), images.length() * cell.height(), QImage::Format_ARGB32_Premultiplied);
+    atlas.fill(Qt::transparent);
+
+    const qreal ratio = win->effectiveDevicePixelRatio();
+    m_starSprites     = QVector<QVector<StarSprite>>(images.length());
+
+    QPainter p(&atlas);
+    for (int i = 0; i < images.length(); ++i)
+    {
+        m_starSprites[i] = QVector<StarSprite>(images[i].length());
+        for (int c = 1; c < images[i].length(); ++c)
+        {
+            const QPixmap *image = images[i][c];
+            const QPoint origin(c * cell.width() + 1, i * cell.height() + 1);
+            p.drawPixmap(origin, *image);
+
+            StarSprite &sprite = m_starSprites[i][c];
+            sprite.source      = QRectF(qreal(origin.x()) / atlas.width(), qreal(origin.y()) / atlas.height(),
+                                        qreal(image->width()) / atlas.width(), qreal(image->height()) / atlas.height());
+            //We divide size of texture by ratio. Otherwise stars will be very large
+            sprite.size = QSizeF(image->width() / ratio, image->height() / ratio);
+        }
+    }
+    p.end();
+
+    //The previous atlas is deleted on the next update, no StarBatchNode refers to it anymore
+    delete m_oldStarAtlas;
+    m_oldStarAtlas = m_starAtlas;
+    m_starAtlas    = win->createTextureFromImage(atlas);
+    setStarAtlas(this, m_starAtlas);
 }
 
 QSGTexture *RootNode::getCachedTexture(int size, char spType)
@@ -191,6 +255,11 @@ QSGTexture *RootNode::getCachedTexture(int size, char spType)
     return m_textureCache[SkyMapLite::Instance()->harvardToIndex(spType)][size];
 }
 
+const RootNode::StarSprite &RootNode::starSprite(int size, char spType) const
+{
+    return m_starSprites[SkyMapLite::Instance()->harvardToIndex(spType)][size];
+}
+
 void RootNode::updateClipPoly()
 {
     QPolygonF newClip = m_skyMapLite->projector()->clipPoly();
@@ -306,5 +375,8 @@ void RootNode::update(bool clearTextures)
                 qDeleteAll(textures.begin(), textures.end());
             }
         }
+
+        delete m_oldStarAtlas;
+        m_oldStarAtlas = nullptr;
     }
 }
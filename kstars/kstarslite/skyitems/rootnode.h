@@ -19,6 +19,9 @@
 #include "kstarslite.h"
 
 #include <QPolygonF>
+#include <QRectF>
+#include <QSizeF>
+#include <QVector>
 #include <QSGClipNode>
 
 class QSGTexture;
@@ -72,6 +75,15 @@ class TelescopeSymbolsItem;
 class RootNode : public QSGClipNode
 {
   public:
+    /** Location of a star image in the star atlas */
+    struct StarSprite
+    {
+        /// Normalized texture coordinates in the atlas
+        QRectF source;
+        /// Size on SkyMapLite in device independent pixels
+        QSizeF size;
+    };
+
     RootNode();
     virtual ~RootNode();
 
@@ -83,6 +95,16 @@ class RootNode : public QSGClipNode
      */
     QSGTexture *getCachedTexture(int size, char spType);
 
+    /** @return texture holding the images of stars of all sizes and spectral classes, used by StarBatchNode */
+    inline QSGTexture *starAtlas() const { return m_starAtlas; }
+
+    /**
+     * @short returns the location of a star image in starAtlas()
+     * @param size size of the star
+     * @param spType spectral class
+     */
+    const StarSprite &starSprite(int size, char spType) const;
+
     /** @short triangulates and sets new clipping polygon provided by Projection system */
     void updateClipPoly();
 
@@ -102,7 +124,7 @@ class RootNode : public QSGClipNode
     inline LabelsItem *labelsItem() { return m_labelsItem; }
 
     inline StarItem *starItem() { return m_starItem; }
-    /** @short initializes textureCache with cached images of stars from SkyMapLite */
+    /** @short initializes textureCache and the star atlas with cached images of stars from SkyMapLite */
     void genCachedTextures();
 
     inline TelescopeSymbolsItem *telescopeSymbolsItem() { return m_telescopeSymbols; }
@@ -110,6 +132,9 @@ class RootNode : public QSGClipNode
   private:
     QVector<QVector<QSGTexture *>> m_textureCache;
     QVector<QVector<QSGTexture *>> m_oldTextureCache;
+    QSGTexture *m_starAtlas { nullptr };
+    QSGTexture *m_oldStarAtlas { nullptr };
+    QVector<QVector<StarSprite>> m_starSprites;
     SkyMapLite *m_skyMapLite { nullptr };
 
     QPolygonF m_clipPoly;
@@ -32,7 +32,7 @@ PointSourceNode::PointSourceNode(SkyObject *skyObject, RootNode *parentNode, Lab
 {
 }
 
-float PointSourceNode::starWidth(float mag) const
+float PointSourceNode::starWidth(float mag)
 {
     //adjust maglimit for ZoomLevel
     const double maxSize = 10.0;
@@ -43,7 +43,7 @@ float PointSourceNode::starWidth(float mag) const
 
     float sizeFactor = maxSize + (lgz - lgmin);
 
-    float m_sizeMagLim = map()->sizeMagLim();
+    float m_sizeMagLim = SkyMapLite::Instance()->sizeMagLim();
 
     float size = (sizeFactor * (m_sizeMagLim - mag) / m_sizeMagLim) + 1.;
     if (size <= 1.0)
@@ -0,0 +1,132 @@
+/** *************************************************************************
+                          starbatchnode.cpp  -  K Desktop Planetarium
+                             -------------------
+ ***************************************************************************/
+/** *************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "starbatchnode.h"
+
+#include "trixelnode.h"
+#include "../rootnode.h"
+
+#include <cstring>
+
+namespace
+{
+// Two triangles per star
+const int VERTICES_PER_STAR = 6;
+// The vertex buffer grows by this number of stars at least
+const int CAPACITY_STEP = 64;
+}
+
+StarBatchNode::StarBatchNode(RootNode *rootNode)
+    : m_rootNode(rootNode), m_geometry(QSGGeometry::defaultAttributes_TexturedPoint2D(), 0)
+{
+    m_geometry.setDrawingMode(GL_TRIANGLES);
+    setGeometry(&m_geometry);
+
+    m_material.setFiltering(QSGTexture::Linear);
+    m_material.setTexture(m_rootNode->starAtlas());
+    setMaterial(&m_material);
+}
+
+StarBatchNode *StarBatchNode::trixelBatch(TrixelNode *trixel, RootNode *rootNode)
+{
+    StarBatchNode *batch = static_cast<StarBatchNode *>(trixel->firstChild());
+    if (!batch)
+    {
+        batch = new StarBatchNode(rootNode);
+        trixel->appendChildNode(batch);
+    }
+    return batch;
+}
+
+void StarBatchNode::setAtlas(QSGTexture *atlas)
+{
+    if (m_material.texture() != atlas)
+    {
+        m_material.setTexture(atlas);
+        markDirty(QSGNode::DirtyMaterial);
+    }
+}
+
+void StarBatchNode::beginUpdate()
+{
+    m_count = 0;
+}
+
+void StarBatchNode::reserve(int stars)
+{
+    if (stars <= m_capacity)
+        return;
+
+    reallocate(qMax(stars, m_capacity + qMax(m_capacity / 2, CAPACITY_STEP)));
+}
+
+void StarBatchNode::reallocate(int capacity)
+{
+    // QSGGeometry::allocate() does not keep the vertex data
+    QVector<QSGGeometry::TexturedPoint2D> vertices(m_count * VERTICES_PER_STAR);
+    if (m_count)
+        std::memcpy(vertices.data(), m_geometry.vertexDataAsTexturedPoint2D(),
+                    vertices.size() * sizeof(QSGGeometry::TexturedPoint2D));
+
+    m_geometry.allocate(capacity * VERTICES_PER_STAR);
+    if (m_count)
+        std::memcpy(m_geometry.vertexDataAsTexturedPoint2D(), vertices.constData(),
+                    vertices.size() * sizeof(QSGGeometry::TexturedPoint2D));
+
+    m_capacity = capacity;
+    // The new part of the buffer is not initialized
+    m_drawn = m_capacity;
+}
+
+void StarBatchNode::addStar(const QPointF &pos, float size, char spType)
+{
+    reserve(m_count + 1);
+
+    const RootNode::StarSprite &sprite = m_rootNode->starSprite(qMin(static_cast<int>(size), 14), spType);
+
+    const float left   = pos.x() - 0.5 * sprite.size.width();
+    const float top    = pos.y() - 0.5 * sprite.size.height();
+    const float right  = left + sprite.size.width();
+    const float bottom = top + sprite.size.height();
+
+    const QRectF &tex = sprite.source;
+
+    QSGGeometry::TexturedPoint2D *v = m_geometry.vertexDataAsTexturedPoint2D() + m_count * VERTICES_PER_STAR;
+    v[0].set(left, top, tex.left(), tex.top());
+    v[1].set(right, top, tex.right(), tex.top());
+    v[2].set(left, bottom, tex.left(), tex.bottom());
+    v[3].set(left, bottom, tex.left(), tex.bottom());
+    v[4].set(right, top, tex.right(), tex.top());
+    v[5].set(right, bottom, tex.right(), tex.bottom());
+
+    ++m_count;
+}
+
+void StarBatchNode::endUpdate()
+{
+    // Trim the buffer once most of it is unused, e.g. after zooming in. The margin avoids
+    // reallocating back and forth when the number of stars oscillates.
+    if (m_capacity > CAPACITY_STEP && m_count < m_capacity / 4)
+        reallocate(qMax(2 * m_count, CAPACITY_STEP));
+
+    // Collapse the quads left over from the previous batch instead of reallocating the buffer
+    if (m_drawn > m_count)
+    {
+        QSGGeometry::TexturedPoint2D *v = m_geometry.vertexDataAsTexturedPoint2D();
+        std::memset(v + m_count * VERTICES_PER_STAR, 0,
+                    (m_drawn - m_count) * VERTICES_PER_STAR * sizeof(QSGGeometry::TexturedPoint2D));
+    }
+    m_drawn = m_count;
+
+    markDirty(QSGNode::DirtyGeometry);
+}
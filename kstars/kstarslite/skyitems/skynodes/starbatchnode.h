@@ -0,0 +1,88 @@
+/** *************************************************************************
+                          starbatchnode.h  -  K Desktop Planetarium
+                             -------------------
+ ***************************************************************************/
+/** *************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#pragma once
+
+#include <QSGGeometryNode>
+#include <QSGTextureMaterial>
+
+class RootNode;
+class TrixelNode;
+
+/**
+ * @class StarBatchNode
+ * @short A geometry node that draws all the visible stars of a trixel in one batch
+ *
+ * Each star is a textured quad whose texture coordinates point to its sprite in the star atlas of
+ * RootNode. The quads of a trixel share a single vertex buffer, which is rewritten in place on each
+ * update of SkyMapLite. It grows when the number of stars outgrows it and is trimmed when most of it
+ * is left unused. Compared to one PointSourceNode per star this saves a node, a transform and a
+ * material per star.
+ *
+ * Usage: call beginUpdate(), addStar() for each visible star and endUpdate().
+ */
+class StarBatchNode : public QSGGeometryNode
+{
+  public:
+    /**
+     * @short Constructor
+     * @param rootNode pointer to the top parent node, which holds the star atlas
+     */
+    explicit StarBatchNode(RootNode *rootNode);
+
+    /**
+     * @short returns the batch of a trixel, appended to it on first use
+     * @param trixel trixel node which only holds the batch
+     * @param rootNode pointer to the top parent node, which holds the star atlas
+     */
+    static StarBatchNode *trixelBatch(TrixelNode *trixel, RootNode *rootNode);
+
+    /** @short Draw the stars from a new atlas, set by RootNode when the atlas is regenerated */
+    void setAtlas(QSGTexture *atlas);
+
+    /** @short Start a new batch, the stars of the previous one are discarded */
+    void beginUpdate();
+
+    /**
+     * @short Append a star to the batch
+     * @param pos position of the star on SkyMapLite
+     * @param size size of the star as returned by PointSourceNode::starWidth()
+     * @param spType spectral class of the star
+     */
+    void addStar(const QPointF &pos, float size, char spType);
+
+    /**
+     * @short Hide the unused part of the vertex buffer and mark the geometry dirty
+     * The buffer is trimmed when the batch only uses a small part of it.
+     */
+    void endUpdate();
+
+    /** @return number of stars in the current batch */
+    inline int starCount() const { return m_count; }
+
+  private:
+    /** @short Grow the vertex buffer so that it can hold stars, keeping the current quads */
+    void reserve(int stars);
+    /** @short Reallocate the vertex buffer for capacity stars, keeping the current quads */
+    void reallocate(int capacity);
+
+    RootNode *m_rootNode { nullptr };
+    QSGGeometry m_geometry;
+    QSGTextureMaterial m_material;
+    /// Number of stars in the current batch
+    int m_count { 0 };
+    /// Number of stars the vertex buffer can hold
+    int m_capacity { 0 };
+    /// Number of quads that were drawn by the previous batch
+    int m_drawn { 0 };
+};
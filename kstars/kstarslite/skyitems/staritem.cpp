@@ -26,7 +26,9 @@
 #include "starcomponent.h"
 #include "htmesh/MeshIterator.h"
 #include "projections/projector.h"
+#include "skynodes/labelnode.h"
 #include "skynodes/pointsourcenode.h"
+#include "skynodes/starbatchnode.h"
 #include "skynodes/trixelnode.h"
 
 #include <QLinkedList>
@@ -176,19 +178,8 @@ void StarItem::update()
         {
             StarList *skyList = index->at(trixelID);
 
-            QSGNode *n = trixel->firstChild();
-
-            //Delete nodes
-            while (n != 0)
-            {
-                QSGNode *c = n;
-                n          = n->nextSibling();
-
-                trixel->removeChildNode(c);
-                delete c;
-            }
-
-            //Delete all pairs that represent stars
+            //Labels were deleted above
+            deleteBatch(trixel);
             trixel->m_nodes.clear();
 
             for (int c = 0; c < skyList->size(); ++c)
@@ -209,7 +200,8 @@ void StarItem::update()
 
             if (trixel->hideCount() > delLim)
             {
-                trixel->deleteAllChildNodes();
+                deleteBatch(trixel);
+                deleteLabels(trixel);
             }
         }
         else
@@ -222,69 +214,72 @@ void StarItem::update()
                 regionID = region.next();
             }
 
+            // All the stars of the trixel are drawn by a single node, the pairs only hold their labels
+            StarBatchNode *batch = StarBatchNode::trixelBatch(trixel, rootNode());
+            batch->beginUpdate();
+
             QLinkedList<QPair<SkyObject *, SkyNode *>> *nodes = &trixel->m_nodes;
             QLinkedList<QPair<SkyObject *, SkyNode *>>::iterator i = nodes->begin();
             bool hide = false;
 
             while (i != nodes->end())
             {
-                bool drawLabel = false;
-
                 StarObject *starObj = static_cast<StarObject *>((*i).first);
-                SkyNode *node       = (*i).second;
+                LabelNode *starLabel = static_cast<LabelNode *>((*i).second);
 
                 int mag = starObj->mag();
 
-                // break loop if maglim is reached
+                // stars are sorted by magnitude, so all the following ones are hidden too
                 if (mag > maglim)
                     hide = true;
-                if (!(hideLabel || mag > labelMagLim))
-                    drawLabel = true;
-                if (starObj->updateID != KStarsData::Instance()->updateID())
-                    starObj->JITupdate();
 
-                if (node)
+                if (hide)
                 {
-                    if (node->hideCount() > delLim || hide)
+                    if (starLabel)
                     {
-                        trixel->removeChildNode(node);
-                        delete node;
+                        deleteLabel(starLabel);
                         *i = QPair<SkyObject *, SkyNode *>((*i).first, 0);
                     }
-                    else
-                    {
-                        if (!hide)
-                        {
-                            node->update(drawLabel);
-                        }
-                        else
-                        {
-                            node->hide();
-                        }
-                    }
+                    ++i;
+                    continue;
                 }
-                else
+
+                bool drawLabel = !(hideLabel || mag > labelMagLim);
+                if (starObj->updateID != KStarsData::Instance()->updateID())
+                    starObj->JITupdate();
+
+                bool visible = false;
+                QPointF pos;
+                if (projector->checkVisibility(starObj))
+                    pos = projector->toScreen(starObj, true, &visible);
+
+                if (visible && projector->onScreen(pos))
                 {
-                    if (!hide && projector->checkVisibility(starObj))
-                    {
-                        QPointF pos;
+                    batch->addStar(pos, PointSourceNode::starWidth(starObj->mag()), starObj->spchar());
 
-                        bool visible = false;
-                        pos          = projector->toScreen(starObj, true, &visible);
-                        if (visible && projector->onScreen(pos))
+                    if (drawLabel)
+                    {
+                        //Labels are created only when they are needed
+                        if (!starLabel)
                         {
-                            PointSourceNode *point =
-                                new PointSourceNode(starObj, rootNode(), LabelsItem::label_t::STAR_LABEL,
-                                                    starObj->spchar(), starObj->mag(), trixelID);
-                            trixel->appendChildNode(point);
-
-                            *i = QPair<SkyObject *, SkyNode *>((*i).first, static_cast<SkyNode *>(point));
-                            point->updatePos(pos, drawLabel);
+                            starLabel = rootNode()->labelsItem()->addLabel(starObj, labelType(), trixelID);
+                            *i        = QPair<SkyObject *, SkyNode *>((*i).first, starLabel);
                         }
+                        starLabel->setLabelPos(pos);
+                    }
+                    else if (starLabel)
+                    {
+                        starLabel->hide();
                     }
                 }
+                else if (starLabel)
+                {
+                    starLabel->hide();
+                }
                 ++i;
             }
+
+            batch->endUpdate();
         }
         trixel = static_cast<TrixelNode *>(trixel->nextSibling());
         label  = static_cast<TrixelNode *>(label->nextSibling());
@@ -309,10 +304,36 @@ void StarItem::update()
         deepStars->update();
     }
 
-    QSGNode *n = m_stars->firstChild();
-    while (n != 0)
+    m_skyMesh->inDraw(false);
+}
+
+void StarItem::deleteBatch(TrixelNode *trixel)
+{
+    while (QSGNode *n = trixel->firstChild())
     {
-        n = n->nextSibling();
+        trixel->removeChildNode(n);
+        delete n;
     }
-    m_skyMesh->inDraw(false);
+}
+
+void StarItem::deleteLabels(TrixelNode *trixel)
+{
+    QLinkedList<QPair<SkyObject *, SkyNode *>>::iterator i = trixel->m_nodes.begin();
+
+    while (i != trixel->m_nodes.end())
+    {
+        if ((*i).second)
+        {
+            deleteLabel(static_cast<LabelNode *>((*i).second));
+            *i = QPair<SkyObject *, SkyNode *>((*i).first, 0);
+        }
+        ++i;
+    }
+}
+
+void StarItem::deleteLabel(LabelNode *label)
+{
+    //Star labels are children of the trixels of the label tree
+    label->parent()->removeChildNode(label);
+    delete label;
 }
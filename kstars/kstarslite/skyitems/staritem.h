@@ -18,10 +18,12 @@
 
 #include "skyitem.h"
 
+class LabelNode;
 class SkyMesh;
 class SkyOpacityNode;
 class StarBlockFactory;
 class StarComponent;
+class TrixelNode;
 
 /**
  * @class StarItem
@@ -42,13 +44,23 @@ class StarItem : public SkyItem
 
     /**
      * @short Update positions of nodes that represent stars
-     * In this function we perform almost the same thing as in DeepSkyItem::updateDeepSkyNode() to reduce
-     * memory consumption.
+     * The visible stars of each trixel are drawn by a single StarBatchNode, rebuilt on each update.
+     * Labels are created only for the stars that need one and kept in the pairs of the TrixelNode.
+     * Like in DeepSkyItem::updateDeepSkyNode() nodes of trixels hidden for long are deleted to
+     * reduce memory consumption.
      * @see DeepSkyItem::updateDeepSkyNode()
      */
     virtual void update();
 
   private:
+    /** @short delete the StarBatchNode of a trixel */
+    void deleteBatch(TrixelNode *trixel);
+
+    /** @short delete the labels of the stars of a trixel */
+    void deleteLabels(TrixelNode *trixel);
+
+    void deleteLabel(LabelNode *label);
+
     StarComponent *m_starComp { nullptr };
     SkyMesh *m_skyMesh { nullptr };
     StarBlockFactory *m_StarBlockFactory { nullptr };
@@ -22,6 +22,7 @@
 #include "ksutils.h"
 #include "Options.h"
 #include "skymap.h"
+#include "tracer.h"
 #include "widgets/timespinbox.h"
 
 #include <KConfigDialog>
@@ -48,6 +49,8 @@ OpsAdvanced::OpsAdvanced() : QFrame(KStars::Instance())
 
     connect(showLogsB, SIGNAL(clicked()), this, SLOT(slotShowLogFiles()));
 
+    connect(kcfg_PerformanceTracing, SIGNAL(toggled(bool)), this, SLOT(slotTogglePerformanceTracing(bool)));
+
     connect(kcfg_ObsListDemoteHole, &QCheckBox::toggled,
             [this](bool state)
     {
@@ -100,6 +103,20 @@ void OpsAdvanced::slotToggleOutputOptions()
         KSUtils::Logging::UseFile();
 }
 
+void OpsAdvanced::slotTogglePerformanceTracing(bool enabled)
+{
+    if (enabled)
+    {
+        Tracer::Instance()->clear();
+        Tracer::Instance()->setEnabled(true);
+    }
+    else if (Tracer::isEnabled())
+    {
+        Tracer::Instance()->setEnabled(false);
+        Tracer::Instance()->saveToLogs();
+    }
+}
+
 void OpsAdvanced::slotShowLogFiles()
 {
     QUrl path = QUrl::fromLocalFile(KSPaths::writableLocation(QStandardPaths::GenericDataLocation) + "logs");
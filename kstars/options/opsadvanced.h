@@ -46,6 +46,7 @@ class OpsAdvanced : public QFrame, public Ui::OpsAdvanced
     void slotToggleHideOptions();
     void slotToggleVerbosityOptions();
     void slotToggleOutputOptions();
+    void slotTogglePerformanceTracing(bool enabled);
     void slotShowLogFiles();
     void slotApply();
 };
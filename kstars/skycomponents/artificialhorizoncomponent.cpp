@@ -12,6 +12,7 @@
 #include "kstarsdata.h"
 #include "linelist.h"
 #include "Options.h"
+#include "tracer.h"
 #include "skymap.h"
 #include "skymapcomposite.h"
 #include "skypainter.h"
@@ -71,6 +72,8 @@ ArtificialHorizonComponent::~ArtificialHorizonComponent()
 
 bool ArtificialHorizonComponent::load()
 {
+    TraceZone zone("Load artificial horizon", "load");
+
     m_HorizonList = KStarsData::Instance()->userdb()->GetAllHorizons();
 
     foreach (ArtificialHorizonEntity *horizon, m_HorizonList)
@@ -23,9 +23,11 @@
 #include "ksfilereader.h"
 #include "kstarsdata.h"
 #include "Options.h"
+#include "tracer.h"
 #include "solarsystemcomposite.h"
 #include "skycomponent.h"
 #include "skylabeler.h"
+#include "skymesh.h"
 #ifndef KSTARS_LITE
 #include "skymap.h"
 #else
@@ -35,6 +37,7 @@
 #include "auxiliary/kspaths.h"
 #include "auxiliary/ksnotification.h"
 #include "auxiliary/filedownloader.h"
+#include "htmesh/MeshIterator.h"
 #include "projections/projector.h"
 
 #include <KLocalizedString>
@@ -89,6 +92,8 @@ bool AsteroidsComponent::selected()
  */
 void AsteroidsComponent::loadDataFromText()
 {
+    TraceZone zone("Load asteroids", "load");
+
     QString name, full_name, orbit_id, orbit_class, dimensions;
     int mJD;
     double q, a, e, dble_i, dble_w, dble_N, dble_M, H, G, earth_moid;
@@ -239,16 +244,24 @@ SkyObject *AsteroidsComponent::objectNearest(SkyPoint *p, double &maxrad)
     if (!selected())
         return nullptr;
 
-    for (auto o : m_ObjectList)
+    MeshIterator region(SkyMesh::Instance(), OBJ_NEAREST_BUF);
+    while (region.hasNext())
     {
-        if (!((dynamic_cast<KSAsteroid*>(o)->toDraw())))
+        const QVector<SkyObject *> *objects = trixelObjects(region.next());
+        if (!objects)
             continue;
 
-        double r = o->angularDistanceTo(p).Degrees();
-        if (r < maxrad)
+        for (auto o : *objects)
         {
-            oBest  = o;
-            maxrad = r;
+            if (!((dynamic_cast<KSAsteroid*>(o)->toDraw())))
+                continue;
+
+            double r = o->angularDistanceTo(p).Degrees();
+            if (r < maxrad)
+            {
+                oBest  = o;
+                maxrad = r;
+            }
         }
     }
 
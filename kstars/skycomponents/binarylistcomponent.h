@@ -262,6 +262,7 @@ void  BinaryListComponent<T, Component>::clearData()
     qDeleteAll(parent->m_ObjectList);
     parent->m_ObjectList.clear();
     parent->m_ObjectHash.clear();
+    parent->invalidateIndex();
 
     parent->objectLists(T::TYPE).clear();
     parent->objectNames(T::TYPE).clear();
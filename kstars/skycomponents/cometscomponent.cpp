@@ -32,6 +32,7 @@
 #include "kstarslite.h"
 #endif
 #include "Options.h"
+#include "tracer.h"
 #include "skylabeler.h"
 #include "skypainter.h"
 #include "solarsystemcomposite.h"
@@ -89,12 +90,15 @@ bool CometsComponent::selected()
  */
 void CometsComponent::loadData()
 {
+    TraceZone zone("Load comets", "load");
+
     QString name, orbit_id, orbit_class, dimensions;
 
     emitProgressText(i18n("Loading comets"));
 
     qDeleteAll(m_ObjectList);
     m_ObjectList.clear();
+    invalidateIndex();
 
     objectNames(SkyObject::COMET).clear();
     objectLists(SkyObject::COMET).clear();
@@ -0,0 +1,145 @@
+/*  Cache of constellation art images, decoded in the background at the size they are drawn
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+*/
+
+#include "constellationartcache.h"
+
+#include "kstars_debug.h"
+#include "texturemanager.h"
+
+#include <QCoreApplication>
+#include <QImageReader>
+#include <QtConcurrent>
+
+namespace
+{
+// Largest dimension of the smallest and of the largest level, in pixels
+const int MIN_LEVEL = 64;
+const int MAX_LEVEL = 2048;
+// Memory used by the decoded images at most, in bytes
+const qint64 DEFAULT_MAX_BYTES = 64 * 1024 * 1024;
+}
+
+ConstellationArtCache *ConstellationArtCache::_ConstellationArtCache = nullptr;
+
+ConstellationArtCache *ConstellationArtCache::Instance()
+{
+    if (_ConstellationArtCache == nullptr)
+        _ConstellationArtCache = new ConstellationArtCache(qApp);
+
+    return _ConstellationArtCache;
+}
+
+ConstellationArtCache::ConstellationArtCache(QObject *parent) : QObject(parent)
+{
+    // The cost of the images is counted in kilobytes
+    m_Images.setMaxCost(DEFAULT_MAX_BYTES / 1024);
+    m_Pool.setMaxThreadCount(1);
+}
+
+void ConstellationArtCache::setMaxBytes(qint64 bytes)
+{
+    m_Images.setMaxCost(bytes / 1024);
+}
+
+qint64 ConstellationArtCache::bytes() const
+{
+    return static_cast<qint64>(m_Images.totalCost()) * 1024;
+}
+
+void ConstellationArtCache::waitForDone()
+{
+    m_Pool.waitForDone();
+    QCoreApplication::sendPostedEvents(this);
+}
+
+int ConstellationArtCache::levelForSize(double size)
+{
+    int level = MIN_LEVEL;
+    while (level < size && level < MAX_LEVEL)
+        level *= 2;
+    return level;
+}
+
+QString ConstellationArtCache::key(const QString &name, int level)
+{
+    return QString("%1@%2").arg(name).arg(level);
+}
+
+QImage ConstellationArtCache::decode(const QString &name, int level)
+{
+    const QString filename = TextureManager::findTextureFile(name);
+    if (filename.isEmpty())
+        return QImage();
+
+    QImageReader reader(filename);
+    QSize size = reader.size();
+    if (size.isValid() && qMax(size.width(), size.height()) > level)
+    {
+        // Only the scaled image is held in memory
+        size.scale(level, level, Qt::KeepAspectRatio);
+        reader.setScaledSize(size);
+    }
+
+    QImage image = reader.read();
+    if (image.isNull())
+        qCWarning(KSTARS) << "Unable to read constellation image" << filename << reader.errorString();
+    else if (image.format() != QImage::Format_ARGB32_Premultiplied)
+        image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    return image;
+}
+
+QImage ConstellationArtCache::image(const QString &name, double size)
+{
+    if (name.isEmpty() || m_Missing.contains(name))
+        return QImage();
+
+    const int level = levelForSize(size);
+    const QString levelKey = key(name, level);
+
+    if (QImage *cached = m_Images.object(levelKey))
+        return *cached;
+
+    if (m_Pending.contains(levelKey) == false)
+    {
+        m_Pending.insert(levelKey);
+        QtConcurrent::run(&m_Pool, [this, name, level, levelKey]()
+        {
+            const QImage image = decode(name, level);
+            QMetaObject::invokeMethod(this, "insert", Qt::QueuedConnection, Q_ARG(QString, levelKey), Q_ARG(QImage, image));
+        });
+    }
+
+    // Until then, draw the closest level available, preferably a smaller one
+    for (int smaller = level / 2; smaller >= MIN_LEVEL; smaller /= 2)
+    {
+        if (QImage *cached = m_Images.object(key(name, smaller)))
+            return *cached;
+    }
+    for (int larger = level * 2; larger <= MAX_LEVEL; larger *= 2)
+    {
+        if (QImage *cached = m_Images.object(key(name, larger)))
+            return *cached;
+    }
+
+    return QImage();
+}
+
+void ConstellationArtCache::insert(const QString &key, const QImage &image)
+{
+    m_Pending.remove(key);
+
+    if (image.isNull())
+    {
+        m_Missing.insert(key.left(key.lastIndexOf('@')));
+        return;
+    }
+
+    const int cost = qMax(1, image.byteCount() / 1024);
+    m_Images.insert(key, new QImage(image), cost);
+    emit imageLoaded();
+}
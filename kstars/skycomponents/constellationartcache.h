@@ -0,0 +1,78 @@
+/*  Cache of constellation art images, decoded in the background at the size they are drawn
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+*/
+
+#pragma once
+
+#include <QCache>
+#include <QImage>
+#include <QObject>
+#include <QSet>
+#include <QThreadPool>
+
+/**
+ * @class ConstellationArtCache
+ * Holds the constellation art images near the viewport, at the resolution they are drawn.
+ *
+ * Each image is decoded in the background the first time it is requested, scaled down to the
+ * smallest level of a power of two chain that covers the requested size. Zooming in requests a
+ * larger level, while the smaller one keeps being drawn until it is decoded.
+ *
+ * The decoded images are kept in a least recently used cache bounded in bytes, so that the art
+ * of the constellations out of view is released.
+ */
+class ConstellationArtCache : public QObject
+{
+        Q_OBJECT
+
+    public:
+        static ConstellationArtCache *Instance();
+
+        /**
+         * @brief Get the image of a constellation to draw.
+         * @param name image name, from the textures folder.
+         * @param size largest dimension of the image on screen, in pixels.
+         * @return the image at the requested level, or the closest level decoded so far, or a null
+         * image if none is. Missing levels are decoded in the background, see imageLoaded().
+         */
+        QImage image(const QString &name, double size);
+
+        /** Set the maximum memory used by the decoded images, in bytes */
+        void setMaxBytes(qint64 bytes);
+
+        /** @return memory used by the decoded images, in bytes */
+        qint64 bytes() const;
+
+        /** Wait for the images being decoded */
+        void waitForDone();
+
+        /** @return the smallest level covering a size in pixels */
+        static int levelForSize(double size);
+
+    signals:
+        /** Emitted in the main thread when an image was decoded, so that the sky map is drawn again */
+        void imageLoaded();
+
+    private slots:
+        void insert(const QString &key, const QImage &image);
+
+    private:
+        explicit ConstellationArtCache(QObject *parent = nullptr);
+
+        static QString key(const QString &name, int level);
+        // Decode an image file, scaled down so that its largest dimension does not exceed the level
+        static QImage decode(const QString &name, int level);
+
+        static ConstellationArtCache *_ConstellationArtCache;
+
+        QCache<QString, QImage> m_Images;
+        // Keys of the images being decoded
+        QSet<QString> m_Pending;
+        // Images whose file cannot be read
+        QSet<QString> m_Missing;
+        QThreadPool m_Pool;
+};
@@ -21,7 +21,9 @@
 #include "culturelist.h"
 #include "kspaths.h"
 #include "Options.h"
+#include "tracer.h"
 #ifndef KSTARS_LITE
+#include "constellationartcache.h"
 #include "skymap.h"
 #include "skypainter.h"
 #endif
@@ -34,10 +36,20 @@ ConstellationArtComponent::ConstellationArtComponent(SkyComposite *parent, Cultu
     cultureName = cultures->current();
     records     = 0;
     loadData();
+
+#ifndef KSTARS_LITE
+    // Images are decoded in the background the first time they are drawn, draw again once ready
+    m_ImageLoadedConnection = QObject::connect(ConstellationArtCache::Instance(), &ConstellationArtCache::imageLoaded, []()
+    {
+        if (SkyMap::Instance())
+            SkyMap::Instance()->forceUpdate();
+    });
+#endif
 }
 
 ConstellationArtComponent::~ConstellationArtComponent()
 {
+    QObject::disconnect(m_ImageLoadedConnection);
     deleteData();
 }
 
@@ -49,6 +61,8 @@ void ConstellationArtComponent::deleteData()
 
 void ConstellationArtComponent::loadData()
 {
+    TraceZone zone("Load constellation art", "load");
+
     if (m_ConstList.isEmpty())
     {
         QSqlDatabase skydb = QSqlDatabase::addDatabase("QSQLITE", "skycultures");
@@ -19,6 +19,8 @@
 
 #include "skycomponent.h"
 
+#include <QMetaObject>
+
 class ConstellationsArt;
 class CultureList;
 
@@ -62,4 +64,6 @@ class ConstellationArtComponent : public SkyComponent
   private:
     QString cultureName;
     int records { 0 };
+    // Redraws the sky map when an image was decoded
+    QMetaObject::Connection m_ImageLoadedConnection;
 };
@@ -17,6 +17,8 @@
 
 #include "constellationlines.h"
 
+#include "ksfilereader.h"
+#include "kspaths.h"
 #include "kstarsdata.h"
 #include "kstars_debug.h"
 #include "linelist.h"
@@ -27,9 +29,81 @@
 #endif
 #include "Options.h"
 #include "skypainter.h"
+#include "snapshotcache.h"
 #include "skycomponents/culturelist.h"
 #include "skycomponents/starcomponent.h"
 
+namespace
+{
+/** Series of stars joined by line segments, as read from clines.dat */
+struct LineSeries
+{
+    QString culture;
+    /// HD numbers of the stars at the nodes of the series
+    QVector<int> stars;
+};
+
+QDataStream &operator<<(QDataStream &stream, const LineSeries &series)
+{
+    return stream << series.culture << series.stars;
+}
+
+QDataStream &operator>>(QDataStream &stream, LineSeries &series)
+{
+    return stream >> series.culture >> series.stars;
+}
+
+// Version of the constellation lines snapshot content, to increase whenever LineSeries changes
+const quint32 SNAPSHOT_VERSION = 1;
+
+// Reads the series of all the cultures
+QVector<LineSeries> parseLinesFile(const QString &file_name)
+{
+    QVector<LineSeries> series;
+    QString culture;
+    KSFileReader fileReader;
+
+    if (!fileReader.openFullPath(file_name))
+        return series;
+
+    while (fileReader.hasMoreLines())
+    {
+        QString line = fileReader.readLine();
+
+        if (line.isEmpty())
+            continue;
+
+        QChar mode = line.at(0);
+
+        //ignore lines beginning with "#":
+        if (mode == '#')
+            continue;
+
+        if (mode == 'C')
+        {
+            culture = line.mid(2).trimmed();
+            continue;
+        }
+
+        //Mode == 'M' starts a new series of line segments, joined end to end
+        if (mode == 'M')
+        {
+            LineSeries next;
+            next.culture = culture;
+            series.append(next);
+        }
+
+        // Nodes before the first series of a culture are not drawn
+        if (series.isEmpty() || series.last().culture != culture)
+            continue;
+
+        series.last().stars.append(line.mid(2).trimmed().toInt());
+    }
+
+    return series;
+}
+}
+
 ConstellationLines::ConstellationLines(SkyComposite *parent, CultureList *cultures)
     : LineListIndex(parent, i18n("Constellation Lines")), m_reindexNum(J2000)
 {
@@ -52,68 +126,39 @@ ConstellationLines::ConstellationLines(SkyComposite *parent, CultureList *cultur
 
     intro();
 
-    bool culture = false;
-    std::shared_ptr<LineList> lineList;
     double maxPM(0.0);
-    KSFileReader fileReader;
 
-    if (!fileReader.open("clines.dat"))
-        return;
+    // The file is parsed once, the series of all cultures being kept in a snapshot
+    const QString file_name = KSPaths::locate(QStandardPaths::GenericDataLocation, QString("clines.dat"));
+    SnapshotCache snapshot("clines", QStringList(file_name), SNAPSHOT_VERSION);
+    const QVector<LineSeries> series =
+        snapshot.loadOrParse<QVector<LineSeries>>([&]() { return parseLinesFile(file_name); });
 
-    while (fileReader.hasMoreLines())
+    for (const LineSeries &nodes : series)
     {
-        QString line = fileReader.readLine();
-
-        if (line.isEmpty())
+        if (nodes.culture != cultures->current())
             continue;
 
-        QChar mode = line.at(0);
-
-        //ignore lines beginning with "#":
-        if (mode == '#')
-            continue;
-        //If the first character is "M", we are starting a new series.
-        //In this case, add the existing clc component to the composite,
-        //then prepare a new one.
-
-        if (mode == 'C')
-        {
-            QString cultureName = line.mid(2).trimmed();
-            culture             = cultureName == cultures->current();
-            continue;
-        }
-
-        if (culture)
+        std::shared_ptr<LineList> lineList(new LineList());
+        for (int HDnum : nodes.stars)
         {
-            //Mode == 'M' starts a new series of line segments, joined end to end
-            if (mode == 'M')
-            {
-                if (lineList.get())
-                    appendLine(lineList);
-                lineList.reset(new LineList());
-            }
-
-            int HDnum        = line.mid(2).trimmed().toInt();
-            std::shared_ptr<SkyPoint> star;
-            StarObject* tempStar = StarComponent::Instance()->findByHDIndex(HDnum);
+            StarObject *tempStar = StarComponent::Instance()->findByHDIndex(HDnum);
 
-            if (tempStar && lineList)
+            if (tempStar)
             {
                 double pm = tempStar->pmMagnitude();
 
-                star.reset(new StarObject(*tempStar));
+                std::shared_ptr<SkyPoint> star(new StarObject(*tempStar));
                 if (maxPM < pm)
                     maxPM = pm;
 
                 lineList->append(std::move(star));
             }
-            else if (!star.get())
+            else
                 qCWarning(KSTARS) << i18n("Star HD%1 not found.", HDnum);
         }
-    }
-    //Add the last clc component
-    if (lineList.get())
         appendLine(lineList);
+    }
 
     m_reindexInterval = StarObject::reindexInterval(maxPM);
     //printf("CLines:           maxPM = %6.1f milliarcsec/year\n", maxPM );
@@ -18,8 +18,11 @@
 #include "constellationnamescomponent.h"
 
 #include "ksfilereader.h"
+#include "kspaths.h"
 #include "kstarsdata.h"
 #include "Options.h"
+#include "snapshotcache.h"
+#include "tracer.h"
 #include "skylabeler.h"
 #ifndef KSTARS_LITE
 #include "skymap.h"
@@ -29,29 +32,45 @@
 
 #include <QtConcurrent>
 
-ConstellationNamesComponent::ConstellationNamesComponent(SkyComposite *parent, CultureList *cultures)
-    : ListComponent(parent)
+namespace
 {
-    QtConcurrent::run(this, &ConstellationNamesComponent::loadData, cultures);
+/** Constellation name as read from cnames.dat, the name is not translated */
+struct NameRecord
+{
+    QString culture;
+    /// Right ascension and declination in degrees
+    double ra { 0 };
+    double dec { 0 };
+    QString abbrev;
+    QString name;
+};
+
+QDataStream &operator<<(QDataStream &stream, const NameRecord &record)
+{
+    return stream << record.culture << record.ra << record.dec << record.abbrev << record.name;
 }
 
-void ConstellationNamesComponent::loadData(CultureList *cultures)
+QDataStream &operator>>(QDataStream &stream, NameRecord &record)
 {
-    uint i       = 0;
-    bool culture = false;
-    KSFileReader fileReader;
-    QString cultureName;
+    return stream >> record.culture >> record.ra >> record.dec >> record.abbrev >> record.name;
+}
 
-    if (!fileReader.open("cnames.dat"))
-        return;
+// Version of the constellation names snapshot content, to increase whenever NameRecord changes
+const quint32 SNAPSHOT_VERSION = 1;
 
-    emitProgressText(i18n("Loading constellation names"));
+// Reads the names of all the cultures
+QVector<NameRecord> parseNamesFile(const QString &file_name)
+{
+    QVector<NameRecord> records;
+    KSFileReader fileReader;
+    QString cultureName;
 
-    localCNames = Options::useLocalConstellNames();
+    if (!fileReader.openFullPath(file_name))
+        return records;
 
     while (fileReader.hasMoreLines())
     {
-        QString line, name, abbrev;
+        QString line;
         int rah, ram, ras, dd, dm, ds;
         QChar sgn, mode;
 
@@ -61,43 +80,74 @@ void ConstellationNamesComponent::loadData(CultureList *cultures)
         if (mode == 'C')
         {
             cultureName = line.mid(2).trimmed();
-            culture     = cultureName == cultures->current();
-            i++;
             continue;
         }
 
-        if (culture)
-        {
-            rah = line.midRef(0, 2).toInt();
-            ram = line.midRef(2, 2).toInt();
-            ras = line.midRef(4, 2).toInt();
+        rah = line.midRef(0, 2).toInt();
+        ram = line.midRef(2, 2).toInt();
+        ras = line.midRef(4, 2).toInt();
+
+        sgn = line.at(6);
+        dd  = line.midRef(7, 2).toInt();
+        dm  = line.midRef(9, 2).toInt();
+        ds  = line.midRef(11, 2).toInt();
+
+        dms r;
+        r.setH(rah, ram, ras);
+        dms d(dd, dm, ds);
+
+        if (sgn == '-')
+            d.setD(-1.0 * d.Degrees());
+
+        NameRecord record;
+        record.culture = cultureName;
+        record.ra      = r.Degrees();
+        record.dec     = d.Degrees();
+        record.abbrev  = line.mid(13, 3);
+        record.name    = line.mid(17).trimmed();
+        records.append(record);
+    }
+
+    return records;
+}
+}
+
+ConstellationNamesComponent::ConstellationNamesComponent(SkyComposite *parent, CultureList *cultures)
+    : ListComponent(parent)
+{
+    QtConcurrent::run(this, &ConstellationNamesComponent::loadData, cultures);
+}
 
-            sgn = line.at(6);
-            dd  = line.midRef(7, 2).toInt();
-            dm  = line.midRef(9, 2).toInt();
-            ds  = line.midRef(11, 2).toInt();
+void ConstellationNamesComponent::loadData(CultureList *cultures)
+{
+    TraceZone zone("Load constellation names", "load");
 
-            abbrev = line.mid(13, 3);
-            name   = line.mid(17).trimmed();
+    emitProgressText(i18n("Loading constellation names"));
 
-            if (Options::useLocalConstellNames())
-                name = i18nc("Constellation name (optional)", name.toLocal8Bit().data());
+    localCNames = Options::useLocalConstellNames();
 
-            dms r;
-            r.setH(rah, ram, ras);
-            dms d(dd, dm, ds);
+    // The file is parsed once, the names of all cultures being kept in a snapshot
+    const QString file_name = KSPaths::locate(QStandardPaths::GenericDataLocation, QString("cnames.dat"));
+    SnapshotCache snapshot("cnames", QStringList(file_name), SNAPSHOT_VERSION);
+    const QVector<NameRecord> records =
+        snapshot.loadOrParse<QVector<NameRecord>>([&]() { return parseNamesFile(file_name); });
 
-            if (sgn == '-')
-                d.setD(-1.0 * d.Degrees());
+    for (const NameRecord &record : records)
+    {
+        if (record.culture != cultures->current())
+            continue;
 
-            SkyObject *o = new SkyObject(SkyObject::CONSTELLATION, r, d, 0.0, name, abbrev);
-            o->EquatorialToHorizontal(KStarsData::Instance()->lst(), KStarsData::Instance()->geo()->lat());
-            appendListObject(o);
+        QString name = record.name;
+        if (Options::useLocalConstellNames())
+            name = i18nc("Constellation name (optional)", name.toLocal8Bit().data());
 
-            //Add name to the list of object names
-            objectNames(SkyObject::CONSTELLATION).append(name);
-            objectLists(SkyObject::CONSTELLATION).append(QPair<QString, const SkyObject *>(name, o));
-        }
+        SkyObject *o = new SkyObject(SkyObject::CONSTELLATION, dms(record.ra), dms(record.dec), 0.0, name, record.abbrev);
+        o->EquatorialToHorizontal(KStarsData::Instance()->lst(), KStarsData::Instance()->geo()->lat());
+        appendListObject(o);
+
+        //Add name to the list of object names
+        objectNames(SkyObject::CONSTELLATION).append(name);
+        objectLists(SkyObject::CONSTELLATION).append(QPair<QString, const SkyObject *>(name, o));
     }
 }
 
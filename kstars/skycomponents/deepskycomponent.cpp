@@ -18,10 +18,12 @@
 #include "deepskycomponent.h"
 
 #include "ksfilereader.h"
+#include "snapshotcache.h"
 #include "kspaths.h"
 #include "kstarsdata.h"
 #include "kstars_debug.h"
 #include "Options.h"
+#include "tracer.h"
 #include "skylabeler.h"
 #ifndef KSTARS_LITE
 #include "skymap.h"
@@ -32,51 +34,42 @@
 #include "projections/projector.h"
 #include "skyobjects/deepskyobject.h"
 
-DeepSkyComponent::DeepSkyComponent(SkyComposite *parent) : SkyComponent(parent)
+namespace
 {
-    m_skyMesh = SkyMesh::Instance();
-    // Add labels
-    for (int i = 0; i <= MAX_LINENUMBER_MAG; i++)
-        m_labelList[i] = new LabelList;
-    loadData();
-}
-
-DeepSkyComponent::~DeepSkyComponent()
+/** NGC/IC object as read from ngcic.dat, names are not translated */
+struct DeepSkyRecord
 {
-    clearList(m_MessierList);
-    clearList(m_NGCList);
-    clearList(m_ICList);
-    clearList(m_OtherList);
-    qDeleteAll(m_DeepSkyIndex);
-    m_DeepSkyIndex.clear();
-    qDeleteAll(m_MessierIndex);
-    m_MessierIndex.clear();
-    qDeleteAll(m_NGCIndex);
-    m_NGCIndex.clear();
-    qDeleteAll(m_ICIndex);
-    m_ICIndex.clear();
-    qDeleteAll(m_OtherIndex);
-    m_OtherIndex.clear();
-    for (int i = 0; i <= MAX_LINENUMBER_MAG; i++)
-        delete m_labelList[i];
-}
-
-bool DeepSkyComponent::selected()
+    int type { 0 };
+    /// Right ascension in hours, declination in degrees
+    double ra { 0 };
+    double dec { 0 };
+    float mag { 0 };
+    QString name, name2, longname, cat;
+    float a { 0 };
+    float b { 0 };
+    int pa { 0 };
+    int pgc { 0 };
+    int ugc { 0 };
+    bool hasName { false };
+};
+
+QDataStream &operator<<(QDataStream &stream, const DeepSkyRecord &record)
 {
-    return Options::showDeepSky();
+    return stream << record.type << record.ra << record.dec << record.mag << record.name << record.name2 << record.longname
+           << record.cat << record.a << record.b << record.pa << record.pgc << record.ugc << record.hasName;
 }
 
-void DeepSkyComponent::update(KSNumbers *)
+QDataStream &operator>>(QDataStream &stream, DeepSkyRecord &record)
 {
+    return stream >> record.type >> record.ra >> record.dec >> record.mag >> record.name >> record.name2 >> record.longname
+           >> record.cat >> record.a >> record.b >> record.pa >> record.pgc >> record.ugc >> record.hasName;
 }
 
-void DeepSkyComponent::loadData()
-{
-    KStarsData *data = KStarsData::Instance();
-    //Check whether we need to concatenate a split NGC/IC catalog
-    //(i.e., if user has downloaded the Steinicke catalog)
-    mergeSplitFiles();
+// Version of the NGC/IC snapshot content, to increase whenever DeepSkyRecord changes
+const quint32 SNAPSHOT_VERSION = 1;
 
+QVector<DeepSkyRecord> parseDeepSkyFile(const QString &file_name)
+{
     QList<QPair<QString, KSParser::DataTypes>> sequence;
     QList<int> widths;
     sequence.append(qMakePair(QString("Flag"), KSParser::D_QSTRING));
@@ -145,16 +138,17 @@ void DeepSkyComponent::loadData()
     sequence.append(qMakePair(QString("Longname"), KSParser::D_QSTRING));
     //No width to be appended for last sequence object
 
-    QString file_name = KSPaths::locate(QStandardPaths::GenericDataLocation, QString("ngcic.dat"));
     KSParser deep_sky_parser(file_name, '#', sequence, widths);
 
     deep_sky_parser.SetProgress(i18n("Loading NGC/IC objects"), 13444, 10);
     qCInfo(KSTARS) << "Loading NGC/IC objects";
 
+    QVector<DeepSkyRecord> records;
     QHash<QString, QVariant> row_content;
     while (deep_sky_parser.HasNextRow())
     {
         row_content = deep_sky_parser.ReadNextRow();
+        deep_sky_parser.ShowProgress();
 
         QString iflag;
         QString cat;
@@ -263,15 +257,11 @@ void DeepSkyComponent::loadData()
 
         longname = row_content["Longname"].toString();
 
-        dms r;
-        //r.setH(rah, ram, int(ras));
-        r.setH(rah+ram/60.0+ras/3600.0);
-        dms d(dd, dm, ds);
-
+        DeepSkyRecord record;
+        record.ra  = rah + ram / 60.0 + ras / 3600.0;
+        record.dec = dms(dd, dm, ds).Degrees();
         if (sgn == "-")
-        {
-            d.setD(-1.0 * d.Degrees());
-        }
+            record.dec = -record.dec;
 
         bool hasName = true;
         QString snum;
@@ -301,23 +291,110 @@ void DeepSkyComponent::loadData()
             else
             {
                 hasName = false;
-                name    = i18n("Unnamed Object");
+                name    = "Unnamed Object";
             }
         }
 
+        if (type == 0)
+            type = 1; //Make sure we use CATALOG_STAR, not STAR
+
+        record.type     = type;
+        record.mag      = mag;
+        record.name     = name;
+        record.name2    = name2;
+        record.longname = longname;
+        record.cat      = cat;
+        record.a        = a;
+        record.b        = b;
+        record.pa       = pa;
+        record.pgc      = pgc;
+        record.ugc      = ugc;
+        record.hasName  = hasName;
+        records.append(record);
+    }
+
+    return records;
+}
+}
+
+DeepSkyComponent::DeepSkyComponent(SkyComposite *parent) : SkyComponent(parent)
+{
+    m_skyMesh = SkyMesh::Instance();
+    // Add labels
+    for (int i = 0; i <= MAX_LINENUMBER_MAG; i++)
+        m_labelList[i] = new LabelList;
+    loadData();
+}
+
+DeepSkyComponent::~DeepSkyComponent()
+{
+    clearList(m_MessierList);
+    clearList(m_NGCList);
+    clearList(m_ICList);
+    clearList(m_OtherList);
+    qDeleteAll(m_DeepSkyIndex);
+    m_DeepSkyIndex.clear();
+    qDeleteAll(m_MessierIndex);
+    m_MessierIndex.clear();
+    qDeleteAll(m_NGCIndex);
+    m_NGCIndex.clear();
+    qDeleteAll(m_ICIndex);
+    m_ICIndex.clear();
+    qDeleteAll(m_OtherIndex);
+    m_OtherIndex.clear();
+    for (int i = 0; i <= MAX_LINENUMBER_MAG; i++)
+        delete m_labelList[i];
+}
+
+bool DeepSkyComponent::selected()
+{
+    return Options::showDeepSky();
+}
+
+void DeepSkyComponent::update(KSNumbers *)
+{
+}
+
+void DeepSkyComponent::loadData()
+{
+    TraceZone zone("Load deep sky objects", "load");
+
+    KStarsData *data = KStarsData::Instance();
+    //Check whether we need to concatenate a split NGC/IC catalog
+    //(i.e., if user has downloaded the Steinicke catalog)
+    mergeSplitFiles();
+
+    QString file_name = KSPaths::locate(QStandardPaths::GenericDataLocation, QString("ngcic.dat"));
+
+    emitProgressText(i18n("Loading NGC/IC objects"));
+
+    // Parsing the fixed-width text is slow, so parsed records are kept in a snapshot
+    SnapshotCache snapshot("ngcic", QStringList(file_name), SNAPSHOT_VERSION);
+    const QVector<DeepSkyRecord> records =
+        snapshot.loadOrParse<QVector<DeepSkyRecord>>([&]() { return parseDeepSkyFile(file_name); });
+
+    for (const DeepSkyRecord &record : records)
+    {
+        int type         = record.type;
+        QString name     = record.hasName ? record.name : i18n("Unnamed Object");
+        QString name2    = record.name2;
+        QString longname = record.longname;
+
+        dms r;
+        r.setH(record.ra);
+        dms d(record.dec);
+
         name = i18nc("object name (optional)", name.toLatin1().constData());
         if (!longname.isEmpty())
             longname = i18nc("object name (optional)", longname.toLatin1().constData());
 
         // create new deepskyobject
-        DeepSkyObject *o = nullptr;
-        if (type == 0)
-            type = 1; //Make sure we use CATALOG_STAR, not STAR
-        o = new DeepSkyObject(type, r, d, mag, name, name2, longname, cat, a, b, pa, pgc, ugc);
+        DeepSkyObject *o = new DeepSkyObject(type, r, d, record.mag, name, name2, longname, record.cat, record.a, record.b,
+                                             record.pa, record.pgc, record.ugc);
         o->EquatorialToHorizontal(data->lst(), data->geo()->lat());
 
         // Add the name(s) to the nameHash for fast lookup -jbb
-        if (hasName)
+        if (record.hasName)
         {
             nameHash[name.toLower()] = o;
             if (!longname.isEmpty())
@@ -369,8 +446,6 @@ void DeepSkyComponent::loadData()
             objectNames(type).append(longname);
             objectLists(type).append(QPair<QString, SkyObject *>(longname, o));
         }
-
-        deep_sky_parser.ShowProgress();
     }
 
     for (auto &list : objectNames())
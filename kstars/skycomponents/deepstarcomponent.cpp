@@ -20,6 +20,7 @@
 #include "byteorder.h"
 #include "kstarsdata.h"
 #include "Options.h"
+#include "tracer.h"
 #ifndef KSTARS_LITE
 #include "skymap.h"
 #endif
@@ -32,7 +33,6 @@
 
 #include <qplatformdefs.h>
 #include <QtConcurrent>
-#include <QElapsedTimer>
 
 #include <kstars_debug.h>
 
@@ -60,6 +60,8 @@ DeepStarComponent::~DeepStarComponent()
 
 bool DeepStarComponent::loadStaticStars()
 {
+    TraceZone zone("Load static deep stars", "load");
+
     FILE *dataFile;
 
     if (!staticStars)
@@ -302,20 +304,14 @@ void DeepStarComponent::draw(SkyPainter *skyp)
     StarBlockFactory *m_StarBlockFactory = StarBlockFactory::Instance();
     //    m_StarBlockFactory->drawID = m_skyMesh->drawID();
     //    qDebug() << "Mesh size = " << m_skyMesh->size() << "; drawID = " << m_skyMesh->drawID();
-    QElapsedTimer t;
     int nTrixels = 0;
 
-    t_dynamicLoad = 0;
-    t_updateCache = 0;
-    t_drawUnnamed = 0;
-
     visibleStarCount = 0;
 
-    t.start();
-
     // Mark used blocks in the LRU Cache. Not required for static stars
     if (!staticStars)
     {
+        TraceZone zone("Update star block cache", "draw");
         while (region.hasNext())
         {
             Trixel currentRegion = region.next();
@@ -334,7 +330,6 @@ void DeepStarComponent::draw(SkyPainter *skyp)
                     break;
             }
         }
-        t_updateCache = t.elapsed();
         region.reset();
     }
 
@@ -358,8 +353,6 @@ void DeepStarComponent::draw(SkyPainter *skyp)
         //            qCWarning(KSTARS) << "SBL::fillToMag( " << maglim << " ) failed for trixel " << currentRegion;
         //        }
 
-        t_dynamicLoad += t.restart();
-
         //        qDebug() << "Drawing SBL for trixel " << currentRegion << ", SBL has "
         //                 <<  m_starBlockList[ currentRegion ]->getBlockCount() << " blocks";
 
@@ -401,7 +394,6 @@ void DeepStarComponent::draw(SkyPainter *skyp)
 
         // DEBUG: Uncomment to identify problems with Star Block Factory / preservation of Magnitude Order in the LRU Cache
         //        verifySBLIntegrity();
-        t_drawUnnamed += t.restart();
     }
     m_skyMesh->inDraw(false);
 #ifdef PROFILE_SINCOS
@@ -127,11 +127,6 @@ class DeepStarComponent : public ListComponent
     /// Maximum number of stars in any given trixel
     quint16 MSpT { 0 };
 
-    // Time keeping variables
-    long unsigned t_dynamicLoad { 0 };
-    long unsigned t_drawUnnamed { 0 };
-    long unsigned t_updateCache { 0 };
-
     QVector<std::shared_ptr<StarBlockList>> m_starBlockList;
     QHash<int, StarObject *> m_CatalogNumber;
 
@@ -20,6 +20,7 @@
 #include "ksfilereader.h"
 #include "kstarsdata.h"
 #include "Options.h"
+#include "tracer.h"
 #ifdef KSTARS_LITE
 #include "skymaplite.h"
 #else
@@ -81,6 +82,8 @@ bool FlagComponent::selected()
 
 void FlagComponent::loadFromFile()
 {
+    TraceZone zone("Load flags", "load");
+
     bool imageFound = false;
     QList<QStringList> flagList = KStarsData::Instance()->userdb()->GetAllFlags();
 
@@ -18,6 +18,8 @@
 #include "listcomponent.h"
 
 #include "kstarsdata.h"
+#include "skymesh.h"
+#include "htmesh/MeshIterator.h"
 #ifndef KSTARS_LITE
 #include "skymap.h"
 #endif
@@ -43,10 +45,14 @@ void ListComponent::clear()
         removeFromNames(o);
         delete o;
     }
+
+    invalidateIndex();
 }
 
 void ListComponent::appendListObject(SkyObject *object)
 {
+    const bool indexed = isIndexed();
+
     // Append to the Object List
     m_ObjectList.append(object);
 
@@ -54,6 +60,61 @@ void ListComponent::appendListObject(SkyObject *object)
     m_ObjectHash.insert(object->name().toLower(), object);
     m_ObjectHash.insert(object->longname().toLower(), object);
     m_ObjectHash.insert(object->name2().toLower(), object);
+
+    if (indexed)
+    {
+        m_TrixelIndex[SkyMesh::Instance()->index(object)].append(object);
+        m_IndexedCount++;
+    }
+}
+
+bool ListComponent::ensureIndex()
+{
+    SkyMesh *skyMesh = SkyMesh::Instance();
+    if (skyMesh == nullptr)
+        return false;
+
+    if (isIndexed())
+        return true;
+
+    m_TrixelIndex.clear();
+    for (SkyObject *o : m_ObjectList)
+        m_TrixelIndex[skyMesh->index(o)].append(o);
+
+    m_IndexedCount = m_ObjectList.size();
+    m_IndexValid   = true;
+    return true;
+}
+
+void ListComponent::updateIndex(SkyObject *object, Trixel trixel)
+{
+    if (!isIndexed())
+        return;
+
+    Trixel newTrixel = SkyMesh::Instance()->index(object);
+    if (newTrixel == trixel)
+        return;
+
+    auto it = m_TrixelIndex.find(trixel);
+    if (it == m_TrixelIndex.end() || !it->removeOne(object))
+    {
+        // Not where it was expected, start over
+        invalidateIndex();
+        return;
+    }
+    if (it->isEmpty())
+        m_TrixelIndex.erase(it);
+
+    m_TrixelIndex[newTrixel].append(object);
+}
+
+const QVector<SkyObject *> *ListComponent::trixelObjects(Trixel trixel)
+{
+    if (!ensureIndex())
+        return nullptr;
+
+    auto it = m_TrixelIndex.constFind(trixel);
+    return it == m_TrixelIndex.constEnd() ? nullptr : &(*it);
 }
 
 void ListComponent::update(KSNumbers *num)
@@ -80,14 +141,53 @@ SkyObject *ListComponent::objectNearest(SkyPoint *p, double &maxrad)
         return nullptr;
 
     SkyObject *oBest = nullptr;
-    foreach (SkyObject *o, m_ObjectList)
+
+    if (!ensureIndex())
+    {
+        foreach (SkyObject *o, m_ObjectList)
+        {
+            double r = o->angularDistanceTo(p).Degrees();
+            if (r < maxrad)
+            {
+                oBest  = o;
+                maxrad = r;
+            }
+        }
+        return oBest;
+    }
+
+    MeshIterator region(SkyMesh::Instance(), OBJ_NEAREST_BUF);
+    while (region.hasNext())
     {
-        double r = o->angularDistanceTo(p).Degrees();
-        if (r < maxrad)
+        const QVector<SkyObject *> *objects = trixelObjects(region.next());
+        if (!objects)
+            continue;
+
+        for (SkyObject *o : *objects)
         {
-            oBest  = o;
-            maxrad = r;
+            double r = o->angularDistanceTo(p).Degrees();
+            if (r < maxrad)
+            {
+                oBest  = o;
+                maxrad = r;
+            }
         }
     }
     return oBest;
 }
+
+void ListComponent::objectsInArea(QList<SkyObject *> &list, const SkyRegion &region)
+{
+    if (!selected())
+        return;
+
+    for (SkyRegion::const_iterator it = region.constBegin(); it != region.constEnd(); ++it)
+    {
+        const QVector<SkyObject *> *objects = trixelObjects(it.key());
+        if (!objects)
+            continue;
+
+        for (SkyObject *o : *objects)
+            list.append(o);
+    }
+}
@@ -18,8 +18,11 @@
 #pragma once
 
 #include "skycomponent.h"
+#include "typedef.h"
 
+#include <QHash>
 #include <QList>
+#include <QVector>
 
 class SkyComposite;
 class SkyMap;
@@ -28,6 +31,12 @@ class SkyMap;
  * @class ListComponent
  * An abstract parent class, to be inherited by SkyComponents that store a QList of SkyObjects.
  *
+ * The objects are also bucketed by the trixel of their catalogue (J2000) position, so that
+ * objectNearest() and objectsInArea() only visit the objects of the trixels involved.
+ * The index is built on the first query. Subclasses that remove objects from m_ObjectList or
+ * replace its content must call invalidateIndex(), and those moving objects must call
+ * updateIndex() for each moved object.
+ *
  * @author Jason Harris
  * @version 0.1
  */
@@ -53,8 +62,15 @@ class ListComponent : public SkyComponent
     void update(KSNumbers *num = nullptr) override;
 
     SkyObject *findByName(const QString &name) override;
+    /**
+     * @short Find the object nearest to p within maxrad.
+     * Only the objects of the trixels of the OBJ_NEAREST_BUF aperture are visited, so the aperture
+     * has to be set before, as SkyMapComposite::objectNearest() does.
+     */
     SkyObject *objectNearest(SkyPoint *p, double &maxrad) override;
 
+    void objectsInArea(QList<SkyObject *> &list, const SkyRegion &region) override;
+
     void clear();
 
     const QList<SkyObject *> &objectList() const { return m_ObjectList; }
@@ -69,6 +85,33 @@ class ListComponent : public SkyComponent
     void appendListObject(SkyObject * object);
 
   protected:
+    /** @short Mark the trixel index as outdated, it is rebuilt on the next query. */
+    void invalidateIndex() { m_IndexValid = false; }
+
+    /** @return true if the trixel index is built and up to date */
+    bool isIndexed() const { return m_IndexValid && m_IndexedCount == m_ObjectList.size(); }
+
+    /**
+     * @short Move an object to the bucket of its new position.
+     * @param object object whose catalogue coordinates changed
+     * @param trixel trixel of its previous position
+     */
+    void updateIndex(SkyObject *object, Trixel trixel);
+
+    /**
+     * @return the objects of a trixel, or nullptr if it has none.
+     * The index is rebuilt first if necessary.
+     */
+    const QVector<SkyObject *> *trixelObjects(Trixel trixel);
+
     QList<SkyObject *> m_ObjectList;
     QHash<QString, SkyObject *> m_ObjectHash;
+
+  private:
+    /** @short Rebuild the trixel index if it is outdated. @return false if there is no mesh to index with */
+    bool ensureIndex();
+
+    QHash<Trixel, QVector<SkyObject *>> m_TrixelIndex;
+    int m_IndexedCount { 0 };
+    bool m_IndexValid { false };
 };
@@ -25,6 +25,7 @@
 #include "skymap.h"
 #endif
 #include "Options.h"
+#include "tracer.h"
 #include "skypainter.h"
 #include "skycomponents/skiphashlist.h"
 
@@ -86,6 +87,8 @@ void MilkyWay::draw(SkyPainter *skyp)
 
 void MilkyWay::loadContours(QString fname, QString greeting)
 {
+    TraceZone zone("Load Milky Way", "load");
+
     KSFileReader fileReader;
     std::shared_ptr<LineList> skipList;
     int iSkip = 0;
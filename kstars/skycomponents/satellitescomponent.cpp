@@ -21,6 +21,7 @@
 #include "ksnotification.h"
 #include "kstarsdata.h"
 #include "Options.h"
+#include "tracer.h"
 #include "skylabeler.h"
 #include "skymap.h"
 #include "skypainter.h"
@@ -44,6 +45,8 @@ SatellitesComponent::~SatellitesComponent()
 
 void SatellitesComponent::loadData()
 {
+    TraceZone zone("Load satellites", "load");
+
     KSFileReader fileReader;
     QString line;
     QStringList group_infos;
@@ -92,9 +95,33 @@ void SatellitesComponent::update(KSNumbers *)
     if (!selected())
         return;
 
+    // Satellites that move less than a pixel since their last propagation keep their position
+    const Satellite::Observer observer = Satellite::observer(1.0 / (Options::zoomFactor() * dms::DegToRad));
+
+    QVector<QPair<Satellite *, int>> batch;
     foreach (SatelliteGroup *group, m_groups)
     {
-        group->updateSatellitesPos();
+        for (Satellite *sat : *group)
+        {
+            if (sat->selected())
+                batch.append(qMakePair(sat, 0));
+        }
+    }
+
+    // Each satellite only touches its own state, so they can be propagated concurrently
+    QtConcurrent::blockingMap(batch, [&observer](QPair<Satellite *, int> &job)
+    {
+        job.second = job.first->updatePos(observer);
+    });
+
+    // If position cannot be calculated, remove it from list
+    for (const auto &job : batch)
+    {
+        if (job.second != 0)
+        {
+            foreach (SatelliteGroup *group, m_groups)
+                group->removeOne(job.first);
+        }
     }
 }
 
@@ -104,3 +104,11 @@ SkyObject *SkyComposite::objectNearest(SkyPoint *p, double &maxrad)
     // qDebug() << "Returning best match: oBest = " << oBest;
     return oBest; //will be 0 if no object nearer than maxrad was found
 }
+
+void SkyComposite::objectsInArea(QList<SkyObject *> &list, const SkyRegion &region)
+{
+    if (!selected())
+        return;
+    foreach (SkyComponent *comp, components())
+        comp->objectsInArea(list, region);
+}
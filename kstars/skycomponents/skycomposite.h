@@ -103,6 +103,9 @@ class SkyComposite : public SkyComponent
      */
     SkyObject *objectNearest(SkyPoint *p, double &maxrad) override;
 
+    /** @short Collect the objects of the children of this SkyComposite found in the region */
+    void objectsInArea(QList<SkyObject *> &list, const SkyRegion &region) override;
+
     QList<SkyComponent *> components() { return m_Components.values(); }
 
     QMap<int, SkyComponent *> &componentsWithPriorities() { return m_Components; }
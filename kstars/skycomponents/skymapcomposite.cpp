@@ -58,12 +58,26 @@
 #include "observinglist.h"
 #include "skymap.h"
 #include "hipscomponent.h"
+#include "tracer.h"
 #endif
 
 #include <QApplication>
 
 #include <kstars_debug.h>
 
+#ifndef KSTARS_LITE
+namespace
+{
+// Draw a component within a trace zone named after it
+template <typename Component>
+void drawTraced(const char *name, Component *component, SkyPainter *skyp)
+{
+    TraceZone zone(name, "draw");
+    component->draw(skyp);
+}
+}
+#endif
+
 SkyMapComposite::SkyMapComposite(SkyComposite *parent) : SkyComposite(parent), m_reindexNum(J2000)
 {
     m_skyLabeler.reset(SkyLabeler::Instance());
@@ -249,6 +263,8 @@ void SkyMapComposite::draw(SkyPainter *skyp)
 {
     Q_UNUSED(skyp)
 #ifndef KSTARS_LITE
+    TraceZone zone("Sky map components", "draw");
+
     SkyMap *map      = SkyMap::Instance();
     KStarsData *data = KStarsData::Instance();
 
@@ -311,66 +327,69 @@ void SkyMapComposite::draw(SkyPainter *skyp)
             }
     }
 
-    m_MilkyWay->draw(skyp);
+    drawTraced("Milky Way", m_MilkyWay, skyp);
 
     // Draw HIPS after milky way but before everything else
-    m_HiPS->draw(skyp);
+    drawTraced("HiPS", m_HiPS, skyp);
 
-    m_EquatorialCoordinateGrid->draw(skyp);
-    m_HorizontalCoordinateGrid->draw(skyp);
-    m_LocalMeridianComponent->draw(skyp);
+    drawTraced("Equatorial grid", m_EquatorialCoordinateGrid, skyp);
+    drawTraced("Horizontal grid", m_HorizontalCoordinateGrid, skyp);
+    drawTraced("Local meridian", m_LocalMeridianComponent, skyp);
 
     //Draw constellation boundary lines only if we draw western constellations
     if (m_Cultures->current() == "Western")
     {
-        m_CBoundLines->draw(skyp);
-        m_ConstellationArt->draw(skyp);
+        drawTraced("Constellation boundaries", m_CBoundLines, skyp);
+        drawTraced("Constellation art", m_ConstellationArt, skyp);
     }
     else if (m_Cultures->current() == "Inuit")
     {
-        m_ConstellationArt->draw(skyp);
+        drawTraced("Constellation art", m_ConstellationArt, skyp);
     }
 
-    m_CLines->draw(skyp);
+    drawTraced("Constellation lines", m_CLines, skyp);
 
-    m_Equator->draw(skyp);
+    drawTraced("Equator", m_Equator, skyp);
 
-    m_Ecliptic->draw(skyp);
+    drawTraced("Ecliptic", m_Ecliptic, skyp);
 
-    m_DeepSky->draw(skyp);
+    drawTraced("Deep sky objects", m_DeepSky, skyp);
 
-    m_CustomCatalogs->draw(skyp);
-    m_internetResolvedComponent->draw(skyp);
-    m_manualAdditionsComponent->draw(skyp);
+    drawTraced("Custom catalogs", m_CustomCatalogs, skyp);
+    drawTraced("Internet resolved objects", m_internetResolvedComponent, skyp);
+    drawTraced("Manual additions", m_manualAdditionsComponent, skyp);
 
-    m_Stars->draw(skyp);
+    drawTraced("Stars", m_Stars, skyp);
 
     m_SolarSystem->drawTrails(skyp);
-    m_SolarSystem->draw(skyp);
+    drawTraced("Solar system", m_SolarSystem, skyp);
 
-    m_Satellites->draw(skyp);
+    drawTraced("Satellites", m_Satellites, skyp);
 
-    m_Supernovae->draw(skyp);
+    drawTraced("Supernovae", m_Supernovae, skyp);
 
     map->drawObjectLabels(labelObjects());
 
-    m_skyLabeler->drawQueuedLabels();
-    m_CNames->draw(skyp);
-    m_Stars->drawLabels();
-    m_DeepSky->drawLabels();
+    {
+        TraceZone labelZone("Labels", "draw");
+        m_skyLabeler->drawQueuedLabels();
+        drawTraced("Constellation names", m_CNames, skyp);
+        m_Stars->drawLabels();
+        m_DeepSky->drawLabels();
+    }
 
     m_ObservingList->pen = QPen(QColor(data->colorScheme()->colorNamed("ObsListColor")), 1.);
     m_ObservingList->list2 = KStarsData::Instance()->observingList()->sessionList();
-    m_ObservingList->draw(skyp);
+    drawTraced("Observing list", m_ObservingList, skyp);
 
-    m_Flags->draw(skyp);
+    drawTraced("Flags", m_Flags, skyp);
 
     m_StarHopRouteList->pen = QPen(QColor(data->colorScheme()->colorNamed("StarHopRouteColor")), 1.);
-    m_StarHopRouteList->draw(skyp);
+    drawTraced("Star hop route", m_StarHopRouteList, skyp);
 
-    m_ArtificialHorizon->draw(skyp);
+    drawTraced("Artificial horizon", m_ArtificialHorizon, skyp);
 
-    m_Horizon->draw(skyp);
+    drawTraced("Horizon", m_Horizon, skyp);
 
     m_skyMesh->inDraw(false);
 
@@ -580,6 +599,7 @@ QList<SkyObject *> SkyMapComposite::findObjectsInArea(const SkyPoint &p1, const
         m_Stars->objectsInArea(list, region);
     if (m_DeepSky->selected())
         m_DeepSky->objectsInArea(list, region);
+    m_CustomCatalogs->objectsInArea(list, region);
     return list;
 }
 
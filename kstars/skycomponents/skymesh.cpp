@@ -86,7 +86,8 @@ void SkyMesh::aperture(SkyPoint *p0, double radius, MeshBufNum_t bufNum)
 #endif
     }
 
-    HTMesh::intersect(p1.ra().Degrees(), p1.dec().Degrees(), radius, (BufNum)bufNum);
+    // Apertures only need to be covered, so nearby views can share their trixels
+    HTMesh::intersectCached(p1.ra().Degrees(), p1.dec().Degrees(), radius, (BufNum)bufNum);
     m_drawID++;
 //    if (m_inDraw && bufNum != DRAW_BUF)
 //        printf("Warning: overlapping buffer: %d\n", bufNum);
@@ -117,7 +117,8 @@ class SkyMesh : public HTMesh
          * precession.  The drawID also gets incremented which is useful for
          * drawing extended objects.  Typically a safety factor of about one
          * degree is added to the radius to account for proper motion,
-         * refraction and other imperfections.
+         * refraction and other imperfections.  Recent apertures are cached,
+         * so the set may hold a few trixels beyond the radius.
          *@param center Center of the aperture
          *@param radius Radius of the aperture in degrees
          *@param bufNum Buffer to use
@@ -22,6 +22,7 @@
 #ifndef KSTARS_LITE
 #include "skymap.h"
 #endif
+#include "skymesh.h"
 #include "solarsystemcomposite.h"
 #include "skyobjects/ksplanet.h"
 #include "skyobjects/ksplanetbase.h"
@@ -60,11 +61,16 @@ void SolarSystemListComponent::updateSolarSystemBodies(KSNumbers *num)
     if (selected())
     {
         KStarsData *data = KStarsData::Instance();
+        // Keep the trixel index in step with the new positions, objects rarely change trixel
+        const bool indexed = isIndexed();
         foreach (SkyObject *o, m_ObjectList)
         {
             KSPlanetBase *p = (KSPlanetBase *)o;
+            const Trixel trixel = indexed ? SkyMesh::Instance()->index(p) : 0;
             p->findPosition(num, data->geo()->lat(), data->lst(), m_Earth);
             p->EquatorialToHorizontal(data->lst(), data->geo()->lat());
+            if (indexed)
+                updateIndex(p, trixel);
 
             if (p->hasTrail())
                 p->updateTrail(data->lst(), data->geo()->lat());
@@ -26,6 +26,7 @@
 #include "kstarsdata.h"
 #include "kstarssplash.h"
 #include "Options.h"
+#include "tracer.h"
 #include "skylabeler.h"
 #include "skymap.h"
 #include "skymesh.h"
@@ -121,6 +122,8 @@ bool StarComponent::addDeepStarCatalogIfExists(const QString &fileName, float tr
 
 int StarComponent::loadDeepStarCatalogs()
 {
+    TraceZone zone("Load deep star catalogs", "load");
+
     // Look for the basic unnamed star catalog to mag 8.0
     if (!addDeepStarCatalogIfExists("unnamedstars.dat", -5.0, true))
         return 0;
@@ -401,6 +404,8 @@ void StarComponent::drawLabels()
 
 bool StarComponent::loadStaticData()
 {
+    TraceZone zone("Load stars", "load");
+
     // We break from Qt / KDE API and use traditional file handling here, to obtain speed.
     // We also avoid C++ constructors for the same reason.
     FILE *dataFile, *nameFile;
@@ -22,61 +22,59 @@
 #include "ksnotification.h"
 #include "kstarsdata.h"
 #include "Options.h"
+#include "tracer.h"
 #include "skylabeler.h"
 #include "skymesh.h"
 #include "skypainter.h"
 #include "auxiliary/filedownloader.h"
 #include "projections/projector.h"
 #include "auxiliary/kspaths.h"
+#include "auxiliary/snapshotcache.h"
 
 #include <QtConcurrent>
 #include <QJsonDocument>
 #include <QJsonValue>
 
-SupernovaeComponent::SupernovaeComponent(SkyComposite *parent) : ListComponent(parent)
+namespace
 {
-    //QtConcurrent::run(this, &SupernovaeComponent::loadData);
-    //loadData();
-}
-
-void SupernovaeComponent::update(KSNumbers *num)
+/** Supernova as read from catalog.min.json */
+struct SupernovaRecord
 {
-    if (!selected() || !m_DataLoaded)
-        return;
-
-    KStarsData *data = KStarsData::Instance();
-    for (auto so : m_ObjectList)
-    {
-        if (num)
-            so->updateCoords(num);
-        so->EquatorialToHorizontal(data->lst(), data->geo()->lat());
-    }
-}
-
-bool SupernovaeComponent::selected()
+    QString name, type, host, date;
+    /// Right ascension and declination in degrees
+    double ra { 0 };
+    double dec { 0 };
+    float z { 0 };
+    float mag { 0 };
+};
+
+QDataStream &operator<<(QDataStream &stream, const SupernovaRecord &record)
 {
-    return Options::showSupernovae();
+    return stream << record.name << record.type << record.host << record.date << record.ra << record.dec << record.z
+           << record.mag;
 }
 
-void SupernovaeComponent::loadData()
+QDataStream &operator>>(QDataStream &stream, SupernovaRecord &record)
 {
-    qDeleteAll(m_ObjectList);
-    m_ObjectList.clear();
+    return stream >> record.name >> record.type >> record.host >> record.date >> record.ra >> record.dec >> record.z >>
+           record.mag;
+}
 
-    objectNames(SkyObject::SUPERNOVA).clear();
-    objectLists(SkyObject::SUPERNOVA).clear();
+// Version of the supernovae snapshot content, to increase whenever SupernovaRecord changes
+const quint32 SNAPSHOT_VERSION = 1;
 
+QVector<SupernovaRecord> parseSupernovaFile(const QString &sFileName)
+{
+    QVector<SupernovaRecord> records;
     QString name, type, host, date, ra, de;
     float z, mag;
 
-    QString sFileName = KSPaths::locate(QStandardPaths::GenericDataLocation, QString("catalog.min.json"));
-
     QFile sNovaFile(sFileName);
 
     if (sNovaFile.open(QIODevice::ReadOnly) == false)
     {
         qCritical() << "Unable to open supernova file" << sFileName;
-        return;
+        return records;
     }
 
     QJsonParseError pError;
@@ -85,13 +83,13 @@ void SupernovaeComponent::loadData()
     if (pError.error != QJsonParseError::NoError)
     {
         qCritical() << "Error parsing json document" << pError.errorString();
-        return;
+        return records;
     }
 
     if (sNova.isArray() == false)
     {
         qCCritical(KSTARS) << "Invalid document format! No JSON array.";
-        return;
+        return records;
     }
 
     QJsonArray sArray = sNova.array();
@@ -128,13 +126,76 @@ void SupernovaeComponent::loadData()
         if (ok == false)
             mag = 99.9;
 
-        Supernova *sup =
-            new Supernova(name, dms::fromString(ra, false), dms::fromString(de, true), type, host, date, z, mag);
+        SupernovaRecord record;
+        record.name = name;
+        record.type = type;
+        record.host = host;
+        record.date = date;
+        record.ra   = dms::fromString(ra, false).Degrees();
+        record.dec  = dms::fromString(de, true).Degrees();
+        record.z    = z;
+        record.mag  = mag;
+        records.append(record);
+    }
 
-        objectNames(SkyObject::SUPERNOVA).append(name);
+    return records;
+}
+}
+
+SupernovaeComponent::SupernovaeComponent(SkyComposite *parent) : ListComponent(parent)
+{
+    //QtConcurrent::run(this, &SupernovaeComponent::loadData);
+    //loadData();
+}
+
+void SupernovaeComponent::update(KSNumbers *num)
+{
+    if (!selected() || !m_DataLoaded)
+        return;
+
+    KStarsData *data = KStarsData::Instance();
+    for (auto so : m_ObjectList)
+    {
+        if (num)
+            so->updateCoords(num);
+        so->EquatorialToHorizontal(data->lst(), data->geo()->lat());
+    }
+}
+
+bool SupernovaeComponent::selected()
+{
+    return Options::showSupernovae();
+}
+
+void SupernovaeComponent::loadData()
+{
+    TraceZone zone("Load supernovae", "load");
+
+    qDeleteAll(m_ObjectList);
+    m_ObjectList.clear();
+    invalidateIndex();
+
+    objectNames(SkyObject::SUPERNOVA).clear();
+    objectLists(SkyObject::SUPERNOVA).clear();
+
+    QString sFileName = KSPaths::locate(QStandardPaths::GenericDataLocation, QString("catalog.min.json"));
+
+    // Parsing the JSON catalog is slow, so parsed records are kept in a snapshot until the catalog is updated
+    SnapshotCache snapshot("supernovae", QStringList(sFileName), SNAPSHOT_VERSION);
+    const QVector<SupernovaRecord> records =
+        snapshot.loadOrParse<QVector<SupernovaRecord>>([&]() { return parseSupernovaFile(sFileName); });
+    if (records.isEmpty())
+        return;
+
+    for (const SupernovaRecord &record : records)
+    {
+        Supernova *sup = new Supernova(record.name, dms(record.ra), dms(record.dec), record.type, record.host,
+                                       record.date, record.z, record.mag);
+
+        objectNames(SkyObject::SUPERNOVA).append(record.name);
 
         appendListObject(sup);
-        objectLists(SkyObject::SUPERNOVA).append(QPair<QString, const SkyObject *>(name, sup));
+        objectLists(SkyObject::SUPERNOVA).append(QPair<QString, const SkyObject *>(record.name, sup));
     }
 
     m_DataLoading = false;
@@ -143,24 +204,10 @@ void SupernovaeComponent::loadData()
 
 SkyObject *SupernovaeComponent::objectNearest(SkyPoint *p, double &maxrad)
 {
-    if (!selected() || !m_DataLoaded)
+    if (!m_DataLoaded)
         return nullptr;
 
-    SkyObject *oBest = nullptr;
-    double rBest     = maxrad;
-
-    for (auto so : m_ObjectList)
-    {
-        double r = so->angularDistanceTo(p).Degrees();
-        //qDebug()<<r;
-        if (r < rBest)
-        {
-            oBest = so;
-            rBest = r;
-        }
-    }
-    maxrad = rBest;
-    return oBest;
+    return ListComponent::objectNearest(p, maxrad);
 }
 
 float SupernovaeComponent::zoomMagnitudeLimit()
@@ -155,6 +155,7 @@ bool SyncedCatalogComponent::removeObject(SkyObject &object)
         return false;
     }
     m_ObjectList.removeAll(&object);
+    invalidateIndex();
     qDebug() << "Remove SkyObject " << name << " from synced catalog " << m_catName;
     // Remove the catalog entry
     CatalogEntryData cedata = NameResolver::resolveName(name);
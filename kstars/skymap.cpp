@@ -62,7 +62,6 @@
 #include <QBitmap>
 #include <QToolTip>
 #include <QClipboard>
-#include <QInputDialog>
 #include <QDesktopServices>
 
 #include <QProcess>
@@ -663,36 +662,8 @@ void SkyMap::slotEndRulerMode()
         StarHopperDialog *shd    = new StarHopperDialog(this);
         const SkyPoint &startHop = *AngularRuler.point(0);
         const SkyPoint &stopHop  = *clickedPoint();
-        double fov; // Field of view in arcminutes
-        bool ok;    // true if user did not cancel the operation
-        if (data->getAvailableFOVs().size() == 1)
-        {
-            // Exactly 1 FOV symbol visible, so use that. Also assume a circular FOV of size min{sizeX, sizeY}
-            FOV *f = data->getAvailableFOVs().first();
-            fov    = ((f->sizeX() >= f->sizeY() && f->sizeY() != 0) ? f->sizeY() : f->sizeX());
-            ok     = true;
-        }
-        else if (!data->getAvailableFOVs().isEmpty())
-        {
-            // Ask the user to choose from a list of available FOVs.
-            FOV const *f;
-            QMap<QString, double> nameToFovMap;
-            foreach (f, data->getAvailableFOVs())
-            {
-                nameToFovMap.insert(f->name(),
-                                    ((f->sizeX() >= f->sizeY() && f->sizeY() != 0) ? f->sizeY() : f->sizeX()));
-            }
-            fov = nameToFovMap[QInputDialog::getItem(this, i18n("Star Hopper: Choose a field-of-view"),
-                                                           i18n("FOV to use for star hopping:"), nameToFovMap.uniqueKeys(), 0,
-                                                           false, &ok)];
-        }
-        else
-        {
-            // Ask the user to enter a field of view
-            fov =
-                QInputDialog::getDouble(this, i18n("Star Hopper: Enter field-of-view to use"),
-                                        i18n("FOV to use for star hopping (in arcminutes):"), 60.0, 1.0, 600.0, 1, &ok);
-        }
+        bool ok;                                             // true if user did not cancel the operation
+        double fov = StarHopperDialog::chooseFOV(this, &ok); // Field of view in arcminutes
 
         Q_ASSERT(fov > 0.0);
 
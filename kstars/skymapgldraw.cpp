@@ -23,6 +23,7 @@
 #include "skyglpainter.h"
 #include "skymapgldraw.h"
 #include "skymap.h"
+#include "tracer.h"
 
 SkyMapGLDraw::SkyMapGLDraw(SkyMap *sm) : QGLWidget(sm), SkyMapDrawAbstract(sm)
 {
@@ -51,6 +52,8 @@ void SkyMapGLDraw::paintEvent(QPaintEvent *event)
         return;
     setDrawLock(true);
 
+    TraceZone zone("Paint sky map", "draw");
+
     QPainter p;
     p.begin(this);
     p.beginNativePainting();
@@ -20,6 +20,7 @@
 #include "skymap.h"
 #include "projections/projector.h"
 #include "printing/legend.h"
+#include "tracer.h"
 #include "kstars_debug.h"
 #include <QPainterPath>
 
@@ -44,6 +45,8 @@ void SkyMapQDraw::paintEvent(QPaintEvent *event)
     }
     setDrawLock(true);
 
+    TraceZone zone("Paint sky map", "draw");
+
     // JM 2016-05-03: Not needed since we're not using OpenGL for now
     //calculateFPS();
 
@@ -68,9 +68,11 @@ bool KSPlanet::OrbitDataManager::loadData(KSPlanet::OrbitDataColl &odc, const QS
     int nCount = 0;
     QString nl = n.toLower();
 
-    if (hash.contains(nl))
+    // Read-only lookup, so that positions may be computed from several threads once the data is loaded
+    auto loaded = hash.constFind(nl);
+    if (loaded != hash.constEnd())
     {
-        odc = hash[nl];
+        odc = loaded.value();
         return true; //orbit data already loaded
     }
 
@@ -30,6 +30,36 @@
 #include "texturemanager.h"
 #include "skycomponents/skymapcomposite.h"
 
+#include <QCoreApplication>
+#include <QThread>
+
+#include <memory>
+
+namespace
+{
+/**
+ * The Earth used as reference when computing positions. Positions computed
+ * from threads other than the GUI thread, e.g. batch ephemerides, use a
+ * thread-local Earth so that they neither race with nor disturb the Earth
+ * shown on the sky map. It is built from scratch rather than copied, as the
+ * GUI thread may be updating its Earth at the same time.
+ */
+KSPlanet *referenceEarth()
+{
+    if (QThread::currentThread() == QCoreApplication::instance()->thread())
+        return KStarsData::Instance()->skyComposite()->earth();
+
+    thread_local std::unique_ptr<KSPlanet> localEarth;
+    if (!localEarth)
+    {
+        // The orbital data is already loaded for the Earth of the sky map, so this only looks it up
+        localEarth.reset(new KSPlanet(i18n("Earth"), QString(), QColor("white"), 12756.28 /*diameter in km*/));
+        localEarth->loadData();
+    }
+    return localEarth.get();
+}
+}
+
 QVector<QColor> KSPlanetBase::planetColor = QVector<QColor>() << QColor("slateblue") << //Mercury
         QColor("lightgreen") <<                     //Venus
         QColor("red") <<                            //Mars
@@ -102,18 +132,19 @@ void KSPlanetBase::updateCoords(const KSNumbers *num, bool includePlanets, const
     if (kd == nullptr || !includePlanets)
         return;
 
-    kd->skyComposite()->earth()->findPosition(num); //since we don't pass lat & LST, localizeCoords will be skipped
+    KSPlanet *earth = referenceEarth();
+    earth->findPosition(num); //since we don't pass lat & LST, localizeCoords will be skipped
 
     if (lat && LST)
     {
-        findPosition(num, lat, LST, kd->skyComposite()->earth());
+        findPosition(num, lat, LST, earth);
         // Don't add to the trail this time
         if (hasTrail())
             Trail.takeLast();
     }
     else
     {
-        findGeocentricPosition(num, kd->skyComposite()->earth());
+        findGeocentricPosition(num, earth);
     }
 }
 
@@ -298,7 +329,7 @@ void KSPlanetBase::findPhase()
         return;
     }
     /* Compute the phase of the planet in degrees */
-    double earthSun = KStarsData::Instance()->skyComposite()->earth()->rsun();
+    double earthSun = referenceEarth()->rsun();
     double cosPhase = (rsun() * rsun() + rearth() * rearth() - earthSun * earthSun) / (2 * rsun() * rearth());
 
     Phase           = acos(cosPhase) * 180.0 / dms::PI;
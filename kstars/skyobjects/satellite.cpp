@@ -713,16 +713,105 @@ void Satellite::init()
     }
 }
 
-int Satellite::updatePos()
+Satellite::Observer Satellite::observer(double threshold)
 {
     KStarsData *data = KStarsData::Instance();
-    return sgp4((data->clock()->utc().djd() - m_tle_jd) * MINPD);
+    Observer observer;
+
+    observer.jd        = data->clock()->utc().djd();
+    observer.lst       = data->lst();
+    observer.latitude  = data->geo()->lat();
+    observer.longitude = data->geo()->lng()->Degrees();
+    observer.threshold = threshold;
+
+    // Observer ECI position
+    observer.sinlat   = sin(observer.latitude->radians());
+    observer.coslat   = cos(observer.latitude->radians());
+    double thetageo   = data->geo()->LMST(observer.jd);
+    observer.sintheta = sin(thetageo);
+    observer.costheta = cos(thetageo);
+    double c          = 1.0 / sqrt(1.0 + F * (F - 2.0) * observer.sinlat * observer.sinlat);
+    double sq         = (1.0 - F) * (1.0 - F) * c;
+    double achcp      = (RADIUSEARTHKM * c + MEANALT) * observer.coslat;
+    observer.pos[0]   = achcp * observer.costheta;
+    observer.pos[1]   = achcp * observer.sintheta;
+    observer.pos[2]   = (RADIUSEARTHKM * sq + MEANALT) * observer.sinlat;
+    observer.pos[3]   = sqrt(observer.pos[0] * observer.pos[0] + observer.pos[1] * observer.pos[1] +
+                             observer.pos[2] * observer.pos[2]);
+
+    // Find ECI coordinates of the sun
+    double mjd, year, T, M, L, e, C, O, Lsa, nu, R, eps;
+
+    mjd  = observer.jd - 2415020.0;
+    year = 1900.0 + mjd / 365.25;
+    T    = (mjd + deltaET(year) / (MINPD * 60.0)) / 36525.0;
+    M    = DEG2RAD * (Modulus(358.47583 + Modulus(35999.04975 * T, 360.0) - (0.000150 + 0.0000033 * T) * T * T, 360.0));
+    L    = DEG2RAD * (Modulus(279.69668 + Modulus(36000.76892 * T, 360.0) + 0.0003025 * T * T, 360.0));
+    e    = 0.01675104 - (0.0000418 + 0.000000126 * T) * T;
+    C    = DEG2RAD * ((1.919460 - (0.004789 + 0.000014 * T) * T) * sin(M) + (0.020094 - 0.000100 * T) * sin(2 * M) +
+                      0.000293 * sin(3 * M));
+    O    = DEG2RAD * (Modulus(259.18 - 1934.142 * T, 360.0));
+    Lsa  = Modulus(L + C - DEG2RAD * (0.00569 - 0.00479 * sin(O)), TWOPI);
+    nu   = Modulus(M + C, TWOPI);
+    R    = 1.0000002 * (1.0 - e * e) / (1.0 + e * cos(nu));
+    eps  = DEG2RAD * (23.452294 - (0.0130125 + (0.00000164 - 0.000000503 * T) * T) * T + 0.00256 * cos(O));
+    R    = AU * R;
+
+    observer.sun_pos[0] = R * cos(Lsa);
+    observer.sun_pos[1] = R * sin(Lsa) * cos(eps);
+    observer.sun_pos[2] = R * sin(Lsa) * sin(eps);
+    observer.sun_pos[3] = R;
+
+    KSSun *sun       = dynamic_cast<KSSun *>(data->skyComposite()->findByName(i18n("Sun")));
+    observer.sun_alt = sun ? sun->alt().Degrees() : 90.0;
+
+    return observer;
+}
+
+int Satellite::updatePos()
+{
+    return updatePos(observer());
 }
 
-int Satellite::sgp4(double tsince)
+int Satellite::updatePos(const Observer &observer)
 {
-    KStarsData *data = KStarsData::Instance();
+    const double elapsed = (observer.jd - m_last_jd) * MINPD;
+
+    // Skip the propagation while the apparent motion since the last one stays below the threshold
+    if (observer.threshold > 0 && m_apparent_rate >= 0 && observer.latitude->Degrees() == m_last_lat &&
+            observer.longitude == m_last_lng && fabs(elapsed) * m_apparent_rate < observer.threshold)
+        return 0;
+
+    const double last_alt = alt().Degrees(), last_az = az().Degrees();
+    const double last_ra = ra().Degrees(), last_dec = dec().Degrees();
+
+    int rc = sgp4((observer.jd - m_tle_jd) * MINPD, observer);
+    if (rc != 0)
+        return rc;
 
+    // Estimate the apparent angular rate, in both horizontal and equatorial coordinates
+    if (m_last_jd > 0 && elapsed != 0 && observer.latitude->Degrees() == m_last_lat && observer.longitude == m_last_lng)
+    {
+        auto separation = [](double lng1, double lat1, double lng2, double lat2)
+        {
+            double dlng = Modulus(lng2 - lng1 + 180.0, 360.0) - 180.0;
+            return hypot(lat2 - lat1, dlng * cos(lat2 * DEG2RAD));
+        };
+        m_apparent_rate = qMax(separation(last_az, last_alt, az().Degrees(), alt().Degrees()),
+                               separation(last_ra, last_dec, ra().Degrees(), dec().Degrees())) / fabs(elapsed);
+    }
+    else
+        m_apparent_rate = -1;
+
+    m_last_jd  = observer.jd;
+    m_last_lat = observer.latitude->Degrees();
+    m_last_lng = observer.longitude;
+
+    return 0;
+}
+
+int Satellite::sgp4(double tsince, const Observer &observer)
+{
     int ktr;
     double am, axnl, aynl, betal, cosim, cnod, cos2u, coseo1 = 0, cosi, cosip, cosisq, cossu, cosu, delm, delomg, em,
                                                       ecose, el2, eo1, ep, esine, argpm, argpp, argpdf, pl,
@@ -730,13 +819,11 @@ int Satellite::sgp4(double tsince)
                                                       t3, t4, tem5, temp, temp1, temp2, tempa, tempe, templ, u, ux, uy, uz, vx, vy, vz, inclm, mm, nm, nodem, xinc,
                                                       xincp, xl, xlm, mp, xmdf, xmx, xmy, nodedf, xnode, nodep, tc, sat_posx, sat_posy, sat_posz, sat_posw, sat_velx,
                                                       sat_vely, sat_velz, sinlat, obs_posx, obs_posy, obs_posz, obs_posw, /*obs_velx, obs_vely, obs_velz,*/
-                                                      coslat, thetageo, sintheta, costheta, c, sq, achcp, vkmpersec;
+                                                      coslat, sintheta, costheta, vkmpersec;
     //    double emsq;
 
     const double temp4 = 1.5e-12;
 
-    double jul_utc = data->clock()->utc().djd();
-
     vkmpersec = RADIUSEARTHKM * XKE / 60.0;
 
     // Update for secular gravity and atmospheric drag
@@ -1145,22 +1232,15 @@ int Satellite::sgp4(double tsince)
         return (6);
     }
 
-    // Observer ECI position and velocity
-    sinlat   = sin(data->geo()->lat()->radians());
-    coslat   = cos(data->geo()->lat()->radians());
-    thetageo = data->geo()->LMST(jul_utc);
-    sintheta = sin(thetageo);
-    costheta = cos(thetageo);
-    c        = 1.0 / sqrt(1.0 + F * (F - 2.0) * sinlat * sinlat);
-    sq       = (1.0 - F) * (1.0 - F) * c;
-    achcp    = (RADIUSEARTHKM * c + MEANALT) * coslat;
-    obs_posx = achcp * costheta;
-    obs_posy = achcp * sintheta;
-    obs_posz = (RADIUSEARTHKM * sq + MEANALT) * sinlat;
-    obs_posw = sqrt(obs_posx * obs_posx + obs_posy * sat_posy + obs_posz * obs_posz);
-    /*obs_velx = -MFACTOR * obs_posy;
-    obs_vely = MFACTOR * obs_posx;
-    obs_velz = 0.;*/
+    // Observer ECI position
+    sinlat   = observer.sinlat;
+    coslat   = observer.coslat;
+    sintheta = observer.sintheta;
+    costheta = observer.costheta;
+    obs_posx = observer.pos[0];
+    obs_posy = observer.pos[1];
+    obs_posz = observer.pos[2];
+    obs_posw = observer.pos[3];
 
     m_altitude = sat_posw - obs_posw + MEANALT;
 
@@ -1169,9 +1249,6 @@ int Satellite::sgp4(double tsince)
     double range_posy = sat_posy - obs_posy;
     double range_posz = sat_posz - obs_posz;
     m_range           = sqrt(range_posx * range_posx + range_posy * range_posy + range_posz * range_posz);
-    //     double range_velx = sat_velx - obs_velx;
-    //     double range_vely = sat_velx - obs_vely;
-    //     double range_velz = sat_velx - obs_velz;
 
     double top_s = sinlat * costheta * range_posx + sinlat * sintheta * range_posy - coslat * range_posz;
     double top_e = -sintheta * range_posx + costheta * range_posy;
@@ -1184,36 +1261,15 @@ int Satellite::sgp4(double tsince)
         azimuth += TWOPI;
     double elevation = arcSin(top_z / m_range);
 
-    //     printf("azimuth=%.15f\n\r", azimuth / DEG2RAD);
-    //     printf("elevation=%.15f\n\r", elevation / DEG2RAD);
-
     setAz(azimuth / DEG2RAD);
     setAlt(elevation / DEG2RAD);
-    HorizontalToEquatorial(data->lst(), data->geo()->lat());
+    HorizontalToEquatorial(observer.lst, observer.latitude);
 
     // is the satellite visible ?
-    // Find ECI coordinates of the sun
-    double mjd, year, T, M, L, e, C, O, Lsa, nu, R, eps;
-
-    mjd  = jul_utc - 2415020.0;
-    year = 1900.0 + mjd / 365.25;
-    T    = (mjd + deltaET(year) / (MINPD * 60.0)) / 36525.0;
-    M    = DEG2RAD * (Modulus(358.47583 + Modulus(35999.04975 * T, 360.0) - (0.000150 + 0.0000033 * T) * T * T, 360.0));
-    L    = DEG2RAD * (Modulus(279.69668 + Modulus(36000.76892 * T, 360.0) + 0.0003025 * T * T, 360.0));
-    e    = 0.01675104 - (0.0000418 + 0.000000126 * T) * T;
-    C    = DEG2RAD * ((1.919460 - (0.004789 + 0.000014 * T) * T) * sin(M) + (0.020094 - 0.000100 * T) * sin(2 * M) +
-                      0.000293 * sin(3 * M));
-    O    = DEG2RAD * (Modulus(259.18 - 1934.142 * T, 360.0));
-    Lsa  = Modulus(L + C - DEG2RAD * (0.00569 - 0.00479 * sin(O)), TWOPI);
-    nu   = Modulus(M + C, TWOPI);
-    R    = 1.0000002 * (1.0 - e * e) / (1.0 + e * cos(nu));
-    eps  = DEG2RAD * (23.452294 - (0.0130125 + (0.00000164 - 0.000000503 * T) * T) * T + 0.00256 * cos(O));
-    R    = AU * R;
-
-    double sun_posx = R * cos(Lsa);
-    double sun_posy = R * sin(Lsa) * cos(eps);
-    double sun_posz = R * sin(Lsa) * sin(eps);
-    double sun_posw = R;
+    double sun_posx = observer.sun_pos[0];
+    double sun_posy = observer.sun_pos[1];
+    double sun_posz = observer.sun_pos[2];
+    double sun_posw = observer.sun_pos[3];
 
     // Calculates satellite's eclipse status and depth
     double sd_sun, sd_earth, delta, depth;
@@ -1229,12 +1285,11 @@ int Satellite::sgp4(double tsince)
     double earth_y = -1.0 * sat_posy;
     double earth_z = -1.0 * sat_posz;
     double earth_w = sat_posw;
-    delta      = PIO2 - arcSin((sun_posx * earth_x + sun_posy * earth_y + sun_posz * earth_z) / (sun_posw * earth_w));
-    depth      = sd_earth - sd_sun - delta;
-    KSSun *sun = dynamic_cast<KSSun *>(data->skyComposite()->findByName(i18n("Sun")));
+    delta = PIO2 - arcSin((sun_posx * earth_x + sun_posy * earth_y + sun_posz * earth_z) / (sun_posw * earth_w));
+    depth = sd_earth - sd_sun - delta;
 
     m_is_eclipsed = sd_earth >= sd_sun && depth >= 0;
-    m_is_visible  = !m_is_eclipsed && sun->alt().Degrees() <= -12.0 && elevation >= 0.0;
+    m_is_visible  = !m_is_eclipsed && observer.sun_alt <= -12.0 && elevation >= 0.0;
 
     return (0);
 }
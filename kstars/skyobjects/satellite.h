@@ -21,6 +21,7 @@
 
 #include <QString>
 
+class dms;
 class KSPopupMenu;
 
 /**
@@ -45,9 +46,53 @@ class Satellite : public SkyObject
     /** @short Destructor */
     virtual ~Satellite() override = default;
 
+    /**
+     * @struct Observer
+     * Observer and Sun state shared by every satellite propagated for the same instant.
+     * It is computed once per update so that satellites can be propagated in parallel
+     * without touching KStarsData.
+     */
+    struct Observer
+    {
+        /// UTC Julian day
+        double jd { 0 };
+        /// Local sidereal time and observer latitude
+        const dms *lst { nullptr };
+        const dms *latitude { nullptr };
+        /// Observer longitude in degrees
+        double longitude { 0 };
+        /// Sine and cosine of latitude and local mean sidereal time
+        double sinlat { 0 }, coslat { 0 }, sintheta { 0 }, costheta { 0 };
+        /// Observer ECI position in km, and its norm
+        double pos[4] { 0, 0, 0, 0 };
+        /// Sun ECI position in km, and its norm
+        double sun_pos[4] { 0, 0, 0, 0 };
+        /// Sun altitude in degrees
+        double sun_alt { 0 };
+        /// Apparent motion in degrees below which propagation is skipped, 0 to always propagate
+        double threshold { 0 };
+    };
+
+    /**
+     * @short Build the observer state for the current simulation time and location
+     * @param threshold apparent motion in degrees, typically one pixel, below which
+     * updatePos(const Observer &) keeps the previous position
+     */
+    static Observer observer(double threshold = 0);
+
     /** @short Update satellite position */
     int updatePos();
 
+    /**
+     * @short Update satellite position for a precomputed observer state.
+     * If the apparent motion since the last propagation, extrapolated from the
+     * previous rate, stays below the observer threshold, the position is kept.
+     * This method only touches this satellite and may run concurrently on
+     * different satellites.
+     * @return 0 on success, otherwise an sgp4 error code
+     */
+    int updatePos(const Observer &observer);
+
     /**
      * @return True if the satellite is visible (above horizon, in the sunlight and sun at least 12° under horizon)
      */
@@ -85,10 +130,10 @@ class Satellite : public SkyObject
     void init();
 
     /** @short Compute satellite position */
-    int sgp4(double tsince);
+    int sgp4(double tsince, const Observer &observer);
 
     /** @return Arcsine of the argument */
-    double arcSin(double arg);
+    static double arcSin(double arg);
 
     /**
      * Provides the difference between UT (approximately the same as UTC)
@@ -96,10 +141,10 @@ class Satellite : public SkyObject
      * This function is based on a least squares fit of data from 1950
      * to 1991 and will need to be updated periodically.
      */
-    double deltaET(double year);
+    static double deltaET(double year);
 
     /** @return arg1 mod arg2 */
-    double Modulus(double arg1, double arg2);
+    static double Modulus(double arg1, double arg2);
 
     // TLE
     /// Satellite Number
@@ -152,6 +197,12 @@ class Satellite : public SkyObject
     double m_altitude { 0 };
     /// Satellite range from observer in km
     double m_range { 0 };
+    /// Julian day and observer location of the last propagation
+    double m_last_jd { 0 };
+    double m_last_lat { 0 };
+    double m_last_lng { 0 };
+    /// Apparent angular rate in degrees per minute, negative if unknown
+    double m_apparent_rate { -1 };
 
     // Near Earth
     bool isimp { false };
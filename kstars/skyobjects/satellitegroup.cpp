@@ -63,6 +63,7 @@ void SatelliteGroup::readTLE()
 void SatelliteGroup::updateSatellitesPos()
 {
     QMutableListIterator<Satellite *> sats(*this);
+    const Satellite::Observer observer = Satellite::observer();
 
     while (sats.hasNext())
     {
@@ -70,7 +71,7 @@ void SatelliteGroup::updateSatellitesPos()
 
         if (sat->selected())
         {
-            int rc = sat->updatePos();
+            int rc = sat->updatePos(observer);
             // If position cannot be calculated, remove it from list
             if (rc != 0)
                 sats.remove();
@@ -317,7 +317,7 @@ SkyPoint SkyObject::recomputeCoords(const KStarsDateTime &dt, const GeoLocation
     SkyObject *c = this->clone();
 
     // compute coords of the copy for new time jd
-    KSNumbers num(dt.djd());
+    std::shared_ptr<const KSNumbers> num = KSNumbers::cached(dt.djd());
 
     // Note: isSolarSystem() below should give the same result on this
     // and c. The only very minor reason to prefer this is so that we
@@ -328,11 +328,11 @@ SkyPoint SkyObject::recomputeCoords(const KStarsDateTime &dt, const GeoLocation
     if (isSolarSystem() && geo)
     {
         CachingDms LST = geo->GSTtoLST(dt.gst());
-        c->updateCoords(&num, true, geo->lat(), &LST);
+        c->updateCoords(num.get(), true, geo->lat(), &LST);
     }
     else
     {
-        c->updateCoords(&num);
+        c->updateCoords(num.get());
     }
 
     // Transfer the coordinates into a SkyPoint
@@ -563,10 +563,10 @@ void SkyPoint::precessFromAnyEpoch(long double jd0, long double jdf)
             //Need to first precess to J2000.0 coords
             //s is the product of P1 and v; s represents the
             //coordinates precessed to J2000
-            KSNumbers num(jd0);
+            std::shared_ptr<const KSNumbers> num = KSNumbers::cached(jd0);
             for (unsigned int i = 0; i < 3; ++i)
             {
-                s[i] = num.p1(0, i) * v[0] + num.p1(1, i) * v[1] + num.p1(2, i) * v[2];
+                s[i] = num->p1(0, i) * v[0] + num->p1(1, i) * v[1] + num->p1(2, i) * v[2];
             }
 
             //Input coords already in J2000, set s accordingly.
@@ -587,10 +587,10 @@ void SkyPoint::precessFromAnyEpoch(long double jd0, long double jdf)
             return;
         }
 
-        KSNumbers num(jdf);
+        std::shared_ptr<const KSNumbers> num = KSNumbers::cached(jdf);
         for (unsigned int i = 0; i < 3; ++i)
         {
-            v[i] = num.p2(0, i) * s[0] + num.p2(1, i) * s[1] + num.p2(2, i) * s[2];
+            v[i] = num->p2(0, i) * s[0] + num->p2(1, i) * s[1] + num->p2(2, i) * s[2];
         }
 
         RA.setUsing_atan2(v[1], v[0]);
@@ -605,22 +605,118 @@ void SkyPoint::precessFromAnyEpoch(long double jd0, long double jdf)
 void SkyPoint::apparentCoord(long double jd0, long double jdf)
 {
     precessFromAnyEpoch(jd0, jdf);
-    KSNumbers num(jdf);
-    nutate(&num);
+    std::shared_ptr<const KSNumbers> num = KSNumbers::cached(jdf);
+    nutate(num.get());
     if (Options::useRelativistic() && checkBendLight())
         bendlight();
-    aberrate(&num);
+    aberrate(num.get());
+}
+
+void SkyPoint::apparentCoords(const QList<SkyPoint *> &points, long double jd0, long double jdf, const CachingDms *LST,
+                              const CachingDms *lat)
+{
+    if (jd0 == B1950L || jdf == B1950L)
+    {
+        // The conversions from and to B1950 are not only rotations
+        for (SkyPoint *p : points)
+        {
+            p->apparentCoord(jd0, jdf);
+            if (LST && lat)
+                p->EquatorialToHorizontal(LST, lat);
+        }
+        return;
+    }
+
+    double precession[3][3];
+    precessionMatrix(jd0, jdf, precession);
+
+    std::shared_ptr<const KSNumbers> num = KSNumbers::cached(jdf);
+    const bool relativistic              = Options::useRelativistic();
+
+    for (SkyPoint *p : points)
+    {
+        p->apparentCoord(precession, jd0 == jdf, num.get(), relativistic);
+        if (LST && lat)
+            p->EquatorialToHorizontal(LST, lat);
+    }
+}
+
+void SkyPoint::apparentCoords(QVector<SkyPoint> &points, long double jd0, long double jdf, const CachingDms *LST,
+                              const CachingDms *lat)
+{
+    QList<SkyPoint *> list;
+    list.reserve(points.size());
+    for (SkyPoint &p : points)
+        list.append(&p);
+
+    apparentCoords(list, jd0, jdf, LST, lat);
+}
+
+void SkyPoint::precessionMatrix(long double jd0, long double jdf, double matrix[3][3])
+{
+    // From the original epoch to J2000, transposed as in precessFromAnyEpoch()
+    double toJ2000[3][3];
+    std::shared_ptr<const KSNumbers> num0;
+    if (jd0 != J2000L)
+        num0 = KSNumbers::cached(jd0);
+
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        for (unsigned int j = 0; j < 3; ++j)
+            toJ2000[i][j] = num0 ? num0->p1(j, i) : (i == j ? 1.0 : 0.0);
+    }
+
+    // Then from J2000 to the final epoch
+    std::shared_ptr<const KSNumbers> numf = KSNumbers::cached(jdf);
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        for (unsigned int j = 0; j < 3; ++j)
+            matrix[i][j] = numf->p2(0, i) * toJ2000[0][j] + numf->p2(1, i) * toJ2000[1][j] + numf->p2(2, i) * toJ2000[2][j];
+    }
+}
+
+void SkyPoint::apparentCoord(const double precession[3][3], bool sameEpoch, const KSNumbers *num, bool relativistic)
+{
+    RA  = RA0;
+    Dec = Dec0;
+
+    if (!sameEpoch)
+    {
+        double cosRA, sinRA, cosDec, sinDec;
+        double v[3], s[3];
+
+        RA.SinCos(sinRA, cosRA);
+        Dec.SinCos(sinDec, cosDec);
+
+        s[0] = cosRA * cosDec;
+        s[1] = sinRA * cosDec;
+        s[2] = sinDec;
+
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            v[i] = precession[i][0] * s[0] + precession[i][1] * s[1] + precession[i][2] * s[2];
+        }
+
+        RA.setUsing_atan2(v[1], v[0]);
+        Dec.setUsing_asin(v[2]);
+        RA.reduceToRange(dms::ZERO_TO_2PI);
+    }
+
+    nutate(num);
+    if (relativistic && checkBendLight())
+        bendlight();
+    aberrate(num);
 }
 
 SkyPoint SkyPoint::catalogueCoord(long double jdf)
 {
-    KSNumbers num(jdf);
+    std::shared_ptr<const KSNumbers> num = KSNumbers::cached(jdf);
 
     // remove abberation
-    aberrate(&num, true);
+    aberrate(num.get(), true);
 
     // remove nutation
-    nutate(&num, true);
+    nutate(num.get(), true);
 
     // remove precession
     // the start position needs to be in RA0,Dec0
@@ -682,7 +778,7 @@ void SkyPoint::B1950ToJ2000(void)
     double v[3], s[3];
 
     // 1984 January 1 0h
-    KSNumbers num(2445700.5L);
+    std::shared_ptr<const KSNumbers> num = KSNumbers::cached(2445700.5L);
 
     // Eterms due to aberration
     addEterms();
@@ -695,7 +791,7 @@ void SkyPoint::B1950ToJ2000(void)
     s[2] = sinDec;
     for (unsigned int i = 0; i < 3; ++i)
     {
-        v[i] = num.p2b(0, i) * s[0] + num.p2b(1, i) * s[1] + num.p2b(2, i) * s[2];
+        v[i] = num->p2b(0, i) * s[0] + num->p2b(1, i) * s[1] + num->p2b(2, i) * s[2];
     }
 
     // RA zero-point correction at 1984 day 1, 0h.
@@ -714,7 +810,7 @@ void SkyPoint::B1950ToJ2000(void)
 
     for (unsigned int i = 0; i < 3; ++i)
     {
-        v[i] = num.p1(0, i) * s[0] + num.p1(1, i) * s[1] + num.p1(2, i) * s[2];
+        v[i] = num->p1(0, i) * s[0] + num->p1(1, i) * s[1] + num->p1(2, i) * s[2];
     }
 
     RA.setRadians(atan2(v[1], v[0]));
@@ -728,7 +824,7 @@ void SkyPoint::J2000ToB1950(void)
     double v[3], s[3];
 
     // 1984 January 1 0h
-    KSNumbers num(2445700.5L);
+    std::shared_ptr<const KSNumbers> num = KSNumbers::cached(2445700.5L);
 
     RA.SinCos(sinRA, cosRA);
     Dec.SinCos(sinDec, cosDec);
@@ -741,7 +837,7 @@ void SkyPoint::J2000ToB1950(void)
 
     for (unsigned int i = 0; i < 3; ++i)
     {
-        v[i] = num.p2(0, i) * s[0] + num.p2(1, i) * s[1] + num.p2(2, i) * s[2];
+        v[i] = num->p2(0, i) * s[0] + num->p2(1, i) * s[1] + num->p2(2, i) * s[2];
     }
 
     RA.setRadians(atan2(v[1], v[0]));
@@ -760,7 +856,7 @@ void SkyPoint::J2000ToB1950(void)
     s[2] = sinDec;
     for (unsigned int i = 0; i < 3; ++i)
     {
-        v[i] = num.p1b(0, i) * s[0] + num.p1b(1, i) * s[1] + num.p1b(2, i) * s[2];
+        v[i] = num->p1b(0, i) * s[0] + num->p1b(1, i) * s[1] + num->p1b(2, i) * s[2];
     }
 
     RA.setRadians(atan2(v[1], v[0]));
@@ -913,8 +1009,8 @@ double SkyPoint::vREarth(long double jd0)
     the source coordinates are also in the same reference system.
     */
 
-    KSNumbers num(jd0);
-    return num.vEarth(0) * cosDec * cosRA + num.vEarth(1) * cosDec * sinRA + num.vEarth(2) * sinDec;
+    std::shared_ptr<const KSNumbers> num = KSNumbers::cached(jd0);
+    return num->vEarth(0) * cosDec * cosRA + num->vEarth(1) * cosDec * sinRA + num->vEarth(2) * sinDec;
 }
 
 double SkyPoint::vGeocentric(double vhelio, long double jd0)
@@ -23,6 +23,7 @@
 #include "kstarsdatetime.h"
 
 #include <QList>
+#include <QVector>
 #ifndef KSTARS_LITE
 #include <QtDBus/QtDBus>
 #endif
@@ -392,6 +393,29 @@ class SkyPoint
          */
         void apparentCoord(long double jd0, long double jdf);
 
+        /**
+         * Computes the apparent coordinates of many SkyPoints for the same epochs,
+         * as apparentCoord() does for each of them. The time-dependent variables
+         * and the precession matrix from the original to the final epoch are
+         * computed once for all the points.
+         *
+         * @param points the SkyPoints, whose catalog coordinates (RA0, Dec0) are referred to jd0
+         * @param jd0 Julian Day which identifies the original epoch
+         * @param jdf Julian Day which identifies the final epoch
+         * @param LST pointer to the local sidereal time. If not null, with lat,
+         * the horizontal coordinates are computed as well.
+         * @param lat pointer to the geographic latitude
+         */
+        static void apparentCoords(const QList<SkyPoint *> &points, long double jd0, long double jdf,
+                                   const CachingDms *LST = nullptr, const CachingDms *lat = nullptr);
+
+        /**
+         * Computes the apparent coordinates of an array of SkyPoints for the same epochs.
+         * @see apparentCoords(const QList<SkyPoint *> &, long double, long double, const CachingDms *, const CachingDms *)
+         */
+        static void apparentCoords(QVector<SkyPoint> &points, long double jd0, long double jdf,
+                                   const CachingDms *LST = nullptr, const CachingDms *lat = nullptr);
+
         /**
          * Computes the J2000.0 catalogue coordinates for this SkyPoint using the epoch
          * removing aberration, nutation and precession
@@ -742,6 +766,19 @@ class SkyPoint
 #endif
 
     private:
+        /**
+         * Computes the rotation matrix precessing coordinates from one epoch to another,
+         * as precessFromAnyEpoch() does. Neither epoch may be B1950.
+         */
+        static void precessionMatrix(long double jd0, long double jdf, double matrix[3][3]);
+
+        /**
+         * Computes the apparent coordinates for this SkyPoint, with the precession matrix and
+         * time-dependent variables of the final epoch computed once for many SkyPoints.
+         * @see apparentCoords()
+         */
+        void apparentCoord(const double precession[3][3], bool sameEpoch, const KSNumbers *num, bool relativistic);
+
         CachingDms RA0, Dec0; //catalog coordinates
         CachingDms RA, Dec;   //current true sky coordinates
         dms Alt, Az;
@@ -41,9 +41,15 @@ TrailObject::TrailObject(int t, double r, double d, float m, const QString &n) :
 {
 }
 
+TrailObject::TrailObject(const TrailObject &other) : SkyObject(other)
+{
+}
+
 TrailObject::~TrailObject()
 {
-    trailObjects.remove(this);
+    // Objects without a trail are not registered, and may be destroyed by any thread
+    if (hasTrail())
+        trailObjects.remove(this);
 }
 
 TrailObject *TrailObject::clone() const
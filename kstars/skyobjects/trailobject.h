@@ -40,6 +40,12 @@ class TrailObject : public SkyObject
     /** Constructor */
     TrailObject(int t, double r, double d, float m = 0.0, const QString &n = QString());
 
+    /**
+     * Copy constructor. The trail is not copied: copies are temporary objects, often
+     * updated on worker threads, and must never register in the shared trail set.
+     */
+    TrailObject(const TrailObject &other);
+
     ~TrailObject() override;
 
     TrailObject *clone() const override;
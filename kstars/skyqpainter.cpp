@@ -25,6 +25,7 @@
 #include "Options.h"
 #include "skymap.h"
 #include "projections/projector.h"
+#include "skycomponents/constellationartcache.h"
 #include "skycomponents/flagcomponent.h"
 #include "skycomponents/linelist.h"
 #include "skycomponents/linelistlabel.h"
@@ -632,6 +633,11 @@ bool SkyQPainter::drawConstellationArtImage(ConstellationsArt *obj)
     float w = obj->getWidth() * 60 * dms::PI * zoom / 10800;
     float h = obj->getHeight() * 60 * dms::PI * zoom / 10800;
 
+    // Decoded in the background at the drawn size, the art is skipped until then
+    const QImage image = ConstellationArtCache::Instance()->image(obj->getImageFileName(), qMax(w, h));
+    if (image.isNull())
+        return false;
+
     save();
 
     setRenderHint(QPainter::SmoothPixmapTransform);
@@ -639,7 +645,7 @@ bool SkyQPainter::drawConstellationArtImage(ConstellationsArt *obj)
     translate(constellationmidpoint);
     rotate(positionangle);
     setOpacity(0.7);
-    drawImage(QRectF(-0.5 * w, -0.5 * h, w, h), obj->image());
+    drawImage(QRectF(-0.5 * w, -0.5 * h, w, h), image);
     setOpacity(1);
 
     setRenderHint(QPainter::SmoothPixmapTransform, false);
@@ -70,6 +70,21 @@ const QImage &TextureManager::getImage(const QString &name)
     }
 }
 
+QString TextureManager::findTextureFile(const QString &name)
+{
+    // Try the 'textures' subdirectory, then 'skycultures/western' and 'skycultures/inuit' for
+    // constellation art, then the main data directory
+    const QStringList directories = { "textures/", "skycultures/western/", "skycultures/inuit/", "" };
+
+    for (const QString &directory : directories)
+    {
+        QString filename = KSPaths::locate(QStandardPaths::GenericDataLocation, QString("%1%2.png").arg(directory, name));
+        if (!filename.isNull())
+            return filename;
+    }
+    return QString();
+}
+
 // FIXME: should be cache images which are not found?
 TextureManager::CacheIter TextureManager::findTexture(const QString &name)
 {
@@ -82,45 +97,14 @@ TextureManager::CacheIter TextureManager::findTexture(const QString &name)
     }
     else
     {
-        // Try to load from file in 'textures' subdirectory
-        QString filename = KSPaths::locate(QStandardPaths::GenericDataLocation, QString("textures/%1.png").arg(name));
+        QString filename = findTextureFile(name);
         if (!filename.isNull())
         {
             return (TextureManager::CacheIter)m_p->m_textures.insert(name, QImage(filename, "PNG"));
         }
         else
         {
-            //Try to load from the file in 'skycultures/western' subdirectory for western constellation art
-            QString filename =
-                KSPaths::locate(QStandardPaths::GenericDataLocation, QString("skycultures/western/%1.png").arg(name));
-            if (!filename.isNull())
-            {
-                return (TextureManager::CacheIter)m_p->m_textures.insert(name, QImage(filename, "PNG"));
-            }
-            else
-            {
-                //Try to load from the file in 'skycultures/inuit' subdirectory for Inuit constellation art
-                QString filename =
-                    KSPaths::locate(QStandardPaths::GenericDataLocation, QString("skycultures/inuit/%1.png").arg(name));
-                if (!filename.isNull())
-                {
-                    return (TextureManager::CacheIter)m_p->m_textures.insert(name, QImage(filename, "PNG"));
-                }
-                else
-                {
-                    // Try to load from file in main data directory
-
-                    filename = KSPaths::locate(QStandardPaths::GenericDataLocation, QString("%1.png").arg(name));
-                    if (!filename.isNull())
-                    {
-                        return (TextureManager::CacheIter)m_p->m_textures.insert(name, QImage(filename, "PNG"));
-                    }
-                    else
-                    {
-                        return m_p->m_textures.constEnd();
-                    }
-                }
-            }
+            return m_p->m_textures.constEnd();
         }
     }
 }
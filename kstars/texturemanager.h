@@ -45,6 +45,13 @@ class TextureManager : public QObject
      */
     static const QImage &getImage(const QString &name);
 
+    /**
+     * Return the path of a texture image file, or an empty string if it is not found.
+     * The 'textures' directory is searched first, then the sky culture directories, then
+     * the data directory. Does not use the cache, so that it can be called from any thread.
+     */
+    static QString findTextureFile(const QString &name);
+
 #ifdef HAVE_OPENGL
     /**
      *  Bind OpenGL texture. Acts similarly to getImage but does
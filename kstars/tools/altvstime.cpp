@@ -19,6 +19,7 @@
 
 #include "avtplotwidget.h"
 #include "dms.h"
+#include "ephemerisbatch.h"
 #include "ksalmanac.h"
 #include "kstarsdata.h"
 #include "kstarsdatetime.h"
@@ -383,7 +384,7 @@ void AltVsTime::processObject(SkyObject *o, bool forceAdd)
     o->updateCoordsNow(num);
 
     // vector used for computing the points needed for drawing the graph
-    QVector<double> y(100), t(100);
+    QVector<double> y, t;
 
     //If this point is not in list already, add it to list
     bool found(false);
@@ -420,16 +421,17 @@ void AltVsTime::processObject(SkyObject *o, bool forceAdd)
         // time range: 24h
 
         int offset = 3;
-        for (double h = -12.0, i = 0; h <= 12.0; h += 0.25, i++)
+        y = altitudeCurves({ o }).first();
+        t.resize(y.size());
+        for (int i = 0; i < y.size(); i++)
         {
-            y[i] = findAltitude(o, h);
             if (y[i] > maxAlt)
                 maxAlt = y[i];
             if (y[i] < minAlt)
                 minAlt = y[i];
             t[i] = i * 900 + 43200;
-            avtUI->View->graph(avtUI->View->graphCount() - 1)->addData(t[i], y[i]);
         }
+        avtUI->View->graph(avtUI->View->graphCount() - 1)->setData(t, y);
         avtUI->View->graph(avtUI->View->graphCount() - 1)->setPen(QPen(Qt::white, 3));
 
         // Go into initial state: without Zoom/Pan
@@ -469,6 +471,13 @@ void AltVsTime::processObject(SkyObject *o, bool forceAdd)
     delete num;
 }
 
+QVector<QVector<double>> AltVsTime::altitudeCurves(const QList<const SkyPoint *> &points)
+{
+    // Same samples as findAltitude() for hours -12 to +12 in steps of 15 minutes
+    KStarsDateTime start = getDate().addSecs((-12.0 + 24.0 * DayOffset) * 3600.0);
+    return EphemerisBatch::altitudes(points, start, 900, 97, geo);
+}
+
 double AltVsTime::findAltitude(SkyPoint *p, double hour)
 {
     hour += 24.0 * DayOffset;
@@ -978,6 +987,9 @@ void AltVsTime::slotUpdateDateLoc()
     // Determine dawn/dusk time and min/max sun elevation
     setDawnDusk();
 
+    //First bring all objects to the target date, so that their curves can be computed in one batch
+    QList<const SkyPoint *> points;
+    QList<KSNumbers *> oldNums;
     for (int i = 0; i < pList.count(); ++i)
     {
         SkyObject *o = pList.at(i);
@@ -993,25 +1005,31 @@ void AltVsTime::slotUpdateDateLoc()
             //precess coords to target epoch
             o->updateCoordsNow(num);
 
-            //update pList entry
-            pList.replace(i, o);
+            points.append(o);
+        }
+        oldNums.append(oldNum);
+        oldNum = nullptr;
+    }
+
+    const QVector<QVector<double>> curves = altitudeCurves(points);
 
+    for (int i = 0, curve = 0; i < pList.count(); ++i)
+    {
+        SkyObject *o = pList.at(i);
+        if (o)
+        {
             // We are creating a new data set (time, altitude) for the new date:
-            QVector<double> time_dataSet, altitude_dataSet;
-            double point_altitudeValue, point_timeValue;
+            QVector<double> time_dataSet, altitude_dataSet = curves.at(curve++);
             // compute the new graph values:
             // time range: 24h
             int offset = 3;
-            for (double h = -12.0, i = 0; h <= 12.0; h += 0.25, i++)
+            for (int j = 0; j < altitude_dataSet.size(); j++)
             {
-                point_altitudeValue = findAltitude(o, h);
-                altitude_dataSet.push_back(point_altitudeValue);
-                if (point_altitudeValue > maxAlt)
-                    maxAlt = point_altitudeValue;
-                if (point_altitudeValue < minAlt)
-                    minAlt = point_altitudeValue;
-                point_timeValue = i * 900 + 43200;
-                time_dataSet.push_back(point_timeValue);
+                if (altitude_dataSet.at(j) > maxAlt)
+                    maxAlt = altitude_dataSet.at(j);
+                if (altitude_dataSet.at(j) < minAlt)
+                    minAlt = altitude_dataSet.at(j);
+                time_dataSet.push_back(j * 900 + 43200);
             }
 
             // Replace graph data set:
@@ -1038,9 +1056,8 @@ void AltVsTime::slotUpdateDateLoc()
             //restore original position
             if (o->isSolarSystem())
             {
-                o->updateCoords(oldNum, true, data->geo()->lat(), data->lst());
-                delete oldNum;
-                oldNum = nullptr;
+                o->updateCoords(oldNums.at(i), true, data->geo()->lat(), data->lst());
+                delete oldNums.at(i);
             }
             o->EquatorialToHorizontal(data->lst(), data->geo()->lat());
         }
@@ -117,6 +117,14 @@ class AltVsTime : public QDialog
      */
     double findAltitude(SkyPoint *p, double hour);
 
+    /**
+     * @short Compute the altitude curves of several points over the displayed day
+     * The curves are sampled like findAltitude() every 15 minutes from -12h to +12h,
+     * using the current equatorial coordinates of the points.
+     * @return one curve of 97 altitudes in degrees per point
+     */
+    QVector<QVector<double>> altitudeCurves(const QList<const SkyPoint *> &points);
+
     /**
      * @short get object name. If star has no name, generate a name based on catalog number.
      * @param o sky object.
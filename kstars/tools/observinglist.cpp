@@ -37,6 +37,7 @@
 #include "sessionsortfilterproxymodel.h"
 #include "skymap.h"
 #include "thumbnailpicker.h"
+#include "starhopperdialog.h"
 #include "dialogs/detaildialog.h"
 #include "dialogs/finddialog.h"
 #include "dialogs/locationdialog.h"
@@ -58,6 +59,8 @@
 #include <KPlotting/KPlotAxis>
 #include <KPlotting/KPlotObject>
 
+#include <algorithm>
+
 #include <kstars_debug.h>
 
 //
@@ -297,9 +300,9 @@ void ObservingList::slotAddObject(const SkyObject *_obj, bool session, bool upda
             obj->type() == SkyObject::PLANET) &&
             obj->mag() == 0)
     {
-        KSNumbers num(dt.djd());
+        std::shared_ptr<const KSNumbers> num = KSNumbers::cached(dt.djd());
         CachingDms LST = geo->GSTtoLST(dt.gst());
-        obj->updateCoords(&num, true, geo->lat(), &LST, true);
+        obj->updateCoords(num.get(), true, geo->lat(), &LST, true);
     }
 
     QString smag = "--";
@@ -803,6 +806,47 @@ void ObservingList::slotAVT()
     }
 }
 
+void ObservingList::slotStarHop()
+{
+    Q_ASSERT(sessionView);
+
+    // Hop in the order the session plan is displayed
+    QList<int> rows;
+    foreach (const QModelIndex &i, getSelectedItems())
+        rows.append(i.row());
+    if (rows.size() < 2)
+    {
+        rows.clear();
+        for (int row = 0; row < m_SessionSortModel->rowCount(); ++row)
+            rows.append(row);
+    }
+    std::sort(rows.begin(), rows.end());
+
+    if (rows.size() < 2)
+        return;
+
+    QList<QPair<SkyPoint, SkyPoint>> hops;
+    for (int k = 1; k < rows.size(); ++k)
+    {
+        SkyObject *from = static_cast<SkyObject *>(
+            m_SessionSortModel->index(rows[k - 1], 0).data(Qt::UserRole + 1).value<void *>());
+        SkyObject *to =
+            static_cast<SkyObject *>(m_SessionSortModel->index(rows[k], 0).data(Qt::UserRole + 1).value<void *>());
+        Q_ASSERT(from && to);
+        hops.append(qMakePair(SkyPoint(*from), SkyPoint(*to)));
+    }
+
+    bool ok;
+    double fov = StarHopperDialog::chooseFOV(this, &ok); // Field of view in arcminutes
+    if (!ok || fov <= 0.0)
+        return;
+
+    // All the hops are searched at once, sharing the stars of their corridors
+    StarHopperDialog *shd = new StarHopperDialog(SkyMap::Instance());
+    shd->starHop(hops, fov / 60.0, 9.0); //FIXME: Hardcoded maglimit value, as in SkyMap
+    shd->show();
+}
+
 //FIXME: On close, we will need to close any open Details/AVT windows
 void ObservingList::slotClose()
 {
@@ -227,6 +227,11 @@ class ObservingList : public QDialog
             */
     void slotAVT();
 
+    /** @short Show the star hopping routes between consecutive objects of the session plan,
+            *only between the selected ones if there are several
+            */
+    void slotStarHop();
+
     /** @short Open the WUT dialog
         */
     void slotWUT();
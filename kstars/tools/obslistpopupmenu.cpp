@@ -66,6 +66,10 @@ void ObsListPopupMenu::initPopupMenu(bool sessionView, bool multiSelection, bool
     //Insert item for opening the Altitude vs time dialog
     addAction(i18n("Altitude vs. Time"), ksdata->observingList(), SLOT(slotAVT()));
 
+    //Insert item for the star hopping routes between the targets of the session
+    if (sessionView)
+        addAction(i18n("Star Hop Between Targets"), ksdata->observingList(), SLOT(slotStarHop()));
+
     addSeparator();
 
     //Insert item for downloading different images
@@ -17,6 +17,7 @@
 
 #include "skycalendar.h"
 
+#include "ephemerisbatch.h"
 #include "geolocation.h"
 #include "ksplanetbase.h"
 #include "kstarsdata.h"
@@ -101,20 +102,23 @@ void SkyCalendar::slotFillCalendar()
     scUI->CalendarView->resetPlot();
     scUI->CalendarView->setHorizon();
 
+    QList<int> planets;
     if (scUI->checkBox_Mercury->isChecked())
-        addPlanetEvents(KSPlanetBase::MERCURY);
+        planets << KSPlanetBase::MERCURY;
     if (scUI->checkBox_Venus->isChecked())
-        addPlanetEvents(KSPlanetBase::VENUS);
+        planets << KSPlanetBase::VENUS;
     if (scUI->checkBox_Mars->isChecked())
-        addPlanetEvents(KSPlanetBase::MARS);
+        planets << KSPlanetBase::MARS;
     if (scUI->checkBox_Jupiter->isChecked())
-        addPlanetEvents(KSPlanetBase::JUPITER);
+        planets << KSPlanetBase::JUPITER;
     if (scUI->checkBox_Saturn->isChecked())
-        addPlanetEvents(KSPlanetBase::SATURN);
+        planets << KSPlanetBase::SATURN;
     if (scUI->checkBox_Uranus->isChecked())
-        addPlanetEvents(KSPlanetBase::URANUS);
+        planets << KSPlanetBase::URANUS;
     if (scUI->checkBox_Neptune->isChecked())
-        addPlanetEvents(KSPlanetBase::NEPTUNE);
+        planets << KSPlanetBase::NEPTUNE;
+
+    addPlanetEvents(planets);
 
     scUI->CreateButton->setText(i18n("Plot Planetary Almanac"));
     scUI->CreateButton->setEnabled(true);
@@ -181,23 +185,46 @@ void SkyCalendar::drawEventLabel( float x1, float y1, float x2, float y2, QStrin
 }
 */
 
-void SkyCalendar::addPlanetEvents(int nPlanet)
+void SkyCalendar::addPlanetEvents(const QList<int> &planets)
+{
+    QList<KSPlanetBase *> ksps;
+    QList<const SkyObject *> objects;
+    for (int nPlanet : planets)
+    {
+        KSPlanetBase *ksp = KStarsData::Instance()->skyComposite()->planet(nPlanet);
+        ksps.append(ksp);
+        objects.append(ksp);
+    }
+
+    QVector<KStarsDateTime> dates;
+    for (KStarsDateTime kdt(QDate(year(), 1, 1), QTime(12, 0, 0)); kdt.date().year() == year();
+            kdt = kdt.addDays(scUI->spinBox_Interval->value()))
+        dates.append(kdt);
+
+    // All planets and dates in one concurrent batch
+    const QVector<QVector<EphemerisBatch::RiseSetTransit>> events = EphemerisBatch::riseSetTransit(objects, dates, geo);
+
+    for (int i = 0; i < ksps.size(); ++i)
+        plotPlanetEvents(ksps.at(i), dates, events.at(i));
+}
+
+void SkyCalendar::plotPlanetEvents(KSPlanetBase *ksp, const QVector<KStarsDateTime> &dates,
+                                   const QVector<EphemerisBatch::RiseSetTransit> &events)
 {
-    KSPlanetBase *ksp = KStarsData::Instance()->skyComposite()->planet(nPlanet);
     QColor pColor     = ksp->color();
     //QVector<QPointF> vRise, vSet, vTransit;
     std::vector<QPointF> vRise, vSet, vTransit;
 
-    for (KStarsDateTime kdt(QDate(year(), 1, 1), QTime(12, 0, 0)); kdt.date().year() == year();
-            kdt = kdt.addDays(scUI->spinBox_Interval->value()))
+    for (int i = 0; i < dates.size(); ++i)
     {
+        const KStarsDateTime &kdt = dates.at(i);
         float rTime, sTime, tTime;
 
         //Compute rise/set/transit times.  If they occur before noon,
         //recompute for the following day
-        QTime tmp_rTime = ksp->riseSetTime(kdt, geo, true, true);  //rise time, exact
-        QTime tmp_sTime = ksp->riseSetTime(kdt, geo, false, true); //set time, exact
-        QTime tmp_tTime = ksp->transitTime(kdt, geo);
+        QTime tmp_rTime = events.at(i).rise;    //rise time, exact
+        QTime tmp_sTime = events.at(i).set;     //set time, exact
+        QTime tmp_tTime = events.at(i).transit;
         QTime midday(12, 0, 0);
 
         // NOTE: riseSetTime should be fix now, this test is no longer necessary
@@ -224,7 +251,7 @@ void SkyCalendar::addPlanetEvents(int nPlanet)
         }
         else
         {
-            if (ksp->transitAltitude(kdt, geo).degree() > 0)
+            if (events.at(i).transitAltitude > 0)
             {
                 rTime = -24.0;
                 sTime = 24.0;
@@ -20,9 +20,11 @@
 #include <QDialog>
 #include <QMutex>
 
+#include "ephemerisbatch.h"
 #include "ui_skycalendar.h"
 
 class GeoLocation;
+class KSPlanetBase;
 
 class SkyCalendarUI : public QFrame, public Ui::SkyCalendar
 {
@@ -57,7 +59,9 @@ class SkyCalendar : public QDialog
     //void slotCalculating();
 
   private:
-    void addPlanetEvents(int nPlanet);
+    void addPlanetEvents(const QList<int> &planets);
+    void plotPlanetEvents(KSPlanetBase *ksp, const QVector<KStarsDateTime> &dates,
+                          const QVector<EphemerisBatch::RiseSetTransit> &events);
     void drawEventLabel(float x1, float y1, float x2, float y2, QString LabelText);
 
     SkyCalendarUI *scUI { nullptr };
@@ -24,340 +24,673 @@
 
 #include <kstars_debug.h>
 
-QList<StarObject *> *StarHopper::computePath(const SkyPoint &src, const SkyPoint &dest, float fov__, float maglim__,
-                                             QStringList *metadata_)
+#include <QAtomicInt>
+#include <QHash>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#define RIGHT_ANGLE_THRESHOLD 0.05
+#define EQUAL_EDGE_THRESHOLD  0.025
+
+namespace
 {
-    QList<const StarObject *> starHopList_const = computePath_const(src, dest, fov__, maglim__, metadata_);
-    QList<StarObject *> *starHopList_unconst    = new QList<StarObject *>();
-    foreach (const StarObject *so, starHopList_const)
+// The graph is reused for the following hops of the same day
+const long double GRAPH_LIFETIME = 1.0;
+// Offset of the cell coordinates, so that they fit in 21 bits
+const int CELL_OFFSET = 1 << 20;
+
+struct Vector
+{
+    double x, y, z;
+};
+
+// Unit vector of the catalog position of a point
+Vector toVector(const SkyPoint &p)
+{
+    double sinRa, cosRa, sinDec, cosDec;
+    p.ra0().SinCos(sinRa, cosRa);
+    p.dec0().SinCos(sinDec, cosDec);
+    return Vector { cosDec * cosRa, cosDec * sinRa, sinDec };
+}
+
+double dot(const Vector &a, const Vector &b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+// Angle between two unit vectors, in degrees
+double distance(const Vector &a, const Vector &b)
+{
+    const double cx = a.y * b.z - a.z * b.y;
+    const double cy = a.z * b.x - a.x * b.z;
+    const double cz = a.x * b.y - a.y * b.x;
+    return atan2(sqrt(cx * cx + cy * cy + cz * cz), dot(a, b)) * 180.0 / M_PI;
+}
+
+// Radius of the corridor of a hop around its destination: the nodes farther than 1.2 times the
+// length of the hop are not expanded, and the neighbours of a star are looked for within one FOV
+double corridorRadius(double length, float fov)
+{
+    return 1.2 * length + 2 * fov;
+}
+
+// Position of a hop in catalog coordinates
+SkyPoint catalogPoint(const SkyPoint &p)
+{
+    SkyPoint point(p);
+    return point.catalogueCoord(KStarsData::Instance()->updateNum()->julianDay());
+}
+}
+
+struct StarHopper::Graph
+{
+    typedef enum
     {
-        starHopList_unconst->append(const_cast<StarObject *>(so));
+        NO_PATTERN,
+        TRIANGLE,
+        RIGHT_ANGLED_TRIANGLE,
+        ISOSCELES_TRIANGLE,
+        STRAIGHT_LINE,
+        EQUILATERAL_TRIANGLE
+    } Pattern;
+
+    struct Star
+    {
+        Vector position;
+        // Catalog position in radians, for the pattern tests
+        double ra { 0 };
+        double dec { 0 };
+        float mag { 0 };
+        char spclass { 0 };
+        // Only valid in the main thread until the star catalogs are drawn again
+        const StarObject *object { nullptr };
+        // Cost of hopping to the star but for the distance, evaluated once
+        bool hasCost { false };
+        float cost { 0 };
+        Pattern pattern { NO_PATTERN };
+        // Aperture of the pattern, in percent of the FOV
+        int patternSize { 0 };
+    };
+
+    struct Corridor
+    {
+        Vector center;
+        double radius;
+    };
+
+    Graph(float fov_, float maglim_, long double jd_);
+
+    bool covers(const Vector &center, double radius) const;
+    /** Adds the stars around the destination of a hop, in the main thread */
+    void addCorridor(const SkyPoint &center, double radius);
+    /** Appends the stars within a radius not larger than the FOV, not fainter than a magnitude */
+    void neighbours(const Vector &position, double radius, float mag, QVector<int> &list) const;
+    /** Cost of hopping to a star, but for the distance */
+    float cost(int star);
+    /**
+     * Searches the route of a hop with the A* search algorithm, see
+     * https://en.wikipedia.org/wiki/A*_search_algorithm for details
+     * @return false if no route was found, or if the search was cancelled
+     */
+    bool route(const Vector &src, const Vector &dest, const QAtomicInt &cancelled,
+               const std::function<void(double)> &progress, QVector<int> &path);
+
+    quint64 cellKey(int x, int y, int z) const
+    {
+        return (static_cast<quint64>(x + CELL_OFFSET) << 42) | (static_cast<quint64>(y + CELL_OFFSET) << 21) |
+               static_cast<quint64>(z + CELL_OFFSET);
     }
-    return starHopList_unconst;
+    int cell(double coordinate) const { return static_cast<int>(std::floor(coordinate / cellSize)); }
+
+    float fov { 0 };
+    float maglim { 0 };
+    long double jd { 0 };
+    // Chord of the FOV, so that the neighbours of a star are in the adjacent cells
+    double cellSize { 0 };
+    QVector<Star> stars;
+    QVector<Corridor> corridors;
+    QHash<const StarObject *, int> index;
+    QHash<quint64, QVector<int>> cells;
+};
+
+struct StarHopper::Search
+{
+    std::shared_ptr<Graph> graph;
+    // Catalog positions of the hops
+    QVector<QPair<Vector, Vector>> hops;
+    QList<SkyPoint> sources;
+    QVector<QVector<int>> routes;
+    QVector<bool> found;
+    QAtomicInt cancelled { 0 };
+};
+
+StarHopper::Graph::Graph(float fov_, float maglim_, long double jd_) : fov(fov_), maglim(maglim_), jd(jd_)
+{
+    cellSize = 2 * sin(fov * M_PI / 360.0);
 }
 
-QList<const StarObject *> StarHopper::computePath_const(const SkyPoint &src, const SkyPoint &dest, float fov_,
-                                                        float maglim_, QStringList *metadata)
+bool StarHopper::Graph::covers(const Vector &center, double radius) const
 {
-    fov    = fov_;
-    maglim = maglim_;
-    start  = &src;
-    end    = &dest;
+    for (const Corridor &corridor : corridors)
+    {
+        if (distance(corridor.center, center) + radius <= corridor.radius)
+            return true;
+    }
+    return false;
+}
 
-    came_from.clear();
-    result_path.clear();
+void StarHopper::Graph::addCorridor(const SkyPoint &center, double radius)
+{
+    // One magnitude below the limit, for the density and pattern tests of the faintest stars
+    QList<StarObject *> list;
+    StarComponent::Instance()->starsInAperture(list, center, radius, maglim + 1.0);
 
-    // Implements the A* search algorithm
+    Corridor corridor;
+    corridor.center = toVector(center);
+    corridor.radius = radius;
+    corridors.append(corridor);
 
-    QList<SkyPoint const *> cSet;
-    QList<SkyPoint const *> oSet;
-    QHash<SkyPoint const *, double> g_score;
-    QHash<SkyPoint const *, double> f_score;
-    QHash<SkyPoint const *, double> h_score;
+    for (const StarObject *object : list)
+    {
+        // Bright stars are returned regardless of the magnitude limit
+        if (object->mag() > maglim + 1.0 || index.contains(object))
+            continue;
 
-    qCDebug(KSTARS) << "StarHopper is trying to compute a path from source: " << src.ra().toHMSString()
-             << src.dec().toDMSString() << " to destination: " << dest.ra().toHMSString() << dest.dec().toDMSString()
-             << "; a starhop of " << src.angularDistanceTo(&dest).Degrees() << " degrees!";
+        Star star;
+        star.position = toVector(*object);
+        star.ra       = object->ra0().radians();
+        star.dec      = object->dec0().radians();
+        star.mag      = object->mag();
+        star.spclass  = object->spchar();
+        star.object   = object;
+
+        const int i = stars.size();
+        stars.append(star);
+        index.insert(object, i);
+        cells[cellKey(cell(star.position.x), cell(star.position.y), cell(star.position.z))].append(i);
+    }
 
-    oSet.append(&src);
-    g_score[&src] = 0;
-    h_score[&src] = src.angularDistanceTo(&dest).Degrees() / fov;
-    f_score[&src] = h_score[&src];
+    qCDebug(KSTARS) << "StarHopper graph has" << stars.size() << "stars in" << corridors.size() << "corridors";
+}
 
-    while (!oSet.isEmpty())
-    {
-        qCDebug(KSTARS) << "Next step";
-        // Find the node with the lowest f_score value
-        SkyPoint const *curr_node = nullptr;
-        double lowfscore          = 1.0e8;
+void StarHopper::Graph::neighbours(const Vector &position, double radius, float mag, QVector<int> &list) const
+{
+    Q_ASSERT(radius <= fov);
+
+    const double cosRadius = cos(radius * M_PI / 180.0);
+    const int x = cell(position.x), y = cell(position.y), z = cell(position.z);
 
-        foreach (const SkyPoint *sp, oSet)
+    for (int dx = -1; dx <= 1; ++dx)
+    {
+        for (int dy = -1; dy <= 1; ++dy)
         {
-            if (f_score[sp] < lowfscore)
+            for (int dz = -1; dz <= 1; ++dz)
             {
-                lowfscore = f_score[sp];
-                curr_node = sp;
+                auto it = cells.constFind(cellKey(x + dx, y + dy, z + dz));
+                if (it == cells.constEnd())
+                    continue;
+
+                for (int i : it.value())
+                {
+                    if (stars[i].mag <= mag && dot(stars[i].position, position) >= cosRadius)
+                        list.append(i);
+                }
             }
         }
-        if (curr_node == nullptr)
-            continue;
+    }
+}
 
-        qCDebug(KSTARS) << "Lowest fscore (vertex distance-plus-cost score) is " << lowfscore
-                 << " with coords: " << curr_node->ra().toHMSString() << curr_node->dec().toDMSString()
-                 << ". Considering this node now.";
-        if (curr_node == &dest || (curr_node != &src && h_score[curr_node] < 0.5))
-        {
-            // We are at destination
-            reconstructPath(came_from[curr_node]);
-            qCDebug(KSTARS) << "We've arrived at the destination! Yay! Result path count: " << result_path.count();
+float StarHopper::Graph::cost(int i)
+{
+    // This is a very heuristic method, that tries to produce a cost
+    // for each hop.
 
-            // Just a test -- try to print out useful instructions to the debug console. Once we make star hopper unexperimental, we should move this to some sort of a display
-            qCDebug(KSTARS) << "Star Hopping Directions: ";
-            const SkyPoint *prevHop = start;
+    if (stars[i].hasCost)
+        return stars[i].cost;
 
-            for (auto &hopStar : result_path)
-            {
-                QString direction;
-                QString spectralChar = "";
-                double pa; // should be 0 to 2pi
+    Star &star = stars[i];
 
-                dms angDist = prevHop->angularDistanceTo(hopStar, &pa);
+    // Test 1: How bright is the star?
+    double magcost =
+        star.mag - 7.0 +
+        5 * log10(fov); // The brighter, the better. FIXME: 8.0 is now an arbitrary reference to the average faint star. Should actually depend on FOV, something like log( FOV ).
 
-                dms dmsPA;
-                dmsPA.setRadians(pa);
-                direction = KSUtils::toDirectionString(dmsPA);
+    // Test 2: Is the star strikingly red / yellow coloured?
+    double speccost = (star.spclass == 'G' || star.spclass == 'K' || star.spclass == 'M') ? -0.3 : 0;
 
-                if (metadata)
-                {
-                    if (!patternNames.contains(hopStar))
-                    {
-                        spectralChar += hopStar->spchar();
-                        starHopDirections = i18n(" Slew %1 degrees %2 to find an %3 star of mag %4 ", QString::number(angDist.Degrees(), 'f', 2),
-                                                 direction, spectralChar, QString::number(hopStar->mag()));
-                        qCDebug(KSTARS) << starHopDirections;
-                    }
-                    else
-                    {
-                        starHopDirections = i18n(" Slew %1 degrees %2 to find a(n) %3", QString::number(angDist.Degrees(), 'f', 2), direction,
-                                                     patternNames.value(hopStar));
-                        qCDebug(KSTARS) << starHopDirections;
-                    }
-                    metadata->append(starHopDirections);
-                    qCDebug(KSTARS) << "Appended starHopDirections to metadata";
-                }
-                prevHop = hopStar;
+    // Test 4, how far is the hop, depends on the previous star, see route()
+
+    // Test 6: Is the destination an asterism? Are there bright stars clustered nearby?
+    QVector<int> localNeighbors;
+    neighbours(star.position, fov / 10, maglim + 1.0, localNeighbors);
+    double stardensitycost = 1 - localNeighbors.count(); // -1 "magnitude" for every neighbouring star
+
+    // Test 7: Identify star patterns
+    double patterncost = 0;
+    float factor       = 1.0;
+    while (factor <= 10.0)
+    {
+        localNeighbors.clear();
+        // Use a larger aperture for pattern identification; max 1.0 mag difference
+        neighbours(star.position, fov / factor, star.mag + 1.0, localNeighbors);
+        localNeighbors.erase(std::remove_if(localNeighbors.begin(), localNeighbors.end(),
+                                            [&](int j) { return j == i || fabs(stars[j].mag - star.mag) > 1.0; }),
+                             localNeighbors.end());
+        factor += 1.0;
+        if (localNeighbors.size() == 2)
+            break;
+    }
+    factor -= 1.0;
+    if (localNeighbors.size() == 2)
+    {
+        star.pattern = TRIANGLE; // any three stars form a triangle!
+        // Try to find triangles. Note that we assume that the standard Euclidian metric works on a sphere for small angles, i.e. the celestial sphere is nearly flat over our FOV.
+        const Star &star1 = stars[localNeighbors[0]];
+        double dRA1       = star.ra - star1.ra;
+        double dDec1      = star.dec - star1.dec;
+        double dist1sqr   = dRA1 * dRA1 + dDec1 * dDec1;
+
+        const Star &star2 = stars[localNeighbors[1]];
+        double dRA2       = star.ra - star2.ra;
+        double dDec2      = star.dec - star2.dec;
+        double dist2sqr   = dRA2 * dRA2 + dDec2 * dDec2;
+
+        // Check for right-angled triangles (without loss of generality, right angle is at this vertex)
+        if (fabs((dRA1 * dRA2 - dDec1 * dDec2) / sqrt(dist1sqr * dist2sqr)) < RIGHT_ANGLE_THRESHOLD)
+        {
+            // We have a right angled triangle! Give -3 magnitudes!
+            patterncost += -3;
+            star.pattern = RIGHT_ANGLED_TRIANGLE;
+        }
+
+        // Check for isosceles triangles (without loss of generality, this is the vertex)
+        if (fabs((dist1sqr - dist2sqr) / (dist1sqr)) < EQUAL_EDGE_THRESHOLD)
+        {
+            patterncost += -1;
+            star.pattern = ISOSCELES_TRIANGLE;
+            if (fabs((dRA2 * dDec1 - dRA1 * dDec2) / sqrt(dist1sqr * dist2sqr)) < RIGHT_ANGLE_THRESHOLD)
+            {
+                patterncost += -1;
+                star.pattern = STRAIGHT_LINE;
             }
-            qCDebug(KSTARS) << "  The destination is within a field-of-view";
+            // Check for equilateral triangles
+            double dist3    = distance(star1.position, star2.position) * M_PI / 180.0;
+            double dist3sqr = dist3 * dist3;
+            if (fabs((dist3sqr - dist1sqr) / dist1sqr) < EQUAL_EDGE_THRESHOLD)
+            {
+                patterncost += -1;
+                star.pattern = EQUILATERAL_TRIANGLE;
+            }
+        }
+        star.patternSize = static_cast<int>(100.0 / factor);
+    }
+    // TODO: Identify squares.
 
-            return result_path;
+    star.cost    = magcost + speccost + stardensitycost + patterncost;
+    star.hasCost = true;
+    return star.cost;
+}
+
+bool StarHopper::Graph::route(const Vector &src, const Vector &dest, const QAtomicInt &cancelled,
+                              const std::function<void(double)> &progress, QVector<int> &path)
+{
+    // The source is the node -1, the other nodes are the stars brighter than the limit
+    typedef std::pair<double, int> Entry;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> oSet;
+    QVector<double> g_score(stars.size(), std::numeric_limits<double>::infinity());
+    QVector<int> came_from(stars.size(), -1);
+    QVector<bool> cSet(stars.size(), false);
+    QVector<int> neighbors;
+
+    const double src_h_score = distance(src, dest) / fov;
+    double closest           = src_h_score;
+
+    path.clear();
+    oSet.push(Entry(src_h_score, -1));
+
+    while (!oSet.empty())
+    {
+        if (cancelled.load())
+            return false;
+
+        // Find the node with the lowest f_score value
+        const int curr_node = oSet.top().second;
+        oSet.pop();
+
+        const Vector &position = curr_node < 0 ? src : stars[curr_node].position;
+        const double h_score   = curr_node < 0 ? src_h_score : distance(position, dest) / fov;
+        double curr_g_score    = 0;
+
+        if (curr_node >= 0)
+        {
+            // The node was queued again with a better score
+            if (cSet[curr_node])
+                continue;
+            cSet[curr_node] = true;
+            curr_g_score    = g_score[curr_node];
+
+            if (h_score < 0.5)
+            {
+                // We are at destination
+                for (int node = came_from[curr_node]; node >= 0; node = came_from[node])
+                    path.prepend(node);
+                return true;
+            }
         }
 
-        oSet.removeOne(curr_node);
-        cSet.append(curr_node);
+        if (h_score < closest && src_h_score > 0.5)
+        {
+            closest = h_score;
+            progress((src_h_score - closest) / (src_h_score - 0.5));
+        }
 
         // FIXME: Make sense. If current node ---> dest distance is
         // larger than src --> dest distance by more than 20%, don't
         // even bother considering it.
-
-        if (h_score[curr_node] > h_score[&src] * 1.2)
-        {
-            qCDebug(KSTARS) << "Node under consideration has larger distance to destination (h-score) than start node! "
-                        "Ignoring it.";
+        if (h_score > src_h_score * 1.2)
             continue;
-        }
 
         // Get the list of stars that are neighbours of this node
-        QList<StarObject *> neighbors;
-
-        // FIXME: Actually, this should be done in
-        // HorizontalToEquatorial, but we do it here because SkyPoint
-        // needs a lot of fixing to handle unprecessed and precessed,
-        // equatorial and horizontal coordinates nicely
-        SkyPoint *CurrentNode = const_cast<SkyPoint *>(curr_node);
-        //CurrentNode->deprecess(KStarsData::Instance()->updateNum());
-        CurrentNode->catalogueCoord(KStarsData::Instance()->updateNum()->julianDay());
-        //qCDebug(KSTARS) << "Calling starsInAperture";
-        StarComponent::Instance()->starsInAperture(neighbors, *curr_node, fov, maglim);
-        qCDebug(KSTARS) << "Choosing next node from a set of " << neighbors.count();
-        // Look for the potential next node
-        double curr_g_score = g_score[curr_node];
-
-        for (auto &nhd_node : neighbors)
+        neighbors.clear();
+        neighbours(position, fov, maglim, neighbors);
+
+        for (int nhd_node : neighbors)
         {
-            if (cSet.contains(nhd_node))
+            if (cSet[nhd_node])
                 continue;
 
-            // Compute the tentative g_score
-            double tentative_g_score = curr_g_score + cost(curr_node, nhd_node);
-            bool tentative_better;
-            if (!oSet.contains(nhd_node))
-            {
-                oSet.append(nhd_node);
-                tentative_better = true;
-            }
-            else if (tentative_g_score < g_score[nhd_node])
-                tentative_better = true;
-            else
-                tentative_better = false;
+            // Compute the tentative g_score, with Test 4: How far is the hop?
+            double netcost = cost(nhd_node) + distance(position, stars[nhd_node].position) / fov;
+            if (netcost < 0)
+                netcost = 0.1; // FIXME: Heuristics aren't supposed to be entirely random. This one is.
 
-            if (tentative_better)
+            const double tentative_g_score = curr_g_score + netcost;
+            if (tentative_g_score < g_score[nhd_node])
             {
                 came_from[nhd_node] = curr_node;
                 g_score[nhd_node]   = tentative_g_score;
-                h_score[nhd_node]   = nhd_node->angularDistanceTo(&dest).Degrees() / fov;
-                f_score[nhd_node]   = g_score[nhd_node] + h_score[nhd_node];
+                oSet.push(Entry(tentative_g_score + distance(stars[nhd_node].position, dest) / fov, nhd_node));
             }
         }
     }
-    qCDebug(KSTARS) << "REGRET! Returning empty list!";
-    return QList<StarObject const *>(); // Return an empty QList
+
+    return false;
+}
+
+StarHopper::StarHopper(QObject *parent) : QObject(parent)
+{
 }
 
-void StarHopper::reconstructPath(SkyPoint const *curr_node)
+StarHopper::~StarHopper()
+{
+    cancel();
+    m_Future.waitForFinished();
+}
+
+QList<StarObject *> *StarHopper::computePath(const SkyPoint &src, const SkyPoint &dest, float fov__, float maglim__,
+                                             QStringList *metadata_)
 {
-    if (curr_node != start)
+    QList<const StarObject *> starHopList_const = computePath_const(src, dest, fov__, maglim__, metadata_);
+    QList<StarObject *> *starHopList_unconst    = new QList<StarObject *>();
+    foreach (const StarObject *so, starHopList_const)
     {
-        StarObject const *s = dynamic_cast<StarObject const *>(curr_node);
-        Q_ASSERT(s);
-        result_path.prepend(s);
-        reconstructPath(came_from[s]);
+        starHopList_unconst->append(const_cast<StarObject *>(so));
     }
+    return starHopList_unconst;
 }
 
-float StarHopper::cost(const SkyPoint *curr, const SkyPoint *next)
+QList<const StarObject *> StarHopper::computePath_const(const SkyPoint &src, const SkyPoint &dest, float fov_,
+                                                        float maglim_, QStringList *metadata)
 {
-    // This is a very heuristic method, that tries to produce a cost
-    // for each hop.
+    qCDebug(KSTARS) << "StarHopper is trying to compute a path from source: " << src.ra().toHMSString()
+             << src.dec().toDMSString() << " to destination: " << dest.ra().toHMSString() << dest.dec().toDMSString()
+             << "; a starhop of " << src.angularDistanceTo(&dest).Degrees() << " degrees!";
+
+    // The graph is shared with the searches in the background
+    cancel();
+    m_Future.waitForFinished();
 
-    float netcost = 0;
+    QList<QPair<SkyPoint, SkyPoint>> hops;
+    hops.append(qMakePair(src, dest));
+    std::shared_ptr<Graph> hopGraph = graph(hops, fov_, maglim_);
 
-    // Convert 'next' into a StarObject
-    if (next == start)
+    QVector<int> route;
+    QAtomicInt cancelled(0);
+    if (!hopGraph->route(toVector(catalogPoint(src)), toVector(catalogPoint(dest)), cancelled, [](double) {}, route))
     {
-        // If the next hop is back to square one, junk it
-        return 1e8;
+        qCDebug(KSTARS) << "REGRET! Returning empty list!";
+        return QList<StarObject const *>(); // Return an empty QList
     }
-    bool isThisTheEnd = (next == end);
 
-    float magcost, speccost;
-    magcost = speccost = 0;
+    return resolve(*hopGraph, route, src, metadata);
+}
+
+void StarHopper::computePaths(const QList<QPair<SkyPoint, SkyPoint>> &hops, float fov, float maglim)
+{
+    cancel();
+    m_Future.waitForFinished();
+
+    m_Search.reset(new Search());
+    m_Search->graph = graph(hops, fov, maglim);
+    for (const auto &hop : hops)
+    {
+        m_Search->hops.append(qMakePair(toVector(catalogPoint(hop.first)), toVector(catalogPoint(hop.second))));
+        m_Search->sources.append(hop.first);
+    }
+    m_Search->routes.resize(hops.size());
+    m_Search->found.fill(false, hops.size());
+
+    std::shared_ptr<Search> search = m_Search;
+    const int number               = ++m_SearchNumber;
 
-    if (!isThisTheEnd)
+    m_Future = QtConcurrent::run([this, search, number]()
     {
-        // We ought to be dealing with a star
-        StarObject const *nextstar = dynamic_cast<StarObject const *>(next);
-        Q_ASSERT(nextstar);
-
-        // Test 1: How bright is the star?
-        magcost =
-            nextstar->mag() - 7.0 +
-            5 * log10(
-                    fov); // The brighter, the better. FIXME: 8.0 is now an arbitrary reference to the average faint star. Should actually depend on FOV, something like log( FOV ).
-
-        // Test 2: Is the star strikingly red / yellow coloured?
-        QString SpType = nextstar->sptype();
-        char spclass   = SpType.at(0).toLatin1();
-        speccost       = (spclass == 'G' || spclass == 'K' || spclass == 'M') ? -0.3 : 0;
-        /*
-        // Test 3: Is the star in the general direction of the object?
-        // We use the cosine rule to find the angle between the hop direction, and the direction to destination
-        // a = side joining curr to end
-        // b = side joining curr to next
-        // c = side joining next to end
-        // C = angle between curr-next and curr-end
-        double sina, sinb, cosa, cosb;
-        curr->angularDistanceTo(dest).SinCos( &sina, &cosa );
-        curr->angularDistanceTo(next).SinCos( &sinb, &cosb );
-        double cosc = cos(next->angularDistanceTo(end).radians());
-        double cosC = ( cosc - cosa * cosb ) / (sina * sinb);
-        float dircost;
-        if( cosC < 0 ) // Wrong direction!
-        dircost = 1e8; // Some humongous number;
+        const int count = search->hops.size();
+        int reported    = -1;
+
+        for (int i = 0; i < count; ++i)
+        {
+            auto progress = [&](double fraction)
+            {
+                const int percent = static_cast<int>(100.0 * (i + qBound(0.0, fraction, 1.0)) / count);
+                if (percent != reported)
+                {
+                    reported = percent;
+                    QMetaObject::invokeMethod(this, "slotProgress", Qt::QueuedConnection, Q_ARG(int, number),
+                                              Q_ARG(int, percent));
+                }
+            };
+
+            search->found[i] = search->graph->route(search->hops[i].first, search->hops[i].second, search->cancelled,
+                                                    progress, search->routes[i]);
+            if (search->cancelled.load())
+                return;
+        }
+
+        QMetaObject::invokeMethod(this, "slotSearchDone", Qt::QueuedConnection, Q_ARG(int, number));
+    });
+}
+
+void StarHopper::cancel()
+{
+    if (m_Search)
+        m_Search->cancelled.store(1);
+    m_Search.reset();
+    ++m_SearchNumber;
+}
+
+bool StarHopper::isRunning() const
+{
+    return m_Search && m_Future.isRunning();
+}
+
+void StarHopper::slotProgress(int search, int percent)
+{
+    if (search == m_SearchNumber)
+        emit progress(percent);
+}
+
+void StarHopper::slotSearchDone(int search)
+{
+    if (search != m_SearchNumber || !m_Search)
+        return;
+
+    // Reporting the paths may start another search
+    std::shared_ptr<Search> done = m_Search;
+    m_Search.reset();
+
+    for (int i = 0; i < done->hops.size(); ++i)
+    {
+        QList<StarObject *> path;
+        QStringList directions;
+
+        if (done->found[i])
+        {
+            for (const StarObject *star : resolve(*done->graph, done->routes[i], done->sources[i], &directions))
+                path.append(const_cast<StarObject *>(star));
+        }
         else
-        dircost = sqrt( 1 - cosC * cosC ) / cosC; // tan( C )
-        */
+            qCDebug(KSTARS) << "StarHopper found no path for hop" << i;
+
+        emit pathFound(i, path, directions);
     }
 
-    // Test 4: How far is the hop?
-    double distcost =
-        (curr->angularDistanceTo(next).Degrees() /
-         fov); // 1 "magnitude" incremental cost for 1 FOV. Is this even required, or is it just equivalent to halving our distance unit? I think it is required since the hop is not necessarily in the direction of the object -- asimha
+    emit finished();
+}
 
-    // Test 5: How effective is the hop? [Might not be required with A*]
-    //    double distredcost = -((src->angularDistanceTo( dest ).Degrees() - next->angularDistanceTo( dest ).Degrees()) * 60 / fov)*3; // 3 "magnitudes" for 1 FOV closer
+std::shared_ptr<StarHopper::Graph> StarHopper::graph(const QList<QPair<SkyPoint, SkyPoint>> &hops, float fov,
+                                                     float maglim)
+{
+    const long double jd = KStarsData::Instance()->updateNum()->julianDay();
 
-    // Test 6: Is the destination an asterism? Are there bright stars clustered nearby?
-    QList<StarObject *> localNeighbors;
-    StarComponent::Instance()->starsInAperture(localNeighbors, *next, fov / 10, maglim + 1.0);
-    double stardensitycost = 1 - localNeighbors.count(); // -1 "magnitude" for every neighbouring star
+    QList<SkyPoint> centers;
+    QList<double> radii;
+    bool covered = m_Graph && m_Graph->fov == fov && m_Graph->maglim == maglim && fabs(m_Graph->jd - jd) < GRAPH_LIFETIME;
 
-// Test 7: Identify star patterns
+    for (const auto &hop : hops)
+    {
+        const SkyPoint dest = catalogPoint(hop.second);
+        const double radius = corridorRadius(distance(toVector(catalogPoint(hop.first)), toVector(dest)), fov);
 
-#define RIGHT_ANGLE_THRESHOLD 0.05
-#define EQUAL_EDGE_THRESHOLD  0.025
+        centers.append(dest);
+        radii.append(radius);
+        covered = covered && m_Graph->covers(toVector(dest), radius);
+    }
 
-    double patterncost = 0;
-    QString patternName;
-    if (!isThisTheEnd)
+    if (!covered)
     {
-        // We ought to be dealing with a star
-        StarObject const *nextstar = dynamic_cast<StarObject const *>(next);
-        Q_ASSERT(nextstar);
+        m_Graph.reset(new Graph(fov, maglim, jd));
+        for (int i = 0; i < centers.size(); ++i)
+        {
+            if (!m_Graph->covers(toVector(centers[i]), radii[i]))
+                m_Graph->addCorridor(centers[i], radii[i]);
+        }
+    }
+
+    return m_Graph;
+}
 
-        float factor = 1.0;
-        while (factor <= 10.0)
+QList<const StarObject *> StarHopper::resolve(const Graph &graph, const QVector<int> &route, const SkyPoint &src,
+                                              QStringList *metadata) const
+{
+    QList<const StarObject *> result_path;
+    // Stars of the graph found again
+    QVector<int> result_stars;
+
+    for (int i : route)
+    {
+        const Graph::Star &star = graph.stars[i];
+        const StarObject *found = nullptr;
+
+        // The catalog positions of the stars are compared, their apparent positions may not be up to date
+        SkyPoint center(dms(star.ra * 180.0 / M_PI), dms(star.dec * 180.0 / M_PI));
+        QList<StarObject *> candidates;
+        StarComponent::Instance()->starsInAperture(candidates, center, 0.5, star.mag + 0.01);
+        for (const StarObject *candidate : candidates)
         {
-            localNeighbors.clear();
-            StarComponent::Instance()->starsInAperture(
-                localNeighbors, *next, fov / factor,
-                nextstar->mag() + 1.0); // Use a larger aperture for pattern identification; max 1.0 mag difference
-            foreach (StarObject *star, localNeighbors)
-            {
-                if (star == nextstar)
-                    localNeighbors.removeOne(star);
-                else if (fabs(star->mag() - nextstar->mag()) > 1.0)
-                    localNeighbors.removeOne(star);
-            } // Now, we should have a pruned list
-            factor += 1.0;
-            if (localNeighbors.size() == 2)
+            if (candidate->mag() != star.mag || candidate->ra0().radians() != star.ra ||
+                    candidate->dec0().radians() != star.dec)
+                continue;
+            found = candidate;
+            if (candidate == star.object)
                 break;
         }
-        factor -= 1.0;
-        if (localNeighbors.size() == 2)
+
+        if (found)
         {
-            patternName = i18n("triangle (of similar magnitudes)"); // any three stars form a triangle!
-            // Try to find triangles. Note that we assume that the standard Euclidian metric works on a sphere for small angles, i.e. the celestial sphere is nearly flat over our FOV.
-            StarObject *star1 = localNeighbors[0];
-            double dRA1       = nextstar->ra().radians() - star1->ra().radians();
-            double dDec1      = nextstar->dec().radians() - star1->dec().radians();
-            double dist1sqr   = dRA1 * dRA1 + dDec1 * dDec1;
-
-            StarObject *star2 = localNeighbors[1];
-            double dRA2       = nextstar->ra().radians() - star2->ra().radians();
-            double dDec2      = nextstar->dec().radians() - star2->dec().radians();
-            double dist2sqr   = dRA2 * dRA2 + dDec2 * dDec2;
-
-            // Check for right-angled triangles (without loss of generality, right angle is at this vertex)
-            if (fabs((dRA1 * dRA2 - dDec1 * dDec2) / sqrt(dist1sqr * dist2sqr)) < RIGHT_ANGLE_THRESHOLD)
-            {
-                // We have a right angled triangle! Give -3 magnitudes!
-                patterncost += -3;
-                patternName = i18n("right-angled triangle");
-            }
+            result_path.append(found);
+            result_stars.append(i);
+        }
+        else
+            qCWarning(KSTARS) << "StarHopper could not find again the star of mag" << star.mag << "at"
+                              << center.ra0().toHMSString() << center.dec0().toDMSString();
+    }
+    qCDebug(KSTARS) << "We've arrived at the destination! Yay! Result path count: " << result_path.count();
 
-            // Check for isosceles triangles (without loss of generality, this is the vertex)
-            if (fabs((dist1sqr - dist2sqr) / (dist1sqr)) < EQUAL_EDGE_THRESHOLD)
+    if (metadata)
+    {
+        const SkyPoint *prevHop = &src;
+
+        for (int i = 0; i < result_path.size(); ++i)
+        {
+            const StarObject *hopStar = result_path[i];
+            const Graph::Star &star   = graph.stars[result_stars[i]];
+            QString starHopDirections;
+            double pa; // should be 0 to 2pi
+
+            dms angDist = prevHop->angularDistanceTo(hopStar, &pa);
+
+            dms dmsPA;
+            dmsPA.setRadians(pa);
+            QString direction = KSUtils::toDirectionString(dmsPA);
+
+            QString patternName;
+            switch (star.pattern)
             {
-                patterncost += -1;
-                patternName = i18n("isosceles triangle");
-                if (fabs((dRA2 * dDec1 - dRA1 * dDec2) / sqrt(dist1sqr * dist2sqr)) < RIGHT_ANGLE_THRESHOLD)
-                {
-                    patterncost += -1;
+                case Graph::TRIANGLE:
+                    patternName = i18n("triangle (of similar magnitudes)");
+                    break;
+                case Graph::RIGHT_ANGLED_TRIANGLE:
+                    patternName = i18n("right-angled triangle");
+                    break;
+                case Graph::ISOSCELES_TRIANGLE:
+                    patternName = i18n("isosceles triangle");
+                    break;
+                case Graph::STRAIGHT_LINE:
                     patternName = i18n("straight line of 3 stars");
-                }
-                // Check for equilateral triangles
-                double dist3    = star1->angularDistanceTo(star2).radians();
-                double dist3sqr = dist3 * dist3;
-                if (fabs((dist3sqr - dist1sqr) / dist1sqr) < EQUAL_EDGE_THRESHOLD)
-                {
-                    patterncost += -1;
+                    break;
+                case Graph::EQUILATERAL_TRIANGLE:
                     patternName = i18n("equilateral triangle");
-                }
+                    break;
+                default:
+                    break;
             }
-        }
-        // TODO: Identify squares.
-        if (!patternName.isEmpty())
-        {
-            patternName += i18n(" within %1% of FOV of the marked star", (int)(100.0 / factor));
-            patternNames.insert(nextstar, patternName);
+
+            if (patternName.isEmpty())
+            {
+                QString spectralChar = "";
+                spectralChar += hopStar->spchar();
+                starHopDirections = i18n(" Slew %1 degrees %2 to find an %3 star of mag %4 ", QString::number(angDist.Degrees(), 'f', 2),
+                                         direction, spectralChar, QString::number(hopStar->mag()));
+            }
+            else
+            {
+                patternName += i18n(" within %1% of FOV of the marked star", star.patternSize);
+                starHopDirections = i18n(" Slew %1 degrees %2 to find a(n) %3", QString::number(angDist.Degrees(), 'f', 2), direction,
+                                         patternName);
+            }
+            qCDebug(KSTARS) << starHopDirections;
+            metadata->append(starHopDirections);
+            prevHop = hopStar;
         }
     }
 
-    netcost = magcost + speccost + distcost + stardensitycost + patterncost;
-    if (netcost < 0)
-        netcost = 0.1; // FIXME: Heuristics aren't supposed to be entirely random. This one is.
-    qCDebug(KSTARS) << "Mag cost: " << magcost << "; Spec Cost: " << speccost << "; Dist Cost: " << distcost
-             << "; Density cost: " << stardensitycost << "; Pattern cost: " << patterncost << "; Net cost: " << netcost
-             << "; Pattern: " << patternName;
-    return netcost;
+    return result_path;
 }
@@ -17,10 +17,14 @@
 
 #pragma once
 
-#include <QHash>
+#include <QFuture>
 #include <QList>
+#include <QObject>
+#include <QPair>
+#include <QStringList>
+#include <QVector>
 
-class QStringList;
+#include <memory>
 
 class SkyPoint;
 class StarObject;
@@ -29,12 +33,22 @@ class StarObject;
  * @class StarHopper
  * @short Helps planning star hopping
  *
- * @version 1.0
+ * The stars of the search corridor, brighter than one magnitude below the limit, are collected
+ * once into a graph, kept for the following hops within the same corridor. Routes are searched
+ * with A* over this graph, either synchronously with computePath(), or by a worker thread with
+ * computePaths(), which reports its progress and can be cancelled.
+ *
+ * @version 1.1
  * @author Akarsh Simha
  */
-class StarHopper
+class StarHopper : public QObject
 {
+    Q_OBJECT
+
   public:
+    explicit StarHopper(QObject *parent = nullptr);
+    ~StarHopper() override;
+
     /**
      * @short Computes path for Star Hop
      * @param src SkyPoint to source of the Star Hop
@@ -48,35 +62,65 @@ class StarHopper
     QList<StarObject *> *computePath(const SkyPoint &src, const SkyPoint &dest, float fov__, float maglim__,
                                      QStringList *metadata_ = nullptr);
 
+    /**
+     * @short Computes the paths of several Star Hops in the background
+     * @param hops source and destination of each Star Hop, e.g. to the targets of an observing list
+     * @param fov Field of view within which stars are considered
+     * @param maglim Magnitude limit of stars to consider
+     * @note The stars of the corridors are collected before returning, all the hops sharing one
+     * graph. Each path is then reported by pathFound(), followed by finished(). A search still
+     * running is cancelled.
+     */
+    void computePaths(const QList<QPair<SkyPoint, SkyPoint>> &hops, float fov, float maglim);
+
+    /** @short Cancels the search running in the background, if any. Its paths are not reported. */
+    void cancel();
+
+    /** @return true while a search is running in the background */
+    bool isRunning() const;
+
+  signals:
+    /** Progress of the background search over all its hops, in percent */
+    void progress(int percent);
+
+    /**
+     * A path was found by the background search
+     * @param index index of the hop in the list passed to computePaths()
+     * @param path the stars to hop to, empty if no path was found
+     * @param directions directions for starhopping to each star of the path
+     */
+    void pathFound(int index, const QList<StarObject *> &path, const QStringList &directions);
+
+    /** The background search completed, after all its paths were reported */
+    void finished();
+
   protected:
     // Returns a list of constant StarObject pointers which form the resultant path of Star Hop
     QList<const StarObject *> computePath_const(const SkyPoint &src, const SkyPoint &dest, float fov_, float maglim_,
                                                 QStringList *metadata = nullptr);
 
+  private slots:
+    void slotProgress(int search, int percent);
+    void slotSearchDone(int search);
+
   private:
-    /**
-     * @short The cost function for hopping from current position to the a given star, in view of the final destination
-     * @param curr Source SkyPoint
-     * @param next Next point in the hop.
-     * @note If 'next' is neither the starting point of the hop, nor
-     * the ending point, it _has_ to be a StarObject. A dynamic cast
-     * followed by a Q_ASSERT will ensure this.
-     */
-    float cost(const SkyPoint *curr, const SkyPoint *next);
+    struct Graph;
+    struct Search;
+
+    /** @short Returns the graph covering the corridors of the hops, reusing the last one if it does */
+    std::shared_ptr<Graph> graph(const QList<QPair<SkyPoint, SkyPoint>> &hops, float fov, float maglim);
 
     /**
-     * @short For internal use by the A* Search Algorithm. Completes
-     * the star-hop path. See https://en.wikipedia.org/wiki/A*_search_algorithm for details
+     * @short Finds the stars of a route in the star catalogs again, and writes the directions
+     * @note Deep stars may have been unloaded since the graph was built, so that their pointers
+     * cannot be kept by the graph.
      */
-    void reconstructPath(SkyPoint const *curr_node);
-
-    float fov { 0 };
-    float maglim { 0 };
-    QString starHopDirections;
-    // Useful for internal computations
-    SkyPoint const *start { nullptr };
-    SkyPoint const *end { nullptr };
-    QHash<const SkyPoint *, const SkyPoint *> came_from; // Used by the A* search algorithm
-    QList<StarObject const *> result_path;
-    QHash<SkyPoint const *, QString> patternNames; // if patterns were identified, they are added to this hash.
+    QList<const StarObject *> resolve(const Graph &graph, const QVector<int> &route, const SkyPoint &src,
+                                      QStringList *metadata) const;
+
+    std::shared_ptr<Graph> m_Graph;
+    std::shared_ptr<Search> m_Search;
+    QFuture<void> m_Future;
+    // Incremented for each search, so that the reports of a cancelled one are ignored
+    int m_SearchNumber { 0 };
 };
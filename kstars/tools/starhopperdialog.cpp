@@ -17,6 +17,7 @@
 
 #include "starhopperdialog.h"
 
+#include "fov.h"
 #include "kstars.h"
 #include "ksutils.h"
 #include "skymap.h"
@@ -26,6 +27,8 @@
 #include "targetlistcomponent.h"
 #include "dialogs/detaildialog.h"
 
+#include <QInputDialog>
+
 StarHopperDialog::StarHopperDialog(QWidget *parent) : QDialog(parent), ui(new Ui::StarHopperDialog)
 {
     ui->setupUi(this);
@@ -33,6 +36,10 @@ StarHopperDialog::StarHopperDialog(QWidget *parent) : QDialog(parent), ui(new Ui
     m_Metadata = new QStringList();
     ui->directionsLabel->setWordWrap(true);
     m_sh.reset(new StarHopper());
+    connect(m_sh.get(), SIGNAL(progress(int)), this, SLOT(slotProgress(int)));
+    connect(m_sh.get(), SIGNAL(pathFound(int,QList<StarObject*>,QStringList)), this,
+            SLOT(slotPathFound(int,QList<StarObject*>,QStringList)));
+    connect(m_sh.get(), SIGNAL(finished()), this, SLOT(slotSearchFinished()));
     connect(ui->NextButton, SIGNAL(clicked()), this, SLOT(slotNext()));
     connect(ui->GotoButton, SIGNAL(clicked()), this, SLOT(slotGoto()));
     connect(ui->DetailsButton, SIGNAL(clicked()), this, SLOT(slotDetails()));
@@ -53,28 +60,99 @@ StarHopperDialog::~StarHopperDialog()
 
 void StarHopperDialog::starHop(const SkyPoint &startHop, const SkyPoint &stopHop, float fov, float maglim)
 {
-    QList<StarObject *> *starList = m_sh->computePath(startHop, stopHop, fov, maglim, m_Metadata);
+    QList<QPair<SkyPoint, SkyPoint>> hops;
+    hops.append(qMakePair(startHop, stopHop));
+
+    starHop(hops, fov, maglim);
+}
+
+void StarHopperDialog::starHop(const QList<QPair<SkyPoint, SkyPoint>> &hops, float fov, float maglim)
+{
+    m_Path.clear();
+    m_Metadata->clear();
+    m_lw->clear();
+    m_FailedHops = 0;
+
+    ui->directionsLabel->setText(i18n("Searching for a star hopping route..."));
+    m_sh->computePaths(hops, fov, maglim);
+}
+
+double StarHopperDialog::chooseFOV(QWidget *parent, bool *ok)
+{
+    KStarsData *data = KStarsData::Instance();
+    double fov       = 0; // Field of view in arcminutes
 
-    if (!starList->empty())
+    if (data->getAvailableFOVs().size() == 1)
+    {
+        // Exactly 1 FOV symbol visible, so use that. Also assume a circular FOV of size min{sizeX, sizeY}
+        FOV *f = data->getAvailableFOVs().first();
+        fov    = ((f->sizeX() >= f->sizeY() && f->sizeY() != 0) ? f->sizeY() : f->sizeX());
+        *ok    = true;
+    }
+    else if (!data->getAvailableFOVs().isEmpty())
     {
-        foreach (StarObject *so, *starList)
+        // Ask the user to choose from a list of available FOVs.
+        FOV const *f;
+        QMap<QString, double> nameToFovMap;
+        foreach (f, data->getAvailableFOVs())
+        {
+            nameToFovMap.insert(f->name(),
+                                ((f->sizeX() >= f->sizeY() && f->sizeY() != 0) ? f->sizeY() : f->sizeX()));
+        }
+        fov = nameToFovMap[QInputDialog::getItem(parent, i18n("Star Hopper: Choose a field-of-view"),
+                                                 i18n("FOV to use for star hopping:"), nameToFovMap.uniqueKeys(), 0,
+                                                 false, ok)];
+    }
+    else
+    {
+        // Ask the user to enter a field of view
+        fov = QInputDialog::getDouble(parent, i18n("Star Hopper: Enter field-of-view to use"),
+                                      i18n("FOV to use for star hopping (in arcminutes):"), 60.0, 1.0, 600.0, 1, ok);
+    }
+
+    return fov;
+}
+
+void StarHopperDialog::slotProgress(int percent)
+{
+    ui->directionsLabel->setText(i18n("Searching for a star hopping route... %1%", percent));
+}
+
+void StarHopperDialog::slotPathFound(int index, const QList<StarObject *> &path, const QStringList &directions)
+{
+    Q_UNUSED(index);
+
+    // The paths are reported in the order of the hops, so the routes are chained
+    if (!path.empty())
+    {
+        *m_Metadata << directions;
+        foreach (StarObject *so, path)
         {
             setData(so);
         }
         slotRefreshMetadata();
-        m_skyObjList = KSUtils::castStarObjListToSkyObjList(starList);
-        starList->clear();
-        delete starList;
+        m_Path << path;
+        m_skyObjList = KSUtils::castStarObjListToSkyObjList(&m_Path);
         TargetListComponent *t = getTargetListComponent();
         t->list.reset(m_skyObjList);
         SkyMap::Instance()->forceUpdate(true);
     }
     else
-    {
-        delete starList;
-        KSNotification::error(i18n("Star-hopper algorithm failed. If you're trying a large star hop, try using a "
-                                   "smaller FOV or changing the source point"));
-    }
+        m_FailedHops++;
+}
+
+void StarHopperDialog::slotSearchFinished()
+{
+    if (m_FailedHops == 0)
+        return;
+
+    if (m_Path.isEmpty())
+        ui->directionsLabel->clear();
+    KSNotification::error(i18np("Star-hopper algorithm failed for one hop. If you're trying a large star hop, try "
+                                "using a smaller FOV or changing the source point",
+                                "Star-hopper algorithm failed for %1 hops. If you're trying a large star hop, try "
+                                "using a smaller FOV or changing the source point",
+                                m_FailedHops));
 }
 
 void StarHopperDialog::setData(StarObject *sobj)
@@ -47,11 +47,32 @@ class StarHopperDialog : public QDialog, public Ui::StarHopperDialog
      * @param stopHop SkyPoint to destination of StarHop
      * @param fov Field of view under consideration
      * @param maglim Magnitude limit of star to search for
-     * @note In turn calls StarHopper to perform computations
+     * @note In turn calls StarHopper to perform computations, in the background. The route is
+     * displayed when found, and the search is cancelled if the dialog is closed before.
      */
     void starHop(const SkyPoint &startHop, const SkyPoint &stopHop, float fov, float maglim);
 
+    /**
+     * @short Forms the Star Hop routes between consecutive points, e.g. the targets of an observing session
+     * @param hops source and destination of each Star Hop
+     * @param fov Field of view under consideration
+     * @param maglim Magnitude limit of star to search for
+     * @note All the routes are computed in one background search and displayed one after the other.
+     */
+    void starHop(const QList<QPair<SkyPoint, SkyPoint>> &hops, float fov, float maglim);
+
+    /**
+     * @short Asks for the field of view to use for star hopping
+     * @param parent parent widget of the input dialogs
+     * @param ok set to false if the user cancelled the operation
+     * @return the field of view in arcminutes, from the visible FOV symbols when there are some
+     */
+    static double chooseFOV(QWidget *parent, bool *ok);
+
   private slots:
+    void slotProgress(int percent);
+    void slotPathFound(int index, const QList<StarObject *> &path, const QStringList &directions);
+    void slotSearchFinished();
     void slotNext();
     void slotGoto();
     void slotDetails();
@@ -67,4 +88,6 @@ class StarHopperDialog : public QDialog, public Ui::StarHopperDialog
     Ui::StarHopperDialog *ui { nullptr };
     QListWidget *m_lw { nullptr };
     QStringList *m_Metadata { nullptr };
+    QList<StarObject *> m_Path;
+    int m_FailedHops { 0 };
 };
@@ -52,6 +52,7 @@ ModelManager::ModelManager(ObsConditions *obs)
 
 ModelManager::~ModelManager()
 {
+    m_Filters.waitForFinished();
     qDeleteAll(m_ModelList);
     foreach (QList<SkyObjItem *> list, m_ObjectList)
         qDeleteAll(list);
@@ -222,29 +223,141 @@ void ModelManager::loadSharplessCatalog()
 void ModelManager::updateAllModels(ObsConditions *obs)
 {
     m_ObsConditions = obs;
-    resetAllModels();
 
     for (int i = 0; i < NumberOfLists; i++)
-        loadObjectsIntoModel(*m_ModelList[i], m_ObjectList[i]);
+        filterModel(i, m_ObjectList[i]);
 }
 
 void ModelManager::updateModel(ObsConditions *obs, QString modelName)
 {
-    m_ObsConditions        = obs;
-    SkyObjListModel *model = returnModel(modelName);
-    if (model)
+    m_ObsConditions = obs;
+    int modelNumber = getModelNumber(modelName);
+    if (modelNumber < 0)
+        return;
+
+    if (showOnlyFavorites && modelNumber == Galaxies)
+        filterModel(modelNumber, favoriteGalaxies);
+    else if (showOnlyFavorites && modelNumber == Nebulas)
+        filterModel(modelNumber, favoriteNebulas);
+    else if (showOnlyFavorites && modelNumber == Clusters)
+        filterModel(modelNumber, favoriteClusters);
+    else
+        filterModel(modelNumber, m_ObjectList[modelNumber]);
+}
+
+void ModelManager::filterModel(int modelNumber, const QList<SkyObjItem *> &candidates)
+{
+    int generation = m_Generation[modelNumber].fetchAndAddOrdered(1) + 1;
+
+    // Sky objects are updated by the GUI thread, capture what the filter needs here
+    KStarsData *data  = KStarsData::Instance();
+    KStarsDateTime ut = data->ut();
+    QList<FilterItem> items;
+    QList<VisibilityIndex::Candidate> positions;
+    if (showOnlyVisible)
     {
-        model->resetModel();
-        if (showOnlyFavorites && modelName == "galaxies")
-            loadObjectsIntoModel(*m_ModelList[getModelNumber(modelName)], favoriteGalaxies);
-        else if (showOnlyFavorites && modelName == "nebulas")
-            loadObjectsIntoModel(*m_ModelList[getModelNumber(modelName)], favoriteNebulas);
-        else if (showOnlyFavorites && modelName == "clusters")
-            loadObjectsIntoModel(*m_ModelList[getModelNumber(modelName)], favoriteClusters);
-        else
-            loadObjectsIntoModel(*m_ModelList[getModelNumber(modelName)], m_ObjectList[getModelNumber(modelName)]);
-        emit modelUpdated();
+        QList<const SkyObject *> indexed;
+        items.reserve(candidates.size());
+        for (SkyObjItem *soitem : candidates)
+        {
+            FilterItem item;
+            item.item      = soitem;
+            item.object    = soitem->getSkyObject();
+            item.mag       = item.object->mag();
+            item.satellite = item.object->type() == SkyObject::SATELLITE;
+            if (item.satellite)
+                item.satelliteVisible = item.object->alt().Degrees() > VisibilityIndex::MinAltitude;
+            else
+                indexed.append(item.object);
+            items.append(item);
+        }
+        m_VisibilityIndex.setNight(ut, data->geo());
+        positions = m_VisibilityIndex.candidates(indexed);
+    }
+    else
+    {
+        for (SkyObjItem *soitem : candidates)
+        {
+            FilterItem item;
+            item.item = soitem;
+            items.append(item);
+        }
     }
+
+    QList<QFuture<void>> running;
+    for (const QFuture<void> &future : m_Filters.futures())
+    {
+        if (!future.isFinished())
+            running.append(future);
+    }
+    m_Filters.clearFutures();
+    for (const QFuture<void> &future : running)
+        m_Filters.addFuture(future);
+
+    const double limitingMagnitude = m_ObsConditions->getTrueMagLim();
+    const bool onlyVisible         = showOnlyVisible;
+    m_Filters.addFuture(
+        QtConcurrent::run([this, modelNumber, generation, items, positions, ut, limitingMagnitude, onlyVisible]()
+    {
+        filterObjects(modelNumber, generation, items, positions, ut, limitingMagnitude, onlyVisible);
+    }));
+}
+
+void ModelManager::filterObjects(int modelNumber, int generation, QList<FilterItem> items,
+                                 QList<VisibilityIndex::Candidate> positions, KStarsDateTime ut,
+                                 double limitingMagnitude, bool onlyVisible)
+{
+    QList<SkyObjItem *> visibleObjects;
+
+    if (onlyVisible)
+    {
+        m_VisibilityIndex.addObjects(positions);
+
+        for (const FilterItem &item : items)
+        {
+            bool isVisible = false;
+            if (item.satellite)
+                isVisible = item.satelliteVisible;
+            else
+                isVisible = item.mag < limitingMagnitude && m_VisibilityIndex.isAboveHorizon(item.object, ut);
+            if (isVisible)
+                visibleObjects.append(item.item);
+        }
+    }
+    else
+    {
+        for (const FilterItem &item : items)
+            visibleObjects.append(item.item);
+    }
+
+    {
+        QMutexLocker locker(&m_FilteredObjectsMutex);
+        m_FilteredObjects.insert(modelNumber, qMakePair(generation, visibleObjects));
+    }
+    QMetaObject::invokeMethod(this, "applyFilteredObjects", Qt::QueuedConnection, Q_ARG(int, modelNumber),
+                              Q_ARG(int, generation));
+}
+
+void ModelManager::applyFilteredObjects(int modelNumber, int generation)
+{
+    if (generation != m_Generation[modelNumber].load())
+        return;
+
+    QList<SkyObjItem *> visibleObjects;
+    {
+        QMutexLocker locker(&m_FilteredObjectsMutex);
+        auto it = m_FilteredObjects.find(modelNumber);
+        if (it == m_FilteredObjects.end() || it->first != generation)
+            return;
+        visibleObjects = it->second;
+        m_FilteredObjects.erase(it);
+    }
+
+    SkyObjListModel *model = m_ModelList[modelNumber];
+    model->resetModel();
+    for (SkyObjItem *soitem : visibleObjects)
+        model->addSkyObject(soitem);
+    emit modelUpdated();
 }
 
 void ModelManager::loadObjectList(QList<SkyObjItem *> &skyObjectList, int type)
@@ -281,19 +394,6 @@ void ModelManager::loadObjectList(QList<SkyObjItem *> &skyObjectList, int type)
     }
 }
 
-void ModelManager::loadObjectsIntoModel(SkyObjListModel &model, QList<SkyObjItem *> &skyObjectList)
-{
-    KStarsData *data = KStarsData::Instance();
-
-    foreach (SkyObjItem *soitem, skyObjectList)
-    {
-        bool isVisible =
-            (showOnlyVisible) ? (m_ObsConditions->isVisible(data->geo(), data->lst(), soitem->getSkyObject())) : true;
-        if (isVisible)
-            model.addSkyObject(soitem);
-    }
-}
-
 void ModelManager::resetAllModels()
 {
     foreach (SkyObjListModel *model, m_ModelList)
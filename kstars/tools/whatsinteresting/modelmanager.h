@@ -18,8 +18,13 @@
 #pragma once
 
 #include "skyobjitem.h"
+#include "visibilityindex.h"
 
+#include <QAtomicInt>
+#include <QFutureSynchronizer>
+#include <QHash>
 #include <QList>
+#include <QMutex>
 #include <QObject>
 
 class ObsConditions;
@@ -68,6 +73,13 @@ class ModelManager : public QObject
     /** Updates sky-object list models. */
     void updateAllModels(ObsConditions *obs);
 
+    /**
+     * @brief Refill the model of the given type.
+     * The visible objects are filtered on a background thread using the nightly visibility
+     * index, the model is then updated on the GUI thread and modelUpdated() is emitted.
+     * @param obs   Observing conditions to filter with.
+     * @param modelName Name of the sky-object model to update.
+     */
     void updateModel(ObsConditions *obs, QString modelName);
 
     /** Clears all sky-objects list models. */
@@ -103,11 +115,30 @@ class ModelManager : public QObject
     void loadProgressUpdated(double progress);
     void modelUpdated();
 
+  private slots:
+    /** Replace the contents of a model with the result of its last filtering */
+    void applyFilteredObjects(int modelNumber, int generation);
+
   private:
     void loadLists();
     void loadObjectList(QList<SkyObjItem *> &skyObjectList, int type);
     void loadNamedStarList();
-    void loadObjectsIntoModel(SkyObjListModel &model, QList<SkyObjItem *> &skyObjectList);
+    /** Start filtering the candidates of a model, see updateModel() */
+    void filterModel(int modelNumber, const QList<SkyObjItem *> &candidates);
+    /// State of a candidate captured on the GUI thread by filterModel()
+    struct FilterItem
+    {
+        SkyObjItem *item { nullptr };
+        const SkyObject *object { nullptr };
+        float mag { 0 };
+        /// Satellites move too fast to be indexed for the night, they are tested directly
+        bool satellite { false };
+        bool satelliteVisible { false };
+    };
+    /** Background part of filterModel(), only works on the captured state */
+    void filterObjects(int modelNumber, int generation, QList<FilterItem> items,
+                       QList<VisibilityIndex::Candidate> positions, KStarsDateTime ut, double limitingMagnitude,
+                       bool onlyVisible);
 
     ObsConditions *m_ObsConditions { nullptr };
     QList<QList<SkyObjItem *>> m_ObjectList;
@@ -121,4 +152,14 @@ class ModelManager : public QObject
     bool ngcLoaded { false };
     bool icLoaded { false };
     bool sharplessLoaded { false };
+
+    /// Above-horizon windows of the candidates for the current night
+    VisibilityIndex m_VisibilityIndex;
+    /// Latest filtering request of each model, older results are dropped
+    QAtomicInt m_Generation[NumberOfLists];
+    /// Filtered objects waiting to be applied, per model
+    QHash<int, QPair<int, QList<SkyObjItem *>>> m_FilteredObjects;
+    QMutex m_FilteredObjectsMutex;
+    /// Running filters, finished ones are dropped when a new one starts
+    QFutureSynchronizer<void> m_Filters;
 };
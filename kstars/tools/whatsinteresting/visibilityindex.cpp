@@ -0,0 +1,156 @@
+/*  Precomputed nightly visibility of What's Interesting objects
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+*/
+
+#include "visibilityindex.h"
+
+#include "ephemerisbatch.h"
+#include "geolocation.h"
+#include "skyobjects/skyobject.h"
+
+#include <QMutexLocker>
+
+void VisibilityIndex::setNight(const KStarsDateTime &ut, const GeoLocation *geo)
+{
+    KStarsDateTime lt = geo->UTtoLT(ut);
+    KStarsDateTime noon(lt.date(), QTime(12, 0, 0));
+    if (lt.time() < QTime(12, 0, 0))
+        noon = noon.addDays(-1);
+    KStarsDateTime start = geo->LTtoUT(noon);
+
+    QMutexLocker locker(&m_Mutex);
+    if (start == m_Start && geo == m_Geo && geo->lat()->Degrees() == m_Latitude &&
+        geo->lng()->Degrees() == m_Longitude)
+        return;
+
+    m_Start     = start;
+    m_Geo       = geo;
+    m_Latitude  = geo->lat()->Degrees();
+    m_Longitude = geo->lng()->Degrees();
+    m_Entries.clear();
+}
+
+QList<VisibilityIndex::Candidate> VisibilityIndex::candidates(const QList<const SkyObject *> &objects) const
+{
+    QList<Candidate> result;
+    KStarsDateTime start;
+    const GeoLocation *geo = nullptr;
+    {
+        QMutexLocker locker(&m_Mutex);
+        if (m_Geo == nullptr)
+            return result;
+        for (const SkyObject *object : objects)
+        {
+            if (!m_Entries.contains(object))
+            {
+                Candidate candidate;
+                candidate.object = object;
+                result.append(candidate);
+            }
+        }
+        start = m_Start;
+        geo   = m_Geo;
+    }
+
+    // Objects move little during one night, so their position at midnight is used for all samples
+    const KStarsDateTime midnight = start.addSecs(12 * 3600);
+    for (Candidate &candidate : result)
+    {
+        if (candidate.object->isSolarSystem())
+        {
+            candidate.position = candidate.object->recomputeCoords(midnight, geo);
+            candidate.apparent = true;
+        }
+        else
+            candidate.position = SkyPoint(candidate.object->ra0(), candidate.object->dec0());
+    }
+    return result;
+}
+
+void VisibilityIndex::addObjects(QList<Candidate> candidates)
+{
+    KStarsDateTime start;
+    const GeoLocation *geo = nullptr;
+    {
+        QMutexLocker locker(&m_Mutex);
+        if (m_Geo == nullptr)
+            return;
+        start = m_Start;
+        geo   = m_Geo;
+    }
+    if (candidates.isEmpty())
+        return;
+
+    const KStarsDateTime midnight = start.addSecs(12 * 3600);
+    QList<SkyPoint *> catalogPositions;
+    for (Candidate &candidate : candidates)
+    {
+        if (!candidate.apparent)
+            catalogPositions.append(&candidate.position);
+    }
+    SkyPoint::apparentCoords(catalogPositions, J2000L, midnight.djd());
+
+    QList<const SkyPoint *> points;
+    points.reserve(candidates.size());
+    for (const Candidate &candidate : candidates)
+        points.append(&candidate.position);
+
+    const QVector<QVector<double>> curves = EphemerisBatch::altitudes(points, start, SampleStep, SampleCount, geo);
+
+    QHash<const SkyObject *, Entry> entries;
+    entries.reserve(candidates.size());
+    for (int i = 0; i < candidates.size(); ++i)
+    {
+        const QVector<double> &curve = curves.at(i);
+        Entry entry;
+        int rise = -1;
+        for (int j = 0; j < curve.size(); ++j)
+        {
+            entry.peakAltitude = qMax(entry.peakAltitude, static_cast<float>(curve.at(j)));
+            if (curve.at(j) > MinAltitude && rise < 0)
+                rise = j;
+            else if (curve.at(j) <= MinAltitude && rise >= 0)
+            {
+                entry.windows.append(qMakePair(float(rise * SampleStep / 3600), float(j * SampleStep / 3600)));
+                rise = -1;
+            }
+        }
+        if (rise >= 0)
+            entry.windows.append(qMakePair(float(rise * SampleStep / 3600), 24.0f));
+        entries.insert(candidates.at(i).object, entry);
+    }
+
+    QMutexLocker locker(&m_Mutex);
+    // Drop the results if the night changed in the meantime
+    if (start == m_Start && geo == m_Geo)
+    {
+        for (auto it = entries.constBegin(); it != entries.constEnd(); ++it)
+            m_Entries.insert(it.key(), it.value());
+    }
+}
+
+bool VisibilityIndex::isAboveHorizon(const SkyObject *object, const KStarsDateTime &ut) const
+{
+    QMutexLocker locker(&m_Mutex);
+    auto it = m_Entries.constFind(object);
+    if (it == m_Entries.constEnd())
+        return false;
+
+    const float hour = static_cast<float>((ut.djd() - m_Start.djd()) * 24.0);
+    for (const auto &window : it->windows)
+    {
+        if (hour >= window.first && hour < window.second)
+            return true;
+    }
+    return false;
+}
+
+VisibilityIndex::Entry VisibilityIndex::entry(const SkyObject *object) const
+{
+    QMutexLocker locker(&m_Mutex);
+    return m_Entries.value(object);
+}
@@ -0,0 +1,102 @@
+/*  Precomputed nightly visibility of What's Interesting objects
+
+    This application is free software; you can redistribute it and/or
+    modify it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+*/
+
+#pragma once
+
+#include "kstarsdatetime.h"
+
+#include <QHash>
+#include <QList>
+#include "skyobjects/skypoint.h"
+
+#include <QMutex>
+#include <QPair>
+#include <QVector>
+
+class GeoLocation;
+class SkyObject;
+
+/**
+ * @class VisibilityIndex
+ * @brief Altitude windows of sky-objects during one night.
+ *
+ * The altitude of each indexed object is sampled over the 24 hours following local noon.
+ * The intervals spent above the horizon limit are kept together with the peak altitude,
+ * so that visibility tests become lookups instead of coordinate computations.
+ *
+ * Entries are computed once per night and location, and the index may be used from
+ * several threads at once. Objects are never read outside of the GUI thread: their
+ * positions are captured by candidates() and indexed from that snapshot by addObjects().
+ */
+class VisibilityIndex
+{
+  public:
+    struct Entry
+    {
+        /// Intervals above the horizon limit, in hours since the start of the night
+        QVector<QPair<float, float>> windows;
+        /// Highest altitude reached during the night, in degrees
+        float peakAltitude { -90 };
+    };
+
+    /// Position of an object captured on the GUI thread
+    struct Candidate
+    {
+        const SkyObject *object { nullptr };
+        /// Apparent position for solar system objects, catalog position otherwise
+        SkyPoint position;
+        bool apparent { false };
+    };
+
+    /// Altitude in degrees above which an object is considered visible
+    static constexpr double MinAltitude = 6.0;
+
+    /**
+     * @brief Select the night to index.
+     * The night starts at the local noon preceding ut. Entries of another night or
+     * location are discarded.
+     * @param ut universal time within the night
+     * @param geo location of the observer, must outlive the index
+     */
+    void setNight(const KStarsDateTime &ut, const GeoLocation *geo);
+
+    /**
+     * @brief Capture the positions of the objects which are not indexed yet.
+     * Must be called from the GUI thread, as solar system objects are moved to the
+     * middle of the night.
+     */
+    QList<Candidate> candidates(const QList<const SkyObject *> &objects) const;
+
+    /**
+     * @brief Compute the entries of captured candidates.
+     * Catalog positions are converted to apparent ones in one batch, this may run on any thread.
+     */
+    void addObjects(QList<Candidate> candidates);
+
+    /**
+     * @return true if the object is indexed and above the horizon limit at ut.
+     * ut is expected to lie within the indexed night.
+     */
+    bool isAboveHorizon(const SkyObject *object, const KStarsDateTime &ut) const;
+
+    /** @return the entry of the object, or an empty entry if it is not indexed */
+    Entry entry(const SkyObject *object) const;
+
+  private:
+    /// Sampling interval of the altitude curves in seconds
+    static constexpr double SampleStep = 600;
+    /// Number of samples covering the night
+    static constexpr int SampleCount = 24 * 3600 / 600 + 1;
+
+    mutable QMutex m_Mutex;
+    KStarsDateTime m_Start;
+    const GeoLocation *m_Geo { nullptr };
+    double m_Latitude { 0 };
+    double m_Longitude { 0 };
+    QHash<const SkyObject *, Entry> m_Entries;
+};
@@ -388,10 +388,12 @@ void WIView::onReloadIconClicked()
 {
     if (!m_CurrentObjectListName.isEmpty())
     {
+        // The details view is reloaded by refreshListView() once the model is filtered
+        m_ReloadPending = true;
         updateModel(*m_Obs);
-        m_CurIndex = m_ModManager->returnModel(m_CurrentObjectListName)->getSkyObjIndex(m_CurSoItem);
     }
-    loadDetailsView(m_CurSoItem, m_CurIndex);
+    else
+        loadDetailsView(m_CurSoItem, m_CurIndex);
 }
 
 void WIView::onVisibleIconClicked(bool visible)
@@ -449,6 +451,16 @@ void WIView::refreshListView()
     m_Ctxt->setContextProperty("soListModel", nullptr);
     if (!m_CurrentObjectListName.isEmpty())
         m_Ctxt->setContextProperty("soListModel", m_ModManager->returnModel(m_CurrentObjectListName));
+    // Models are filled asynchronously, so locate the current object again in the new contents
+    if (m_ReloadPending)
+    {
+        m_ReloadPending = false;
+        if (!m_CurrentObjectListName.isEmpty())
+            m_CurIndex = m_ModManager->returnModel(m_CurrentObjectListName)->getSkyObjIndex(m_CurSoItem);
+        loadDetailsView(m_CurSoItem, m_CurIndex);
+    }
+    else if (m_CurIndex >= 0 && m_CurSoItem != nullptr)
+        m_CurIndex = m_ModManager->returnModel(m_CurrentObjectListName)->getSkyObjIndex(m_CurSoItem);
     if (m_CurIndex == -2)
         onSoListItemClicked(0);
     if (m_CurIndex != -1)
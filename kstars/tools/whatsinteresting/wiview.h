@@ -164,6 +164,8 @@ class WIView : public QWidget
     int m_CurIndex { 0 };
     /// Currently selected category from WI QML view
     QString m_CurrentObjectListName;
+    /// Reload the details view once the model being refiltered is updated
+    bool m_ReloadPending { false };
     std::unique_ptr<QNetworkAccessManager> manager;
     bool inspectOnClick { false };
 };